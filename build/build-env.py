@@ -261,6 +261,9 @@ def Environment(buildDir):
     # add a variable to treat warnings as errors
     vars.Add(BoolVariable('Werror', 'Treat warnings as errors', 0))
 
+    # add a variable to build the MPI examples
+    vars.Add(BoolVariable('mpi', 'Build the MPI examples', 0))
+
     # add a variable to filter source files by a regex
     vars.Add('tests', help='Filter test files using a regex')
 
@@ -0,0 +1,211 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file assembly.h
+ *  \brief Repeated assembly of element contributions into a fixed CSR pattern
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+
+/*! \addtogroup sparse_matrices Sparse Matrices
+ *  \{
+ */
+
+/**
+ * \brief Assembles finite-element style contributions into a preallocated
+ * CSR sparsity pattern.
+ *
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam ValueType Type used for matrix values (e.g. \c float or \c double).
+ *
+ * \par Overview
+ * The sparsity pattern of the assembled matrix is computed once from the
+ * element connectivity: node \c i couples with node \c j whenever some
+ * element contains both nodes. Afterwards the values of the matrix can be
+ * reassembled any number of times in a single streaming pass without
+ * sorting or reducing triplets.
+ *
+ * Two thread-safe routes are provided.
+ *  - \p add_values accumulates a dense block addressed by arbitrary row and
+ *    column node lists. Every entry is located with a binary search in its
+ *    (sorted) row and accumulated atomically, so it may be called
+ *    concurrently from OpenMP threads.
+ *  - \p assemble evaluates one dense block per element with a user
+ *    supplied functor and scatters it through a cached list of value
+ *    positions per element. Elements are colored so that elements of the
+ *    same color share no nodes, hence the scatter of a color runs in
+ *    parallel without atomics.
+ *
+ * The assembled matrix lives in host memory and can be copied to any other
+ * memory space or format afterwards.
+ *
+ * \note Atomic accumulation in \p add_values requires a real \p ValueType.
+ *
+ * \par Example
+ * \code
+ * #include <cusp/assembly.h>
+ * #include <cusp/print.h>
+ *
+ * // element stiffness of a linear 1D element of unit length
+ * struct laplace_1d
+ * {
+ *    template <typename ValueType>
+ *    void operator()(size_t element, ValueType* block) const
+ *    {
+ *        block[0] =  1; block[1] = -1;
+ *        block[2] = -1; block[3] =  1;
+ *    }
+ * };
+ *
+ * int main(void)
+ * {
+ *    // 4 nodes connected by 3 two-node elements
+ *    cusp::array1d<int, cusp::host_memory> offsets(4);
+ *    cusp::array1d<int, cusp::host_memory> nodes(6);
+ *    offsets[0] = 0; offsets[1] = 2; offsets[2] = 4; offsets[3] = 6;
+ *    nodes[0] = 0; nodes[1] = 1;
+ *    nodes[2] = 1; nodes[3] = 2;
+ *    nodes[4] = 2; nodes[5] = 3;
+ *
+ *    // build the pattern once
+ *    cusp::csr_assembler<int, float> assembler(4, offsets, nodes);
+ *
+ *    // reassemble values as often as needed
+ *    assembler.assemble(laplace_1d());
+ *
+ *    cusp::print(assembler.matrix);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template <typename IndexType, typename ValueType>
+class csr_assembler
+{
+public:
+
+    /*! Assembled matrix with fixed sparsity pattern.
+     */
+    cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> matrix;
+
+    /* \cond */
+    cusp::array1d<IndexType, cusp::host_memory> element_offsets;
+    cusp::array1d<IndexType, cusp::host_memory> element_indices;
+
+    // positions in matrix.values of every dense element block
+    cusp::array1d<IndexType, cusp::host_memory> position_offsets;
+    cusp::array1d<IndexType, cusp::host_memory> positions;
+
+    // elements grouped by color
+    cusp::array1d<IndexType, cusp::host_memory> color_offsets;
+    cusp::array1d<IndexType, cusp::host_memory> element_order;
+    /* \endcond */
+
+    /*! Construct the sparsity pattern from element connectivity.
+     *
+     * \tparam ArrayType1 Type of element offsets array
+     * \tparam ArrayType2 Type of element node indices array
+     *
+     * \param num_nodes Number of nodes (rows and columns of the matrix).
+     * \param element_offsets Offsets of the node lists of every element,
+     * of length <tt>num_elements + 1</tt>.
+     * \param element_indices Concatenated node lists of all elements.
+     */
+    template <typename ArrayType1, typename ArrayType2>
+    csr_assembler(const size_t num_nodes,
+                  const ArrayType1& element_offsets,
+                  const ArrayType2& element_indices);
+
+    /*! Number of elements.
+     */
+    size_t num_elements(void) const
+    {
+        return element_offsets.size() - 1;
+    }
+
+    /*! Number of element colors used by \p assemble.
+     */
+    size_t num_colors(void) const
+    {
+        return color_offsets.size() - 1;
+    }
+
+    /*! Set all values of the matrix to zero, keeping the pattern.
+     */
+    void zero(void);
+
+    /*! Position of entry <tt>(row, col)</tt> in \p matrix.values, or -1
+     * when the entry is not part of the pattern.
+     */
+    IndexType find(const IndexType row, const IndexType col) const;
+
+    /*! Atomically accumulate a dense block into the matrix.
+     *
+     * \tparam ArrayType1 Type of row node array
+     * \tparam ArrayType2 Type of column node array
+     * \tparam ArrayType3 Type of block values array
+     *
+     * \param rows Row nodes of the block.
+     * \param cols Column nodes of the block.
+     * \param block Row-major dense block of size
+     * <tt>rows.size() * cols.size()</tt>.
+     *
+     * \return Number of block entries that were not part of the pattern
+     * and were therefore dropped.
+     */
+    template <typename ArrayType1, typename ArrayType2, typename ArrayType3>
+    size_t add_values(const ArrayType1& rows,
+                      const ArrayType2& cols,
+                      const ArrayType3& block);
+
+    /*! Accumulate the dense block of \p element through its cached value
+     * positions. Not atomic: concurrent calls must use elements of
+     * different colors, as \p assemble does.
+     *
+     * \param element Index of the element.
+     * \param block Row-major dense block of size <tt>n * n</tt> for an
+     * element with \c n nodes.
+     */
+    template <typename ArrayType>
+    void add_element_values(const size_t element, const ArrayType& block);
+
+    /*! Reassemble the matrix from scratch.
+     *
+     * \tparam ElementFunction Functor with signature
+     * <tt>void (size_t element, ValueType* block)</tt> that fills the
+     * zero-initialized row-major dense block of an element.
+     *
+     * \param f Element function.
+     */
+    template <typename ElementFunction>
+    void assemble(ElementFunction f);
+};
+/*! \}
+ */
+
+} // end namespace cusp
+
+#include <cusp/detail/assembly.inl>
@@ -0,0 +1,195 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file batched_csr_matrix.h
+ *  \brief Many sparse matrices sharing one CSR sparsity pattern
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+
+/*! \addtogroup sparse_matrices Sparse Matrices
+ */
+
+/*! \addtogroup sparse_matrix_containers Sparse Matrix Containers
+ *  \ingroup sparse_matrices
+ *  \{
+ */
+
+/**
+ * \brief Batch of sparse matrices with a common CSR sparsity pattern
+ *
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam ValueType Type used for matrix values (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ *  A \p batched_csr_matrix stores the row offsets and column indices of
+ *  a CSR pattern once together with the values of \p num_systems matrices
+ *  that share this pattern. The values are interleaved by system, entry
+ *  \c k of system \c s is stored at <tt>values[k * num_systems + s]</tt>,
+ *  so that consecutive systems are adjacent in memory and can be processed
+ *  together with SIMD instructions. Batched vectors use the same layout,
+ *  they are row-major \p array2d with one column per system.
+ *
+ * \par Example
+ *  \code
+ *  #include <cusp/batched_csr_matrix.h>
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main()
+ *  {
+ *    cusp::csr_matrix<int,float,cusp::host_memory> A;
+ *    cusp::gallery::poisson5pt(A, 10, 10);
+ *
+ *    // 1000 copies of the pattern and values of A
+ *    cusp::batched_csr_matrix<int,float,cusp::host_memory> batch(A, 1000);
+ *
+ *    // change the values of system 5
+ *    cusp::blas::scal(A.values, 2.0f);
+ *    batch.set_values(5, A.values);
+ *
+ *    return 0;
+ *  }
+ *  \endcode
+ *
+ *  \see \p batched_cg, \p batched_bicgstab
+ */
+template <typename IndexType, typename ValueType, class MemorySpace>
+class batched_csr_matrix
+{
+public:
+
+    /* \cond */
+    typedef IndexType   index_type;
+    typedef ValueType   value_type;
+    typedef MemorySpace memory_space;
+
+    typedef cusp::array1d<IndexType, MemorySpace> row_offsets_array_type;
+    typedef cusp::array1d<IndexType, MemorySpace> column_indices_array_type;
+    typedef cusp::array1d<ValueType, MemorySpace> values_array_type;
+    /* \endcond */
+
+    /*! Number of rows of every matrix. */
+    size_t num_rows;
+
+    /*! Number of columns of every matrix. */
+    size_t num_cols;
+
+    /*! Number of entries of the common pattern. */
+    size_t num_entries;
+
+    /*! Number of matrices. */
+    size_t num_systems;
+
+    /*! Storage for the row offsets of the pattern. */
+    row_offsets_array_type row_offsets;
+
+    /*! Storage for the column indices of the pattern. */
+    column_indices_array_type column_indices;
+
+    /*! Storage for the values of all systems, interleaved by system. */
+    values_array_type values;
+
+    /*! Construct an empty \p batched_csr_matrix.
+     */
+    batched_csr_matrix(void)
+        : num_rows(0), num_cols(0), num_entries(0), num_systems(0) {}
+
+    /*! Construct a \p batched_csr_matrix with a specific shape.
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of entries of the pattern.
+     *  \param num_systems Number of matrices.
+     */
+    batched_csr_matrix(const size_t num_rows, const size_t num_cols,
+                       const size_t num_entries, const size_t num_systems)
+        : num_rows(num_rows), num_cols(num_cols), num_entries(num_entries), num_systems(num_systems),
+          row_offsets(num_rows + 1), column_indices(num_entries), values(num_entries * num_systems) {}
+
+    /*! Construct a \p batched_csr_matrix with the pattern of a matrix and
+     *  initialize every system with its values.
+     *
+     *  \tparam MatrixType Type of the matrix.
+     *
+     *  \param A Matrix whose pattern and values are replicated.
+     *  \param num_systems Number of matrices.
+     */
+    template <typename MatrixType>
+    batched_csr_matrix(const MatrixType& A, const size_t num_systems);
+
+    /*! Construct a copy of a \p batched_csr_matrix in another memory space.
+     *
+     *  \param B Batch to copy.
+     */
+    template <typename IndexType2, typename ValueType2, class MemorySpace2>
+    batched_csr_matrix(const batched_csr_matrix<IndexType2, ValueType2, MemorySpace2>& B)
+        : num_rows(B.num_rows), num_cols(B.num_cols), num_entries(B.num_entries), num_systems(B.num_systems),
+          row_offsets(B.row_offsets), column_indices(B.column_indices), values(B.values) {}
+
+    /*! Resize the batch.
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of entries of the pattern.
+     *  \param num_systems Number of matrices.
+     */
+    void resize(const size_t num_rows, const size_t num_cols,
+                const size_t num_entries, const size_t num_systems);
+
+    /*! Overwrite the values of one system.
+     *
+     *  \tparam ArrayType Type of the values array.
+     *
+     *  \param system Index of the system.
+     *  \param values Values of the system in the order of the pattern.
+     */
+    template <typename ArrayType>
+    void set_values(const size_t system, const ArrayType& values);
+
+    /*! Extract one system as a \p csr_matrix.
+     *
+     *  \tparam MatrixType Type of the output matrix.
+     *
+     *  \param system Index of the system.
+     *  \param A Output matrix.
+     */
+    template <typename MatrixType>
+    void get_system(const size_t system, MatrixType& A) const;
+
+    /*! Swap the contents of two \p batched_csr_matrix objects.
+     *
+     *  \param B Another \p batched_csr_matrix with the same IndexType,
+     *  ValueType and MemorySpace.
+     */
+    void swap(batched_csr_matrix& B);
+};
+/*! \} // end Containers
+ */
+
+} // end namespace cusp
+
+#include <cusp/detail/batched_csr_matrix.inl>
@@ -0,0 +1,222 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/exception.h>
+#include <cusp/multiply.h>
+#include <cusp/transpose.h>
+
+#include <cusp/blas/blas.h>
+#include <cusp/graph/vertex_coloring.h>
+
+#include <algorithm>
+
+namespace cusp
+{
+
+template <typename IndexType, typename ValueType>
+template <typename ArrayType1, typename ArrayType2>
+csr_assembler<IndexType,ValueType>
+::csr_assembler(const size_t num_nodes,
+                const ArrayType1& element_offsets,
+                const ArrayType2& element_indices)
+    : element_offsets(element_offsets),
+      element_indices(element_indices)
+{
+    typedef cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> HostMatrix;
+
+    if (this->element_offsets.size() == 0)
+        throw cusp::invalid_input_exception("element offsets must contain at least one entry");
+
+    const IndexType num_elements = this->element_offsets.size() - 1;
+
+    // element-to-node incidence matrix E
+    HostMatrix E(num_elements, num_nodes, this->element_indices.size());
+    E.row_offsets    = this->element_offsets;
+    E.column_indices = this->element_indices;
+    cusp::blas::fill(E.values, ValueType(1));
+
+    HostMatrix Et;
+    cusp::transpose(E, Et);
+
+    // nodes i and j are coupled iff (E^T E)(i,j) != 0
+    cusp::multiply(Et, E, matrix);
+
+    // sort the column indices of every row for binary searches
+    #pragma omp parallel for
+    for (int i = 0; i < int(num_nodes); i++)
+        std::sort(matrix.column_indices.begin() + matrix.row_offsets[i],
+                  matrix.column_indices.begin() + matrix.row_offsets[i + 1]);
+
+    zero();
+
+    // elements e and f share a node iff (E E^T)(e,f) != 0
+    HostMatrix G;
+    cusp::multiply(E, Et, G);
+
+    cusp::array1d<IndexType, cusp::host_memory> colors(num_elements);
+    size_t num_colors = num_elements > 0 ? cusp::graph::vertex_coloring(G, colors) : 0;
+
+    // group the elements by color
+    color_offsets.resize(num_colors + 1);
+    cusp::blas::fill(color_offsets, IndexType(0));
+
+    for (IndexType e = 0; e < num_elements; e++)
+        color_offsets[colors[e] + 1]++;
+
+    for (size_t c = 0; c < num_colors; c++)
+        color_offsets[c + 1] += color_offsets[c];
+
+    cusp::array1d<IndexType, cusp::host_memory> next(color_offsets.begin(), color_offsets.end() - 1);
+    element_order.resize(num_elements);
+
+    for (IndexType e = 0; e < num_elements; e++)
+        element_order[next[colors[e]]++] = e;
+
+    // cache the value positions of every dense element block
+    position_offsets.resize(num_elements + 1);
+    position_offsets[0] = 0;
+
+    for (IndexType e = 0; e < num_elements; e++)
+    {
+        IndexType n = this->element_offsets[e + 1] - this->element_offsets[e];
+        position_offsets[e + 1] = position_offsets[e] + n * n;
+    }
+
+    positions.resize(position_offsets[num_elements]);
+
+    #pragma omp parallel for
+    for (int e = 0; e < int(num_elements); e++)
+    {
+        IndexType start = this->element_offsets[e];
+        IndexType n     = this->element_offsets[e + 1] - start;
+        IndexType p     = position_offsets[e];
+
+        for (IndexType a = 0; a < n; a++)
+            for (IndexType b = 0; b < n; b++)
+                positions[p++] = find(this->element_indices[start + a], this->element_indices[start + b]);
+    }
+}
+
+template <typename IndexType, typename ValueType>
+void csr_assembler<IndexType,ValueType>
+::zero(void)
+{
+    cusp::blas::fill(matrix.values, ValueType(0));
+}
+
+template <typename IndexType, typename ValueType>
+IndexType csr_assembler<IndexType,ValueType>
+::find(const IndexType row, const IndexType col) const
+{
+    typedef typename cusp::array1d<IndexType, cusp::host_memory>::const_iterator Iterator;
+
+    Iterator first = matrix.column_indices.begin() + matrix.row_offsets[row];
+    Iterator last  = matrix.column_indices.begin() + matrix.row_offsets[row + 1];
+    Iterator iter  = std::lower_bound(first, last, col);
+
+    if (iter == last || *iter != col)
+        return -1;
+
+    return iter - matrix.column_indices.begin();
+}
+
+template <typename IndexType, typename ValueType>
+template <typename ArrayType1, typename ArrayType2, typename ArrayType3>
+size_t csr_assembler<IndexType,ValueType>
+::add_values(const ArrayType1& rows,
+             const ArrayType2& cols,
+             const ArrayType3& block)
+{
+    const size_t num_rows = rows.size();
+    const size_t num_cols = cols.size();
+
+    // no entry of an empty matrix can receive a value
+    if (matrix.num_entries == 0)
+        return num_rows * num_cols;
+
+    ValueType* values = thrust::raw_pointer_cast(&matrix.values[0]);
+    size_t num_dropped = 0;
+
+    for (size_t a = 0; a < num_rows; a++)
+    {
+        for (size_t b = 0; b < num_cols; b++)
+        {
+            IndexType p = find(rows[a], cols[b]);
+
+            if (p < 0)
+            {
+                num_dropped++;
+                continue;
+            }
+
+            ValueType v = block[a * num_cols + b];
+
+            #pragma omp atomic
+            values[p] += v;
+        }
+    }
+
+    return num_dropped;
+}
+
+template <typename IndexType, typename ValueType>
+template <typename ArrayType>
+void csr_assembler<IndexType,ValueType>
+::add_element_values(const size_t element, const ArrayType& block)
+{
+    IndexType start = position_offsets[element];
+    IndexType end   = position_offsets[element + 1];
+
+    for (IndexType k = start; k < end; k++)
+        matrix.values[positions[k]] += block[k - start];
+}
+
+template <typename IndexType, typename ValueType>
+template <typename ElementFunction>
+void csr_assembler<IndexType,ValueType>
+::assemble(ElementFunction f)
+{
+    zero();
+
+    IndexType max_block_size = 1;
+
+    for (size_t e = 0; e < num_elements(); e++)
+        max_block_size = std::max(max_block_size, position_offsets[e + 1] - position_offsets[e]);
+
+    const int C = num_colors();
+
+    #pragma omp parallel
+    {
+        cusp::array1d<ValueType, cusp::host_memory> storage(max_block_size);
+        ValueType* block = thrust::raw_pointer_cast(&storage[0]);
+
+        for (int c = 0; c < C; c++)
+        {
+            // elements of the same color write to disjoint rows
+            #pragma omp for
+            for (int k = color_offsets[c]; k < int(color_offsets[c + 1]); k++)
+            {
+                IndexType e = element_order[k];
+
+                std::fill(block, block + (position_offsets[e + 1] - position_offsets[e]), ValueType(0));
+                f(size_t(e), block);
+                add_element_values(e, block);
+            }
+        }
+    }
+}
+
+} // end namespace cusp
@@ -0,0 +1,119 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/convert.h>
+#include <cusp/exception.h>
+
+#include <cusp/iterator/strided_iterator.h>
+
+#include <thrust/copy.h>
+#include <thrust/swap.h>
+
+namespace cusp
+{
+
+template <typename IndexType, typename ValueType, class MemorySpace>
+template <typename MatrixType>
+batched_csr_matrix<IndexType,ValueType,MemorySpace>
+::batched_csr_matrix(const MatrixType& A, const size_t num_systems)
+{
+    cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> B(A);
+
+    resize(B.num_rows, B.num_cols, B.num_entries, num_systems);
+
+    row_offsets    = B.row_offsets;
+    column_indices = B.column_indices;
+
+    cusp::array1d<ValueType, cusp::host_memory> host_values(num_entries * num_systems);
+
+    for (size_t k = 0; k < num_entries; k++)
+        for (size_t s = 0; s < num_systems; s++)
+            host_values[k * num_systems + s] = B.values[k];
+
+    values = host_values;
+}
+
+template <typename IndexType, typename ValueType, class MemorySpace>
+void
+batched_csr_matrix<IndexType,ValueType,MemorySpace>
+::resize(const size_t num_rows, const size_t num_cols,
+         const size_t num_entries, const size_t num_systems)
+{
+    this->num_rows    = num_rows;
+    this->num_cols    = num_cols;
+    this->num_entries = num_entries;
+    this->num_systems = num_systems;
+
+    row_offsets.resize(num_rows + 1);
+    column_indices.resize(num_entries);
+    values.resize(num_entries * num_systems);
+}
+
+template <typename IndexType, typename ValueType, class MemorySpace>
+template <typename ArrayType>
+void
+batched_csr_matrix<IndexType,ValueType,MemorySpace>
+::set_values(const size_t system, const ArrayType& values)
+{
+    typedef typename values_array_type::iterator Iterator;
+
+    if (system >= num_systems || values.size() != num_entries)
+        throw cusp::invalid_input_exception("set_values requires a valid system and num_entries values");
+
+    cusp::strided_iterator<Iterator> iter(this->values.begin() + system, this->values.end(), num_systems);
+
+    thrust::copy(values.begin(), values.end(), iter.begin());
+}
+
+template <typename IndexType, typename ValueType, class MemorySpace>
+template <typename MatrixType>
+void
+batched_csr_matrix<IndexType,ValueType,MemorySpace>
+::get_system(const size_t system, MatrixType& A) const
+{
+    typedef typename values_array_type::const_iterator Iterator;
+
+    if (system >= num_systems)
+        throw cusp::invalid_input_exception("get_system requires a valid system");
+
+    cusp::csr_matrix<IndexType, ValueType, MemorySpace> B(num_rows, num_cols, num_entries);
+
+    B.row_offsets    = row_offsets;
+    B.column_indices = column_indices;
+
+    cusp::strided_iterator<Iterator> iter(values.begin() + system, values.end(), num_systems);
+
+    thrust::copy(iter.begin(), iter.end(), B.values.begin());
+
+    cusp::convert(B, A);
+}
+
+template <typename IndexType, typename ValueType, class MemorySpace>
+void
+batched_csr_matrix<IndexType,ValueType,MemorySpace>
+::swap(batched_csr_matrix& B)
+{
+    thrust::swap(num_rows,    B.num_rows);
+    thrust::swap(num_cols,    B.num_cols);
+    thrust::swap(num_entries, B.num_entries);
+    thrust::swap(num_systems, B.num_systems);
+
+    row_offsets.swap(B.row_offsets);
+    column_indices.swap(B.column_indices);
+    values.swap(B.values);
+}
+
+} // end namespace cusp
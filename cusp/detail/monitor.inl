@@ -26,14 +26,16 @@ namespace cusp
 template <typename ValueType>
 template <typename VectorType>
 monitor<ValueType>
-::monitor(const VectorType& b, size_t iteration_limit, Real relative_tolerance, Real absolute_tolerance, bool verbose)
+::monitor(const VectorType& b, size_t iteration_limit, Real relative_tolerance, Real absolute_tolerance, bool verbose, size_t print_interval)
     : b_norm(cusp::blas::nrm2(b)),
       r_norm(std::numeric_limits<Real>::max()),
       iteration_limit_(iteration_limit),
       iteration_count_(0),
       relative_tolerance_(relative_tolerance),
       absolute_tolerance_(absolute_tolerance),
-      verbose(verbose)
+      verbose(verbose),
+      print_interval_(print_interval),
+      replacement_interval_(0)
 {
     if(verbose)
     {
@@ -43,7 +45,8 @@ monitor<ValueType>
         std::cout << "  Iteration Number  | Residual Norm" << std::endl;
     }
 
-    residuals.reserve(iteration_limit);
+    // one entry per iteration and one for the initial residual
+    residuals.reserve(iteration_limit + 1);
 }
 
 template <typename ValueType>
@@ -126,6 +129,38 @@ monitor<ValueType>
     return verbose;
 }
 
+template <typename ValueType>
+void
+monitor<ValueType>
+::set_print_interval(const size_t interval)
+{
+    print_interval_ = interval;
+}
+
+template <typename ValueType>
+void
+monitor<ValueType>
+::set_replacement_interval(const size_t interval)
+{
+    replacement_interval_ = interval;
+}
+
+template <typename ValueType>
+size_t
+monitor<ValueType>
+::replacement_interval(void) const
+{
+    return replacement_interval_;
+}
+
+template <typename ValueType>
+bool
+monitor<ValueType>
+::replace_residual(void) const
+{
+    return replacement_interval_ > 0 && (iteration_count_ + 1) % replacement_interval_ == 0;
+}
+
 template <typename ValueType>
 template <typename Vector>
 void
@@ -181,10 +216,19 @@ bool monitor<ValueType>
 ::finished(thrust::execution_policy<DerivedPolicy> &exec,
            const Vector& r)
 {
-    r_norm = cusp::blas::nrm2(exec, r);
+    return finished_norm(cusp::blas::nrm2(exec, r));
+}
+
+template <typename ValueType>
+bool monitor<ValueType>
+::finished_norm(const Real r_norm_)
+{
+    r_norm = r_norm_;
     residuals.push_back(r_norm);
 
-    if(verbose)
+    const bool done = converged() || iteration_count() >= iteration_limit();
+
+    if(verbose && ((print_interval_ > 0 && iteration_count() % print_interval_ == 0) || done))
     {
         std::cout << "       "  << std::setw(10) << iteration_count();
         std::cout << "       "  << std::setw(10) << std::scientific << residual_norm() << std::endl;
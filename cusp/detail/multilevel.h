@@ -120,13 +120,15 @@ public:
 
         Smoother smoother;
 
-        level(void) {}
+        int num_threads;                                      // host threads, 0 leaves them unchanged
+
+        level(void) : num_threads(0) {}
 
         template<typename LevelType>
         level(const LevelType& level)
           : R(level.R), A(level.A), P(level.P),
             x(level.x), b(level.b), residual(level.residual),
-            smoother(level.smoother) {}
+            smoother(level.smoother), num_threads(level.num_threads) {}
     };
     /* \endcond */
 
@@ -135,11 +137,15 @@ public:
     size_t min_level_size;
     size_t max_levels;
 
+    // levels use one host thread per this many nonzeros, up to all threads
+    size_t min_entries_per_thread;
+
     Solver solver;
 
     std::vector<level> levels;
 
-    multilevel(size_t min_level_size=500, size_t max_levels=10) : A_ptr(NULL), min_level_size(min_level_size), max_levels(max_levels) {};
+    multilevel(size_t min_level_size=500, size_t max_levels=10)
+      : A_ptr(NULL), min_level_size(min_level_size), max_levels(max_levels), min_entries_per_thread(10000), cycle_threads(0) {};
 
     template <typename MemorySpace2, typename Format2, typename SmootherType2, typename SolverType2>
     multilevel(const multilevel<IndexType,ValueType,MemorySpace2,Format2,SmootherType2,SolverType2>& M);
@@ -159,6 +165,22 @@ public:
 
     void set_max_levels(size_t max_depth);
 
+    /*! Size the thread team of every level of a host hierarchy by its
+     *  number of nonzeros. Levels with fewer than \p min_entries
+     *  nonzeros per thread run with fewer threads, down to a single
+     *  thread, which avoids the fork/join overhead dominating the
+     *  small coarse levels, and the coarse solve runs on one thread.
+     *  0 uses all threads on every level, including the coarse solve.
+     */
+    void set_min_entries_per_thread(size_t min_entries);
+
+    /*! Choose the thread team of every level of a host hierarchy by
+     *  timing \p num_trials products with the level matrix for team
+     *  sizes 1, 2, 4, ... up to all threads, and keeping the smallest
+     *  team within 5% of the fastest.
+     */
+    void calibrate_level_threads(size_t num_trials = 10);
+
     double operator_complexity( void );
 
     double grid_complexity( void );
@@ -172,6 +194,9 @@ protected:
     cusp::array1d<ValueType, cusp::host_memory> temp_b;
     cusp::array1d<ValueType, cusp::host_memory> temp_x;
 
+    // team size of the caller, restored by levels without their own team
+    int cycle_threads;
+
     template <typename Array1, typename Array2>
     void _solve(const Array1& b, Array2& x, const size_t i);
 
@@ -190,6 +215,8 @@ protected:
     void copy_or_swap_matrix(SolveMatrixType& dst, SolveMatrixType2& src);
 
     void initialize_coarse_solver(void);
+
+    void select_level_threads(void);
 };
 /*! \}
  */
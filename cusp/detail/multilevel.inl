@@ -18,14 +18,68 @@
 #include <cusp/monitor.h>
 #include <cusp/blas/blas.h>
 
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace cusp
 {
+namespace detail
+{
+
+// team size of the parallel regions started by the calling thread, the
+// calls do nothing without OpenMP
+inline int get_host_threads(void)
+{
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+inline void set_host_threads(const int num_threads)
+{
+#ifdef _OPENMP
+    if (num_threads > 0)
+        omp_set_num_threads(num_threads);
+#endif
+}
+
+inline double host_wall_time(void)
+{
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    return 0.0;
+#endif
+}
+
+inline std::string level_threads(const int num_threads)
+{
+    std::ostringstream name;
+
+    if (num_threads > 0)
+        name << num_threads;
+    else
+        name << "-";
+
+    return name.str();
+}
+
+} // end namespace detail
 
 template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
 template <typename MemorySpace2, typename Format2, typename SmootherType2, typename SolverType2>
 multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
 ::multilevel(const multilevel<IndexType,ValueType,MemorySpace2,Format2,SmootherType2,SolverType2>& M)
-    : min_level_size(M.min_level_size), max_levels(M.max_levels), solver(M.solver)
+    : min_level_size(M.min_level_size), max_levels(M.max_levels),
+      min_entries_per_thread(M.min_entries_per_thread), solver(M.solver), cycle_threads(0)
 {
     for( size_t lvl = 0; lvl < M.levels.size(); lvl++ )
         levels.push_back(M.levels[lvl]);
@@ -37,6 +91,8 @@ multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
     update.resize(A_ptr->num_rows);
     temp_b.resize(levels.back().A.num_rows);
     temp_x.resize(levels.back().A.num_rows);
+
+    select_level_threads();
 }
 
 template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
@@ -129,6 +185,103 @@ void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
     temp_x.resize(levels.back().A.num_rows);
 
     solver = Solver(levels.back().A);
+
+    select_level_threads();
+}
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
+void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
+::set_min_entries_per_thread(size_t min_entries)
+{
+    min_entries_per_thread = min_entries;
+
+    select_level_threads();
+}
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
+void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
+::select_level_threads(void)
+{
+    const bool host = thrust::detail::is_same<MemorySpace, cusp::host_memory>::value;
+    const size_t max_threads = detail::get_host_threads();
+
+    for(size_t lvl = 0; lvl < levels.size(); lvl++)
+    {
+        // device levels run with the team of the caller
+        if (!host)
+        {
+            levels[lvl].num_threads = 0;
+            continue;
+        }
+
+        // the coarse solver is sequential, unless all levels use all threads
+        if (lvl + 1 == levels.size() && min_entries_per_thread > 0)
+        {
+            levels[lvl].num_threads = 1;
+            continue;
+        }
+
+        size_t num_threads = max_threads;
+
+        if (min_entries_per_thread > 0)
+        {
+            const size_t num_entries = lvl == 0 ? A_ptr->num_entries : levels[lvl].A.num_entries;
+
+            num_threads = std::min(max_threads, std::max(size_t(1), num_entries / min_entries_per_thread));
+        }
+
+        levels[lvl].num_threads = num_threads;
+    }
+}
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
+void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
+::calibrate_level_threads(size_t num_trials)
+{
+    if (!thrust::detail::is_same<MemorySpace, cusp::host_memory>::value || levels.size() < 2)
+        return;
+
+    const int max_threads = detail::get_host_threads();
+
+    for(size_t lvl = 0; lvl + 1 < levels.size(); lvl++)
+    {
+        const SolveMatrixType& A_lvl = lvl == 0 ? *A_ptr : levels[lvl].A;
+
+        cusp::array1d<ValueType, MemorySpace> x(A_lvl.num_cols, ValueType(1));
+
+        int best_threads = max_threads;
+        std::vector<double> times;
+        std::vector<int> teams;
+
+        for(int num_threads = 1; ; num_threads = std::min(2 * num_threads, max_threads))
+        {
+            detail::set_host_threads(num_threads);
+
+            // warm up the thread team and the caches
+            cusp::multiply(A_lvl, x, levels[lvl].residual);
+
+            const double start = detail::host_wall_time();
+
+            for(size_t trial = 0; trial < num_trials; trial++)
+                cusp::multiply(A_lvl, x, levels[lvl].residual);
+
+            times.push_back(detail::host_wall_time() - start);
+            teams.push_back(num_threads);
+
+            if (num_threads == max_threads)
+                break;
+        }
+
+        const double fastest = *std::min_element(times.begin(), times.end());
+
+        for(size_t t = teams.size(); t > 0; t--)
+            if (times[t - 1] <= 1.05 * fastest)
+                best_threads = teams[t - 1];
+
+        levels[lvl].num_threads = best_threads;
+    }
+
+    detail::set_host_threads(max_threads);
 }
 
 template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
@@ -136,8 +289,12 @@ template <typename Array1, typename Array2>
 void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
 ::operator()(const Array1& b, Array2& x)
 {
+    cycle_threads = detail::get_host_threads();
+
     // perform 1 V-cycle
     _solve(b, x, 0);
+
+    detail::set_host_threads(cycle_threads);
 }
 
 template <typename IndexType, typename ValueType, typename MemorySpace, typename Format, typename SmootherType, typename SolverType>
@@ -160,10 +317,14 @@ void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
     cusp::multiply(*A_ptr, x, residual);
     cusp::blas::axpby(b, residual, residual, ValueType(1.0), ValueType(-1.0));
 
+    cycle_threads = detail::get_host_threads();
+
     while(!monitor.finished(residual))
     {
         _solve(residual, update, 0);
 
+        detail::set_host_threads(cycle_threads);
+
         // x += M * r
         cusp::blas::axpy(update, x, ValueType(1.0));
 
@@ -179,6 +340,11 @@ template <typename Array1, typename Array2>
 void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
 ::_solve(const Array1& b, Array2& x, const size_t i)
 {
+    // run the level with its own thread team, or the team of the caller
+    const int num_threads = levels[i].num_threads > 0 ? levels[i].num_threads : cycle_threads;
+
+    detail::set_host_threads(num_threads);
+
     if (i + 1 == levels.size())
     {
         // coarse grid solve
@@ -212,6 +378,8 @@ void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
         // compute coarse grid solution
         _solve(levels[i + 1].b, levels[i + 1].x, i + 1);
 
+        detail::set_host_threads(num_threads);
+
         // apply coarse grid correction
         cusp::multiply(levels[i].P, levels[i + 1].x, levels[i].residual);
         cusp::blas::axpy(levels[i].residual, x, ValueType(1.0));
@@ -234,7 +402,7 @@ void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
     std::cout << "\tNumber of Levels    :\t" << num_levels << std::endl;
     std::cout << "\tOperator Complexity :\t" << operator_complexity() << std::endl;
     std::cout << "\tGrid Complexity     :\t" << grid_complexity() << std::endl;
-    std::cout << "\tlevel\tunknowns\tnonzeros" << std::endl;
+    std::cout << "\tlevel\tunknowns\tnonzeros\t\tthreads" << std::endl;
 
     for(size_t index = 1; index < num_levels; index++)
         nnz += levels[index].A.num_entries;
@@ -243,14 +411,14 @@ void multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>
 
     std::cout << "\t" << 0 << "\t" << std::setw(8) << std::right << this->num_cols << "\t" \
               << std::setw(8) << std::right << this->num_entries << "  [" << 100*percent << "%]" \
-              << std::endl;
+              << "\t" << detail::level_threads(levels[0].num_threads) << std::endl;
 
     for(size_t index = 1; index < num_levels; index++)
     {
         percent = levels[index].A.num_entries / nnz;
         std::cout << "\t" << index << "\t" << std::setw(8) << std::right << levels[index].A.num_cols << "\t" \
                   << std::setw(8) << std::right << levels[index].A.num_entries << "  [" << 100*percent << "%]" \
-                  << std::endl;
+                  << "\t" << detail::level_threads(levels[index].num_threads) << std::endl;
     }
 }
 
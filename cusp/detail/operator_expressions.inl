@@ -0,0 +1,340 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file operator_expressions.inl
+ *  \brief Inline file for operator_expressions.h
+ */
+
+#include <cusp/exception.h>
+#include <cusp/multiply.h>
+#include <cusp/transpose.h>
+
+#include <cusp/blas/blas.h>
+
+#include <thrust/transform.h>
+#include <thrust/tuple.h>
+#include <thrust/iterator/zip_iterator.h>
+
+namespace cusp
+{
+namespace detail
+{
+
+template <typename ValueType>
+struct affine_diagonal_functor
+{
+    ValueType alpha;
+    ValueType sigma;
+
+    affine_diagonal_functor(const ValueType alpha, const ValueType sigma)
+        : alpha(alpha), sigma(sigma) {}
+
+    // (d, Ax, x) -> alpha * d * Ax + sigma * x
+    template <typename Tuple>
+    __host__ __device__
+    ValueType operator()(const Tuple& t) const
+    {
+        return alpha * thrust::get<0>(t) * thrust::get<1>(t) + sigma * thrust::get<2>(t);
+    }
+};
+
+} // end namespace detail
+
+////////////////////
+// affine_operator //
+////////////////////
+template <typename LinearOperator, typename ArrayType>
+template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+void affine_operator<LinearOperator,ArrayType>
+::operator()(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y)
+{
+    apply(exec, x, y, typename LinearOperator::format(), MemorySpace());
+}
+
+template <typename LinearOperator, typename ArrayType>
+template <typename VectorType1, typename VectorType2>
+void affine_operator<LinearOperator,ArrayType>
+::operator()(const VectorType1& x, VectorType2& y)
+{
+    cusp::multiply(*this, x, y);
+}
+
+template <typename LinearOperator, typename ArrayType>
+template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+void affine_operator<LinearOperator,ArrayType>
+::apply(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y,
+        cusp::csr_format, cusp::host_memory)
+{
+    typedef typename LinearOperator::index_type IndexType;
+
+    // evaluate the whole expression within a single pass over the rows
+    #pragma omp parallel for
+    for (int i = 0; i < int(A.num_rows); i++)
+    {
+        ValueType sum = 0;
+
+        for (IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            sum += A.values[jj] * x[A.column_indices[jj]];
+
+        if (diagonal != NULL)
+            sum *= (*diagonal)[i];
+
+        sum *= alpha;
+
+        if (sigma != ValueType(0))
+            sum += sigma * x[i];
+
+        y[i] = sum;
+    }
+}
+
+template <typename LinearOperator, typename ArrayType>
+template <typename DerivedPolicy, typename VectorType1, typename VectorType2, typename Format, typename System>
+void affine_operator<LinearOperator,ArrayType>
+::apply(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y,
+        Format, System)
+{
+    cusp::multiply(exec, A, x, y);
+
+    // apply the diagonal, scaling and shift in one additional pass
+    if (diagonal != NULL && sigma == ValueType(0))
+    {
+        cusp::blas::xmy(exec, *diagonal, y, y);
+
+        if (alpha != ValueType(1))
+            cusp::blas::scal(exec, y, alpha);
+    }
+    else if (diagonal != NULL)
+    {
+        thrust::transform(exec,
+                          thrust::make_zip_iterator(thrust::make_tuple(diagonal->begin(), y.begin(), x.begin())),
+                          thrust::make_zip_iterator(thrust::make_tuple(diagonal->end(),   y.end(),   x.begin() + y.size())),
+                          y.begin(),
+                          detail::affine_diagonal_functor<ValueType>(alpha, sigma));
+    }
+    else if (sigma != ValueType(0))
+    {
+        cusp::blas::axpby(exec, y, x, y, alpha, sigma);
+    }
+    else if (alpha != ValueType(1))
+    {
+        cusp::blas::scal(exec, y, alpha);
+    }
+}
+
+//////////////////
+// sum_operator //
+//////////////////
+template <typename LinearOperator1, typename LinearOperator2>
+sum_operator<LinearOperator1,LinearOperator2>
+::sum_operator(const LinearOperator1& A, const LinearOperator2& B)
+    : Parent(A.num_rows, A.num_cols, A.num_entries + B.num_entries), A(A), B(B)
+{
+    if (A.num_rows != B.num_rows || A.num_cols != B.num_cols)
+        throw cusp::invalid_input_exception("operator dimensions do not match");
+}
+
+template <typename LinearOperator1, typename LinearOperator2>
+template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+void sum_operator<LinearOperator1,LinearOperator2>
+::operator()(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y)
+{
+    temp.resize(y.size());
+
+    cusp::multiply(exec, A, x, y);
+    cusp::multiply(exec, B, x, temp);
+    cusp::blas::axpy(exec, temp, y, ValueType(1));
+}
+
+template <typename LinearOperator1, typename LinearOperator2>
+template <typename VectorType1, typename VectorType2>
+void sum_operator<LinearOperator1,LinearOperator2>
+::operator()(const VectorType1& x, VectorType2& y)
+{
+    cusp::multiply(*this, x, y);
+}
+
+//////////////////////
+// product_operator //
+//////////////////////
+template <typename LinearOperator1, typename LinearOperator2>
+product_operator<LinearOperator1,LinearOperator2>
+::product_operator(const LinearOperator1& A, const LinearOperator2& B)
+    : Parent(A.num_rows, B.num_cols, A.num_entries + B.num_entries), A(A), B(B)
+{
+    if (A.num_cols != B.num_rows)
+        throw cusp::invalid_input_exception("operator dimensions do not match");
+}
+
+template <typename LinearOperator1, typename LinearOperator2>
+template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+void product_operator<LinearOperator1,LinearOperator2>
+::operator()(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y)
+{
+    temp.resize(B.num_rows);
+
+    cusp::multiply(exec, B, x, temp);
+    cusp::multiply(exec, A, temp, y);
+}
+
+template <typename LinearOperator1, typename LinearOperator2>
+template <typename VectorType1, typename VectorType2>
+void product_operator<LinearOperator1,LinearOperator2>
+::operator()(const VectorType1& x, VectorType2& y)
+{
+    cusp::multiply(*this, x, y);
+}
+
+////////////////////////
+// transpose_operator //
+////////////////////////
+template <typename MatrixType>
+template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+void transpose_operator<MatrixType>
+::operator()(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y)
+{
+    apply(exec, x, y, typename MatrixType::format(), MemorySpace());
+}
+
+template <typename MatrixType>
+template <typename VectorType1, typename VectorType2>
+void transpose_operator<MatrixType>
+::operator()(const VectorType1& x, VectorType2& y)
+{
+    cusp::multiply(*this, x, y);
+}
+
+template <typename MatrixType>
+void transpose_operator<MatrixType>
+::refresh(void)
+{
+    At.resize(0, 0, 0);
+}
+
+template <typename MatrixType>
+template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+void transpose_operator<MatrixType>
+::apply(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y,
+        cusp::csr_format, cusp::host_memory)
+{
+    cusp::blas::fill(y, ValueType(0));
+
+    // scatter the rows of A
+    for (IndexType i = 0; i < IndexType(A.num_rows); i++)
+        for (IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            y[A.column_indices[jj]] += A.values[jj] * x[i];
+}
+
+template <typename MatrixType>
+template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+void transpose_operator<MatrixType>
+::apply(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y,
+        cusp::coo_format, cusp::host_memory)
+{
+    cusp::blas::fill(y, ValueType(0));
+
+    for (size_t n = 0; n < A.num_entries; n++)
+        y[A.column_indices[n]] += A.values[n] * x[A.row_indices[n]];
+}
+
+template <typename MatrixType>
+template <typename DerivedPolicy, typename VectorType1, typename VectorType2, typename Format, typename System>
+void transpose_operator<MatrixType>
+::apply(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y,
+        Format, System)
+{
+    // form the transpose once and reuse it until refresh()
+    if (At.num_rows != A.num_cols || At.num_cols != A.num_rows || At.num_entries != A.num_entries)
+        cusp::transpose(exec, A, At);
+
+    cusp::multiply(exec, At, x, y);
+}
+
+///////////////
+// Factories //
+///////////////
+template <typename LinearOperator>
+affine_operator<LinearOperator>
+shift(const LinearOperator& A, const typename LinearOperator::value_type sigma)
+{
+    typedef typename LinearOperator::value_type ValueType;
+
+    if (A.num_rows != A.num_cols)
+        throw cusp::invalid_input_exception("shifted operator must be square");
+
+    return affine_operator<LinearOperator>(A, NULL, ValueType(1), sigma);
+}
+
+template <typename LinearOperator, typename ArrayType>
+affine_operator<LinearOperator,ArrayType>
+shift(const affine_operator<LinearOperator,ArrayType>& A, const typename LinearOperator::value_type sigma)
+{
+    if (A.num_rows != A.num_cols)
+        throw cusp::invalid_input_exception("shifted operator must be square");
+
+    return affine_operator<LinearOperator,ArrayType>(A.A, A.diagonal, A.alpha, A.sigma + sigma);
+}
+
+template <typename LinearOperator>
+affine_operator<LinearOperator>
+scale(const LinearOperator& A, const typename LinearOperator::value_type alpha)
+{
+    typedef typename LinearOperator::value_type ValueType;
+
+    return affine_operator<LinearOperator>(A, NULL, alpha, ValueType(0));
+}
+
+template <typename LinearOperator, typename ArrayType>
+affine_operator<LinearOperator,ArrayType>
+scale(const affine_operator<LinearOperator,ArrayType>& A, const typename LinearOperator::value_type alpha)
+{
+    return affine_operator<LinearOperator,ArrayType>(A.A, A.diagonal, alpha * A.alpha, alpha * A.sigma);
+}
+
+template <typename ArrayType, typename LinearOperator>
+affine_operator<LinearOperator,ArrayType>
+diag_scale(const ArrayType& D, const LinearOperator& A)
+{
+    typedef typename LinearOperator::value_type ValueType;
+
+    if (D.size() != size_t(A.num_rows))
+        throw cusp::invalid_input_exception("diagonal size does not match operator dimensions");
+
+    return affine_operator<LinearOperator,ArrayType>(A, &D, ValueType(1), ValueType(0));
+}
+
+template <typename LinearOperator1, typename LinearOperator2>
+sum_operator<LinearOperator1,LinearOperator2>
+sum(const LinearOperator1& A, const LinearOperator2& B)
+{
+    return sum_operator<LinearOperator1,LinearOperator2>(A, B);
+}
+
+template <typename LinearOperator1, typename LinearOperator2>
+product_operator<LinearOperator1,LinearOperator2>
+product(const LinearOperator1& A, const LinearOperator2& B)
+{
+    return product_operator<LinearOperator1,LinearOperator2>(A, B);
+}
+
+template <typename MatrixType>
+transpose_operator<MatrixType>
+transpose_view(const MatrixType& A)
+{
+    return transpose_operator<MatrixType>(A);
+}
+
+} // end namespace cusp
@@ -0,0 +1,187 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <cusp/array1d.h>
+#include <cusp/complex.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
+
+#include <thrust/for_each.h>
+#include <thrust/memory.h>
+#include <thrust/iterator/counting_iterator.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace cusp
+{
+namespace reduced_precision_detail
+{
+
+// conversion of the scaled values to the storage type
+template <typename StorageType>
+struct storage_traits
+{
+    static const bool scaled = false;
+
+    static double max_value(void) { return 1.0; }
+
+    template <typename ValueType>
+    static StorageType encode(const ValueType value)
+    {
+        return StorageType(value);
+    }
+};
+
+template <>
+struct storage_traits<cusp::bfloat16>
+{
+    static const bool scaled = true;
+
+    static double max_value(void) { return 1.0; }
+
+    template <typename ValueType>
+    static cusp::bfloat16 encode(const ValueType value)
+    {
+        return cusp::bfloat16(float(value));
+    }
+};
+
+template <>
+struct storage_traits<short>
+{
+    static const bool scaled = true;
+
+    static double max_value(void) { return 32767.0; }
+
+    template <typename ValueType>
+    static short encode(const ValueType value)
+    {
+        return short(std::floor(value + ValueType(0.5)));
+    }
+};
+
+// y(i) = s(i) * sum_j A(i,j) x(j) with the values converted on load
+template <typename IndexType, typename StorageType, typename ValueType>
+struct spmv_row_functor
+{
+    const IndexType*   Ap;
+    const IndexType*   Aj;
+    const StorageType* Av;
+    const ValueType*   scales;
+    const ValueType*   x;
+    ValueType*         y;
+
+    spmv_row_functor(const IndexType* Ap, const IndexType* Aj, const StorageType* Av,
+                     const ValueType* scales, const ValueType* x, ValueType* y)
+        : Ap(Ap), Aj(Aj), Av(Av), scales(scales), x(x), y(y) {}
+
+    __host__ __device__
+    void operator()(const int i) const
+    {
+        ValueType sum = 0;
+
+        for (IndexType jj = Ap[i]; jj < Ap[i + 1]; jj++)
+            sum += ValueType(Av[jj]) * x[Aj[jj]];
+
+        y[i] = scales[i] * sum;
+    }
+};
+
+template <typename ArrayType>
+typename ArrayType::value_type * raw(ArrayType& x)
+{
+    return x.size() == 0 ? NULL : thrust::raw_pointer_cast(&x[0]);
+}
+
+template <typename ArrayType>
+const typename ArrayType::value_type * raw(const ArrayType& x)
+{
+    return x.size() == 0 ? NULL : thrust::raw_pointer_cast(&x[0]);
+}
+
+} // end namespace reduced_precision_detail
+
+//////////////////////////////////
+// reduced_precision_csr_matrix //
+//////////////////////////////////
+template <typename IndexType, typename StorageType, typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+reduced_precision_csr_matrix<IndexType,StorageType,ValueType,MemorySpace>
+::reduced_precision_csr_matrix(const MatrixType& A)
+    : Parent(A.num_rows, A.num_cols, A.num_entries)
+{
+    typedef reduced_precision_detail::storage_traits<StorageType> Traits;
+
+    cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> B(A);
+
+    cusp::array1d<StorageType, cusp::host_memory> B_values(B.num_entries);
+    cusp::array1d<ValueType, cusp::host_memory> B_scales(B.num_rows, ValueType(1));
+
+    #pragma omp parallel for
+    for (int i = 0; i < int(B.num_rows); i++)
+    {
+        ValueType scale = 1;
+
+        if (Traits::scaled)
+        {
+            ValueType max_abs = 0;
+
+            for (IndexType jj = B.row_offsets[i]; jj < B.row_offsets[i + 1]; jj++)
+                max_abs = std::max(max_abs, ValueType(cusp::abs(B.values[jj])));
+
+            if (max_abs > ValueType(0))
+                scale = max_abs / ValueType(Traits::max_value());
+        }
+
+        for (IndexType jj = B.row_offsets[i]; jj < B.row_offsets[i + 1]; jj++)
+            B_values[jj] = Traits::encode(B.values[jj] / scale);
+
+        B_scales[i] = scale;
+    }
+
+    row_offsets    = B.row_offsets;
+    column_indices = B.column_indices;
+    values         = B_values;
+    row_scales     = B_scales;
+}
+
+template <typename IndexType, typename StorageType, typename ValueType, typename MemorySpace>
+template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+void reduced_precision_csr_matrix<IndexType,StorageType,ValueType,MemorySpace>
+::operator()(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y) const
+{
+    using reduced_precision_detail::raw;
+
+    reduced_precision_detail::spmv_row_functor<IndexType, StorageType, ValueType>
+        f(raw(row_offsets), raw(column_indices), raw(values), raw(row_scales), raw(x), raw(y));
+
+    thrust::for_each(exec,
+                     thrust::counting_iterator<int>(0),
+                     thrust::counting_iterator<int>(this->num_rows),
+                     f);
+}
+
+template <typename IndexType, typename StorageType, typename ValueType, typename MemorySpace>
+template <typename VectorType1, typename VectorType2>
+void reduced_precision_csr_matrix<IndexType,StorageType,ValueType,MemorySpace>
+::operator()(const VectorType1& x, VectorType2& y) const
+{
+    cusp::multiply(*this, x, y);
+}
+
+} // end namespace cusp
@@ -0,0 +1,549 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/convert.h>
+#include <cusp/copy.h>
+#include <cusp/multiply.h>
+#include <cusp/verify.h>
+
+#include <cusp/blas/blas.h>
+
+#include <thrust/memory.h>
+#include <thrust/transform.h>
+
+#include <cmath>
+
+namespace cusp
+{
+namespace split_complex_detail
+{
+
+template <typename RealType>
+struct real_part_functor
+{
+    typedef cusp::complex<RealType> argument_type;
+    typedef RealType                result_type;
+
+    __host__ __device__
+    RealType operator()(const cusp::complex<RealType>& z) const
+    {
+        return z.real();
+    }
+};
+
+template <typename RealType>
+struct imag_part_functor
+{
+    typedef cusp::complex<RealType> argument_type;
+    typedef RealType                result_type;
+
+    __host__ __device__
+    RealType operator()(const cusp::complex<RealType>& z) const
+    {
+        return z.imag();
+    }
+};
+
+template <typename RealType>
+struct make_complex_functor
+{
+    typedef RealType                first_argument_type;
+    typedef RealType                second_argument_type;
+    typedef cusp::complex<RealType> result_type;
+
+    __host__ __device__
+    cusp::complex<RealType> operator()(const RealType re, const RealType im) const
+    {
+        return cusp::complex<RealType>(re, im);
+    }
+};
+
+// raw pointer to the entries of a host array
+template <typename ArrayType>
+typename ArrayType::value_type * raw(ArrayType& x)
+{
+    return x.empty() ? NULL : thrust::raw_pointer_cast(&x[0]);
+}
+
+template <typename ArrayType>
+const typename ArrayType::value_type * raw(const ArrayType& x)
+{
+    return x.empty() ? NULL : thrust::raw_pointer_cast(&x[0]);
+}
+
+//////////////////////////////////////////
+// Host kernels over the split streams //
+//////////////////////////////////////////
+
+template <typename IndexType, typename RealType>
+void multiply(const split_complex_csr_matrix<IndexType, RealType, cusp::host_memory>& A,
+              const split_complex_array1d<RealType, cusp::host_memory>& x,
+                    split_complex_array1d<RealType, cusp::host_memory>& y,
+              cusp::host_memory)
+{
+    const IndexType * Ap = raw(A.row_offsets);
+    const IndexType * Aj = raw(A.column_indices);
+    const RealType  * Ar = raw(A.real_values);
+    const RealType  * Ai = raw(A.imag_values);
+    const RealType  * xr = raw(x.real);
+    const RealType  * xi = raw(x.imag);
+    RealType        * yr = raw(y.real);
+    RealType        * yi = raw(y.imag);
+
+    #pragma omp parallel for
+    for (int i = 0; i < int(A.num_rows); i++)
+    {
+        RealType sum_r = 0;
+        RealType sum_i = 0;
+
+        for (IndexType jj = Ap[i]; jj < Ap[i + 1]; jj++)
+        {
+            const IndexType j = Aj[jj];
+
+            sum_r += Ar[jj] * xr[j] - Ai[jj] * xi[j];
+            sum_i += Ar[jj] * xi[j] + Ai[jj] * xr[j];
+        }
+
+        yr[i] = sum_r;
+        yi[i] = sum_i;
+    }
+}
+
+template <typename IndexType, typename RealType>
+void multiply(const csr_matrix<IndexType, RealType, cusp::host_memory>& A,
+              const split_complex_array1d<RealType, cusp::host_memory>& x,
+                    split_complex_array1d<RealType, cusp::host_memory>& y,
+              cusp::host_memory)
+{
+    const IndexType * Ap = raw(A.row_offsets);
+    const IndexType * Aj = raw(A.column_indices);
+    const RealType  * Av = raw(A.values);
+    const RealType  * xr = raw(x.real);
+    const RealType  * xi = raw(x.imag);
+    RealType        * yr = raw(y.real);
+    RealType        * yi = raw(y.imag);
+
+    // one pass over the matrix for both streams
+    #pragma omp parallel for
+    for (int i = 0; i < int(A.num_rows); i++)
+    {
+        RealType sum_r = 0;
+        RealType sum_i = 0;
+
+        for (IndexType jj = Ap[i]; jj < Ap[i + 1]; jj++)
+        {
+            const IndexType j = Aj[jj];
+
+            sum_r += Av[jj] * xr[j];
+            sum_i += Av[jj] * xi[j];
+        }
+
+        yr[i] = sum_r;
+        yi[i] = sum_i;
+    }
+}
+
+template <typename RealType>
+void scal(split_complex_array1d<RealType, cusp::host_memory>& x,
+          const cusp::complex<RealType> alpha,
+          cusp::host_memory)
+{
+    const RealType ar = alpha.real();
+    const RealType ai = alpha.imag();
+
+    RealType * xr = raw(x.real);
+    RealType * xi = raw(x.imag);
+
+    #pragma omp parallel for
+    for (int i = 0; i < int(x.size()); i++)
+    {
+        const RealType re = xr[i];
+        const RealType im = xi[i];
+
+        xr[i] = ar * re - ai * im;
+        xi[i] = ar * im + ai * re;
+    }
+}
+
+template <typename RealType>
+void axpy(const split_complex_array1d<RealType, cusp::host_memory>& x,
+                split_complex_array1d<RealType, cusp::host_memory>& y,
+          const cusp::complex<RealType> alpha,
+          cusp::host_memory)
+{
+    const RealType ar = alpha.real();
+    const RealType ai = alpha.imag();
+
+    const RealType * xr = raw(x.real);
+    const RealType * xi = raw(x.imag);
+    RealType       * yr = raw(y.real);
+    RealType       * yi = raw(y.imag);
+
+    #pragma omp parallel for
+    for (int i = 0; i < int(x.size()); i++)
+    {
+        yr[i] += ar * xr[i] - ai * xi[i];
+        yi[i] += ar * xi[i] + ai * xr[i];
+    }
+}
+
+// sum_i conj(x_i)^c y_i with c = 1 for dotc and c = 0 for dot
+template <typename RealType>
+cusp::complex<RealType>
+dot(const split_complex_array1d<RealType, cusp::host_memory>& x,
+    const split_complex_array1d<RealType, cusp::host_memory>& y,
+    const bool conjugate,
+    cusp::host_memory)
+{
+    const RealType * xr = raw(x.real);
+    const RealType * xi = raw(x.imag);
+    const RealType * yr = raw(y.real);
+    const RealType * yi = raw(y.imag);
+
+    const RealType s = conjugate ? RealType(-1) : RealType(1);
+
+    RealType re = 0;
+    RealType im = 0;
+
+    #pragma omp parallel for reduction(+:re,im)
+    for (int i = 0; i < int(x.size()); i++)
+    {
+        re += xr[i] * yr[i] - s * xi[i] * yi[i];
+        im += xr[i] * yi[i] + s * xi[i] * yr[i];
+    }
+
+    return cusp::complex<RealType>(re, im);
+}
+
+template <typename RealType>
+RealType nrm2(const split_complex_array1d<RealType, cusp::host_memory>& x,
+              cusp::host_memory)
+{
+    const RealType * xr = raw(x.real);
+    const RealType * xi = raw(x.imag);
+
+    RealType sum = 0;
+
+    #pragma omp parallel for reduction(+:sum)
+    for (int i = 0; i < int(x.size()); i++)
+        sum += xr[i] * xr[i] + xi[i] * xi[i];
+
+    return std::sqrt(sum);
+}
+
+////////////////////////////////////////////////////////
+// Other memory spaces compose the real cusp routines //
+////////////////////////////////////////////////////////
+
+template <typename IndexType, typename RealType, typename MemorySpace, typename System>
+void multiply(const split_complex_csr_matrix<IndexType, RealType, MemorySpace>& A,
+              const split_complex_array1d<RealType, MemorySpace>& x,
+                    split_complex_array1d<RealType, MemorySpace>& y,
+              System)
+{
+    // the real and imaginary parts as real matrices sharing the pattern
+    cusp::array1d<RealType, MemorySpace> t(A.num_rows);
+
+    cusp::multiply(cusp::make_csr_matrix_view(A.num_rows, A.num_cols, A.num_entries,
+                                              cusp::make_array1d_view(A.row_offsets),
+                                              cusp::make_array1d_view(A.column_indices),
+                                              cusp::make_array1d_view(A.real_values)),
+                   x.real, y.real);
+    cusp::multiply(cusp::make_csr_matrix_view(A.num_rows, A.num_cols, A.num_entries,
+                                              cusp::make_array1d_view(A.row_offsets),
+                                              cusp::make_array1d_view(A.column_indices),
+                                              cusp::make_array1d_view(A.imag_values)),
+                   x.imag, t);
+    cusp::blas::axpy(t, y.real, RealType(-1));
+
+    cusp::multiply(cusp::make_csr_matrix_view(A.num_rows, A.num_cols, A.num_entries,
+                                              cusp::make_array1d_view(A.row_offsets),
+                                              cusp::make_array1d_view(A.column_indices),
+                                              cusp::make_array1d_view(A.real_values)),
+                   x.imag, y.imag);
+    cusp::multiply(cusp::make_csr_matrix_view(A.num_rows, A.num_cols, A.num_entries,
+                                              cusp::make_array1d_view(A.row_offsets),
+                                              cusp::make_array1d_view(A.column_indices),
+                                              cusp::make_array1d_view(A.imag_values)),
+                   x.real, t);
+    cusp::blas::axpy(t, y.imag, RealType(1));
+}
+
+template <typename IndexType, typename RealType, typename MemorySpace, typename System>
+void multiply(const csr_matrix<IndexType, RealType, MemorySpace>& A,
+              const split_complex_array1d<RealType, MemorySpace>& x,
+                    split_complex_array1d<RealType, MemorySpace>& y,
+              System)
+{
+    cusp::multiply(A, x.real, y.real);
+    cusp::multiply(A, x.imag, y.imag);
+}
+
+template <typename RealType, typename MemorySpace, typename System>
+void scal(split_complex_array1d<RealType, MemorySpace>& x,
+          const cusp::complex<RealType> alpha,
+          System)
+{
+    cusp::array1d<RealType, MemorySpace> re(x.real);
+
+    cusp::blas::axpby(x.real, x.imag, x.real, alpha.real(), -alpha.imag());
+    cusp::blas::axpby(re, x.imag, x.imag, alpha.imag(), alpha.real());
+}
+
+template <typename RealType, typename MemorySpace, typename System>
+void axpy(const split_complex_array1d<RealType, MemorySpace>& x,
+                split_complex_array1d<RealType, MemorySpace>& y,
+          const cusp::complex<RealType> alpha,
+          System)
+{
+    cusp::blas::axpbypcz(y.real, x.real, x.imag, y.real, RealType(1), alpha.real(), -alpha.imag());
+    cusp::blas::axpbypcz(y.imag, x.imag, x.real, y.imag, RealType(1), alpha.real(),  alpha.imag());
+}
+
+template <typename RealType, typename MemorySpace, typename System>
+cusp::complex<RealType>
+dot(const split_complex_array1d<RealType, MemorySpace>& x,
+    const split_complex_array1d<RealType, MemorySpace>& y,
+    const bool conjugate,
+    System)
+{
+    const RealType s = conjugate ? RealType(-1) : RealType(1);
+
+    const RealType rr = cusp::blas::dot(x.real, y.real);
+    const RealType ii = cusp::blas::dot(x.imag, y.imag);
+    const RealType ri = cusp::blas::dot(x.real, y.imag);
+    const RealType ir = cusp::blas::dot(x.imag, y.real);
+
+    return cusp::complex<RealType>(rr - s * ii, ri + s * ir);
+}
+
+template <typename RealType, typename MemorySpace, typename System>
+RealType nrm2(const split_complex_array1d<RealType, MemorySpace>& x,
+              System)
+{
+    const RealType re = cusp::blas::nrm2(x.real);
+    const RealType im = cusp::blas::nrm2(x.imag);
+
+    return std::sqrt(re * re + im * im);
+}
+
+} // end namespace split_complex_detail
+
+///////////////////////////
+// split_complex_array1d //
+///////////////////////////
+template <typename RealType, typename MemorySpace>
+template <typename MemorySpace2>
+split_complex_array1d<RealType,MemorySpace>
+::split_complex_array1d(const cusp::array1d<value_type, MemorySpace2>& x)
+    : real(x.size()), imag(x.size())
+{
+    cusp::array1d<value_type, MemorySpace> z(x);
+
+    thrust::transform(z.begin(), z.end(), real.begin(), split_complex_detail::real_part_functor<RealType>());
+    thrust::transform(z.begin(), z.end(), imag.begin(), split_complex_detail::imag_part_functor<RealType>());
+}
+
+template <typename RealType, typename MemorySpace>
+template <typename ArrayType>
+void
+split_complex_array1d<RealType,MemorySpace>
+::copy_to(ArrayType& x) const
+{
+    cusp::array1d<value_type, MemorySpace> z(size());
+
+    thrust::transform(real.begin(), real.end(), imag.begin(), z.begin(), split_complex_detail::make_complex_functor<RealType>());
+
+    cusp::copy(z, x);
+}
+
+//////////////////////////////
+// split_complex_csr_matrix //
+//////////////////////////////
+template <typename IndexType, typename RealType, typename MemorySpace>
+template <typename MatrixType>
+split_complex_csr_matrix<IndexType,RealType,MemorySpace>
+::split_complex_csr_matrix(const MatrixType& A)
+{
+    cusp::csr_matrix<IndexType, cusp::complex<RealType>, MemorySpace> B;
+    cusp::convert(A, B);
+
+    this->num_rows    = B.num_rows;
+    this->num_cols    = B.num_cols;
+    this->num_entries = B.num_entries;
+
+    row_offsets    = B.row_offsets;
+    column_indices = B.column_indices;
+
+    real_values.resize(B.num_entries);
+    imag_values.resize(B.num_entries);
+
+    thrust::transform(B.values.begin(), B.values.end(), real_values.begin(), split_complex_detail::real_part_functor<RealType>());
+    thrust::transform(B.values.begin(), B.values.end(), imag_values.begin(), split_complex_detail::imag_part_functor<RealType>());
+}
+
+template <typename IndexType, typename RealType, typename MemorySpace>
+template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+void split_complex_csr_matrix<IndexType,RealType,MemorySpace>
+::operator()(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y)
+{
+    apply(exec, x, y, MemorySpace());
+}
+
+template <typename IndexType, typename RealType, typename MemorySpace>
+template <typename VectorType1, typename VectorType2>
+void split_complex_csr_matrix<IndexType,RealType,MemorySpace>
+::operator()(const VectorType1& x, VectorType2& y)
+{
+    cusp::multiply(*this, x, y);
+}
+
+template <typename IndexType, typename RealType, typename MemorySpace>
+template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+void split_complex_csr_matrix<IndexType,RealType,MemorySpace>
+::apply(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y,
+        cusp::host_memory)
+{
+    typedef cusp::complex<RealType> ValueType;
+
+    const IndexType * Ap = split_complex_detail::raw(row_offsets);
+    const IndexType * Aj = split_complex_detail::raw(column_indices);
+    const RealType  * Ar = split_complex_detail::raw(real_values);
+    const RealType  * Ai = split_complex_detail::raw(imag_values);
+
+    // accumulate the real and imaginary parts of every row separately
+    #pragma omp parallel for
+    for (int i = 0; i < int(this->num_rows); i++)
+    {
+        RealType sum_r = 0;
+        RealType sum_i = 0;
+
+        for (IndexType jj = Ap[i]; jj < Ap[i + 1]; jj++)
+        {
+            const ValueType xj = x[Aj[jj]];
+
+            sum_r += Ar[jj] * xj.real() - Ai[jj] * xj.imag();
+            sum_i += Ar[jj] * xj.imag() + Ai[jj] * xj.real();
+        }
+
+        y[i] = ValueType(sum_r, sum_i);
+    }
+}
+
+template <typename IndexType, typename RealType, typename MemorySpace>
+template <typename DerivedPolicy, typename VectorType1, typename VectorType2, typename System>
+void split_complex_csr_matrix<IndexType,RealType,MemorySpace>
+::apply(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y,
+        System)
+{
+    // split the input, multiply and interleave the result
+    split_complex_array1d<RealType, MemorySpace> xs(x.size());
+    split_complex_array1d<RealType, MemorySpace> ys(this->num_rows);
+
+    thrust::transform(exec, x.begin(), x.end(), xs.real.begin(), split_complex_detail::real_part_functor<RealType>());
+    thrust::transform(exec, x.begin(), x.end(), xs.imag.begin(), split_complex_detail::imag_part_functor<RealType>());
+
+    cusp::multiply(*this, xs, ys);
+
+    thrust::transform(exec, ys.real.begin(), ys.real.end(), ys.imag.begin(), y.begin(),
+                      split_complex_detail::make_complex_functor<RealType>());
+}
+
+//////////////
+// multiply //
+//////////////
+template <typename IndexType, typename RealType, typename MemorySpace>
+void multiply(const split_complex_csr_matrix<IndexType, RealType, MemorySpace>& A,
+              const split_complex_array1d<RealType, MemorySpace>& x,
+                    split_complex_array1d<RealType, MemorySpace>& y)
+{
+    split_complex_detail::multiply(A, x, y, MemorySpace());
+}
+
+template <typename IndexType, typename RealType, typename MemorySpace>
+void multiply(const csr_matrix<IndexType, RealType, MemorySpace>& A,
+              const split_complex_array1d<RealType, MemorySpace>& x,
+                    split_complex_array1d<RealType, MemorySpace>& y)
+{
+    split_complex_detail::multiply(A, x, y, MemorySpace());
+}
+
+namespace blas
+{
+
+template <typename RealType, typename MemorySpace>
+void copy(const cusp::split_complex_array1d<RealType, MemorySpace>& x,
+                cusp::split_complex_array1d<RealType, MemorySpace>& y)
+{
+    cusp::blas::copy(x.real, y.real);
+    cusp::blas::copy(x.imag, y.imag);
+}
+
+template <typename RealType, typename MemorySpace>
+void fill(cusp::split_complex_array1d<RealType, MemorySpace>& x,
+          const cusp::complex<RealType> alpha)
+{
+    cusp::blas::fill(x.real, alpha.real());
+    cusp::blas::fill(x.imag, alpha.imag());
+}
+
+template <typename RealType, typename MemorySpace>
+void scal(cusp::split_complex_array1d<RealType, MemorySpace>& x,
+          const cusp::complex<RealType> alpha)
+{
+    cusp::split_complex_detail::scal(x, alpha, MemorySpace());
+}
+
+template <typename RealType, typename MemorySpace>
+void axpy(const cusp::split_complex_array1d<RealType, MemorySpace>& x,
+                cusp::split_complex_array1d<RealType, MemorySpace>& y,
+          const cusp::complex<RealType> alpha)
+{
+    cusp::assert_same_dimensions(x.real, y.real);
+
+    cusp::split_complex_detail::axpy(x, y, alpha, MemorySpace());
+}
+
+template <typename RealType, typename MemorySpace>
+cusp::complex<RealType>
+dot(const cusp::split_complex_array1d<RealType, MemorySpace>& x,
+    const cusp::split_complex_array1d<RealType, MemorySpace>& y)
+{
+    cusp::assert_same_dimensions(x.real, y.real);
+
+    return cusp::split_complex_detail::dot(x, y, false, MemorySpace());
+}
+
+template <typename RealType, typename MemorySpace>
+cusp::complex<RealType>
+dotc(const cusp::split_complex_array1d<RealType, MemorySpace>& x,
+     const cusp::split_complex_array1d<RealType, MemorySpace>& y)
+{
+    cusp::assert_same_dimensions(x.real, y.real);
+
+    return cusp::split_complex_detail::dot(x, y, true, MemorySpace());
+}
+
+template <typename RealType, typename MemorySpace>
+RealType
+nrm2(const cusp::split_complex_array1d<RealType, MemorySpace>& x)
+{
+    return cusp::split_complex_detail::nrm2(x, MemorySpace());
+}
+
+} // end namespace blas
+} // end namespace cusp
@@ -0,0 +1,134 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file chfsi.h
+ *  \brief Chebyshev-filtered subspace iteration
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace eigen
+{
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup eigensolvers EigenSolvers
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/* \cond */
+template <typename LinearOperator,
+          typename Array1d,
+          typename Array2d>
+void chfsi(const LinearOperator& A,
+           Array1d& S,
+           Array2d& X,
+           bool largest = true);
+/* \endcond */
+
+/**
+ * \brief Chebyshev-filtered subspace iteration
+ *
+ * \tparam LinearOperator is a matrix or subclass of \p linear_operator
+ * \tparam Array1d array of eigenvalues
+ * \tparam Array2d column-major \p array2d of eigenvectors
+ * \tparam Monitor is a \p monitor
+ *
+ * \param A symmetric matrix
+ * \param S eigenvalues, the number of wanted eigenpairs is \p S.size()
+ * \param X block of vectors. If \p X has \p A.num_rows rows and at least
+ * \p S.size() columns it is used as initial guess, otherwise it is
+ * replaced by a random block with a few extra columns. On return the
+ * first \p S.size() columns hold the eigenvectors.
+ * \param monitor monitors iteration and determines stopping conditions
+ * \param largest If true compute the largest eigenpairs otherwise compute
+ * the smallest.
+ * \param degree degree of the Chebyshev filter
+ *
+ * \par Overview
+ * Computes many extreme eigenpairs of a symmetric matrix. Every iteration
+ * applies a Chebyshev polynomial of degree \p degree to the block \p X,
+ * which damps the unwanted part of the spectrum, orthonormalizes the
+ * block with Cholesky-QR and performs a Rayleigh-Ritz step on it. Ritz
+ * pairs whose residual norm is below the relative tolerance of
+ * \p monitor, relative to the spectral bound of \p A, are locked and no
+ * longer filtered. The bound is estimated with \p ritz_spectral_radius.
+ *
+ * Nearly all the work is in products of \p A with blocks of vectors, for
+ * a \p csr_matrix these are done with a single sparse matrix-dense
+ * matrix product per filter step. The dense eigenvalue problems and
+ * Cholesky factorizations of size \p X.num_cols are solved on the host
+ * with \p cusp::lapack.
+ *
+ * \par Example
+ *  The following code snippet demonstrates how to use \p chfsi to
+ *  compute the 20 smallest eigenpairs of a 2D Poisson problem.
+ *
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/monitor.h>
+ *  #include <cusp/eigen/chfsi.h>
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main(void)
+ *  {
+ *      cusp::csr_matrix<int, double, cusp::device_memory> A;
+ *      cusp::gallery::poisson5pt(A, 100, 100);
+ *
+ *      cusp::array1d<double, cusp::device_memory> S(20);
+ *      cusp::array2d<double, cusp::device_memory, cusp::column_major> X;
+ *
+ *      // at most 100 iterations, residuals below 1e-8 times the spectral radius
+ *      cusp::array1d<double, cusp::device_memory> b(A.num_rows, 1);
+ *      cusp::monitor<double> monitor(b, 100, 1e-8, 0, true);
+ *
+ *      // smallest eigenpairs with a filter of degree 12
+ *      cusp::eigen::chfsi(A, S, X, monitor, false, 12);
+ *
+ *      std::cout << "Smallest eigenvalue : " << S[0] << std::endl;
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ *
+ *  \see \p monitor
+ *  \see \p lobpcg
+ */
+template <typename LinearOperator,
+          typename Array1d,
+          typename Array2d,
+          typename Monitor>
+void chfsi(const LinearOperator& A,
+           Array1d& S,
+           Array2d& X,
+           Monitor& monitor,
+           bool largest = true,
+           size_t degree = 10);
+
+/*! \}
+ */
+
+} // end namespace eigen
+} // end namespace cusp
+
+#include <cusp/eigen/detail/chfsi.inl>
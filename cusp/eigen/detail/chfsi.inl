@@ -0,0 +1,356 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/copy.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+#include <cusp/detail/format.h>
+#include <cusp/eigen/spectral_radius.h>
+#include <cusp/krylov/detail/block_ops.h>
+#include <cusp/lapack/lapack.h>
+
+#include <thrust/copy.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace cusp
+{
+namespace eigen
+{
+namespace detail
+{
+
+// columns [first,last) of the column-major block X
+template <typename Array2d>
+typename Array2d::view
+column_block(Array2d& X, const size_t first, const size_t last)
+{
+    typedef typename Array2d::view View;
+
+    return View(X.num_rows, last - first, X.pitch,
+                X.values.subarray(first * X.pitch, (last - first) * X.pitch));
+}
+
+// Y = A X with a single sparse matrix-dense matrix product
+template <typename LinearOperator, typename Array2d1, typename Array2d2>
+void block_multiply(const LinearOperator& A, const Array2d1& X, Array2d2& Y, cusp::csr_format)
+{
+    cusp::multiply(A, X, Y);
+}
+
+// Y = A X one column at a time
+template <typename LinearOperator, typename Array2d1, typename Array2d2, typename Format>
+void block_multiply(const LinearOperator& A, const Array2d1& X, Array2d2& Y, Format)
+{
+    typedef typename Array2d2::column_view ColumnView;
+
+    for(size_t j = 0; j < X.num_cols; j++)
+    {
+        ColumnView Yj = Y.column(j);
+        cusp::multiply(A, X.column(j), Yj);
+    }
+}
+
+template <typename LinearOperator, typename Array2d1, typename Array2d2>
+void block_multiply(const LinearOperator& A, const Array2d1& X, Array2d2& Y)
+{
+    block_multiply(A, X, Y, typename LinearOperator::format());
+}
+
+// X <- X C for a square host matrix C, W is a workspace of the size of X
+template <typename Array2d1, typename Array2d2, typename Array2d3>
+void block_transform(Array2d1& X, const Array2d2& C, Array2d3& W)
+{
+    typedef typename Array2d1::value_type   ValueType;
+    typedef typename Array2d1::memory_space MemorySpace;
+
+    cusp::array2d<ValueType,MemorySpace,cusp::column_major> Cd;
+    cusp::copy(C, Cd);
+
+    cusp::blas::gemm(X, Cd, W);
+    cusp::blas::copy(W.values, X.values);
+}
+
+// Make the columns of Xa orthonormal and orthogonal to the columns of XL
+// using shifted Cholesky-QR followed by two plain Cholesky-QR passes
+template <typename DerivedPolicy, typename Array2d1, typename Array2d2, typename Array2d3>
+void cholesky_qr(thrust::execution_policy<DerivedPolicy> &exec,
+                 const Array2d1& XL, Array2d2& Xa, Array2d3& W)
+{
+    typedef typename Array2d2::value_type   ValueType;
+    typedef typename Array2d2::memory_space MemorySpace;
+    typedef cusp::array2d<double,cusp::host_memory,cusp::column_major> HostMatrix;
+
+    const size_t N  = Xa.num_rows;
+    const size_t nl = XL.num_cols;
+    const size_t na = Xa.num_cols;
+    const double u  = std::numeric_limits<ValueType>::epsilon();
+
+    if(na == 0)
+        return;
+
+    HostMatrix G;
+
+    // two passes of block Gram-Schmidt against the locked vectors
+    for(size_t pass = 0; nl > 0 && pass < 2; pass++)
+    {
+        cusp::krylov::detail::block_gram(exec, XL, nl, Xa, na, G);
+
+        cusp::array2d<ValueType,MemorySpace,cusp::column_major> Gd;
+        cusp::copy(G, Gd);
+
+        cusp::blas::gemm(XL, Gd, W);
+        cusp::blas::axpy(W.values, Xa.values, ValueType(-1));
+    }
+
+    for(size_t pass = 0; pass < 3; pass++)
+    {
+        cusp::krylov::detail::block_gram(exec, Xa, na, Xa, na, G);
+
+        // the shift makes the first factorization succeed however ill
+        // conditioned the filtered block is
+        if(pass == 0)
+        {
+            double trace = 0.0;
+            for(size_t i = 0; i < na; i++)
+                trace += G(i,i);
+
+            const double shift = 11.0 * double(N * na + na * (na + 1)) * u * trace;
+
+            for(size_t i = 0; i < na; i++)
+                G(i,i) += shift;
+        }
+
+        // Xa <- Xa R^{-1} with G = R^T R
+        cusp::lapack::potrf(G, 'U');
+        cusp::lapack::trtri(G, 'U', 'N');
+
+        for(size_t j = 0; j < na; j++)
+            for(size_t i = j + 1; i < na; i++)
+                G(i,j) = 0.0;
+
+        block_transform(Xa, G, W);
+    }
+}
+
+} // end namespace detail
+
+template <typename LinearOperator,
+          typename Array1d,
+          typename Array2d,
+          typename Monitor>
+void chfsi(const LinearOperator& A,
+           Array1d& S,
+           Array2d& X,
+           Monitor& monitor,
+           bool largest,
+           size_t degree)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+    typedef typename LinearOperator::memory_space MemorySpace;
+    typedef typename Array2d::view                BlockView;
+
+    typedef cusp::array1d<double,cusp::host_memory>                     HostArray;
+    typedef cusp::array2d<double,cusp::host_memory,cusp::column_major> HostMatrix;
+
+    const size_t N   = A.num_rows;
+    const size_t nev = std::min(S.size(), N);
+
+    if(nev == 0)
+        return;
+
+    degree = std::max(degree, size_t(1));
+
+    MemorySpace system;
+
+    // block of nev wanted and a few guard vectors, initially random
+    if(X.num_rows != N || X.num_cols < nev)
+    {
+        const size_t p = std::min(N, nev + std::max(nev / 5, size_t(10)));
+
+        X.resize(N, p);
+        cusp::copy(cusp::random_array<ValueType>(N * p), X.values);
+    }
+
+    const size_t p = X.num_cols;
+
+    // interval containing the spectrum of A
+    const double upper = 1.1 * cusp::eigen::ritz_spectral_radius(A, 20, true);
+    const double lower = -upper;
+    const double tol   = monitor.relative_tolerance() * upper;
+
+    // workspace
+    Array2d Y(N, p);
+    Array2d Z(N, p);
+    Array2d W(N, p);
+    cusp::array1d<ValueType,MemorySpace> r(N);
+
+    HostArray theta(p, 0.0);
+    HostArray resid(p, 0.0);
+    HostArray w;
+    HostMatrix H;
+    HostMatrix Q;
+
+    // columns [0,L) hold the locked eigenvectors
+    size_t L = 0;
+
+    {
+        BlockView Xa = detail::column_block(X, 0, p);
+        BlockView Wa = detail::column_block(W, 0, p);
+        BlockView XL = detail::column_block(X, 0, 0);
+        detail::cholesky_qr(system, XL, Xa, Wa);
+    }
+
+    while(1)
+    {
+        const size_t pa = p - L;
+
+        BlockView XL  = detail::column_block(X, 0, L);
+        BlockView Xa  = detail::column_block(X, L, p);
+        BlockView AXa = detail::column_block(Z, L, p);
+        BlockView Wa  = detail::column_block(W, L, p);
+
+        // Rayleigh-Ritz on the active block
+        detail::block_multiply(A, Xa, AXa);
+        cusp::krylov::detail::block_gram(system, Xa, pa, AXa, pa, H);
+
+        for(size_t j = 0; j < pa; j++)
+            for(size_t i = 0; i < j; i++)
+                H(i,j) = H(j,i) = 0.5 * (H(i,j) + H(j,i));
+
+        w.resize(pa);
+        Q.resize(pa, pa);
+        cusp::lapack::syev(H, w, Q);
+
+        // order the Ritz pairs with the wanted ones first
+        if(largest)
+        {
+            std::reverse(w.begin(), w.end());
+
+            for(size_t j = 0; j < pa / 2; j++)
+                for(size_t i = 0; i < pa; i++)
+                    std::swap(Q(i,j), Q(i,pa - 1 - j));
+        }
+
+        detail::block_transform(Xa,  Q, Wa);
+        detail::block_transform(AXa, Q, Wa);
+
+        for(size_t j = 0; j < pa; j++)
+        {
+            theta[L + j] = w[j];
+
+            cusp::blas::axpby(AXa.column(j), Xa.column(j), r, ValueType(1), ValueType(-w[j]));
+            resid[L + j] = cusp::blas::nrm2(r);
+        }
+
+        // lock the leading converged Ritz pairs
+        while(L < nev && resid[L] <= tol)
+            L++;
+
+        double max_resid = 0.0;
+        for(size_t j = L; j < nev; j++)
+            max_resid = std::max(max_resid, resid[j]);
+
+        monitor.residuals.push_back(max_resid);
+
+        if(monitor.is_verbose())
+        {
+            std::cout << "Iteration      : " << monitor.iteration_count() << std::endl;
+            std::cout << "Locked pairs   : " << L << " of " << nev << std::endl;
+            std::cout << "Residual norms : " << max_resid << std::endl << std::endl;
+        }
+
+        if(L == nev || monitor.iteration_count() >= monitor.iteration_limit())
+            break;
+
+        // damp the unwanted interval [a,b], scaled so that the wanted end stays O(1)
+        const double a  = largest ? lower : theta[p - 1];
+        const double b  = largest ? theta[p - 1] : upper;
+        const double e  = (b - a) / 2.0;
+        const double c  = (b + a) / 2.0;
+        const double aL = theta[L];
+
+        double sigma = e / (aL - c);
+        const double tau = 2.0 / sigma;
+
+        BlockView X0 = detail::column_block(X, L, p);
+        BlockView X1 = detail::column_block(Y, L, p);
+        BlockView X2 = detail::column_block(Z, L, p);
+
+        // X1 = (A - c I) X0 * sigma / e
+        detail::block_multiply(A, X0, X1);
+        cusp::blas::axpby(X1.values, X0.values, X1.values, ValueType(sigma / e), ValueType(-c * sigma / e));
+
+        for(size_t k = 2; k <= degree; k++)
+        {
+            const double sigma1 = 1.0 / (tau - sigma);
+
+            // X2 = (A - c I) X1 * 2 sigma1 / e - sigma sigma1 X0
+            detail::block_multiply(A, X1, X2);
+            cusp::blas::axpbypcz(X2.values, X1.values, X0.values, X2.values,
+                                 ValueType(2.0 * sigma1 / e),
+                                 ValueType(-2.0 * c * sigma1 / e),
+                                 ValueType(-sigma * sigma1));
+
+            // [X0 X1 X2] -> [X1 X2 X0]
+            BlockView T = X0;
+            X0 = X1;
+            X1 = X2;
+            X2 = T;
+
+            sigma = sigma1;
+        }
+
+        cusp::blas::copy(X1.values, Xa.values);
+
+        detail::cholesky_qr(system, XL, Xa, Wa);
+
+        ++monitor;
+    }
+
+    thrust::copy(theta.begin(), theta.begin() + nev, S.begin());
+}
+
+template <typename LinearOperator,
+          typename Array1d,
+          typename Array2d>
+void chfsi(const LinearOperator& A,
+           Array1d& S,
+           Array2d& X,
+           bool largest)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+
+    cusp::constant_array<ValueType> b(A.num_rows, ValueType(1));
+    cusp::monitor<ValueType> monitor(b);
+
+    cusp::eigen::chfsi(A, S, X, monitor, largest);
+}
+
+} // end namespace eigen
+} // end namespace cusp
@@ -21,6 +21,7 @@
 
 #include <cusp/array1d.h>
 #include <cusp/array2d.h>
+#include <cusp/exception.h>
 #include <cusp/multiply.h>
 
 #include <cusp/blas/blas.h>
@@ -30,6 +31,9 @@
 #include <cusp/eigen/detail/gram_schmidt.inl>
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
 
 #include <iostream>
 #include <iomanip>
@@ -38,10 +42,384 @@ namespace cusp
 {
 namespace eigen
 {
+namespace detail
+{
+
+template <typename Array1d>
+struct ritz_value_less
+{
+    const Array1d& values;
+
+    ritz_value_less(const Array1d& values) : values(values) {}
+
+    bool operator()(const size_t i, const size_t j) const
+    {
+        return values[i] < values[j];
+    }
+};
+
+// Orders the Ritz values so that the wanted ones come first
+template <typename Array1d>
+void ritz_value_order(const Array1d& values, const SpectrumPart eigPart, std::vector<size_t>& order)
+{
+    const size_t n = values.size();
+
+    std::vector<size_t> ascending(n);
+    for(size_t i = 0; i < n; i++)
+        ascending[i] = i;
+
+    std::stable_sort(ascending.begin(), ascending.end(), ritz_value_less<Array1d>(values));
+
+    order.clear();
+
+    if(eigPart == cusp::eigen::SA)
+    {
+        order = ascending;
+    }
+    else if(eigPart == cusp::eigen::LA)
+    {
+        order.assign(ascending.rbegin(), ascending.rend());
+    }
+    else
+    {
+        // alternate between the ends, starting with the largest
+        size_t lo = 0, hi = n;
+        while(lo < hi)
+        {
+            order.push_back(ascending[--hi]);
+            if(lo < hi)
+                order.push_back(ascending[lo++]);
+        }
+    }
+}
+
+// V(:,first:first+k) <- V(:,first:first+n) Y for an n-by-k matrix Y with
+// k <= n, one block of rows at a time so that the workspace stays small
+template <typename Array2d1, typename Array2d2>
+void combine_in_place(Array2d1& V, const size_t first, const Array2d2& Y)
+{
+    typedef typename Array2d1::value_type   ValueType;
+    typedef typename Array2d1::memory_space MemorySpace;
+    typedef typename Array2d1::view         Array2dView;
+
+    const size_t N = V.num_rows;
+    const size_t n = Y.num_rows;
+    const size_t k = Y.num_cols;
+
+    if(k == 0)
+        return;
+
+    // workspace of about one basis vector
+    const size_t block_size = std::min(N, std::max(size_t(1024), N / k));
+
+    cusp::array2d<ValueType,MemorySpace,cusp::column_major> Yd;
+    cusp::copy(Y, Yd);
+
+    cusp::array2d<ValueType,MemorySpace,cusp::column_major> W(block_size, k);
+
+    for(size_t row = 0; row < N; row += block_size)
+    {
+        const size_t rows = std::min(block_size, N - row);
+
+        Array2dView Vb(rows, n, V.pitch, V.values.subarray(first * V.pitch + row, (n - 1) * V.pitch + rows));
+        Array2dView Wb(rows, k, W.pitch, W.values.subarray(0, (k - 1) * W.pitch + rows));
+
+        cusp::blas::gemm(Vb, Yd, Wb);
+
+        for(size_t j = 0; j < k; j++)
+            cusp::blas::copy(Wb.column(j), Vb.column(j));
+    }
+}
+
+// V(:,j) <- a random unit vector orthogonal to V(:,0:j), used to continue
+// the basis when the Lanczos recurrence finds an invariant subspace
+template <typename Array2d>
+void random_orthogonal_column(Array2d& V, const size_t j, const size_t seed)
+{
+    typedef typename Array2d::value_type  ValueType;
+    typedef typename Array2d::column_view ColumnView;
+
+    ColumnView vj = V.column(j);
+    cusp::copy(cusp::random_array<ValueType>(V.num_rows, seed), vj);
+
+    for(size_t pass = 0; pass < 2; pass++)
+    {
+        for(size_t i = 0; i < j; i++)
+        {
+            ValueType h = cusp::blas::dot(V.column(i), vj);
+            cusp::blas::axpy(V.column(i), vj, -h);
+        }
+    }
+
+    cusp::blas::scal(vj, ValueType(1.0/cusp::blas::nrm2(vj)));
+}
+
+template <typename Matrix, typename Array1d, typename Array2d, typename LanczosOptions>
+void thick_restart_lanczos(const Matrix& A, Array1d& eigVals, Array2d& eigVecs, LanczosOptions& options)
+{
+    typedef typename Matrix::value_type   ValueType;
+    typedef typename Matrix::memory_space MemorySpace;
+    typedef cusp::array2d<ValueType,MemorySpace,cusp::column_major> Basis;
+    typedef typename Basis::column_view ColumnView;
+    typedef cusp::array2d<double,cusp::host_memory,cusp::column_major> HostMatrix;
+    typedef cusp::array1d<double,cusp::host_memory> HostArray;
+
+    const size_t N = A.num_cols;
+    const size_t m = std::min(options.maxBasisSize, N);
+    const size_t neigWanted = std::min(eigVals.size(), N);
+
+    const double eps = std::numeric_limits<ValueType>::epsilon();
+
+    if(options.eigPart != cusp::eigen::SA && options.eigPart != cusp::eigen::LA && options.eigPart != cusp::eigen::BE)
+        throw cusp::runtime_exception("Invalid spectrum part specified!");
+
+    if(m <= neigWanted && m < N)
+        throw cusp::invalid_input_exception("maximum basis size must exceed the number of wanted eigenvalues");
+
+    if(options.maxIter == 0)
+        options.maxIter = 500 + options.defaultMaxIterFactor * neigWanted;
+    if(options.tol < 0.0)
+        options.tol = std::sqrt(eps);
+
+    if(options.verbose)
+        options.print();
+
+    if(neigWanted == 0)
+    {
+        eigVals.resize(0);
+        eigVecs.resize(0,0);
+        return;
+    }
+
+    // the basis is allocated once, columns [0,L) hold the locked Ritz vectors
+    Basis V(N, m);
+    cusp::array1d<ValueType,MemorySpace> w(N);
+
+    HostMatrix T(m, m, 0.0);
+    HostMatrix Y;
+    HostArray theta;
+    HostArray lockedTheta;
+    HostArray values;
+
+    std::vector<size_t> order;
+    std::vector<size_t> newLocked;
+    std::vector<size_t> selected;
+
+    // initialize starting vector to random values in [0,1)
+    ColumnView v0 = V.column(0);
+    cusp::copy(cusp::random_array<ValueType>(N), v0);
+    cusp::blas::scal(v0, ValueType(1.0/cusp::blas::nrm2(v0)));
+
+    size_t L = 0, k = 0, iter = 0, restarts = 0, numConverged = 0;
+    double beta = 0.0, anorm = 0.0;
+
+    while(1)
+    {
+        // extend the basis to m vectors with fully reorthogonalized Lanczos steps
+        for(size_t j = k; j < m; j++)
+        {
+            cusp::multiply(A, V.column(j), w);
+            iter++;
+
+            for(size_t pass = 0; pass < 2; pass++)
+            {
+                for(size_t i = 0; i <= j; i++)
+                {
+                    ValueType h = cusp::blas::dot(V.column(i), w);
+                    cusp::blas::axpy(V.column(i), w, -h);
+
+                    // couplings to locked vectors are below the tolerance and dropped
+                    if(i >= L)
+                        T(i,j) += h;
+                }
+            }
+
+            for(size_t i = L; i < j; i++)
+                T(j,i) = T(i,j);
+
+            beta = cusp::blas::nrm2(w);
+            anorm = std::max(anorm, std::abs(T(j,j)) + beta);
+
+            if(j + 1 == m)
+                break;
+
+            ColumnView vj = V.column(j + 1);
+
+            if(beta <= eps * anorm)
+            {
+                if(options.verbose)
+                    std::cout << "At iteration #" << iter
+                              << ", invariant subspace found, continuing with a random vector" << std::endl;
+
+                random_orthogonal_column(V, j + 1, iter);
+                beta = 0.0;
+            }
+            else
+            {
+                cusp::blas::copy(w, vj);
+                cusp::blas::scal(vj, ValueType(1.0/beta));
+            }
+        }
+
+        // Rayleigh-Ritz on the active part of the basis
+        const size_t ma = m - L;
+
+        HostMatrix Ta(ma, ma);
+        for(size_t j = 0; j < ma; j++)
+            for(size_t i = 0; i < ma; i++)
+                Ta(i,j) = T(L + i, L + j);
+
+        theta.resize(ma);
+        Y.resize(ma, ma);
+        cusp::lapack::syev(Ta, theta, Y);
+
+        values = lockedTheta;
+        values.insert(values.end(), theta.begin(), theta.end());
+
+        for(size_t i = 0; i < ma; i++)
+            anorm = std::max(anorm, std::abs(theta[i]));
+
+        ritz_value_order(values, options.eigPart, order);
+
+        // residual norm of the Ritz pair i is |beta Y(ma-1,i)|
+        numConverged = 0;
+        newLocked.clear();
+
+        for(size_t l = 0; l < neigWanted; l++)
+        {
+            const size_t i = order[l];
+
+            if(i < L)
+            {
+                numConverged++;
+            }
+            else if(std::abs(beta * Y(ma - 1, i - L)) <= options.tol * anorm)
+            {
+                numConverged++;
+                newLocked.push_back(i - L);
+            }
+        }
+
+        if(options.verbose)
+            std::cout << "At iteration #" << iter << ", restart #" << restarts << " : "
+                      << numConverged << " of " << neigWanted << " eigenvalues converged" << std::endl;
+
+        if(numConverged == neigWanted || iter >= options.maxIter)
+            break;
+
+        // keep the locked vectors, the remaining wanted vectors and half of the rest
+        const size_t L2 = L + newLocked.size();
+        const size_t remaining = neigWanted - numConverged;
+        const size_t k2 = std::min(m - 1, L2 + remaining + (m - L2 - remaining) / 2);
+
+        if(k2 <= L2)
+            break;
+
+        selected = newLocked;
+
+        for(size_t l = 0; l < order.size() && selected.size() < k2 - L; l++)
+        {
+            const size_t i = order[l];
+
+            if(i >= L && std::find(newLocked.begin(), newLocked.end(), i - L) == newLocked.end())
+                selected.push_back(i - L);
+        }
+
+        HostMatrix Ys(ma, selected.size());
+        for(size_t j = 0; j < selected.size(); j++)
+            for(size_t i = 0; i < ma; i++)
+                Ys(i,j) = Y(i, selected[j]);
+
+        combine_in_place(V, L, Ys);
+
+        // the couplings to the residual vector are recomputed by the next step
+        cusp::blas::fill(T.values, 0.0);
+
+        for(size_t j = 0; j < selected.size(); j++)
+        {
+            if(j < newLocked.size())
+                lockedTheta.push_back(theta[selected[j]]);
+            else
+                T(L + j, L + j) = theta[selected[j]];
+        }
+
+        L = L2;
+        k = k2;
+
+        if(beta <= eps * anorm)
+        {
+            if(options.verbose)
+                std::cout << "At restart #" << restarts
+                          << ", invariant subspace found, continuing with a random vector" << std::endl;
+
+            random_orthogonal_column(V, k, iter);
+        }
+        else
+        {
+            ColumnView vk = V.column(k);
+            cusp::blas::copy(w, vk);
+            cusp::blas::scal(vk, ValueType(1.0/beta));
+        }
+
+        restarts++;
+    }
+
+    if(numConverged < neigWanted)
+        std::cout << "Maximum number of Lanczos iterations " << iter
+                  << " is met, but the desired eigenvalues may not be converged!" << std::endl;
+
+    // return the wanted Ritz pairs in ascending order
+    std::vector<size_t> wanted(order.begin(), order.begin() + neigWanted);
+    std::sort(wanted.begin(), wanted.end(), ritz_value_less<HostArray>(values));
+
+    const size_t ma = m - L;
+
+    eigVals.resize(neigWanted);
+    HostMatrix S(m, neigWanted, 0.0);
+
+    for(size_t j = 0; j < neigWanted; j++)
+    {
+        const size_t i = wanted[j];
+
+        eigVals[j] = values[i];
+
+        if(i < L)
+            S(i,j) = 1.0;
+        else
+            for(size_t l = 0; l < ma; l++)
+                S(L + l, j) = Y(l, i - L);
+    }
+
+    if(options.computeEigVecs)
+    {
+        cusp::array2d<ValueType,MemorySpace,cusp::column_major> Sd;
+        cusp::copy(S, Sd);
+
+        eigVecs.resize(N, neigWanted);
+        cusp::blas::gemm(V, Sd, eigVecs);
+    }
+
+    if(options.verbose)
+    {
+        std::cout << std::endl;
+        std::cout << "Iteration Count    : " << iter << std::endl;
+        std::cout << "Restart Count      : " << restarts << std::endl;
+        std::cout << "Locked Ritz Pairs  : " << L << std::endl;
+        std::cout << std::endl;
+    }
+}
+
+} // end namespace detail
 
 template <typename Matrix, typename Array1d, typename Array2d, typename LanczosOptions>
 void lanczos(const Matrix& A, Array1d& eigVals, Array2d& eigVecs, LanczosOptions& options)
 {
+    if(options.maxBasisSize > 0)
+    {
+        detail::thick_restart_lanczos(A, eigVals, eigVecs, options);
+        return;
+    }
+
     typedef typename Matrix::value_type   ValueType;
     typedef typename Matrix::memory_space MemorySpace;
     typedef typename Array2d::view Array2dView;
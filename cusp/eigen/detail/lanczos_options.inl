@@ -38,6 +38,7 @@ lanczos_options<ValueType>
     maxIter               = opts.maxIter;
     extraIter             = opts.extraIter;
     stride                = opts.stride;
+    maxBasisSize          = opts.maxBasisSize;
     defaultMinIterFactor  = opts.defaultMinIterFactor;
     defaultMaxIterFactor  = opts.defaultMaxIterFactor;
 
@@ -72,6 +73,7 @@ lanczos_options<ValueType>
     std::cout << "\tMinimum Iterations      : " << minIter << std::endl;
     std::cout << "\tMaximum Iterations      : " << maxIter << std::endl;
     std::cout << "\tExtra Iterations        : " << extraIter << std::endl;
+    std::cout << "\tMaximum Basis Size      : " << maxBasisSize << std::endl;
     std::cout << "\tMemory Expansion Factor : " << memoryExpansionFactor << std::endl;
     std::cout << "\tDefault MinIter Factor  : " << defaultMinIterFactor << std::endl;
     std::cout << "\tDefault MaxIter Factor  : " << defaultMaxIterFactor << std::endl;
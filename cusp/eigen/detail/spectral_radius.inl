@@ -21,11 +21,12 @@
 #include <cusp/array2d.h>
 #include <cusp/complex.h>
 #include <cusp/format_utils.h>
+#include <cusp/functional.h>
 #include <cusp/multiply.h>
+#include <cusp/operator_expressions.h>
 
 #include <cusp/blas/blas.h>
 #include <cusp/eigen/arnoldi.h>
-#include <cusp/precond/diagonal.h>
 
 #include <thrust/extrema.h>
 #include <thrust/transform.h>
@@ -43,28 +44,6 @@ namespace eigen
 namespace detail
 {
 
-template <typename MatrixType>
-struct Dinv_A : public cusp::linear_operator<typename MatrixType::value_type, typename MatrixType::memory_space>
-{
-    typedef typename MatrixType::value_type   ValueType;
-    typedef typename MatrixType::memory_space MemorySpace;
-
-    const MatrixType& A;
-    const cusp::precond::diagonal<ValueType,MemorySpace> Dinv;
-
-    Dinv_A(const MatrixType& A)
-        : cusp::linear_operator<ValueType,MemorySpace>(A.num_rows, A.num_cols, A.num_entries + A.num_rows),
-          A(A), Dinv(A)
-    {}
-
-    template <typename Array1, typename Array2>
-    void operator()(const Array1& x, Array2& y) const
-    {
-        cusp::multiply(A,x,y);
-        cusp::multiply(Dinv,y,y);
-    }
-};
-
 template <typename MatrixType>
 double disks_spectral_radius(const MatrixType& A, coo_format)
 {
@@ -176,9 +155,15 @@ double disks_spectral_radius(const MatrixType& A)
 template <typename MatrixType>
 double estimate_rho_Dinv_A(const MatrixType& A)
 {
-    detail::Dinv_A<MatrixType> Dinv_A(A);
+    typedef typename MatrixType::value_type   ValueType;
+    typedef typename MatrixType::memory_space MemorySpace;
+
+    cusp::array1d<ValueType, MemorySpace> Dinv(A.num_rows);
+
+    cusp::extract_diagonal(A, Dinv);
+    thrust::transform(Dinv.begin(), Dinv.end(), Dinv.begin(), cusp::reciprocal_functor<ValueType>());
 
-    return cusp::eigen::ritz_spectral_radius(Dinv_A, 8);
+    return cusp::eigen::ritz_spectral_radius(cusp::diag_scale(Dinv, A), 8);
 }
 
 template <typename MatrixType>
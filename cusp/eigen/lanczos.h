@@ -63,6 +63,16 @@ void lanczos(const MatrixType& A,
  * \par Overview
  * Computes the extreme eigenpairs of hermitian linear systems A x = s x.
  *
+ * By default the whole Lanczos basis is kept and grows with the number of
+ * iterations. If \p options.maxBasisSize is nonzero the thick-restart
+ * variant is used instead: the basis never holds more than
+ * \p maxBasisSize vectors, converged Ritz pairs are locked, and the basis
+ * is compressed in place onto the wanted Ritz vectors when it is full. The
+ * Rayleigh-Ritz step solves a small dense eigenvalue problem with
+ * \p cusp::lapack::syev. In this mode \p options.maxIter bounds the total
+ * number of products with \p A and \p options.tol bounds the residual
+ * norms relative to the largest Ritz value.
+ *
  * \note \p A must be symmetric.
  *
  * \par Example
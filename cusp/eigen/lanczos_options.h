@@ -58,6 +58,9 @@ public:
     size_t extraIter;
     size_t stride;
 
+    // if nonzero, thick-restart Lanczos with at most this many basis vectors
+    size_t maxBasisSize;
+
     ReorthStrategy reorth;
     SpectrumPart eigPart;
 
@@ -74,7 +77,7 @@ public:
 
     lanczos_options() :
         computeEigVecs(false), verbose(false), minIter(0), maxIter(0), extraIter(10),
-        stride(10), reorth(None), eigPart(LA), memoryExpansionFactor(1.2), tol(1e-4),
+        stride(10), maxBasisSize(0), reorth(None), eigPart(LA), memoryExpansionFactor(1.2), tol(1e-4),
         doubleReorthGamma(1.0/std::sqrt(2.0)), localReorthGamma(1.0/std::sqrt(2.0)),
         defaultMinIterFactor(5), defaultMaxIterFactor(50),
         eigLowCut(std::numeric_limits<ValueType>::infinity()),
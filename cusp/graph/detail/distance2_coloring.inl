@@ -0,0 +1,154 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <cusp/detail/config.h>
+#include <thrust/system/detail/generic/select_system.h>
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/exception.h>
+#include <cusp/graph/distance2_coloring.h>
+
+#include <cusp/system/detail/adl/graph/distance2_coloring.h>
+#include <cusp/system/detail/generic/graph/distance2_coloring.h>
+
+namespace cusp
+{
+namespace graph
+{
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t distance2_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                                ArrayType& colors)
+{
+    using cusp::system::detail::generic::distance2_coloring;
+
+    return distance2_coloring(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G, colors);
+}
+
+template<typename MatrixType,
+         typename ArrayType>
+size_t distance2_coloring(const MatrixType& G,
+                                ArrayType& colors)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType::memory_space System1;
+    typedef typename ArrayType::memory_space  System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::graph::distance2_coloring(select_system(system1,system2), G, colors);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t partial_distance2_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                                  const MatrixType& A,
+                                        ArrayType& colors)
+{
+    using cusp::system::detail::generic::partial_distance2_coloring;
+
+    return partial_distance2_coloring(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, colors);
+}
+
+template<typename MatrixType,
+         typename ArrayType>
+size_t partial_distance2_coloring(const MatrixType& A,
+                                        ArrayType& colors)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType::memory_space System1;
+    typedef typename ArrayType::memory_space  System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::graph::partial_distance2_coloring(select_system(system1,system2), A, colors);
+}
+
+template <typename ArrayType,
+          typename Array2dType>
+void coloring_seed_matrix(const ArrayType& colors,
+                          const size_t num_colors,
+                                Array2dType& S)
+{
+    typedef typename ArrayType::value_type   IndexType;
+    typedef typename Array2dType::value_type ValueType;
+    typedef typename Array2dType::orientation Orientation;
+
+    cusp::array1d<IndexType,cusp::host_memory> colors_host(colors);
+    cusp::array2d<ValueType,cusp::host_memory,Orientation> S_host(colors_host.size(), num_colors, ValueType(0));
+
+    for (size_t j = 0; j < colors_host.size(); j++)
+    {
+        if (colors_host[j] < 0 || size_t(colors_host[j]) >= num_colors)
+            throw cusp::invalid_input_exception("color out of range");
+
+        S_host(j, colors_host[j]) = ValueType(1);
+    }
+
+    S = S_host;
+}
+
+template <typename MatrixType1,
+          typename ArrayType,
+          typename Array2dType,
+          typename MatrixType2>
+void recover_colored_matrix(const MatrixType1& pattern,
+                            const ArrayType& colors,
+                            const Array2dType& B,
+                                  MatrixType2& J)
+{
+    typedef typename MatrixType1::index_type  IndexType;
+    typedef typename Array2dType::value_type  ValueType;
+    typedef typename Array2dType::orientation Orientation;
+
+    if (colors.size() != pattern.num_cols || B.num_rows != pattern.num_rows)
+        throw cusp::invalid_input_exception("dimensions of pattern, colors and compressed matrix do not match");
+
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> J_host(pattern);
+    cusp::array1d<IndexType,cusp::host_memory> colors_host(colors);
+    cusp::array2d<ValueType,cusp::host_memory,Orientation> B_host(B);
+
+    for (size_t j = 0; j < colors_host.size(); j++)
+        if (colors_host[j] < 0 || size_t(colors_host[j]) >= B_host.num_cols)
+            throw cusp::invalid_input_exception("color out of range");
+
+    const IndexType num_rows = J_host.num_rows;
+
+    #pragma omp parallel for
+    for (IndexType i = 0; i < num_rows; i++)
+    {
+        for (IndexType jj = J_host.row_offsets[i]; jj < J_host.row_offsets[i + 1]; jj++)
+        {
+            J_host.values[jj] = B_host(i, colors_host[J_host.column_indices[jj]]);
+        }
+    }
+
+    J = J_host;
+}
+
+} // end namespace graph
+} // end namespace cusp
@@ -58,6 +58,38 @@ size_t maximal_independent_set(const MatrixType& G,
     return cusp::graph::maximal_independent_set(select_system(system1,system2), G, stencil, k);
 }
 
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t maximal_independent_set(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                               const MatrixType& G,
+                                     ArrayType& stencil,
+                               const size_t k,
+                                     size_t& num_rounds)
+{
+    using cusp::system::detail::generic::maximal_independent_set;
+
+    return maximal_independent_set(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G, stencil, k, num_rounds);
+}
+
+template <typename MatrixType,
+          typename ArrayType>
+size_t maximal_independent_set(const MatrixType& G,
+                                     ArrayType& stencil,
+                               const size_t k,
+                                     size_t& num_rounds)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType::memory_space System1;
+    typedef typename ArrayType::memory_space  System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::graph::maximal_independent_set(select_system(system1,system2), G, stencil, k, num_rounds);
+}
+
 } // end namespace graph
 } // end namespace cusp
 
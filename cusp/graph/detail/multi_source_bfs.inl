@@ -0,0 +1,101 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <cusp/detail/config.h>
+#include <thrust/system/detail/generic/select_system.h>
+
+#include <cusp/exception.h>
+#include <cusp/graph/multi_source_bfs.h>
+
+#include <cusp/system/detail/adl/graph/multi_source_bfs.h>
+#include <cusp/system/detail/generic/graph/multi_source_bfs.h>
+
+namespace cusp
+{
+namespace graph
+{
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3>
+void multi_source_bfs(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType1& sources,
+                      ArrayType2& eccentricities,
+                      ArrayType3& farthest)
+{
+    using cusp::system::detail::generic::multi_source_bfs;
+
+    return multi_source_bfs(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G, sources, eccentricities, farthest);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType1,
+          typename ArrayType2>
+void multi_source_bfs(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType1& sources,
+                      ArrayType2& eccentricities)
+{
+    using cusp::system::detail::generic::multi_source_bfs;
+
+    return multi_source_bfs(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G, sources, eccentricities);
+}
+
+template <typename MatrixType,
+          typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3>
+void multi_source_bfs(const MatrixType& G,
+                      const ArrayType1& sources,
+                      ArrayType2& eccentricities,
+                      ArrayType3& farthest)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType::memory_space System1;
+    typedef typename ArrayType2::memory_space System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::graph::multi_source_bfs(select_system(system1,system2), G, sources, eccentricities, farthest);
+}
+
+template <typename MatrixType,
+          typename ArrayType1,
+          typename ArrayType2>
+void multi_source_bfs(const MatrixType& G,
+                      const ArrayType1& sources,
+                      ArrayType2& eccentricities)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType::memory_space System1;
+    typedef typename ArrayType2::memory_space System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::graph::multi_source_bfs(select_system(system1,system2), G, sources, eccentricities);
+}
+
+} // end namespace graph
+} // end namespace cusp
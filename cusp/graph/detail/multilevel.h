@@ -0,0 +1,862 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file multilevel.h
+ *  \brief Multilevel bisection engine shared by the partitioner and the
+ *  nested dissection ordering
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
+#include <cusp/transpose.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <queue>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace cusp
+{
+namespace graph
+{
+namespace detail
+{
+
+// graphs with at most this many vertices are bisected without coarsening
+const size_t multilevel_coarse_size = 64;
+
+// allowed deviation of a part weight from its target, as a fraction of
+// the target
+const double multilevel_imbalance = 0.03;
+
+// Undirected graph with integer vertex and edge weights. The edges are
+// stored as a symmetric CSR matrix of edge weights without self loops.
+template <typename IndexType>
+struct weighted_graph
+{
+    typedef cusp::csr_matrix<IndexType, IndexType, cusp::host_memory> matrix_type;
+    typedef cusp::array1d<IndexType, cusp::host_memory>               array_type;
+
+    matrix_type edges;
+    array_type  weights;
+
+    IndexType num_vertices(void) const
+    {
+        return weights.size();
+    }
+
+    IndexType total_weight(void) const
+    {
+        IndexType total = 0;
+
+        for (size_t i = 0; i < weights.size(); i++)
+            total += weights[i];
+
+        return total;
+    }
+
+    IndexType max_weight(void) const
+    {
+        IndexType max_weight = 0;
+
+        for (size_t i = 0; i < weights.size(); i++)
+            max_weight = std::max(max_weight, weights[i]);
+
+        return max_weight;
+    }
+};
+
+// Graph of the pattern of A + A^T without the diagonal, unit vertex weights
+template <typename MatrixType, typename IndexType>
+void build_weighted_graph(const MatrixType& A, weighted_graph<IndexType>& G)
+{
+    const IndexType N = A.num_rows;
+
+    std::vector< std::pair<IndexType,IndexType> > pairs;
+    pairs.reserve(2 * A.num_entries);
+
+    for (IndexType i = 0; i < N; i++)
+    {
+        for (IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = A.column_indices[jj];
+
+            if (i != j)
+            {
+                pairs.push_back(std::make_pair(i, j));
+                pairs.push_back(std::make_pair(j, i));
+            }
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+
+    const size_t num_edges = std::unique(pairs.begin(), pairs.end()) - pairs.begin();
+
+    G.edges.resize(N, N, num_edges);
+    G.weights.assign(N, IndexType(1));
+
+    for (IndexType i = 0; i <= N; i++)
+        G.edges.row_offsets[i] = 0;
+
+    for (size_t n = 0; n < num_edges; n++)
+    {
+        G.edges.row_offsets[pairs[n].first + 1]++;
+        G.edges.column_indices[n] = pairs[n].second;
+        G.edges.values[n] = 1;
+    }
+
+    for (IndexType i = 0; i < N; i++)
+        G.edges.row_offsets[i + 1] += G.edges.row_offsets[i];
+}
+
+template <typename IndexType, typename ArrayType>
+IndexType edge_cut(const weighted_graph<IndexType>& G, const ArrayType& parts)
+{
+    IndexType cut = 0;
+
+    for (IndexType i = 0; i < G.num_vertices(); i++)
+        for (IndexType jj = G.edges.row_offsets[i]; jj < G.edges.row_offsets[i + 1]; jj++)
+            if (parts[i] != parts[G.edges.column_indices[jj]])
+                cut += G.edges.values[jj];
+
+    return cut / 2;
+}
+
+// Heavy-edge matching. Vertices are visited by increasing degree and
+// matched with the unmatched neighbor of heaviest edge, unless the pair
+// would outweigh max_weight. Returns the number of aggregates.
+template <typename IndexType, typename ArrayType>
+IndexType heavy_edge_matching(const weighted_graph<IndexType>& G,
+                              const IndexType max_weight,
+                                    ArrayType& aggregates)
+{
+    const IndexType N = G.num_vertices();
+
+    std::vector< std::pair<IndexType,IndexType> > order(N);
+
+    for (IndexType i = 0; i < N; i++)
+        order[i] = std::make_pair(G.edges.row_offsets[i + 1] - G.edges.row_offsets[i], i);
+
+    std::sort(order.begin(), order.end());
+
+    aggregates.assign(N, IndexType(-1));
+
+    IndexType num_aggregates = 0;
+
+    for (IndexType n = 0; n < N; n++)
+    {
+        const IndexType i = order[n].second;
+
+        if (aggregates[i] >= 0)
+            continue;
+
+        IndexType best = -1;
+        IndexType best_weight = 0;
+
+        for (IndexType jj = G.edges.row_offsets[i]; jj < G.edges.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = G.edges.column_indices[jj];
+
+            if (aggregates[j] < 0 && G.edges.values[jj] > best_weight &&
+                G.weights[i] + G.weights[j] <= max_weight)
+            {
+                best = j;
+                best_weight = G.edges.values[jj];
+            }
+        }
+
+        aggregates[i] = num_aggregates;
+
+        if (best >= 0)
+            aggregates[best] = num_aggregates;
+
+        num_aggregates++;
+    }
+
+    return num_aggregates;
+}
+
+// Coarse graph P^T G P of the aggregates, where P(i, aggregates[i]) = 1.
+// The weights of the contracted edges end up on the diagonal, which is
+// dropped.
+template <typename IndexType, typename ArrayType>
+void contract_graph(const weighted_graph<IndexType>& G,
+                    const ArrayType& aggregates,
+                    const IndexType num_aggregates,
+                          weighted_graph<IndexType>& Gc)
+{
+    typedef typename weighted_graph<IndexType>::matrix_type MatrixType;
+
+    const IndexType N = G.num_vertices();
+
+    cusp::coo_matrix<IndexType, IndexType, cusp::host_memory> P_coo(N, num_aggregates, N);
+
+    for (IndexType i = 0; i < N; i++)
+    {
+        P_coo.row_indices[i]    = i;
+        P_coo.column_indices[i] = aggregates[i];
+        P_coo.values[i]         = 1;
+    }
+
+    MatrixType P(P_coo);
+    MatrixType R;
+    cusp::transpose(P, R);
+
+    MatrixType RG;
+    MatrixType RGP;
+    cusp::multiply(R, G.edges, RG);
+    cusp::multiply(RG, P, RGP);
+
+    Gc.weights.resize(num_aggregates);
+    cusp::multiply(R, G.weights, Gc.weights);
+
+    size_t num_edges = 0;
+
+    for (IndexType i = 0; i < num_aggregates; i++)
+        for (IndexType jj = RGP.row_offsets[i]; jj < RGP.row_offsets[i + 1]; jj++)
+            if (RGP.column_indices[jj] != i && RGP.values[jj] != 0)
+                num_edges++;
+
+    Gc.edges.resize(num_aggregates, num_aggregates, num_edges);
+    Gc.edges.row_offsets[0] = 0;
+
+    num_edges = 0;
+
+    for (IndexType i = 0; i < num_aggregates; i++)
+    {
+        for (IndexType jj = RGP.row_offsets[i]; jj < RGP.row_offsets[i + 1]; jj++)
+        {
+            if (RGP.column_indices[jj] != i && RGP.values[jj] != 0)
+            {
+                Gc.edges.column_indices[num_edges] = RGP.column_indices[jj];
+                Gc.edges.values[num_edges] = RGP.values[jj];
+                num_edges++;
+            }
+        }
+
+        Gc.edges.row_offsets[i + 1] = num_edges;
+    }
+}
+
+// Subgraph induced by the given vertices, numbered in the given order
+template <typename IndexType, typename ArrayType>
+void induced_subgraph(const weighted_graph<IndexType>& G,
+                      const ArrayType& vertices,
+                            weighted_graph<IndexType>& S)
+{
+    const IndexType N = G.num_vertices();
+    const IndexType n = vertices.size();
+
+    std::vector<IndexType> local(N, -1);
+
+    for (IndexType i = 0; i < n; i++)
+        local[vertices[i]] = i;
+
+    size_t num_edges = 0;
+
+    for (IndexType i = 0; i < n; i++)
+        for (IndexType jj = G.edges.row_offsets[vertices[i]]; jj < G.edges.row_offsets[vertices[i] + 1]; jj++)
+            if (local[G.edges.column_indices[jj]] >= 0)
+                num_edges++;
+
+    S.edges.resize(n, n, num_edges);
+    S.weights.resize(n);
+    S.edges.row_offsets[0] = 0;
+
+    num_edges = 0;
+
+    for (IndexType i = 0; i < n; i++)
+    {
+        for (IndexType jj = G.edges.row_offsets[vertices[i]]; jj < G.edges.row_offsets[vertices[i] + 1]; jj++)
+        {
+            const IndexType j = local[G.edges.column_indices[jj]];
+
+            if (j >= 0)
+            {
+                S.edges.column_indices[num_edges] = j;
+                S.edges.values[num_edges] = G.edges.values[jj];
+                num_edges++;
+            }
+        }
+
+        S.edges.row_offsets[i + 1] = num_edges;
+        S.weights[i] = G.weights[vertices[i]];
+    }
+}
+
+// weight of part 0 beyond the allowed deviation from its target
+template <typename IndexType>
+IndexType bisection_excess(const IndexType weight0, const IndexType target0, const IndexType tol)
+{
+    return std::max(IndexType(0), IndexType(std::abs(weight0 - target0) - tol));
+}
+
+// Fiduccia-Mattheyses refinement of a bisection. Every pass moves boundary
+// vertices of highest gain between the parts, each vertex at most once,
+// and keeps the prefix of moves that gave the best balance and then the
+// smallest cut. Returns the edge cut.
+template <typename IndexType, typename ArrayType>
+IndexType refine_bisection(const weighted_graph<IndexType>& G,
+                           const IndexType target0,
+                           const IndexType tol,
+                                 ArrayType& parts)
+{
+    typedef std::set< std::pair<IndexType,IndexType> > GainQueue;
+
+    const IndexType N = G.num_vertices();
+
+    // moves without improvement before a pass gives up
+    const size_t max_fruitless_moves = std::max(IndexType(50), N / 100);
+
+    std::vector<IndexType> gain(N);
+    std::vector<char> locked(N);
+    std::vector<char> queued(N);
+    std::vector<IndexType> moves;
+
+    IndexType weight0 = 0;
+
+    for (IndexType i = 0; i < N; i++)
+        if (parts[i] == 0)
+            weight0 += G.weights[i];
+
+    IndexType cut = edge_cut(G, parts);
+
+    for (int pass = 0; pass < 10; pass++)
+    {
+        GainQueue queue[2];
+
+        for (IndexType i = 0; i < N; i++)
+        {
+            IndexType external = 0;
+            IndexType internal = 0;
+
+            for (IndexType jj = G.edges.row_offsets[i]; jj < G.edges.row_offsets[i + 1]; jj++)
+            {
+                if (parts[G.edges.column_indices[jj]] == parts[i])
+                    internal += G.edges.values[jj];
+                else
+                    external += G.edges.values[jj];
+            }
+
+            gain[i]   = external - internal;
+            locked[i] = false;
+            queued[i] = external > 0;
+
+            if (queued[i])
+                queue[parts[i]].insert(std::make_pair(gain[i], i));
+        }
+
+        moves.clear();
+
+        IndexType current_cut = cut;
+        IndexType best_cut    = cut;
+        IndexType best_excess = bisection_excess(weight0, target0, tol);
+        size_t    best_moves  = 0;
+
+        while (moves.size() - best_moves <= max_fruitless_moves)
+        {
+            // the side whose best move has the highest gain and does not
+            // push the balance further out of bounds
+            int from = -1;
+
+            for (int side = 0; side < 2; side++)
+            {
+                if (queue[side].empty())
+                    continue;
+
+                const IndexType v = queue[side].rbegin()->second;
+                const IndexType new_weight0 = side == 0 ? weight0 - G.weights[v] : weight0 + G.weights[v];
+                const IndexType new_excess  = bisection_excess(new_weight0, target0, tol);
+
+                if (new_excess > 0 && new_excess >= bisection_excess(weight0, target0, tol))
+                    continue;
+
+                if (from < 0 || gain[v] > gain[queue[from].rbegin()->second])
+                    from = side;
+            }
+
+            if (from < 0)
+                break;
+
+            const IndexType v = queue[from].rbegin()->second;
+
+            queue[from].erase(std::make_pair(gain[v], v));
+            queued[v] = false;
+            locked[v] = true;
+
+            parts[v] = 1 - from;
+            weight0 += from == 0 ? -G.weights[v] : G.weights[v];
+            current_cut -= gain[v];
+            moves.push_back(v);
+
+            for (IndexType jj = G.edges.row_offsets[v]; jj < G.edges.row_offsets[v + 1]; jj++)
+            {
+                const IndexType u = G.edges.column_indices[jj];
+
+                if (locked[u])
+                    continue;
+
+                if (queued[u])
+                    queue[parts[u]].erase(std::make_pair(gain[u], u));
+
+                gain[u] += parts[u] == parts[v] ? -2 * G.edges.values[jj] : 2 * G.edges.values[jj];
+
+                queue[parts[u]].insert(std::make_pair(gain[u], u));
+                queued[u] = true;
+            }
+
+            const IndexType excess = bisection_excess(weight0, target0, tol);
+
+            if (excess < best_excess || (excess == best_excess && current_cut < best_cut))
+            {
+                best_cut    = current_cut;
+                best_excess = excess;
+                best_moves  = moves.size();
+            }
+        }
+
+        // undo the moves after the best prefix
+        while (moves.size() > best_moves)
+        {
+            const IndexType v = moves.back();
+
+            weight0 += parts[v] == 0 ? -G.weights[v] : G.weights[v];
+            parts[v] = 1 - parts[v];
+
+            moves.pop_back();
+        }
+
+        cut = best_cut;
+
+        if (best_moves == 0)
+            break;
+    }
+
+    return cut;
+}
+
+// Greedy graph growing: part 0 collects the vertices in breadth-first
+// order from start until it reaches its target weight
+template <typename IndexType, typename ArrayType>
+void grow_bisection(const weighted_graph<IndexType>& G,
+                    const IndexType target0,
+                    const IndexType start,
+                          ArrayType& parts)
+{
+    const IndexType N = G.num_vertices();
+
+    std::vector<char> visited(N, false);
+    std::queue<IndexType> frontier;
+
+    parts.assign(N, IndexType(1));
+
+    IndexType weight0 = 0;
+    IndexType next_root = 0;
+
+    frontier.push(start);
+    visited[start] = true;
+
+    while (weight0 < target0)
+    {
+        // continue in the next component once this one is exhausted
+        if (frontier.empty())
+        {
+            while (next_root < N && visited[next_root])
+                next_root++;
+
+            if (next_root == N)
+                break;
+
+            frontier.push(next_root);
+            visited[next_root] = true;
+        }
+
+        const IndexType v = frontier.front();
+        frontier.pop();
+
+        parts[v] = 0;
+        weight0 += G.weights[v];
+
+        for (IndexType jj = G.edges.row_offsets[v]; jj < G.edges.row_offsets[v + 1]; jj++)
+        {
+            const IndexType u = G.edges.column_indices[jj];
+
+            if (!visited[u])
+            {
+                visited[u] = true;
+                frontier.push(u);
+            }
+        }
+    }
+}
+
+// Bisection of a small graph: the best refined result of graph growing
+// from a few evenly spaced vertices
+template <typename IndexType, typename ArrayType>
+void initial_bisection(const weighted_graph<IndexType>& G,
+                       const IndexType target0,
+                       const IndexType tol,
+                             ArrayType& parts)
+{
+    const IndexType N = G.num_vertices();
+    const IndexType num_trials = std::min(N, IndexType(8));
+
+    ArrayType trial;
+
+    IndexType best_cut    = 0;
+    IndexType best_excess = -1;
+
+    for (IndexType t = 0; t < num_trials; t++)
+    {
+        grow_bisection(G, target0, t * N / num_trials, trial);
+
+        const IndexType cut = refine_bisection(G, target0, tol, trial);
+
+        IndexType weight0 = 0;
+
+        for (IndexType i = 0; i < N; i++)
+            if (trial[i] == 0)
+                weight0 += G.weights[i];
+
+        const IndexType excess = bisection_excess(weight0, target0, tol);
+
+        if (best_excess < 0 || excess < best_excess || (excess == best_excess && cut < best_cut))
+        {
+            best_cut    = cut;
+            best_excess = excess;
+            parts       = trial;
+        }
+    }
+}
+
+// Multilevel bisection: coarsen by heavy-edge matching until the graph is
+// small or stops shrinking, bisect the coarsest graph, then project the
+// bisection back level by level and refine it on every level. Part 0
+// receives a vertex weight of target0 +/- tol.
+template <typename IndexType, typename ArrayType>
+void multilevel_bisection(const weighted_graph<IndexType>& G,
+                          const IndexType target0,
+                          const IndexType tol,
+                                ArrayType& parts)
+{
+    const IndexType N = G.num_vertices();
+
+    if (size_t(N) <= multilevel_coarse_size)
+    {
+        initial_bisection(G, target0, tol, parts);
+        return;
+    }
+
+    // keep the coarse vertices light enough for a balanced bisection
+    const IndexType max_weight =
+        std::max(IndexType(2) * G.max_weight(),
+                 IndexType(3 * size_t(G.total_weight()) / (2 * multilevel_coarse_size)));
+
+    ArrayType aggregates;
+    const IndexType num_aggregates = heavy_edge_matching(G, max_weight, aggregates);
+
+    // matching stalled, bisect this level directly
+    if (20 * size_t(num_aggregates) > 19 * size_t(N))
+    {
+        initial_bisection(G, target0, tol, parts);
+        return;
+    }
+
+    weighted_graph<IndexType> Gc;
+    contract_graph(G, aggregates, num_aggregates, Gc);
+
+    ArrayType coarse_parts;
+    multilevel_bisection(Gc, target0, std::max(tol, Gc.max_weight()), coarse_parts);
+
+    parts.resize(N);
+
+    for (IndexType i = 0; i < N; i++)
+        parts[i] = coarse_parts[aggregates[i]];
+
+    refine_bisection(G, target0, tol, parts);
+}
+
+// tolerance of a bisection of G with target0 for part 0 that is followed
+// by depth - 1 levels of bisections, which share the allowed imbalance
+template <typename IndexType>
+IndexType bisection_tolerance(const weighted_graph<IndexType>& G, const IndexType target0, const int depth)
+{
+    const IndexType target = std::min(target0, G.total_weight() - target0);
+
+    return std::max(G.max_weight(), IndexType(multilevel_imbalance * target / depth));
+}
+
+// k-way partition by recursive bisection. The vertices of G are the
+// vertices[i] of the original graph, whose parts are written to parts.
+template <typename IndexType, typename ArrayType1, typename ArrayType2>
+void recursive_bisection(const weighted_graph<IndexType>& G,
+                         const ArrayType1& vertices,
+                         const IndexType num_parts,
+                         const IndexType first_part,
+                               ArrayType2& parts)
+{
+    typedef typename weighted_graph<IndexType>::array_type Array;
+
+    const IndexType N = G.num_vertices();
+
+    if (num_parts == 1 || N <= 1)
+    {
+        for (IndexType i = 0; i < N; i++)
+            parts[vertices[i]] = first_part;
+
+        return;
+    }
+
+    const IndexType num_parts0 = num_parts / 2;
+    const IndexType target0 = IndexType(double(G.total_weight()) * num_parts0 / num_parts);
+
+    int depth = 0;
+
+    while ((IndexType(1) << depth) < num_parts)
+        depth++;
+
+    Array bisection;
+    multilevel_bisection(G, target0, bisection_tolerance(G, target0, depth), bisection);
+
+    Array local[2];
+
+    for (IndexType i = 0; i < N; i++)
+        local[bisection[i]].push_back(i);
+
+    for (int side = 0; side < 2; side++)
+    {
+        weighted_graph<IndexType> S;
+        induced_subgraph(G, local[side], S);
+
+        Array global(local[side].size());
+
+        for (size_t i = 0; i < local[side].size(); i++)
+            global[i] = vertices[local[side][i]];
+
+        if (side == 0)
+            recursive_bisection(S, global, num_parts0, first_part, parts);
+        else
+            recursive_bisection(S, global, num_parts - num_parts0, first_part + num_parts0, parts);
+    }
+}
+
+// Greedy k-way refinement. The best move of every vertex is evaluated in
+// parallel against the current partition, then the moves that still
+// reduce the cut and respect the balance are applied in order.
+template <typename IndexType, typename ArrayType>
+void refine_kway(const weighted_graph<IndexType>& G,
+                 const IndexType num_parts,
+                       ArrayType& parts)
+{
+    const IndexType N = G.num_vertices();
+
+    const IndexType max_part_weight =
+        std::max(IndexType((1.0 + multilevel_imbalance) * G.total_weight() / num_parts + 1),
+                 IndexType(G.total_weight() / num_parts + G.max_weight()));
+
+    std::vector<IndexType> part_weights(num_parts, 0);
+
+    for (IndexType i = 0; i < N; i++)
+        part_weights[parts[i]] += G.weights[i];
+
+    std::vector<IndexType> destination(N);
+    std::vector<IndexType> connectivity(num_parts, 0);
+
+    for (int pass = 0; pass < 8; pass++)
+    {
+        #pragma omp parallel
+        {
+            // edge weight from a vertex to every part
+            std::vector<IndexType> weights(num_parts, 0);
+
+            #pragma omp for
+            for (int i = 0; i < int(N); i++)
+            {
+                const IndexType p = parts[i];
+
+                IndexType best = p;
+                IndexType best_gain = 0;
+
+                for (IndexType jj = G.edges.row_offsets[i]; jj < G.edges.row_offsets[i + 1]; jj++)
+                    weights[parts[G.edges.column_indices[jj]]] += G.edges.values[jj];
+
+                for (IndexType jj = G.edges.row_offsets[i]; jj < G.edges.row_offsets[i + 1]; jj++)
+                {
+                    const IndexType q = parts[G.edges.column_indices[jj]];
+
+                    if (q != p && weights[q] - weights[p] > best_gain)
+                    {
+                        best = q;
+                        best_gain = weights[q] - weights[p];
+                    }
+                }
+
+                for (IndexType jj = G.edges.row_offsets[i]; jj < G.edges.row_offsets[i + 1]; jj++)
+                    weights[parts[G.edges.column_indices[jj]]] = 0;
+
+                destination[i] = best;
+            }
+        }
+
+        IndexType num_moves = 0;
+
+        for (IndexType i = 0; i < N; i++)
+        {
+            const IndexType p = parts[i];
+            const IndexType q = destination[i];
+
+            if (q == p || part_weights[q] + G.weights[i] > max_part_weight)
+                continue;
+
+            // earlier moves may have changed the gain
+            for (IndexType jj = G.edges.row_offsets[i]; jj < G.edges.row_offsets[i + 1]; jj++)
+                connectivity[parts[G.edges.column_indices[jj]]] += G.edges.values[jj];
+
+            const IndexType gain = connectivity[q] - connectivity[p];
+
+            for (IndexType jj = G.edges.row_offsets[i]; jj < G.edges.row_offsets[i + 1]; jj++)
+                connectivity[parts[G.edges.column_indices[jj]]] = 0;
+
+            if (gain <= 0)
+                continue;
+
+            parts[i] = q;
+            part_weights[p] -= G.weights[i];
+            part_weights[q] += G.weights[i];
+            num_moves++;
+        }
+
+        if (num_moves == 0)
+            break;
+    }
+}
+
+template <typename IndexType, typename ArrayType>
+void multilevel_kway(const weighted_graph<IndexType>& G,
+                     const IndexType num_parts,
+                           ArrayType& parts)
+{
+    const IndexType N = G.num_vertices();
+
+    typename weighted_graph<IndexType>::array_type vertices(N);
+
+    for (IndexType i = 0; i < N; i++)
+        vertices[i] = i;
+
+    parts.resize(N);
+
+    recursive_bisection(G, vertices, num_parts, IndexType(0), parts);
+
+    if (num_parts > 2)
+        refine_kway(G, num_parts, parts);
+}
+
+// Appends the nested dissection order of G to order. The vertices of G
+// are the vertices[i] of the original graph. Every level bisects the
+// graph, takes the boundary of the side with fewer boundary vertices as
+// vertex separator and numbers it after both halves.
+template <typename IndexType, typename ArrayType1, typename ArrayType2>
+void nested_dissection_order(const weighted_graph<IndexType>& G,
+                             const ArrayType1& vertices,
+                             const IndexType leaf_size,
+                                   ArrayType2& order)
+{
+    typedef typename weighted_graph<IndexType>::array_type Array;
+
+    const IndexType N = G.num_vertices();
+
+    if (N <= leaf_size || G.edges.num_entries == 0)
+    {
+        for (IndexType i = 0; i < N; i++)
+            order.push_back(vertices[i]);
+
+        return;
+    }
+
+    const IndexType target0 = G.total_weight() / 2;
+
+    Array bisection;
+    multilevel_bisection(G, target0, bisection_tolerance(G, target0, 1), bisection);
+
+    // boundary vertices of either side
+    std::vector<char> boundary(N, false);
+    IndexType num_boundary[2] = {0, 0};
+
+    for (IndexType i = 0; i < N; i++)
+    {
+        for (IndexType jj = G.edges.row_offsets[i]; jj < G.edges.row_offsets[i + 1]; jj++)
+        {
+            if (bisection[G.edges.column_indices[jj]] != bisection[i])
+            {
+                boundary[i] = true;
+                num_boundary[bisection[i]]++;
+                break;
+            }
+        }
+    }
+
+    const IndexType separator_side = num_boundary[0] <= num_boundary[1] ? 0 : 1;
+
+    Array local[2];
+    Array separator;
+
+    for (IndexType i = 0; i < N; i++)
+    {
+        if (boundary[i] && bisection[i] == separator_side)
+            separator.push_back(i);
+        else
+            local[bisection[i]].push_back(i);
+    }
+
+    // the bisection failed to split the graph
+    if (IndexType(local[0].size()) == N || IndexType(local[1].size()) == N)
+    {
+        for (IndexType i = 0; i < N; i++)
+            order.push_back(vertices[i]);
+
+        return;
+    }
+
+    for (int side = 0; side < 2; side++)
+    {
+        weighted_graph<IndexType> S;
+        induced_subgraph(G, local[side], S);
+
+        Array global(local[side].size());
+
+        for (size_t i = 0; i < local[side].size(); i++)
+            global[i] = vertices[local[side][i]];
+
+        nested_dissection_order(S, global, leaf_size, order);
+    }
+
+    for (size_t i = 0; i < separator.size(); i++)
+        order.push_back(vertices[separator[i]]);
+}
+
+} // end namespace detail
+} // end namespace graph
+} // end namespace cusp
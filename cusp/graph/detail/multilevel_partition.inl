@@ -0,0 +1,63 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <cusp/detail/config.h>
+#include <thrust/system/detail/generic/select_system.h>
+
+#include <cusp/exception.h>
+#include <cusp/graph/multilevel_partition.h>
+
+#include <cusp/system/detail/adl/graph/multilevel_partition.h>
+#include <cusp/system/detail/generic/graph/multilevel_partition.h>
+
+namespace cusp
+{
+namespace graph
+{
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+void multilevel_partition(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                          const size_t num_parts,
+                          ArrayType& parts)
+{
+    using cusp::system::detail::generic::multilevel_partition;
+
+    multilevel_partition(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G, num_parts, parts);
+}
+
+template<typename MatrixType,
+         typename ArrayType>
+void multilevel_partition(const MatrixType& G,
+                          const size_t num_parts,
+                          ArrayType& parts)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename MatrixType::memory_space System1;
+    typedef typename ArrayType::memory_space  System2;
+
+    System1 system1;
+    System2 system2;
+
+    cusp::graph::multilevel_partition(select_system(system1,system2), G, num_parts, parts);
+}
+
+} // end namespace graph
+} // end namespace cusp
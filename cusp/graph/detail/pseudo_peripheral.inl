@@ -30,16 +30,17 @@ template <typename DerivedPolicy,
 typename MatrixType::index_type
 pseudo_peripheral_vertex(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
                          const MatrixType& G,
-                         ArrayType& levels)
+                         ArrayType& levels,
+                         const unsigned int seed)
 {
     using cusp::system::detail::generic::pseudo_peripheral_vertex;
 
-    return pseudo_peripheral_vertex(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G, levels);
+    return pseudo_peripheral_vertex(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), G, levels, seed);
 }
 
 template<typename MatrixType, typename ArrayType>
 typename MatrixType::index_type
-pseudo_peripheral_vertex(const MatrixType& G, ArrayType& levels)
+pseudo_peripheral_vertex(const MatrixType& G, ArrayType& levels, const unsigned int seed)
 {
     using thrust::system::detail::generic::select_system;
 
@@ -49,7 +50,7 @@ pseudo_peripheral_vertex(const MatrixType& G, ArrayType& levels)
     System1 system1;
     System2 system2;
 
-    return cusp::graph::pseudo_peripheral_vertex(select_system(system1,system2), G, levels);
+    return cusp::graph::pseudo_peripheral_vertex(select_system(system1,system2), G, levels, seed);
 }
 
 template<typename DerivedPolicy,
@@ -0,0 +1,229 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file distance2_coloring.h
+ *  \brief Distance-2 colorings of graphs and sparse matrix compression
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/execution_policy.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace graph
+{
+/*! \addtogroup algorithms Algorithms
+ *  \addtogroup graph_algorithms Graph Algorithms
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t distance2_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                                ArrayType& colors);
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t partial_distance2_coloring(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                                  const MatrixType& A,
+                                        ArrayType& colors);
+/*! \endcond */
+
+/**
+ * \brief Performs a distance-2 vertex coloring of a graph.
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of colors array
+ *
+ * \param G A symmetric matrix that represents the graph
+ * \param colors Contains the color associated with each vertex
+ * computed during the coloring routine
+ *
+ * \return The number of colors
+ *
+ * \par Overview
+ * Vertices joined by a path of at most two edges receive different
+ * colors. If G is the symmetric pattern of a Jacobian, the columns of
+ * every color are structurally orthogonal and the Jacobian can be
+ * estimated with one function evaluation per color.
+ *
+ * The coloring is computed on the host by speculative greedy coloring:
+ * blocks of vertices are colored in parallel, conflicts between blocks
+ * are detected afterwards and the vertices with the larger index are
+ * recolored until no conflicts remain. \p colors is resized to the number
+ * of vertices.
+ *
+ * \see \p vertex_coloring
+ * \see \p partial_distance2_coloring
+ *
+ * \par Example
+ * \code
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/print.h>
+ * #include <cusp/gallery/grid.h>
+ *
+ * //include distance-2 coloring header file
+ * #include <cusp/graph/distance2_coloring.h>
+ *
+ * int main()
+ * {
+ *    // Build a 2D grid on the device
+ *    cusp::csr_matrix<int,float,cusp::device_memory> G;
+ *    cusp::gallery::grid2d(G, 4, 4);
+ *
+ *    cusp::array1d<int,cusp::device_memory> colors(G.num_rows);
+ *
+ *    // Execute distance-2 coloring
+ *    size_t num_colors = cusp::graph::distance2_coloring(G, colors);
+ *
+ *    // Print the vertex colors
+ *    cusp::print(colors);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template <typename MatrixType,
+          typename ArrayType>
+size_t distance2_coloring(const MatrixType& G,
+                                ArrayType& colors);
+
+/**
+ * \brief Colors the columns of a matrix such that no two columns of the
+ * same color have an entry in the same row.
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of colors array
+ *
+ * \param A A matrix, usually the sparsity pattern of a Jacobian
+ * \param colors Contains the color associated with each column
+ * computed during the coloring routine
+ *
+ * \return The number of colors
+ *
+ * \par Overview
+ * This is a partial distance-2 coloring of the columns in the bipartite
+ * row/column graph of A, which need not be square or symmetric. The
+ * number of colors is at least the largest number of entries in a row
+ * and usually close to it. The coloring is computed on the host with the
+ * same speculative scheme as \p distance2_coloring. \p colors is resized
+ * to the number of columns.
+ *
+ * Together with \p coloring_seed_matrix and \p recover_colored_matrix this
+ * estimates a sparse Jacobian J by finite differences with one function
+ * evaluation per color instead of one per column.
+ *
+ * \par Example
+ * \code
+ * #include <cusp/array2d.h>
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/multiply.h>
+ * #include <cusp/gallery/poisson.h>
+ *
+ * #include <cusp/graph/distance2_coloring.h>
+ *
+ * int main()
+ * {
+ *    // sparsity pattern and values of the Jacobian
+ *    cusp::csr_matrix<int,float,cusp::host_memory> J;
+ *    cusp::gallery::poisson5pt(J, 10, 10);
+ *
+ *    cusp::array1d<int,cusp::host_memory> colors;
+ *    size_t num_colors = cusp::graph::partial_distance2_coloring(J, colors);
+ *
+ *    // B = J * S, in practice one finite difference per column of S
+ *    cusp::array2d<float,cusp::host_memory,cusp::column_major> S, B(J.num_rows, num_colors);
+ *    cusp::graph::coloring_seed_matrix(colors, num_colors, S);
+ *
+ *    for (size_t c = 0; c < num_colors; c++)
+ *    {
+ *        cusp::array2d<float,cusp::host_memory,cusp::column_major>::column_view Bc = B.column(c);
+ *        cusp::multiply(J, S.column(c), Bc);
+ *    }
+ *
+ *    // recover the entries of J from B
+ *    cusp::csr_matrix<int,float,cusp::host_memory> J2;
+ *    cusp::graph::recover_colored_matrix(J, colors, B, J2);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template <typename MatrixType,
+          typename ArrayType>
+size_t partial_distance2_coloring(const MatrixType& A,
+                                        ArrayType& colors);
+
+/**
+ * \brief Builds the seed matrix of a column coloring.
+ *
+ * \tparam ArrayType Type of colors array
+ * \tparam Array2dType Type of seed matrix
+ *
+ * \param colors Color of every column
+ * \param num_colors Number of colors
+ * \param S Seed matrix with <tt>colors.size()</tt> rows and
+ * \p num_colors columns, S(j,c) is one if column j has color c and zero
+ * otherwise
+ */
+template <typename ArrayType,
+          typename Array2dType>
+void coloring_seed_matrix(const ArrayType& colors,
+                          const size_t num_colors,
+                                Array2dType& S);
+
+/**
+ * \brief Recovers a sparse matrix from its compressed form.
+ *
+ * \tparam MatrixType1 Type of sparsity pattern
+ * \tparam ArrayType Type of colors array
+ * \tparam Array2dType Type of compressed matrix
+ * \tparam MatrixType2 Type of recovered matrix
+ *
+ * \param pattern Sparsity pattern of the matrix, the values are ignored
+ * \param colors Column coloring of \p pattern computed by
+ * \p partial_distance2_coloring, or by \p distance2_coloring for a
+ * symmetric pattern
+ * \param B Compressed matrix, the product of the matrix with the seed
+ * matrix of \p colors
+ * \param J Matrix with the pattern of \p pattern and the values
+ * <tt>J(i,j) = B(i,colors[j])</tt>
+ */
+template <typename MatrixType1,
+          typename ArrayType,
+          typename Array2dType,
+          typename MatrixType2>
+void recover_colored_matrix(const MatrixType1& pattern,
+                            const ArrayType& colors,
+                            const Array2dType& B,
+                                  MatrixType2& J);
+/*! \}
+ */
+
+} // end namespace graph
+} // end namespace cusp
+
+#include <cusp/graph/detail/distance2_coloring.inl>
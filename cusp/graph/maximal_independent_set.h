@@ -43,6 +43,15 @@ size_t maximal_independent_set(const thrust::detail::execution_policy_base<Deriv
                                const MatrixType& G,
                                      ArrayType& stencil,
                                const size_t k = 1);
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t maximal_independent_set(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                               const MatrixType& G,
+                                     ArrayType& stencil,
+                               const size_t k,
+                                     size_t& num_rounds);
 /*! \endcond */
 
 /**
@@ -70,6 +79,12 @@ size_t maximal_independent_set(const thrust::detail::execution_policy_base<Deriv
  * <tt>stencil[i]</tt> is 1 if vertex \p i is a member of the MIS(k) and
  * 0 otherwise.
  *
+ * On the OpenMP and TBB backends the set is computed in parallel rounds
+ * in the manner of Luby's algorithm: the priorities of the vertices are a
+ * hash of their index, so the result is the same for any number of
+ * threads. The other host backends select vertices greedily in a single
+ * sequential pass.
+ *
  *
  * \see http://en.wikipedia.org/wiki/Maximal_independent_set
  *
@@ -110,6 +125,32 @@ template <typename MatrixType,
 size_t maximal_independent_set(const MatrixType& G,
                                      ArrayType& stencil,
                                const size_t k = 1);
+
+/**
+ * \brief Compute maximal independent set of a graph and report the number
+ * of rounds
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of components array
+ *
+ * \param G symmetric matrix that represents a graph
+ * \param stencil array to hold the MIS(k)
+ * \param k radius of independence
+ * \param num_rounds number of selection rounds used to compute the set
+ *
+ * \return The number of MIS vertices computed for G.
+ *
+ * \par Overview
+ *
+ * Same as the function above. The number of rounds is 1 for the
+ * sequential greedy selection and 0 for <tt>k = 0</tt>.
+ */
+template <typename MatrixType,
+          typename ArrayType>
+size_t maximal_independent_set(const MatrixType& G,
+                                     ArrayType& stencil,
+                               const size_t k,
+                                     size_t& num_rounds);
 /*! \}
  */
 
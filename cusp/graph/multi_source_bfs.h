@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file multi_source_bfs.h
+ *  \brief Breadth-first traversals from many sources at once
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/execution_policy.h>
+
+namespace cusp
+{
+namespace graph
+{
+/*! \addtogroup algorithms Algorithms
+ *  \addtogroup graph_algorithms Graph Algorithms
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3>
+void multi_source_bfs(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType1& sources,
+                            ArrayType2& eccentricities,
+                            ArrayType3& farthest);
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType1,
+          typename ArrayType2>
+void multi_source_bfs(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType1& sources,
+                            ArrayType2& eccentricities);
+
+template <typename MatrixType,
+          typename ArrayType1,
+          typename ArrayType2>
+void multi_source_bfs(const MatrixType& G,
+                      const ArrayType1& sources,
+                            ArrayType2& eccentricities);
+/*! \endcond */
+
+/**
+ * \brief Computes the eccentricities of many source vertices with
+ * breadth-first traversals that share each sweep over the graph.
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType1 Type of sources array
+ * \tparam ArrayType2 Type of eccentricities array
+ * \tparam ArrayType3 Type of farthest array
+ *
+ * \param G A symmetric matrix that represents the graph
+ * \param sources The source vertices
+ * \param eccentricities On return the largest distance from every source
+ * to a vertex of its connected component
+ * \param farthest On return a vertex at that distance from every source,
+ * the one of smallest degree and then smallest index
+ *
+ * \par Overview
+ * Up to 64 traversals are advanced together. Every vertex keeps a 64-bit
+ * mask of the sources that reached it, so one sweep over the adjacency
+ * structure per level serves all of them. Longer source lists are
+ * processed in batches of 64. The results do not depend on the system
+ * the traversal is executed on.
+ *
+ * \see \p breadth_first_search
+ * \see \p pseudo_peripheral_vertex
+ *
+ * \par Example
+ *
+ * \code
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/print.h>
+ * #include <cusp/gallery/grid.h>
+ *
+ * //include multi-source bfs header file
+ * #include <cusp/graph/multi_source_bfs.h>
+ *
+ * int main()
+ * {
+ *    // Build a 2D grid on the device
+ *    cusp::csr_matrix<int,float,cusp::device_memory> G;
+ *    cusp::gallery::grid2d(G, 4, 4);
+ *
+ *    // traverse from the four corners of the grid
+ *    cusp::array1d<int,cusp::device_memory> sources(4);
+ *    sources[0] = 0; sources[1] = 3; sources[2] = 12; sources[3] = 15;
+ *
+ *    cusp::array1d<int,cusp::device_memory> eccentricities(4);
+ *    cusp::array1d<int,cusp::device_memory> farthest(4);
+ *
+ *    cusp::graph::multi_source_bfs(G, sources, eccentricities, farthest);
+ *
+ *    // every corner is at distance 6 from the opposite corner
+ *    cusp::print(eccentricities);
+ *    cusp::print(farthest);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template <typename MatrixType,
+          typename ArrayType1,
+          typename ArrayType2,
+          typename ArrayType3>
+void multi_source_bfs(const MatrixType& G,
+                      const ArrayType1& sources,
+                            ArrayType2& eccentricities,
+                            ArrayType3& farthest);
+/*! \}
+ */
+
+} // end namespace graph
+} // end namespace cusp
+
+#include <cusp/graph/detail/multi_source_bfs.inl>
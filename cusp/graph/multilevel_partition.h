@@ -0,0 +1,117 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file multilevel_partition.h
+ *  \brief Multilevel k-way partitioning of a graph
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/execution_policy.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace graph
+{
+/*! \addtogroup algorithms Algorithms
+ *  \addtogroup graph_algorithms Graph Algorithms
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/*! \cond */
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+void multilevel_partition(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                          const size_t num_parts,
+                                ArrayType& parts);
+/*! \endcond */
+
+/**
+ * \brief Partition a graph with a multilevel scheme
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam ArrayType Type of output partition indicator array, parts
+ *
+ * \param G A matrix that represents the graph
+ * \param num_parts Number of partitions to construct
+ * \param parts Partition assigned to each vertex
+ *
+ * \par Overview
+ * Splits the vertices of the graph into \p num_parts parts of nearly equal
+ * size with few edges between different parts. Unlike \p hilbert_curve no
+ * coordinates are needed. The graph is that of the pattern of G + G^T
+ * without the diagonal.
+ *
+ * The parts are computed by recursive bisection. Every bisection coarsens
+ * the graph by heavy-edge matching, where the coarse graph is the Galerkin
+ * product P^T G P of the matching, bisects the coarsest graph by greedy
+ * graph growing and refines the bisection with Fiduccia-Mattheyses passes
+ * while it is projected back to the original graph. A final pass of greedy
+ * k-way refinement evaluates the moves of all vertices in parallel. The
+ * parts are balanced to within a few percent and the result is
+ * deterministic. The computation runs on the host.
+ *
+ * \see http://en.wikipedia.org/wiki/Graph_partition
+ * \see \p nested_dissection
+ *
+ * \par Example
+ * \code
+ * #include <cusp/array1d.h>
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/print.h>
+ * #include <cusp/gallery/poisson.h>
+ *
+ * //include multilevel partition header file
+ * #include <cusp/graph/multilevel_partition.h>
+ *
+ * int main()
+ * {
+ *    // Build a 2D Poisson matrix on the device
+ *    cusp::csr_matrix<int,float,cusp::device_memory> G;
+ *    cusp::gallery::poisson5pt(G, 8, 8);
+ *
+ *    // Array that indicates partition each vertex belongs
+ *    cusp::array1d<int,cusp::device_memory> parts(G.num_rows);
+ *
+ *    // Partition the graph into 4 parts
+ *    cusp::graph::multilevel_partition(G, 4, parts);
+ *
+ *    // Print the per vertex membership
+ *    cusp::print(parts);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template <typename MatrixType,
+          typename ArrayType>
+void multilevel_partition(const MatrixType& G,
+                          const size_t num_parts,
+                                ArrayType& parts);
+/*! \}
+ */
+
+} // end namespace graph
+} // end namespace cusp
+
+#include <cusp/graph/detail/multilevel_partition.inl>
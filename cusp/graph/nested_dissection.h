@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file nested_dissection.h
+ *  \brief Nested dissection ordering of a sparse matrix
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/execution_policy.h>
+
+namespace cusp
+{
+namespace graph
+{
+
+/*! \addtogroup algorithms Algorithms
+ *  \addtogroup graph_algorithms Graph Algorithms
+ *  \ingroup algorithms
+ *  \{
+ */
+
+/* \cond */
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename PermutationType>
+void nested_dissection(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                             PermutationType& P);
+/* \endcond */
+
+/**
+ * \brief Compute a nested dissection ordering
+ *
+ * \tparam MatrixType Type of input matrix
+ * \tparam PermutationType Type of permutation matrix
+ *
+ * \param G A matrix that represents the graph
+ * \param P The permutation matrix that is generated by the ordering
+ *
+ * \par Overview
+ *
+ * Computes a fill-reducing ordering of the graph of the pattern of
+ * G + G^T. The graph is bisected with the multilevel scheme of
+ * \p multilevel_partition, the boundary vertices of the side with fewer
+ * boundary vertices form a vertex separator, and the separator is numbered
+ * after the two halves, which are ordered recursively. Subgraphs of at
+ * most 64 vertices keep their original order. The computation runs on the
+ * host.
+ *
+ * \see http://en.wikipedia.org/wiki/Nested_dissection
+ * \see \p symmetric_rcm
+ *
+ * \par Example
+ *
+ * \code
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/permutation_matrix.h>
+ * #include <cusp/print.h>
+ * #include <cusp/gallery/poisson.h>
+ *
+ * //include nested dissection header file
+ * #include <cusp/graph/nested_dissection.h>
+ *
+ * int main()
+ * {
+ *    // Build a 2D Poisson matrix on the device
+ *    cusp::csr_matrix<int,float,cusp::device_memory> G;
+ *    cusp::gallery::poisson5pt(G, 32, 32);
+ *
+ *    // Allocate permutation matrix P
+ *    cusp::permutation_matrix<int,cusp::device_memory> P(G.num_rows);
+ *
+ *    // Construct nested dissection permutation matrix on the device
+ *    cusp::graph::nested_dissection(G, P);
+ *
+ *    // Print the permutation
+ *    cusp::print(P.permutation);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template<typename MatrixType,
+         typename PermutationType>
+void nested_dissection(const MatrixType& G,
+                             PermutationType& P);
+/*! \}
+ */
+
+} // end namespace graph
+} // end namespace cusp
+
+#include <cusp/graph/detail/nested_dissection.inl>
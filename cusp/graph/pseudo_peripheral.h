@@ -50,7 +50,8 @@ template <typename DerivedPolicy,
 typename MatrixType::index_type
 pseudo_peripheral_vertex(const thrust::detail::execution_policy_base<DerivedPolicy>& exec,
                          const MatrixType& G,
-                               ArrayType& levels);
+                               ArrayType& levels,
+                         const unsigned int seed = 0);
 /*! \endcond */
 
 /**
@@ -62,6 +63,7 @@ pseudo_peripheral_vertex(const thrust::detail::execution_policy_base<DerivedPoli
  * \param G A symmetric matrix that represents the graph
  * \param levels Array containing the level set of all vertices from the
  * computed pseudo-peripheral vertex.
+ * \param seed Seed of the generator that draws the starting vertices
  *
  * \return The computed pseudo-peripheral vertex
  *
@@ -70,7 +72,15 @@ pseudo_peripheral_vertex(const thrust::detail::execution_policy_base<DerivedPoli
  * is the vertex which achieves the diameter of the graph, i.e. achieves the
  * maximum separation distance.
  *
+ * The search starts from the vertex of smallest degree and up to 63
+ * vertices drawn with \p seed. Every refinement step advances the
+ * traversals from all current candidates together with
+ * \p multi_source_bfs and continues from the farthest vertices of the
+ * most eccentric candidates until the eccentricity stops growing. The
+ * result only depends on \p G and \p seed.
+ *
  * \see http://en.wikipedia.org/wiki/Distance_(graph_theory)
+ * \see \p multi_source_bfs
  *
  * \par Example
  *
@@ -110,7 +120,8 @@ template<typename MatrixType,
          typename ArrayType>
 typename MatrixType::index_type
 pseudo_peripheral_vertex(const MatrixType& G,
-                               ArrayType& levels);
+                               ArrayType& levels,
+                         const unsigned int seed = 0);
 
 /*! \}
  */
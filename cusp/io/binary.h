@@ -44,6 +44,10 @@ namespace io
  * \param filename file name of the binary file
  *
  * \par Overview
+ * Reads files written by \p write_binary_file and
+ * \p write_compressed_binary_file. Compressed files are decoded in
+ * parallel, directly into the storage of a host \p csr_matrix.
+ *
  * \note any contents of \p mtx will be overwritten
  *
  * \par Example
@@ -173,6 +177,71 @@ void write_binary_file(const Matrix& mtx, const std::string& filename);
 template <typename Matrix, typename Stream>
 void write_binary_stream(const Matrix& mtx, Stream& output);
 
+/**
+ * \brief Write a compressed binary file
+ *
+ * \tparam Matrix matrix container
+ *
+ * \param mtx a sparse matrix container (e.g. \p csr_matrix or \p coo_matrix)
+ * \param filename file name of the binary file
+ * \param compress_values compress the values losslessly
+ *
+ * \par Overview
+ * Stores the matrix in CSR form, split into chunks of rows that are
+ * encoded and decoded independently in parallel. Row lengths are stored
+ * as variable length integers and the column indices of every row as
+ * bit-packed differences. With \p compress_values the bytes of the
+ * values are regrouped by significance and compressed with a built-in LZ
+ * codec, chunks whose values do not compress are stored raw. The file is
+ * read by \p read_binary_file.
+ *
+ * \note the values are stored in the byte order of the host and the file
+ * must be read into a matrix with the same value type.
+ *
+ * \par Example
+ * \code
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/gallery/poisson.h>
+ * #include <cusp/io/binary.h>
+ *
+ * int main(void)
+ * {
+ *     cusp::csr_matrix<int, float, cusp::host_memory> A;
+ *     cusp::gallery::poisson5pt(A, 100, 100);
+ *
+ *     // save A into a compressed binary file
+ *     cusp::io::write_compressed_binary_file(A, "A.bin");
+ *
+ *     // load it back
+ *     cusp::csr_matrix<int, float, cusp::host_memory> B;
+ *     cusp::io::read_binary_file(B, "A.bin");
+ *
+ *     return 0;
+ * }
+ * \endcode
+ *
+ * \see \p read_binary_file
+ * \see \p write_binary_file
+ */
+template <typename Matrix>
+void write_compressed_binary_file(const Matrix& mtx, const std::string& filename, const bool compress_values = true);
+
+/**
+ * \brief Write compressed binary data to a stream.
+ *
+ * \tparam Matrix matrix container
+ * \tparam Stream stream type
+ *
+ * \param mtx a sparse matrix container (e.g. \p csr_matrix or \p coo_matrix)
+ * \param output stream to which the binary contents will be written
+ * \param compress_values compress the values losslessly
+ *
+ * \see write_compressed_binary_file
+ * \see read_binary_stream
+ */
+template <typename Matrix, typename Stream>
+void write_compressed_binary_stream(const Matrix& mtx, Stream& output, const bool compress_values = true);
+
 /*! \}
  */
 
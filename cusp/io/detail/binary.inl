@@ -18,11 +18,15 @@
 #pragma once
 
 #include <cusp/array2d.h>
+#include <cusp/complex.h>
 #include <cusp/coo_matrix.h>
 #include <cusp/convert.h>
+#include <cusp/csr_matrix.h>
 #include <cusp/exception.h>
 #include <cusp/io/matrix_market.h>
 
+#include <cusp/io/detail/compression.h>
+
 #include <thrust/sort.h>
 #include <thrust/tuple.h>
 
@@ -32,6 +36,8 @@
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <cstring>
+#include <limits>
 
 namespace cusp
 {
@@ -40,17 +46,285 @@ namespace io
 namespace detail
 {
 
+// The compressed binary format starts with this magic string, which the
+// leading num_rows field of the raw format cannot realistically match.
+//
+// It is followed by little endian 64 bit fields: the format version,
+// num_rows, num_cols, num_entries, the kind and size of the values and
+// the number of chunks, and for every chunk its number of rows, entries
+// and bytes. The chunks follow in order. A chunk holds the row lengths as
+// varints, then for every nonempty row a bit width and the bit-packed,
+// zigzag-encoded differences between consecutive column indices, starting
+// from the row index, and finally a byte selecting whether the values are
+// stored raw or byte-shuffled and LZ compressed.
+static const char compressed_binary_magic[8] = {'C', 'U', 'S', 'P', 'C', 'S', 'R', 'Z'};
+static const unsigned long long compressed_binary_version = 1;
+
+// rows and entries after which a chunk is closed
+static const size_t compressed_binary_chunk_rows    = 65536;
+static const size_t compressed_binary_chunk_entries = 65536;
+
+// 0 for integers, 1 for real and 2 for complex values
+template <typename ValueType>
+unsigned long long compressed_binary_value_kind(void)
+{
+    if (thrust::detail::is_same<ValueType, cusp::complex<typename cusp::norm_type<ValueType>::type> >::value)
+        return 2;
+    else if (std::numeric_limits<ValueType>::is_integer)
+        return 0;
+    else
+        return 1;
+}
+
+template <typename IndexType, typename ValueType>
+void encode_compressed_chunk(const cusp::csr_matrix<IndexType,ValueType,cusp::host_memory>& csr,
+                             const size_t row_begin, const size_t row_end,
+                             const bool compress_values,
+                             byte_vector& output)
+{
+    for (size_t i = row_begin; i < row_end; i++)
+        put_varint(output, csr.row_offsets[i + 1] - csr.row_offsets[i]);
+
+    for (size_t i = row_begin; i < row_end; i++)
+    {
+        if (csr.row_offsets[i] == csr.row_offsets[i + 1])
+            continue;
+
+        unsigned long long max_delta = 0;
+        long long previous = i;
+
+        for (IndexType jj = csr.row_offsets[i]; jj < csr.row_offsets[i + 1]; jj++)
+        {
+            max_delta = std::max(max_delta, zigzag_encode((long long)(csr.column_indices[jj]) - previous));
+            previous = csr.column_indices[jj];
+        }
+
+        const int width = bit_width(max_delta);
+
+        output.push_back((unsigned char)(width));
+
+        bit_writer bits(output);
+        previous = i;
+
+        for (IndexType jj = csr.row_offsets[i]; jj < csr.row_offsets[i + 1]; jj++)
+        {
+            bits.put(zigzag_encode((long long)(csr.column_indices[jj]) - previous), width);
+            previous = csr.column_indices[jj];
+        }
+
+        bits.flush();
+    }
+
+    const size_t num_entries = csr.row_offsets[row_end] - csr.row_offsets[row_begin];
+    const size_t num_bytes   = num_entries * sizeof(ValueType);
+
+    const unsigned char* values = num_entries > 0 ?
+                                  reinterpret_cast<const unsigned char*>(&csr.values[csr.row_offsets[row_begin]]) : NULL;
+
+    if (compress_values && num_entries > 0)
+    {
+        byte_vector shuffled(num_bytes);
+        byte_shuffle(values, num_entries, sizeof(ValueType), &shuffled[0]);
+
+        byte_vector compressed;
+        lz_compress(&shuffled[0], num_bytes, compressed);
+
+        // keep incompressible values raw
+        if (compressed.size() < num_bytes)
+        {
+            output.push_back(1);
+            output.insert(output.end(), compressed.begin(), compressed.end());
+            return;
+        }
+    }
+
+    output.push_back(0);
+    output.insert(output.end(), values, values + num_bytes);
+}
+
+template <typename IndexType, typename ValueType>
+void decode_compressed_chunk(cusp::csr_matrix<IndexType,ValueType,cusp::host_memory>& csr,
+                             const size_t row_begin, const size_t row_end,
+                             const size_t entry_begin, const size_t entry_end,
+                             byte_cursor input)
+{
+    size_t offset = entry_begin;
+
+    for (size_t i = row_begin; i < row_end; i++)
+    {
+        csr.row_offsets[i] = offset;
+        offset += get_varint(input);
+
+        if (offset > entry_end)
+            throw cusp::io_exception("invalid row lengths in compressed binary data");
+    }
+
+    if (offset != entry_end)
+        throw cusp::io_exception("invalid row lengths in compressed binary data");
+
+    for (size_t i = row_begin; i < row_end; i++)
+    {
+        const size_t jj_begin = csr.row_offsets[i];
+        const size_t jj_end   = i + 1 < row_end ? size_t(csr.row_offsets[i + 1]) : entry_end;
+
+        if (jj_begin == jj_end)
+            continue;
+
+        const int width = *input.take(1);
+
+        if (width > 64)
+            throw cusp::io_exception("invalid column indices in compressed binary data");
+
+        bit_reader bits(input);
+        long long previous = i;
+
+        for (size_t jj = jj_begin; jj < jj_end; jj++)
+        {
+            const long long column = previous + zigzag_decode(bits.get(width));
+
+            if (column < 0 || (unsigned long long)(column) >= csr.num_cols)
+                throw cusp::io_exception("invalid column indices in compressed binary data");
+
+            csr.column_indices[jj] = column;
+            previous = column;
+        }
+
+        bits.align();
+    }
+
+    const size_t num_entries = entry_end - entry_begin;
+    const size_t num_bytes   = num_entries * sizeof(ValueType);
+
+    const unsigned char mode = *input.take(1);
+
+    if (num_entries == 0)
+        return;
+
+    unsigned char* values = reinterpret_cast<unsigned char*>(&csr.values[entry_begin]);
+
+    if (mode == 0)
+    {
+        std::memcpy(values, input.take(num_bytes), num_bytes);
+    }
+    else if (mode == 1)
+    {
+        byte_vector shuffled(num_bytes);
+        lz_decompress(input, &shuffled[0], num_bytes);
+        byte_unshuffle(&shuffled[0], num_entries, sizeof(ValueType), values);
+    }
+    else
+    {
+        throw cusp::io_exception("invalid value encoding in compressed binary data");
+    }
+}
+
+// reads the compressed format following its magic string
 template <typename IndexType, typename ValueType, typename Stream>
-void read_binary_stream(cusp::coo_matrix<IndexType,ValueType,cusp::host_memory>& coo, Stream& input)
+void read_compressed_binary_stream(cusp::csr_matrix<IndexType,ValueType,cusp::host_memory>& csr, Stream& input)
 {
-    size_t num_rows, num_cols, num_entries;
+    const size_t header_size = 7 * 8;
+
+    byte_vector header(header_size);
+    input.read(reinterpret_cast<char *>(&header[0]), header_size);
+
+    if (!input)
+        throw cusp::io_exception("unexpected end of compressed binary data");
+
+    byte_cursor fields(&header[0], &header[0] + header_size);
+
+    const unsigned long long version     = get_uint64(fields);
+    const unsigned long long num_rows    = get_uint64(fields);
+    const unsigned long long num_cols    = get_uint64(fields);
+    const unsigned long long num_entries = get_uint64(fields);
+    const unsigned long long value_kind  = get_uint64(fields);
+    const unsigned long long value_size  = get_uint64(fields);
+    const unsigned long long num_chunks  = get_uint64(fields);
+
+    if (version != compressed_binary_version)
+        throw cusp::io_exception("unsupported compressed binary format version");
+
+    if (value_kind != compressed_binary_value_kind<ValueType>() || value_size != sizeof(ValueType))
+        throw cusp::io_exception("value type of the compressed binary data does not match the matrix");
+
+    if (num_chunks > num_rows)
+        throw cusp::io_exception("invalid compressed binary header");
+
+    byte_vector directory(num_chunks * 3 * 8);
+
+    if (num_chunks > 0)
+        input.read(reinterpret_cast<char *>(&directory[0]), directory.size());
+
+    if (!input)
+        throw cusp::io_exception("unexpected end of compressed binary data");
+
+    // first row, entry and byte of every chunk
+    std::vector<size_t> row_begin(num_chunks + 1, 0);
+    std::vector<size_t> entry_begin(num_chunks + 1, 0);
+    std::vector<size_t> byte_begin(num_chunks + 1, 0);
+
+    if (num_chunks > 0)
+    {
+        byte_cursor chunk_fields(&directory[0], &directory[0] + directory.size());
+
+        for (size_t c = 0; c < num_chunks; c++)
+        {
+            row_begin[c + 1]   = row_begin[c]   + get_uint64(chunk_fields);
+            entry_begin[c + 1] = entry_begin[c] + get_uint64(chunk_fields);
+            byte_begin[c + 1]  = byte_begin[c]  + get_uint64(chunk_fields);
+        }
+    }
+
+    if (row_begin[num_chunks] != num_rows || entry_begin[num_chunks] != num_entries)
+        throw cusp::io_exception("invalid compressed binary header");
+
+    // read all chunks at once
+    byte_vector chunks(byte_begin[num_chunks]);
+
+    if (!chunks.empty())
+        input.read(reinterpret_cast<char *>(&chunks[0]), chunks.size());
+
+    if (!input)
+        throw cusp::io_exception("unexpected end of compressed binary data");
+
+    csr.resize(num_rows, num_cols, num_entries);
+    csr.row_offsets[num_rows] = num_entries;
+
+    // decode the chunks in parallel, exceptions must not leave the loop
+    std::vector<char> failed(num_chunks, 0);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int c = 0; c < int(num_chunks); c++)
+    {
+        try
+        {
+            decode_compressed_chunk(csr, row_begin[c], row_begin[c + 1], entry_begin[c], entry_begin[c + 1],
+                                    byte_cursor(&chunks[0] + byte_begin[c], &chunks[0] + byte_begin[c + 1]));
+        }
+        catch (const cusp::io_exception&)
+        {
+            failed[c] = 1;
+        }
+    }
+
+    if (std::find(failed.begin(), failed.end(), 1) != failed.end())
+        throw cusp::io_exception("invalid compressed binary data");
+}
+
+// reads the raw format following the first 8 bytes of its header
+template <typename IndexType, typename ValueType, typename Stream>
+void read_raw_binary_stream(cusp::coo_matrix<IndexType,ValueType,cusp::host_memory>& coo, Stream& input, const char* leading_bytes)
+{
+    size_t header[3];
+    std::memcpy(header, leading_bytes, 8);
+    input.read(reinterpret_cast<char *>(header) + 8, sizeof(header) - 8);
+
+    size_t num_rows    = header[0];
+    size_t num_cols    = header[1];
+    size_t num_entries = header[2];
+
     IndexType ientry;
     ValueType ventry;
 
-    input.read(reinterpret_cast<char *>(&num_rows), sizeof(size_t));
-    input.read(reinterpret_cast<char *>(&num_cols), sizeof(size_t));
-    input.read(reinterpret_cast<char *>(&num_entries), sizeof(size_t));
-
     coo.resize(num_rows, num_cols, num_entries);
 
     size_t index = 0;
@@ -78,6 +352,27 @@ void read_binary_stream(cusp::coo_matrix<IndexType,ValueType,cusp::host_memory>&
     coo.sort_by_row_and_column();
 }
 
+template <typename IndexType, typename ValueType, typename Stream>
+void read_binary_stream(cusp::csr_matrix<IndexType,ValueType,cusp::host_memory>& csr, Stream& input, cusp::csr_format)
+{
+    char leading_bytes[8];
+    input.read(leading_bytes, 8);
+
+    if (std::equal(leading_bytes, leading_bytes + 8, compressed_binary_magic))
+    {
+        // decode straight into csr
+        read_compressed_binary_stream(csr, input);
+    }
+    else
+    {
+        cusp::coo_matrix<IndexType,ValueType,cusp::host_memory> temp;
+
+        read_raw_binary_stream(temp, input, leading_bytes);
+
+        cusp::convert(temp, csr);
+    }
+}
+
 template <typename Matrix, typename Stream, typename Format>
 void read_binary_stream(Matrix& mtx, Stream& input, Format)
 {
@@ -85,11 +380,25 @@ void read_binary_stream(Matrix& mtx, Stream& input, Format)
     typedef typename Matrix::index_type IndexType;
     typedef typename Matrix::value_type ValueType;
 
-    cusp::coo_matrix<IndexType,ValueType,cusp::host_memory> temp;
+    char leading_bytes[8];
+    input.read(leading_bytes, 8);
 
-    read_binary_stream(temp, input);
+    if (std::equal(leading_bytes, leading_bytes + 8, compressed_binary_magic))
+    {
+        cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> temp;
+
+        read_compressed_binary_stream(temp, input);
+
+        cusp::convert(temp, mtx);
+    }
+    else
+    {
+        cusp::coo_matrix<IndexType,ValueType,cusp::host_memory> temp;
 
-    cusp::convert(temp, mtx);
+        read_raw_binary_stream(temp, input, leading_bytes);
+
+        cusp::convert(temp, mtx);
+    }
 }
 
 template <typename IndexType, typename ValueType, typename Stream>
@@ -116,6 +425,71 @@ void write_binary_stream(const Matrix& mtx, Stream& output, cusp::sparse_format)
     cusp::io::detail::write_binary_stream(coo, output);
 }
 
+template <typename IndexType, typename ValueType, typename Stream>
+void write_compressed_binary_stream(const cusp::csr_matrix<IndexType,ValueType,cusp::host_memory>& csr,
+                                    Stream& output,
+                                    const bool compress_values,
+                                    cusp::csr_format)
+{
+    // split the rows into chunks
+    std::vector<size_t> row_begin(1, 0);
+
+    for (size_t i = 0; i < csr.num_rows; i++)
+    {
+        const size_t first = row_begin.back();
+
+        if (i > first && (i - first >= compressed_binary_chunk_rows ||
+                          size_t(csr.row_offsets[i] - csr.row_offsets[first]) >= compressed_binary_chunk_entries))
+            row_begin.push_back(i);
+    }
+
+    if (csr.num_rows > 0)
+        row_begin.push_back(csr.num_rows);
+
+    const size_t num_chunks = row_begin.size() - 1;
+
+    // encode the chunks in parallel
+    std::vector<byte_vector> chunks(num_chunks);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int c = 0; c < int(num_chunks); c++)
+        encode_compressed_chunk(csr, row_begin[c], row_begin[c + 1], compress_values, chunks[c]);
+
+    byte_vector header(compressed_binary_magic, compressed_binary_magic + 8);
+
+    put_uint64(header, compressed_binary_version);
+    put_uint64(header, csr.num_rows);
+    put_uint64(header, csr.num_cols);
+    put_uint64(header, csr.num_entries);
+    put_uint64(header, compressed_binary_value_kind<ValueType>());
+    put_uint64(header, sizeof(ValueType));
+    put_uint64(header, num_chunks);
+
+    for (size_t c = 0; c < num_chunks; c++)
+    {
+        put_uint64(header, row_begin[c + 1] - row_begin[c]);
+        put_uint64(header, csr.row_offsets[row_begin[c + 1]] - csr.row_offsets[row_begin[c]]);
+        put_uint64(header, chunks[c].size());
+    }
+
+    output.write(reinterpret_cast<const char *>(&header[0]), header.size());
+
+    for (size_t c = 0; c < num_chunks; c++)
+        output.write(reinterpret_cast<const char *>(&chunks[c][0]), chunks[c].size());
+}
+
+template <typename Matrix, typename Stream>
+void write_compressed_binary_stream(const Matrix& mtx, Stream& output, const bool compress_values, cusp::sparse_format)
+{
+    // general sparse case
+    typedef typename Matrix::index_type IndexType;
+    typedef typename Matrix::value_type ValueType;
+
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> csr(mtx);
+
+    cusp::io::detail::write_compressed_binary_stream(csr, output, compress_values, cusp::csr_format());
+}
+
 } // end namespace detail
 
 
@@ -173,6 +547,32 @@ void write_binary_stream(const Matrix& mtx, Stream& output)
     cusp::io::detail::write_binary_stream(mtx, output, typename Matrix::format());
 }
 
+template <typename Matrix>
+void write_compressed_binary_file(const Matrix& mtx, const std::string& filename, const bool compress_values)
+{
+    std::ofstream file(filename.c_str(), std::ios::binary);
+
+    if (!file)
+        throw cusp::io_exception(std::string("unable to open file \"") + filename + std::string("\" for writing"));
+
+#ifdef __APPLE__
+    // WAR OSX-specific issue using rdbuf
+    std::stringstream file_string (std::stringstream::in | std::stringstream::out | std::ios::binary);
+
+    cusp::io::write_compressed_binary_stream(mtx, file_string, compress_values);
+
+    file.rdbuf()->sputn(file_string.str().c_str(), file_string.str().size());
+#else
+    cusp::io::write_compressed_binary_stream(mtx, file, compress_values);
+#endif
+}
+
+template <typename Matrix, typename Stream>
+void write_compressed_binary_stream(const Matrix& mtx, Stream& output, const bool compress_values)
+{
+    cusp::io::detail::write_compressed_binary_stream(mtx, output, compress_values, typename Matrix::format());
+}
+
 } //end namespace io
 } //end namespace cusp
 
@@ -0,0 +1,373 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/exception.h>
+
+#include <cstring>
+#include <vector>
+
+namespace cusp
+{
+namespace io
+{
+namespace detail
+{
+
+// Encoding helpers of the compressed binary format. Encoders append to a
+// byte vector and decoders read through a cursor that is checked against
+// the end of the input, so corrupt files raise an io_exception instead of
+// reading out of bounds.
+
+typedef std::vector<unsigned char> byte_vector;
+
+struct byte_cursor
+{
+    const unsigned char* pos;
+    const unsigned char* end;
+
+    byte_cursor(const unsigned char* begin, const unsigned char* end)
+        : pos(begin), end(end) {}
+
+    const unsigned char* take(const size_t n)
+    {
+        if (size_t(end - pos) < n)
+            throw cusp::io_exception("unexpected end of compressed binary data");
+
+        const unsigned char* result = pos;
+        pos += n;
+
+        return result;
+    }
+};
+
+// fixed width little endian
+inline void put_uint64(byte_vector& output, const unsigned long long value)
+{
+    for (int k = 0; k < 8; k++)
+        output.push_back((unsigned char)(value >> (8 * k)));
+}
+
+inline unsigned long long get_uint64(byte_cursor& input)
+{
+    const unsigned char* bytes = input.take(8);
+
+    unsigned long long value = 0;
+
+    for (int k = 0; k < 8; k++)
+        value |= (unsigned long long)(bytes[k]) << (8 * k);
+
+    return value;
+}
+
+// unsigned LEB128
+inline void put_varint(byte_vector& output, unsigned long long value)
+{
+    while (value >= 0x80)
+    {
+        output.push_back((unsigned char)(value | 0x80));
+        value >>= 7;
+    }
+
+    output.push_back((unsigned char)(value));
+}
+
+inline unsigned long long get_varint(byte_cursor& input)
+{
+    unsigned long long value = 0;
+
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        const unsigned char byte = *input.take(1);
+
+        value |= (unsigned long long)(byte & 0x7f) << shift;
+
+        if (byte < 0x80)
+            return value;
+    }
+
+    throw cusp::io_exception("invalid integer in compressed binary data");
+}
+
+// maps signed differences to unsigned integers with small magnitudes first
+inline unsigned long long zigzag_encode(const long long value)
+{
+    return ((unsigned long long)(value) << 1) ^ (unsigned long long)(value >> 63);
+}
+
+inline long long zigzag_decode(const unsigned long long value)
+{
+    return (long long)(value >> 1) ^ -(long long)(value & 1);
+}
+
+// number of bits of the largest value
+inline int bit_width(unsigned long long value)
+{
+    int width = 0;
+
+    while (value > 0)
+    {
+        width++;
+        value >>= 1;
+    }
+
+    return width;
+}
+
+// packs values of a fixed bit width, least significant bits first
+struct bit_writer
+{
+    byte_vector& output;
+    unsigned long long buffer;
+    int num_bits;
+
+    bit_writer(byte_vector& output)
+        : output(output), buffer(0), num_bits(0) {}
+
+    void put(unsigned long long value, int width)
+    {
+        if (width > 32)
+        {
+            put(value & 0xffffffffull, 32);
+            value >>= 32;
+            width -= 32;
+        }
+
+        buffer |= value << num_bits;
+        num_bits += width;
+
+        while (num_bits >= 8)
+        {
+            output.push_back((unsigned char)(buffer));
+            buffer >>= 8;
+            num_bits -= 8;
+        }
+    }
+
+    // pads the last byte with zeros
+    void flush(void)
+    {
+        if (num_bits > 0)
+            output.push_back((unsigned char)(buffer));
+
+        buffer = 0;
+        num_bits = 0;
+    }
+};
+
+struct bit_reader
+{
+    byte_cursor& input;
+    unsigned long long buffer;
+    int num_bits;
+
+    bit_reader(byte_cursor& input)
+        : input(input), buffer(0), num_bits(0) {}
+
+    unsigned long long get(const int width)
+    {
+        if (width > 32)
+        {
+            const unsigned long long low = get(32);
+            return low | (get(width - 32) << 32);
+        }
+
+        while (num_bits < width)
+        {
+            buffer |= (unsigned long long)(*input.take(1)) << num_bits;
+            num_bits += 8;
+        }
+
+        const unsigned long long value = buffer & ((1ull << width) - 1);
+
+        buffer >>= width;
+        num_bits -= width;
+
+        return value;
+    }
+
+    // drops the padding of the last byte
+    void align(void)
+    {
+        buffer = 0;
+        num_bits = 0;
+    }
+};
+
+// Groups byte k of every element together. The bytes holding the sign and
+// exponent of floating point values repeat far more often than the
+// mantissa bytes, which the LZ codec below exploits.
+inline void byte_shuffle(const unsigned char* input, const size_t num_elements, const size_t element_size,
+                         unsigned char* output)
+{
+    for (size_t k = 0; k < element_size; k++)
+        for (size_t i = 0; i < num_elements; i++)
+            output[k * num_elements + i] = input[i * element_size + k];
+}
+
+inline void byte_unshuffle(const unsigned char* input, const size_t num_elements, const size_t element_size,
+                           unsigned char* output)
+{
+    for (size_t k = 0; k < element_size; k++)
+        for (size_t i = 0; i < num_elements; i++)
+            output[i * element_size + k] = input[k * num_elements + i];
+}
+
+// Byte oriented LZ77 codec in the spirit of LZ4. The input is a sequence
+// of tokens, each a run of literals followed by a back reference of at
+// least 4 bytes into the last 64KB of output. The high and low nibbles of
+// the token hold the literal length and the match length minus 4, where
+// 15 is continued by bytes of 255 and a final byte below 255. The last
+// token has literals only.
+
+inline void lz_put_length(byte_vector& output, size_t length)
+{
+    while (length >= 255)
+    {
+        output.push_back(255);
+        length -= 255;
+    }
+
+    output.push_back((unsigned char)(length));
+}
+
+inline void lz_put_sequence(byte_vector& output,
+                            const unsigned char* literals, const size_t num_literals,
+                            const size_t offset, const size_t match_length)
+{
+    const size_t extra = match_length > 0 ? match_length - 4 : 0;
+
+    output.push_back((unsigned char)(((num_literals < 15 ? num_literals : 15) << 4) | (extra < 15 ? extra : 15)));
+
+    if (num_literals >= 15)
+        lz_put_length(output, num_literals - 15);
+
+    output.insert(output.end(), literals, literals + num_literals);
+
+    if (match_length > 0)
+    {
+        output.push_back((unsigned char)(offset));
+        output.push_back((unsigned char)(offset >> 8));
+
+        if (extra >= 15)
+            lz_put_length(output, extra - 15);
+    }
+}
+
+inline unsigned int lz_read32(const unsigned char* ptr)
+{
+    unsigned int value;
+    std::memcpy(&value, ptr, 4);
+    return value;
+}
+
+inline void lz_compress(const unsigned char* input, const size_t size, byte_vector& output)
+{
+    // most recent position of every hashed 4 byte sequence, plus one
+    const int hash_bits = 14;
+    std::vector<size_t> table(size_t(1) << hash_bits, 0);
+
+    size_t anchor = 0;
+    size_t i = 0;
+
+    while (i + 4 <= size)
+    {
+        const unsigned int sequence = lz_read32(input + i);
+        const unsigned int hash = (sequence * 2654435761u) >> (32 - hash_bits);
+
+        const size_t candidate = table[hash];
+        table[hash] = i + 1;
+
+        if (candidate > 0 && i - (candidate - 1) <= 65535 && lz_read32(input + candidate - 1) == sequence)
+        {
+            const size_t match = candidate - 1;
+
+            size_t length = 4;
+            while (i + length < size && input[match + length] == input[i + length])
+                length++;
+
+            lz_put_sequence(output, input + anchor, i - anchor, i - match, length);
+
+            i += length;
+            anchor = i;
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    lz_put_sequence(output, input + anchor, size - anchor, 0, 0);
+}
+
+inline size_t lz_get_length(byte_cursor& input, size_t length)
+{
+    if (length == 15)
+    {
+        unsigned char byte;
+
+        do
+        {
+            byte = *input.take(1);
+            length += byte;
+        }
+        while (byte == 255);
+    }
+
+    return length;
+}
+
+// decodes exactly size bytes into output
+inline void lz_decompress(byte_cursor input, unsigned char* output, const size_t size)
+{
+    size_t n = 0;
+
+    while (true)
+    {
+        const unsigned char token = *input.take(1);
+
+        const size_t num_literals = lz_get_length(input, token >> 4);
+
+        if (size - n < num_literals)
+            throw cusp::io_exception("invalid compressed binary data");
+
+        std::memcpy(output + n, input.take(num_literals), num_literals);
+        n += num_literals;
+
+        if (input.pos == input.end)
+            break;
+
+        const unsigned char* offset_bytes = input.take(2);
+        const size_t offset = offset_bytes[0] | (size_t(offset_bytes[1]) << 8);
+        const size_t length = lz_get_length(input, token & 15) + 4;
+
+        if (offset == 0 || offset > n || size - n < length)
+            throw cusp::io_exception("invalid compressed binary data");
+
+        // copy bytewise, the match may overlap the output
+        for (size_t k = 0; k < length; k++, n++)
+            output[n] = output[n - offset];
+    }
+
+    if (n != size)
+        throw cusp::io_exception("invalid compressed binary data");
+}
+
+} // end namespace detail
+} // end namespace io
+} // end namespace cusp
@@ -23,6 +23,8 @@
 #include <cusp/exception.h>
 #include <cusp/io/matrix_market.h>
 
+#include <cusp/io/detail/text_format.h>
+
 #include <thrust/sort.h>
 #include <thrust/tuple.h>
 
@@ -152,24 +154,50 @@ read_dimacs_stream(Matrix& mtx, Stream& input, Format)
     return ret;
 }
 
+// Formats edge n of a coordinate matrix as one line
+template <typename MatrixType>
+struct dimacs_line_formatter
+{
+    const MatrixType& coo;
+
+    dimacs_line_formatter(const MatrixType& coo)
+        : coo(coo) {}
+
+    void operator()(std::string& buffer, const size_t n) const
+    {
+        int val = coo.values[n];
+
+        buffer += "a ";
+        append_integer(buffer, coo.row_indices[n] + 1);
+        buffer += ' ';
+        append_integer(buffer, coo.column_indices[n] + 1);
+        buffer += ' ';
+        append_integer(buffer, val);
+        buffer += '\n';
+    }
+};
+
 template <typename IndexType, typename ValueType, typename Stream>
 void write_dimacs_stream(const cusp::coo_matrix<IndexType,ValueType,cusp::host_memory>& coo,
                          const thrust::tuple<IndexType,IndexType>& t,
                          Stream& output)
 {
-    output << "p max " << coo.num_rows << " " << coo.num_entries << std::endl;
-    output << "n " << (thrust::get<0>(t) + 1) << " s" << std::endl;
-    output << "n " << (thrust::get<1>(t) + 1) << " t" << std::endl;
+    typedef cusp::coo_matrix<IndexType,ValueType,cusp::host_memory> MatrixType;
 
-    for(size_t i = 0; i < coo.num_entries; i++)
-    {
-        output << "a ";
-        output << (coo.row_indices[i]    + 1) << " ";
-        output << (coo.column_indices[i] + 1) << " ";
+    std::string header("p max ");
 
-        int val = coo.values[i];
-        output << val << std::endl;
-    }
+    append_integer(header, coo.num_rows);
+    header += ' ';
+    append_integer(header, coo.num_entries);
+    header += "\nn ";
+    append_integer(header, thrust::get<0>(t) + 1);
+    header += " s\nn ";
+    append_integer(header, thrust::get<1>(t) + 1);
+    header += " t\n";
+
+    output.write(header.data(), header.size());
+
+    write_lines(output, coo.num_entries, dimacs_line_formatter<MatrixType>(coo));
 }
 
 template <typename Matrix, typename Stream>
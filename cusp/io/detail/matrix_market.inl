@@ -23,6 +23,8 @@
 #include <cusp/convert.h>
 #include <cusp/exception.h>
 
+#include <cusp/io/detail/text_format.h>
+
 #include <thrust/sort.h>
 
 #include <vector>
@@ -111,17 +113,46 @@ void assign_complex(cusp::complex<ScalarType>& value, double real, double imag)
     value.imag(imag);
 }
 
-template <typename Stream, typename ScalarType>
-void write_value(Stream& output, const ScalarType& value)
+// Formats entry n of a coordinate matrix as one line
+template <typename MatrixType>
+struct coordinate_line_formatter
 {
-    output << value;
-}
+    const MatrixType& coo;
+
+    // entries written, or NULL to write every entry
+    const size_t* entries;
 
-template <typename Stream, typename ScalarType>
-void write_value(Stream& output, const cusp::complex<ScalarType>& value)
+    coordinate_line_formatter(const MatrixType& coo, const size_t* entries)
+        : coo(coo), entries(entries) {}
+
+    void operator()(std::string& buffer, const size_t line) const
+    {
+        const size_t n = entries ? entries[line] : line;
+
+        append_integer(buffer, coo.row_indices[n] + 1);
+        buffer += ' ';
+        append_integer(buffer, coo.column_indices[n] + 1);
+        buffer += ' ';
+        append_value(buffer, coo.values[n]);
+        buffer += '\n';
+    }
+};
+
+// Formats entry i of an array as one line
+template <typename ArrayType>
+struct array_line_formatter
 {
-    output << value.real() << " " << value.imag();
-}
+    const ArrayType& values;
+
+    array_line_formatter(const ArrayType& values)
+        : values(values) {}
+
+    void operator()(std::string& buffer, const size_t line) const
+    {
+        append_value(buffer, values[line]);
+        buffer += '\n';
+    }
+};
 
 template<typename Stream>
 thrust::tuple<size_t,size_t,size_t>
@@ -420,25 +451,47 @@ void read_array_stream(cusp::array2d<ValueType,cusp::host_memory>& mtx, Stream&
 
 
 
-template <typename IndexType, typename ValueType, typename Stream>
-void write_coordinate_stream(const cusp::coo_matrix<IndexType,ValueType,cusp::host_memory>& coo, Stream& output)
+template <typename ValueType>
+std::string matrix_market_banner_line(const std::string& storage, const bool symmetric)
 {
     bool is_complex = thrust::detail::is_same<ValueType, cusp::complex<typename cusp::norm_type<ValueType>::type> >::value;
 
-    if (is_complex)
-        output << "%%MatrixMarket matrix coordinate complex general\n";
-    else
-        output << "%%MatrixMarket matrix coordinate real general\n";
+    return std::string("%%MatrixMarket matrix ") + storage + (is_complex ? " complex" : " real")
+           + (symmetric ? " symmetric\n" : " general\n");
+}
 
-    output << "\t" << coo.num_rows << "\t" << coo.num_cols << "\t" << coo.num_entries << "\n";
+template <typename IndexType, typename ValueType, typename Stream>
+void write_coordinate_stream(const cusp::coo_matrix<IndexType,ValueType,cusp::host_memory>& coo, Stream& output, const bool symmetric = false)
+{
+    typedef cusp::coo_matrix<IndexType,ValueType,cusp::host_memory> MatrixType;
 
-    for(size_t i = 0; i < coo.num_entries; i++)
-    {
-        output << (coo.row_indices[i]    + 1) << " ";
-        output << (coo.column_indices[i] + 1) << " ";
-        cusp::io::detail::write_value(output, coo.values[i]);
-        output << "\n";
-    }
+    if (symmetric && coo.num_rows != coo.num_cols)
+        throw cusp::invalid_input_exception("symmetric MatrixMarket output requires a square matrix");
+
+    // symmetric output keeps the entries on and below the diagonal
+    std::vector<size_t> entries;
+
+    if (symmetric)
+        for (size_t n = 0; n < coo.num_entries; n++)
+            if (coo.row_indices[n] >= coo.column_indices[n])
+                entries.push_back(n);
+
+    const size_t num_entries = symmetric ? entries.size() : coo.num_entries;
+
+    std::string header = matrix_market_banner_line<ValueType>("coordinate", symmetric);
+
+    header += '\t';
+    append_integer(header, coo.num_rows);
+    header += '\t';
+    append_integer(header, coo.num_cols);
+    header += '\t';
+    append_integer(header, num_entries);
+    header += '\n';
+
+    output.write(header.data(), header.size());
+
+    write_lines(output, num_entries,
+                coordinate_line_formatter<MatrixType>(coo, symmetric && num_entries > 0 ? &entries[0] : NULL));
 }
 
 
@@ -480,7 +533,7 @@ void read_matrix_market_stream(Matrix& mtx, Stream& input, cusp::array1d_format)
 }
 
 template <typename Matrix, typename Stream>
-void write_matrix_market_stream(const Matrix& mtx, Stream& output, cusp::sparse_format)
+void write_matrix_market_stream(const Matrix& mtx, Stream& output, const bool symmetric, cusp::sparse_format)
 {
     // general sparse case
     typedef typename Matrix::index_type IndexType;
@@ -488,52 +541,59 @@ void write_matrix_market_stream(const Matrix& mtx, Stream& output, cusp::sparse_
 
     cusp::coo_matrix<IndexType,ValueType,cusp::host_memory> coo(mtx);
 
-    cusp::io::detail::write_coordinate_stream(coo, output);
+    cusp::io::detail::write_coordinate_stream(coo, output, symmetric);
 }
 
 template <typename Matrix, typename Stream>
-void write_matrix_market_stream(const Matrix& mtx, Stream& output, cusp::array1d_format)
+void write_matrix_market_stream(const Matrix& mtx, Stream& output, const bool symmetric, cusp::array1d_format)
 {
     typedef typename Matrix::value_type ValueType;
+    typedef cusp::array1d<ValueType,cusp::host_memory> ArrayType;
 
-    bool is_complex = thrust::detail::is_same<ValueType, cusp::complex<typename cusp::norm_type<ValueType>::type> >::value;
+    if (symmetric)
+        throw cusp::not_implemented_exception("symmetric array MatrixMarket output is not supported");
 
-    if (is_complex)
-        output << "%%MatrixMarket matrix array complex general\n";
-    else
-        output << "%%MatrixMarket matrix array real general\n";
+    ArrayType values(mtx);
 
-    output << "\t" << mtx.size() << "\t1\n";
+    std::string header = matrix_market_banner_line<ValueType>("array", false);
 
-    for(size_t i = 0; i < mtx.size(); i++)
-    {
-        write_value(output, mtx[i]);
-        output << "\n";
-    }
+    header += '\t';
+    append_integer(header, values.size());
+    header += "\t1\n";
+
+    output.write(header.data(), header.size());
+
+    write_lines(output, values.size(), array_line_formatter<ArrayType>(values));
 }
 
 template <typename Matrix, typename Stream>
-void write_matrix_market_stream(const Matrix& mtx, Stream& output, cusp::array2d_format)
+void write_matrix_market_stream(const Matrix& mtx, Stream& output, const bool symmetric, cusp::array2d_format)
 {
     typedef typename Matrix::value_type ValueType;
+    typedef cusp::array1d<ValueType,cusp::host_memory> ArrayType;
 
-    bool is_complex = thrust::detail::is_same<ValueType, cusp::complex<typename cusp::norm_type<ValueType>::type> >::value;
+    if (symmetric)
+        throw cusp::not_implemented_exception("symmetric array MatrixMarket output is not supported");
 
-    if (is_complex)
-        output << "%%MatrixMarket matrix array complex general\n";
-    else
-        output << "%%MatrixMarket matrix array real general\n";
+    // entries in column-major order
+    cusp::array2d<ValueType,cusp::host_memory,cusp::column_major> dense(mtx);
+    ArrayType values(dense.num_entries);
 
-    output << "\t" << mtx.num_rows << "\t" << mtx.num_cols << "\n";
+    for (size_t j = 0; j < dense.num_cols; j++)
+        for (size_t i = 0; i < dense.num_rows; i++)
+            values[j * dense.num_rows + i] = dense(i,j);
 
-    for(size_t j = 0; j < mtx.num_cols; j++)
-    {
-        for(size_t i = 0; i < mtx.num_rows; i++)
-        {
-            write_value(output, mtx(i,j));
-            output << "\n";
-        }
-    }
+    std::string header = matrix_market_banner_line<ValueType>("array", false);
+
+    header += '\t';
+    append_integer(header, dense.num_rows);
+    header += '\t';
+    append_integer(header, dense.num_cols);
+    header += '\n';
+
+    output.write(header.data(), header.size());
+
+    write_lines(output, values.size(), array_line_formatter<ArrayType>(values));
 }
 
 } // end namespace detail
@@ -568,7 +628,7 @@ void read_matrix_market_stream(Matrix& mtx, Stream& input)
 }
 
 template <typename Matrix>
-void write_matrix_market_file(const Matrix& mtx, const std::string& filename)
+void write_matrix_market_file(const Matrix& mtx, const std::string& filename, const bool symmetric)
 {
     std::ofstream file(filename.c_str());
 
@@ -579,18 +639,18 @@ void write_matrix_market_file(const Matrix& mtx, const std::string& filename)
     // WAR OSX-specific issue using rdbuf
     std::stringstream file_string (std::stringstream::in | std::stringstream::out);
 
-    cusp::io::write_matrix_market_stream(mtx, file_string);
+    cusp::io::write_matrix_market_stream(mtx, file_string, symmetric);
 
     file.rdbuf()->sputn(file_string.str().c_str(), file_string.str().size());
 #else
-    cusp::io::write_matrix_market_stream(mtx, file);
+    cusp::io::write_matrix_market_stream(mtx, file, symmetric);
 #endif
 }
 
 template <typename Matrix, typename Stream>
-void write_matrix_market_stream(const Matrix& mtx, Stream& output)
+void write_matrix_market_stream(const Matrix& mtx, Stream& output, const bool symmetric)
 {
-    cusp::io::detail::write_matrix_market_stream(mtx, output, typename Matrix::format());
+    cusp::io::detail::write_matrix_market_stream(mtx, output, symmetric, typename Matrix::format());
 }
 
 } //end namespace io
@@ -0,0 +1,429 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/complex.h>
+
+#include <thrust/detail/type_traits.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+namespace cusp
+{
+namespace io
+{
+namespace detail
+{
+
+// Text formatting for the writers. Numbers are formatted without the
+// stream machinery, so the output does not depend on the global locale,
+// integers are converted directly and floating point values are written
+// with the shortest decimal string that reads back to the same value,
+// in the layout of std::to_chars. std::to_chars itself is used when the
+// standard library provides it.
+
+template <typename T>
+struct shortest_float_traits
+{
+    typedef double type;
+
+    // significant digits that always suffice to read back the value
+    static const int max_digits = 17;
+
+    static double parse(const char* str)
+    {
+        return std::strtod(str, NULL);
+    }
+};
+
+template <>
+struct shortest_float_traits<float>
+{
+    typedef float type;
+
+    static const int max_digits = 9;
+
+    static float parse(const char* str)
+    {
+        return std::strtof(str, NULL);
+    }
+};
+
+// Formats value into buffer and returns the number of characters written.
+// buffer must hold at least 24 characters.
+template <typename IntegerType>
+size_t format_integer(char* buffer, const IntegerType value)
+{
+    char digits[24];
+    int n = 0;
+
+    const bool negative = value < IntegerType(0);
+
+    unsigned long long magnitude = negative ? 0ull - (unsigned long long)(value) : (unsigned long long)(value);
+
+    do
+    {
+        digits[n++] = char('0' + magnitude % 10);
+        magnitude /= 10;
+    }
+    while (magnitude > 0);
+
+    char* p = buffer;
+
+    if (negative)
+        *p++ = '-';
+
+    while (n > 0)
+        *p++ = digits[--n];
+
+    return p - buffer;
+}
+
+inline unsigned long long power_of_ten(const int n)
+{
+    unsigned long long result = 1;
+
+    for (int i = 0; i < n; i++)
+        result *= 10;
+
+    return result;
+}
+
+// Splits the output [-]d.ddde[+-]xx of printf into the significant digits
+// and the decimal exponent, whatever the locale spells the point as
+inline void split_scientific(const char* str, unsigned long long& digits, int& num_digits, int& exponent)
+{
+    digits = 0;
+    num_digits = 0;
+
+    for (; *str != 'e'; str++)
+    {
+        if (*str >= '0' && *str <= '9')
+        {
+            digits = 10 * digits + (*str - '0');
+            num_digits++;
+        }
+    }
+
+    exponent = std::atoi(str + 1);
+}
+
+// Rounds x to num_digits significant digits. all_digits holds the
+// max_digits leading digits of x, which decide the rounding unless they end
+// in a tie, when x is formatted again to round its exact value.
+template <typename FloatType>
+void round_digits(const FloatType x,
+                  const unsigned long long all_digits, const int max_digits, const int all_exponent,
+                  const int num_digits, unsigned long long& digits, int& exponent)
+{
+    const unsigned long long scale = power_of_ten(max_digits - num_digits);
+
+    const unsigned long long remainder = all_digits % scale;
+
+    if (scale > 1 && 2 * remainder == scale)
+    {
+        char scientific[40];
+        int n;
+
+        std::sprintf(scientific, "%.*e", num_digits - 1, double(x));
+        split_scientific(scientific, digits, n, exponent);
+
+        return;
+    }
+
+    digits   = all_digits / scale;
+    exponent = all_exponent;
+
+    if (2 * remainder > scale && ++digits == power_of_ten(num_digits))
+    {
+        digits /= 10;
+        exponent++;
+    }
+}
+
+// Returns true if the decimal number digits * 10^(exponent - num_digits + 1)
+// reads back to x
+template <typename FloatType>
+bool reads_back(const FloatType x, const bool negative,
+                const unsigned long long digits, const int num_digits, const int exponent)
+{
+    char str[48];
+    char* p = str;
+
+    if (negative)
+        *p++ = '-';
+
+    p += format_integer(p, digits);
+    *p++ = 'e';
+    p += format_integer(p, exponent - (num_digits - 1));
+    *p = '\0';
+
+    return shortest_float_traits<FloatType>::parse(str) == x;
+}
+
+// Formats value into buffer and returns the number of characters written.
+// buffer must hold at least 32 characters.
+template <typename FloatType>
+size_t format_shortest(char* buffer, const FloatType value)
+{
+    typedef shortest_float_traits<FloatType> Traits;
+    typedef typename Traits::type ParseType;
+
+    const ParseType x = value;
+
+#if defined(__cpp_lib_to_chars)
+    return std::to_chars(buffer, buffer + 32, x).ptr - buffer;
+#else
+    // nan and inf are spelled as by printf
+    if (x != x || x - x != x - x)
+        return std::sprintf(buffer, "%g", double(x));
+
+    const bool negative = x < ParseType(0) || (x == ParseType(0) && ParseType(1) / x < ParseType(0));
+
+    const int max_digits = Traits::max_digits;
+
+    // leading digits, enough to read back x
+    char scientific[40];
+
+    unsigned long long all_digits;
+    int all_exponent;
+    int n;
+
+    std::sprintf(scientific, "%.*e", max_digits - 1, double(x));
+    split_scientific(scientific, all_digits, n, all_exponent);
+
+    // find the fewest significant digits that read back to x, rounding to
+    // the nearest reads back for every precision above the smallest one.
+    // Most values need all or all but one digit, so those are tried first.
+    unsigned long long digits;
+    int exponent;
+
+    int lo = 1;
+    int hi = max_digits;
+
+    int mid = max_digits - 1;
+
+    while (lo < hi)
+    {
+        round_digits(x, all_digits, max_digits, all_exponent, mid, digits, exponent);
+
+        if (reads_back(x, negative, digits, mid, exponent))
+        {
+            hi  = mid;
+            mid = hi == max_digits - 1 ? hi - 1 : (lo + hi) / 2;
+        }
+        else
+        {
+            lo  = mid + 1;
+            mid = (lo + hi) / 2;
+        }
+    }
+
+    int num_digits = lo;
+
+    round_digits(x, all_digits, max_digits, all_exponent, num_digits, digits, exponent);
+
+    // below a power of two the values round to x in half the distance
+    // they do above it, so one digit less may still read back when it is
+    // rounded up instead of to the nearest
+    if (num_digits > 1)
+    {
+        unsigned long long up;
+        int up_exponent;
+
+        round_digits(x, all_digits, max_digits, all_exponent, num_digits - 1, up, up_exponent);
+
+        if (++up == power_of_ten(num_digits - 1))
+        {
+            up /= 10;
+            up_exponent++;
+        }
+
+        if (reads_back(x, negative, up, num_digits - 1, up_exponent))
+        {
+            digits     = up;
+            num_digits = num_digits - 1;
+            exponent   = up_exponent;
+        }
+    }
+
+    while (num_digits > 1 && digits % 10 == 0)
+    {
+        digits /= 10;
+        num_digits--;
+    }
+
+    // fixed notation unless scientific notation is shorter
+    const int abs_exponent = exponent < 0 ? -exponent : exponent;
+    const int exponent_length = abs_exponent >= 100 ? 3 : 2;
+    const int scientific_length = num_digits + (num_digits > 1 ? 1 : 0) + 2 + exponent_length;
+
+    int fixed_length;
+
+    if (exponent < 0)
+        fixed_length = 1 - exponent + num_digits;
+    else if (num_digits <= exponent + 1)
+        fixed_length = exponent + 1;
+    else
+        fixed_length = num_digits + 1;
+
+    // integral values in fixed notation are written exactly
+    if (fixed_length <= scientific_length && num_digits <= exponent + 1)
+        return std::sprintf(buffer, "%.0f", double(x));
+
+    char str[24];
+
+    for (int i = num_digits - 1; i >= 0; i--)
+    {
+        str[i] = char('0' + digits % 10);
+        digits /= 10;
+    }
+
+    char* p = buffer;
+
+    if (negative)
+        *p++ = '-';
+
+    if (fixed_length <= scientific_length)
+    {
+        if (exponent < 0)
+        {
+            *p++ = '0';
+            *p++ = '.';
+
+            for (int i = 0; i < -exponent - 1; i++)
+                *p++ = '0';
+        }
+
+        for (int i = 0; i < num_digits; i++)
+        {
+            if (exponent >= 0 && i == exponent + 1)
+                *p++ = '.';
+
+            *p++ = str[i];
+        }
+    }
+    else
+    {
+        *p++ = str[0];
+
+        if (num_digits > 1)
+        {
+            *p++ = '.';
+
+            for (int i = 1; i < num_digits; i++)
+                *p++ = str[i];
+        }
+
+        *p++ = 'e';
+        *p++ = exponent < 0 ? '-' : '+';
+
+        if (abs_exponent >= 100)
+            *p++ = char('0' + abs_exponent / 100);
+
+        *p++ = char('0' + (abs_exponent / 10) % 10);
+        *p++ = char('0' + abs_exponent % 10);
+    }
+
+    return p - buffer;
+#endif
+}
+
+template <typename IntegerType>
+void append_integer(std::string& buffer, const IntegerType value)
+{
+    char str[24];
+    buffer.append(str, format_integer(str, value));
+}
+
+template <typename ScalarType>
+void append_value(std::string& buffer, const ScalarType value, thrust::detail::true_type)
+{
+    append_integer(buffer, value);
+}
+
+template <typename ScalarType>
+void append_value(std::string& buffer, const ScalarType value, thrust::detail::false_type)
+{
+    char str[40];
+    buffer.append(str, format_shortest(str, value));
+}
+
+template <typename ScalarType>
+void append_value(std::string& buffer, const ScalarType& value)
+{
+    append_value(buffer, value,
+                 thrust::detail::integral_constant<bool, std::numeric_limits<ScalarType>::is_integer>());
+}
+
+template <typename ScalarType>
+void append_value(std::string& buffer, const cusp::complex<ScalarType>& value)
+{
+    append_value(buffer, value.real());
+    buffer += ' ';
+    append_value(buffer, value.imag());
+}
+
+// Writes num_lines lines to output. format(buffer, i) appends line i to
+// buffer. Consecutive lines are formatted into separate buffers in
+// parallel and the buffers are written in order with one call each.
+template <typename Stream, typename LineFormatter>
+void write_lines(Stream& output, const size_t num_lines, const LineFormatter& format)
+{
+    // lines per buffer and buffers per parallel pass
+    const size_t chunk_size = 16384;
+    const size_t num_chunks = 64;
+
+    std::vector<std::string> buffers(num_chunks);
+
+    for (size_t base = 0; base < num_lines; base += chunk_size * num_chunks)
+    {
+        const int count = (std::min(num_lines - base, chunk_size * num_chunks) + chunk_size - 1) / chunk_size;
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int c = 0; c < count; c++)
+        {
+            std::string& buffer = buffers[c];
+            buffer.clear();
+
+            const size_t begin = base + c * chunk_size;
+            const size_t end   = std::min(num_lines, begin + chunk_size);
+
+            for (size_t i = begin; i < end; i++)
+                format(buffer, i);
+        }
+
+        for (int c = 0; c < count; c++)
+            output.write(buffers[c].data(), buffers[c].size());
+    }
+}
+
+} // end namespace detail
+} // end namespace io
+} // end namespace cusp
@@ -109,8 +109,15 @@ void read_matrix_market_stream(Matrix& mtx, Stream& input);
  *
  * \param mtx a matrix container (e.g. \p csr_matrix or \p coo_matrix)
  * \param filename file name of the MatrixMarket file
+ * \param symmetric write only the entries on and below the diagonal with
+ * a symmetric banner
  *
  * \par Overview
+ * Values are written with the fewest digits that read back exactly,
+ * independently of the locale. Sparse matrices are written in coordinate
+ * format, which supports \p symmetric for square matrices, the entries
+ * above the diagonal are then assumed to mirror those below it.
+ *
  * \note if the file already exists it will be overwritten
  *
  * \par Example
@@ -137,7 +144,7 @@ void read_matrix_market_stream(Matrix& mtx, Stream& input);
  * \see \p read_matrix_market_stream
  */
 template <typename Matrix>
-void write_matrix_market_file(const Matrix& mtx, const std::string& filename);
+void write_matrix_market_file(const Matrix& mtx, const std::string& filename, const bool symmetric = false);
 
 /**
  * \brief Write MatrixMarket data to a stream.
@@ -147,6 +154,12 @@ void write_matrix_market_file(const Matrix& mtx, const std::string& filename);
  *
  * \param mtx a matrix container (e.g. \p csr_matrix or \p coo_matrix)
  * \param output stream to which the MatrixMarket contents will be written
+ * \param symmetric write only the entries on and below the diagonal with
+ * a symmetric banner
+ *
+ * \par Overview
+ * The entries are formatted into buffers in parallel and the buffers are
+ * written to \p output in order.
  *
  * \par Example
  * \code
@@ -172,7 +185,7 @@ void write_matrix_market_file(const Matrix& mtx, const std::string& filename);
  * \see read_matrix_market_stream
  */
 template <typename Matrix, typename Stream>
-void write_matrix_market_stream(const Matrix& mtx, Stream& output);
+void write_matrix_market_stream(const Matrix& mtx, Stream& output, const bool symmetric = false);
 
 /*! \}
  */
@@ -0,0 +1,305 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file batched.h
+ *  \brief Batched Krylov methods for many small systems with a shared pattern
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/complex.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace krylov
+{
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup krylov_methods Krylov Methods
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/**
+ * \brief Per-system stopping criteria and convergence report of a batched solve
+ *
+ * \tparam ValueType Value type of the systems (e.g. \c float or \c double).
+ *
+ * \par Overview
+ * Every system \c s of the batch iterates until
+ * <tt>||b_s - A_s x_s|| <= absolute_tolerance + relative_tolerance * ||b_s||</tt>
+ * or until the iteration limit is reached, independently of the other
+ * systems. After the solve the monitor holds the number of iterations,
+ * the final residual norm and the convergence flag of every system.
+ *
+ * \see \p batched_cg, \p batched_bicgstab
+ */
+template <typename ValueType>
+class batched_monitor
+{
+public:
+    typedef typename cusp::norm_type<ValueType>::type Real;
+
+    /* \cond */
+    cusp::array1d<size_t, cusp::host_memory> iteration_counts;
+    cusp::array1d<Real, cusp::host_memory>   residual_norms;
+    cusp::array1d<bool, cusp::host_memory>   converged_flags;
+    /* \endcond */
+
+    /**
+     *  \brief Constructs a \p batched_monitor
+     *
+     *  \param iteration_limit maximum number of iterations of every system
+     *  \param relative_tolerance determines convergence criteria
+     *  \param absolute_tolerance determines convergence criteria
+     */
+    batched_monitor(const size_t iteration_limit = 500,
+                    const Real relative_tolerance = 1e-5,
+                    const Real absolute_tolerance = 0)
+        : iteration_limit_(iteration_limit),
+          relative_tolerance_(relative_tolerance),
+          absolute_tolerance_(absolute_tolerance) {}
+
+    /**
+     * \brief Returns the maximum number of iterations of every system
+     */
+    size_t iteration_limit(void) const
+    {
+        return iteration_limit_;
+    }
+
+    /**
+     * \brief Returns the relative tolerance
+     */
+    Real relative_tolerance(void) const
+    {
+        return relative_tolerance_;
+    }
+
+    /**
+     * \brief Returns the absolute tolerance
+     */
+    Real absolute_tolerance(void) const
+    {
+        return absolute_tolerance_;
+    }
+
+    /**
+     * \brief Returns the number of systems of the last solve
+     */
+    size_t num_systems(void) const
+    {
+        return converged_flags.size();
+    }
+
+    /**
+     * \brief Indicates whether system \p i satisfied the convergence tolerance
+     */
+    bool converged(const size_t i) const
+    {
+        return converged_flags[i];
+    }
+
+    /**
+     * \brief Returns the number of iterations of system \p i
+     */
+    size_t iteration_count(const size_t i) const
+    {
+        return iteration_counts[i];
+    }
+
+    /**
+     * \brief Euclidean norm of the last residual of system \p i
+     */
+    Real residual_norm(const size_t i) const
+    {
+        return residual_norms[i];
+    }
+
+    /**
+     * \brief Returns the number of converged systems
+     */
+    size_t num_converged(void) const;
+
+    /**
+     * \brief Prints the number of converged systems and the iteration counts.
+     */
+    void print(void) const;
+
+    /* \cond */
+    void reset(const size_t num_systems);
+    /* \endcond */
+
+private:
+
+    /*! \cond */
+    size_t iteration_limit_;
+    Real relative_tolerance_;
+    Real absolute_tolerance_;
+    /*! \endcond */
+};
+
+/**
+ * \brief Identity preconditioner of the batched solvers
+ */
+struct batched_identity {};
+
+/**
+ * \brief Jacobi (diagonal) preconditioner of the batched solvers
+ *
+ * Rows with a zero diagonal entry are not scaled.
+ */
+struct batched_jacobi {};
+
+/* \cond */
+
+template <typename BatchedMatrix,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitor>
+void batched_cg(const BatchedMatrix& A,
+                      Array2d1& X,
+                const Array2d2& B,
+                      Monitor& monitor);
+
+template <typename BatchedMatrix,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitor>
+void batched_bicgstab(const BatchedMatrix& A,
+                            Array2d1& X,
+                      const Array2d2& B,
+                            Monitor& monitor);
+
+/* \endcond */
+
+/**
+ * \brief Batched Conjugate Gradient method
+ *
+ * \tparam BatchedMatrix is a \p batched_csr_matrix
+ * \tparam Array2d1 row-major \p array2d
+ * \tparam Array2d2 row-major \p array2d
+ * \tparam Monitor is a \p batched_monitor
+ * \tparam Preconditioner is \p batched_identity or \p batched_jacobi
+ *
+ * \param A matrices of the linear systems
+ * \param X approximate solutions, column \c s is the solution of system \c s
+ * \param B right-hand sides, column \c s is the right-hand side of system \c s
+ * \param monitor stopping criteria and per-system convergence report
+ * \param M preconditioner
+ *
+ * \par Overview
+ * Solves the symmetric, positive-definite systems <tt>A_s x_s = b_s</tt>
+ * of all matrices of the batch with the preconditioned CG method. The
+ * systems are processed in groups of consecutive systems whose values
+ * and vectors are interleaved, so that every operation of the method
+ * runs over the systems of a group in the innermost loop and vectorizes.
+ * Groups are distributed over OpenMP threads and every thread allocates
+ * its workspace once for all of its groups. Systems that converge stop
+ * updating while the rest of their group continues.
+ *
+ * The solver runs on the host. Batches stored in another memory space
+ * are copied to the host and the solutions are copied back.
+ *
+ * \par Example
+ *
+ *  \code
+ *  #include <cusp/batched_csr_matrix.h>
+ *  #include <cusp/krylov/batched.h>
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main(void)
+ *  {
+ *      cusp::csr_matrix<int, float, cusp::host_memory> A;
+ *      cusp::gallery::poisson5pt(A, 10, 10);
+ *
+ *      // 1000 systems with the pattern of A
+ *      cusp::batched_csr_matrix<int, float, cusp::host_memory> batch(A, 1000);
+ *
+ *      // ... set the values of every system with batch.set_values
+ *
+ *      cusp::array2d<float, cusp::host_memory> X(A.num_rows, 1000, 0);
+ *      cusp::array2d<float, cusp::host_memory> B(A.num_rows, 1000, 1);
+ *
+ *      cusp::krylov::batched_monitor<float> monitor(100, 1e-6);
+ *
+ *      cusp::krylov::batched_cg(batch, X, B, monitor, cusp::krylov::batched_jacobi());
+ *
+ *      monitor.print();
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ *
+ *  \see \p batched_csr_matrix
+ *  \see \p batched_monitor
+ */
+template <typename BatchedMatrix,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitor,
+          typename Preconditioner>
+void batched_cg(const BatchedMatrix& A,
+                      Array2d1& X,
+                const Array2d2& B,
+                      Monitor& monitor,
+                const Preconditioner& M);
+
+/**
+ * \brief Batched Biconjugate Gradient Stabilized method
+ *
+ * \tparam BatchedMatrix is a \p batched_csr_matrix
+ * \tparam Array2d1 row-major \p array2d
+ * \tparam Array2d2 row-major \p array2d
+ * \tparam Monitor is a \p batched_monitor
+ * \tparam Preconditioner is \p batched_identity or \p batched_jacobi
+ *
+ * \param A matrices of the linear systems
+ * \param X approximate solutions, column \c s is the solution of system \c s
+ * \param B right-hand sides, column \c s is the right-hand side of system \c s
+ * \param monitor stopping criteria and per-system convergence report
+ * \param M preconditioner
+ *
+ * \par Overview
+ * Solves the nonsymmetric systems <tt>A_s x_s = b_s</tt> of all matrices
+ * of the batch with the preconditioned BiCGStab method, processing the
+ * systems in interleaved groups like \p batched_cg. Systems that break
+ * down stop iterating and are reported as not converged.
+ *
+ *  \see \p batched_cg
+ */
+template <typename BatchedMatrix,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitor,
+          typename Preconditioner>
+void batched_bicgstab(const BatchedMatrix& A,
+                            Array2d1& X,
+                      const Array2d2& B,
+                            Monitor& monitor,
+                      const Preconditioner& M);
+/*! \}
+ */
+
+} // end namespace krylov
+} // end namespace cusp
+
+#include <cusp/krylov/detail/batched.inl>
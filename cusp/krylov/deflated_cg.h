@@ -0,0 +1,160 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file deflated_cg.h
+ *  \brief Deflated Conjugate Gradient (deflated CG) method
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/detail/execution_policy.h>
+#include <cusp/krylov/recycle_space.h>
+
+namespace cusp
+{
+namespace krylov
+{
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup krylov_methods Krylov Methods
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/* \cond */
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace,
+          typename Monitor,
+          typename Preconditioner>
+void deflated_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                       RecycleSpace& space,
+                       Monitor& monitor,
+                       Preconditioner& M);
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace,
+          typename Monitor>
+void deflated_cg(const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                       RecycleSpace& space,
+                       Monitor& monitor);
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace>
+void deflated_cg(const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                       RecycleSpace& space);
+
+/* \endcond */
+
+/**
+ * \brief Deflated Conjugate Gradient method
+ *
+ * \tparam LinearOperator is a matrix or subclass of \p linear_operator
+ * \tparam VectorType1 vector
+ * \tparam RecycleSpace is a \p recycle_space
+ * \tparam Monitor is a \p monitor
+ * \tparam Preconditioner is a matrix or subclass of \p linear_operator
+ *
+ * \param A matrix of the linear system
+ * \param x approximate solution of the linear system
+ * \param b right-hand side of the linear system
+ * \param space recycled subspace, updated on return
+ * \param monitor montiors iteration and determines stopping conditions
+ * \param M preconditioner for A
+ *
+ * \par Overview
+ * Solves the symmetric, positive-definite linear system A x = b with
+ * preconditioner \p M. The search directions are kept A-orthogonal to
+ * the vectors of \p space, which removes the corresponding eigenvalues
+ * from the convergence of CG. On return \p space holds the harmonic Ritz
+ * vectors of the smallest harmonic Ritz values of \p A over the previous
+ * space and the first <tt>2 * space.max_size</tt> search directions, so
+ * passing the same \p space to the solves of a slowly varying sequence of
+ * systems deflates the slowest modes of the sequence.
+ *
+ * \par Example
+ *
+ *  The following code snippet demonstrates how to use \p deflated_cg to
+ *  solve a sequence of 10x10 Poisson problems.
+ *
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/monitor.h>
+ *  #include <cusp/krylov/deflated_cg.h>
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main(void)
+ *  {
+ *      cusp::csr_matrix<int, float, cusp::device_memory> A;
+ *      cusp::gallery::poisson5pt(A, 10, 10);
+ *
+ *      cusp::array1d<float, cusp::device_memory> x(A.num_rows, 0);
+ *      cusp::array1d<float, cusp::device_memory> b(A.num_rows, 1);
+ *
+ *      // keep up to 8 vectors between the solves
+ *      cusp::krylov::recycle_space<float, cusp::device_memory> space(8);
+ *
+ *      for (int i = 0; i < 4; i++)
+ *      {
+ *          cusp::monitor<float> monitor(b, 100, 1e-6, 0, true);
+ *
+ *          cusp::krylov::deflated_cg(A, x, b, space, monitor);
+ *
+ *          // ... update A and b
+ *      }
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ *
+ *  \see \p recycle_space
+ *  \see \p monitor
+ */
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace,
+          typename Monitor,
+          typename Preconditioner>
+void deflated_cg(const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                       RecycleSpace& space,
+                       Monitor& monitor,
+                       Preconditioner& M);
+/*! \}
+ */
+
+} // end namespace krylov
+} // end namespace cusp
+
+#include <cusp/krylov/detail/deflated_cg.inl>
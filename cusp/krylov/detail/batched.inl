@@ -0,0 +1,642 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/batched_csr_matrix.h>
+#include <cusp/complex.h>
+#include <cusp/exception.h>
+
+#include <cusp/krylov/detail/hermitian_eigen.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace cusp
+{
+namespace krylov
+{
+
+template <typename ValueType>
+size_t
+batched_monitor<ValueType>
+::num_converged(void) const
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < converged_flags.size(); i++)
+        if (converged_flags[i])
+            count++;
+
+    return count;
+}
+
+template <typename ValueType>
+void
+batched_monitor<ValueType>
+::print(void) const
+{
+    size_t min_count = 0;
+    size_t max_count = 0;
+
+    for (size_t i = 0; i < iteration_counts.size(); i++)
+    {
+        min_count = (i == 0) ? iteration_counts[i] : std::min(min_count, iteration_counts[i]);
+        max_count = std::max(max_count, iteration_counts[i]);
+    }
+
+    std::cout << num_converged() << " of " << num_systems() << " systems converged";
+    std::cout << " with iteration limit " << iteration_limit() << std::endl;
+    std::cout << "Ran between " << min_count << " and " << max_count << " iterations per system" << std::endl;
+}
+
+template <typename ValueType>
+void
+batched_monitor<ValueType>
+::reset(const size_t num_systems)
+{
+    iteration_counts.resize(num_systems);
+    residual_norms.resize(num_systems);
+    converged_flags.resize(num_systems);
+
+    for (size_t i = 0; i < num_systems; i++)
+    {
+        iteration_counts[i] = 0;
+        residual_norms[i]   = 0;
+        converged_flags[i]  = false;
+    }
+}
+
+namespace batched_detail
+{
+
+// number of systems that are interleaved and iterated together
+const size_t lane_width = 8;
+
+struct cg_method {};
+struct bicgstab_method {};
+
+template <typename ValueType>
+struct lane_workspace
+{
+    typedef typename cusp::norm_type<ValueType>::type Real;
+
+    // interleaved values of the group and inverse diagonal
+    std::vector<ValueType> values;
+    std::vector<ValueType> dinv;
+
+    // interleaved vectors
+    std::vector<ValueType> b, x, r, p, q, z, s, t, u, w;
+
+    // per-lane state
+    Real   tol[lane_width];
+    Real   r_norm[lane_width];
+    size_t iterations[lane_width];
+    bool   active[lane_width];
+    bool   converged[lane_width];
+
+    lane_workspace(const size_t num_rows, const size_t num_entries)
+        : values(num_entries * lane_width), dinv(num_rows * lane_width),
+          b(num_rows * lane_width), x(num_rows * lane_width), r(num_rows * lane_width),
+          p(num_rows * lane_width), q(num_rows * lane_width), z(num_rows * lane_width),
+          s(num_rows * lane_width), t(num_rows * lane_width), u(num_rows * lane_width),
+          w(num_rows * lane_width) {}
+};
+
+// y = A x for all lanes
+template <typename IndexType, typename ValueType>
+void lane_spmv(const size_t num_rows,
+               const IndexType * Ap, const IndexType * Aj, const ValueType * Av,
+               const ValueType * x, ValueType * y)
+{
+    const size_t L = lane_width;
+
+    for (size_t i = 0; i < num_rows; i++)
+    {
+        ValueType sum[L];
+
+        for (size_t l = 0; l < L; l++)
+            sum[l] = ValueType(0);
+
+        for (IndexType jj = Ap[i]; jj < Ap[i + 1]; jj++)
+        {
+            const ValueType * a  = Av + jj * L;
+            const ValueType * xj = x + Aj[jj] * L;
+
+            for (size_t l = 0; l < L; l++)
+                sum[l] += a[l] * xj[l];
+        }
+
+        for (size_t l = 0; l < L; l++)
+            y[i * L + l] = sum[l];
+    }
+}
+
+// result[l] = x_l^H y_l for all lanes
+template <typename ValueType>
+void lane_dotc(const size_t num_rows, const ValueType * x, const ValueType * y, ValueType * result)
+{
+    const size_t L = lane_width;
+
+    for (size_t l = 0; l < L; l++)
+        result[l] = ValueType(0);
+
+    for (size_t i = 0; i < num_rows; i++)
+        for (size_t l = 0; l < L; l++)
+            result[l] += cusp::conj(x[i * L + l]) * y[i * L + l];
+}
+
+template <typename ValueType, typename RealType>
+void lane_nrm2(const size_t num_rows, const ValueType * x, RealType * result)
+{
+    const size_t L = lane_width;
+
+    ValueType dot[L];
+    lane_dotc(num_rows, x, x, dot);
+
+    for (size_t l = 0; l < L; l++)
+        result[l] = std::sqrt(cusp::krylov::detail::real_part(dot[l]));
+}
+
+// y = a .* x + y
+template <typename ValueType>
+void lane_axpy(const size_t num_rows, const ValueType * a, const ValueType * x, ValueType * y)
+{
+    const size_t L = lane_width;
+
+    for (size_t i = 0; i < num_rows; i++)
+        for (size_t l = 0; l < L; l++)
+            y[i * L + l] += a[l] * x[i * L + l];
+}
+
+// y = d .* x elementwise
+template <typename ValueType>
+void lane_scale(const size_t num_rows, const ValueType * d, const ValueType * x, ValueType * y)
+{
+    const size_t L = lane_width;
+
+    for (size_t n = 0; n < num_rows * L; n++)
+        y[n] = d[n] * x[n];
+}
+
+template <typename IndexType, typename ValueType>
+void lane_diagonal(cusp::krylov::batched_identity,
+                   const size_t num_rows,
+                   const IndexType *, const IndexType *, const ValueType *,
+                   ValueType * dinv)
+{
+    for (size_t n = 0; n < num_rows * lane_width; n++)
+        dinv[n] = ValueType(1);
+}
+
+template <typename IndexType, typename ValueType>
+void lane_diagonal(cusp::krylov::batched_jacobi,
+                   const size_t num_rows,
+                   const IndexType * Ap, const IndexType * Aj, const ValueType * Av,
+                   ValueType * dinv)
+{
+    const size_t L = lane_width;
+
+    for (size_t i = 0; i < num_rows; i++)
+    {
+        for (size_t l = 0; l < L; l++)
+            dinv[i * L + l] = ValueType(0);
+
+        for (IndexType jj = Ap[i]; jj < Ap[i + 1]; jj++)
+            if (size_t(Aj[jj]) == i)
+                for (size_t l = 0; l < L; l++)
+                    dinv[i * L + l] += Av[jj * L + l];
+
+        for (size_t l = 0; l < L; l++)
+            dinv[i * L + l] = (dinv[i * L + l] == ValueType(0)) ? ValueType(1) : ValueType(1) / dinv[i * L + l];
+    }
+}
+
+// mark lanes as converged or exhausted after an iteration
+template <typename ValueType>
+void lane_check(lane_workspace<ValueType>& ws, const size_t iteration_limit)
+{
+    for (size_t l = 0; l < lane_width; l++)
+    {
+        if (!ws.active[l])
+            continue;
+
+        if (ws.r_norm[l] <= ws.tol[l])
+        {
+            ws.converged[l] = true;
+            ws.active[l] = false;
+        }
+        else if (ws.iterations[l] >= iteration_limit)
+        {
+            ws.active[l] = false;
+        }
+    }
+}
+
+template <typename ValueType>
+bool any_active(const lane_workspace<ValueType>& ws)
+{
+    for (size_t l = 0; l < lane_width; l++)
+        if (ws.active[l])
+            return true;
+
+    return false;
+}
+
+template <typename IndexType, typename ValueType>
+void lane_iterate(cg_method,
+                  const size_t N,
+                  const IndexType * Ap, const IndexType * Aj,
+                  lane_workspace<ValueType>& ws,
+                  const size_t iteration_limit)
+{
+    const size_t L = lane_width;
+    const ValueType * Av = &ws.values[0];
+
+    ValueType rho[L], pq[L], rho_new[L], alpha[L], beta[L], minus_alpha[L];
+
+    // z = M r, p = z, rho = r^H z
+    lane_scale(N, &ws.dinv[0], &ws.r[0], &ws.z[0]);
+    ws.p = ws.z;
+    lane_dotc(N, &ws.r[0], &ws.z[0], rho);
+
+    while (any_active(ws))
+    {
+        // q = A p, alpha = rho / (p^H q)
+        lane_spmv(N, Ap, Aj, Av, &ws.p[0], &ws.q[0]);
+        lane_dotc(N, &ws.p[0], &ws.q[0], pq);
+
+        for (size_t l = 0; l < L; l++)
+        {
+            if (ws.active[l] && pq[l] == ValueType(0))
+                ws.active[l] = false;
+
+            alpha[l] = ws.active[l] ? rho[l] / pq[l] : ValueType(0);
+            minus_alpha[l] = -alpha[l];
+
+            if (ws.active[l])
+                ws.iterations[l]++;
+        }
+
+        // x += alpha p, r -= alpha q
+        lane_axpy(N, alpha, &ws.p[0], &ws.x[0]);
+        lane_axpy(N, minus_alpha, &ws.q[0], &ws.r[0]);
+
+        lane_nrm2(N, &ws.r[0], ws.r_norm);
+        lane_check(ws, iteration_limit);
+
+        // z = M r, beta = rho_new / rho, p = z + beta p
+        lane_scale(N, &ws.dinv[0], &ws.r[0], &ws.z[0]);
+        lane_dotc(N, &ws.r[0], &ws.z[0], rho_new);
+
+        for (size_t l = 0; l < L; l++)
+        {
+            beta[l] = (ws.active[l] && rho[l] != ValueType(0)) ? rho_new[l] / rho[l] : ValueType(0);
+            rho[l] = rho_new[l];
+        }
+
+        for (size_t i = 0; i < N; i++)
+            for (size_t l = 0; l < L; l++)
+                ws.p[i * L + l] = ws.z[i * L + l] + beta[l] * ws.p[i * L + l];
+    }
+}
+
+template <typename IndexType, typename ValueType>
+void lane_iterate(bicgstab_method,
+                  const size_t N,
+                  const IndexType * Ap, const IndexType * Aj,
+                  lane_workspace<ValueType>& ws,
+                  const size_t iteration_limit)
+{
+    typedef typename cusp::norm_type<ValueType>::type Real;
+
+    const size_t L = lane_width;
+    const ValueType * Av = &ws.values[0];
+
+    // r_star = r, p = r
+    std::vector<ValueType>& r_star = ws.z;
+    std::vector<ValueType>& Mp     = ws.q;
+    std::vector<ValueType>& AMp    = ws.s;
+    std::vector<ValueType>& Ms     = ws.t;
+    std::vector<ValueType>& AMs    = ws.u;
+    std::vector<ValueType>& sv     = ws.w;
+
+    ValueType rho[L], rho_new[L], den[L], ts[L], tt[L];
+    ValueType alpha[L], omega[L], beta[L], x_alpha[L], x_omega[L], r_omega[L];
+    Real s_norm[L];
+
+    r_star = ws.r;
+    ws.p   = ws.r;
+    lane_dotc(N, &r_star[0], &ws.r[0], rho);
+
+    while (any_active(ws))
+    {
+        // Mp = M p, AMp = A Mp, alpha = rho / (r_star^H AMp)
+        lane_scale(N, &ws.dinv[0], &ws.p[0], &Mp[0]);
+        lane_spmv(N, Ap, Aj, Av, &Mp[0], &AMp[0]);
+        lane_dotc(N, &r_star[0], &AMp[0], den);
+
+        bool continues[L];
+
+        for (size_t l = 0; l < L; l++)
+        {
+            if (ws.active[l] && den[l] == ValueType(0))
+                ws.active[l] = false;
+
+            alpha[l]     = ws.active[l] ? rho[l] / den[l] : ValueType(0);
+            x_alpha[l]   = alpha[l];
+            continues[l] = ws.active[l];
+
+            if (ws.active[l])
+                ws.iterations[l]++;
+        }
+
+        // s = r - alpha AMp
+        for (size_t i = 0; i < N; i++)
+            for (size_t l = 0; l < L; l++)
+                sv[i * L + l] = ws.r[i * L + l] - alpha[l] * AMp[i * L + l];
+
+        lane_nrm2(N, &sv[0], s_norm);
+
+        // lanes whose s satisfies the tolerance finish with x += alpha Mp
+        for (size_t l = 0; l < L; l++)
+        {
+            if (continues[l] && s_norm[l] <= ws.tol[l])
+            {
+                continues[l]    = false;
+                ws.active[l]    = false;
+                ws.converged[l] = true;
+                ws.r_norm[l]    = s_norm[l];
+            }
+        }
+
+        // Ms = M s, AMs = A Ms, omega = (AMs^H s) / (AMs^H AMs)
+        lane_scale(N, &ws.dinv[0], &sv[0], &Ms[0]);
+        lane_spmv(N, Ap, Aj, Av, &Ms[0], &AMs[0]);
+        lane_dotc(N, &AMs[0], &sv[0], ts);
+        lane_dotc(N, &AMs[0], &AMs[0], tt);
+
+        for (size_t l = 0; l < L; l++)
+        {
+            if (continues[l] && (tt[l] == ValueType(0) || ts[l] == ValueType(0)))
+            {
+                // breakdown, keep the half step
+                continues[l] = false;
+                ws.active[l] = false;
+                ws.r_norm[l] = s_norm[l];
+            }
+
+            omega[l]   = continues[l] ? ts[l] / tt[l] : ValueType(0);
+            x_omega[l] = omega[l];
+            r_omega[l] = -omega[l];
+        }
+
+        // x += alpha Mp + omega Ms, r = s - omega AMs
+        lane_axpy(N, x_alpha, &Mp[0], &ws.x[0]);
+        lane_axpy(N, x_omega, &Ms[0], &ws.x[0]);
+
+        for (size_t n = 0; n < N * L; n++)
+            ws.r[n] = sv[n];
+
+        lane_axpy(N, r_omega, &AMs[0], &ws.r[0]);
+
+        Real r_norm[L];
+        lane_nrm2(N, &ws.r[0], r_norm);
+
+        for (size_t l = 0; l < L; l++)
+            if (continues[l])
+                ws.r_norm[l] = r_norm[l];
+
+        lane_check(ws, iteration_limit);
+
+        // beta = (rho_new / rho) (alpha / omega), p = r + beta (p - omega AMp)
+        lane_dotc(N, &r_star[0], &ws.r[0], rho_new);
+
+        for (size_t l = 0; l < L; l++)
+        {
+            if (ws.active[l] && rho[l] == ValueType(0))
+                ws.active[l] = false;
+
+            beta[l] = ws.active[l] ? (rho_new[l] / rho[l]) * (alpha[l] / omega[l]) : ValueType(0);
+            rho[l]  = rho_new[l];
+        }
+
+        for (size_t i = 0; i < N; i++)
+            for (size_t l = 0; l < L; l++)
+                ws.p[i * L + l] = ws.r[i * L + l] + beta[l] * (ws.p[i * L + l] - omega[l] * AMp[i * L + l]);
+    }
+}
+
+// solve the systems first, ..., first + lane_width - 1 of the batch
+template <typename Method, typename BatchedMatrix, typename Array2d1, typename Array2d2,
+          typename Monitor, typename Preconditioner>
+void solve_group(Method method,
+                 const BatchedMatrix& A,
+                       Array2d1& X,
+                 const Array2d2& B,
+                       Monitor& monitor,
+                 const Preconditioner& M,
+                 const size_t first,
+                       lane_workspace<typename BatchedMatrix::value_type>& ws)
+{
+    typedef typename BatchedMatrix::index_type IndexType;
+    typedef typename BatchedMatrix::value_type ValueType;
+    typedef typename cusp::norm_type<ValueType>::type Real;
+
+    const size_t L  = lane_width;
+    const size_t N  = A.num_rows;
+    const size_t S  = A.num_systems;
+    const size_t nl = std::min(L, S - first);
+
+    const IndexType * Ap = &A.row_offsets[0];
+    const IndexType * Aj = &A.column_indices[0];
+
+    // gather the interleaved values and vectors of the group, padding
+    // the unused lanes with zeros
+    for (size_t k = 0; k < A.num_entries; k++)
+        for (size_t l = 0; l < L; l++)
+            ws.values[k * L + l] = (l < nl) ? A.values[k * S + first + l] : ValueType(0);
+
+    for (size_t i = 0; i < N; i++)
+    {
+        for (size_t l = 0; l < L; l++)
+        {
+            ws.b[i * L + l] = (l < nl) ? B.values[i * S + first + l] : ValueType(0);
+            ws.x[i * L + l] = (l < nl) ? X.values[i * S + first + l] : ValueType(0);
+        }
+    }
+
+    lane_diagonal(M, N, Ap, Aj, &ws.values[0], &ws.dinv[0]);
+
+    // r = b - A x
+    lane_spmv(N, Ap, Aj, &ws.values[0], &ws.x[0], &ws.r[0]);
+
+    for (size_t n = 0; n < N * L; n++)
+        ws.r[n] = ws.b[n] - ws.r[n];
+
+    Real b_norm[L];
+    lane_nrm2(N, &ws.b[0], b_norm);
+    lane_nrm2(N, &ws.r[0], ws.r_norm);
+
+    for (size_t l = 0; l < L; l++)
+    {
+        ws.tol[l]        = monitor.absolute_tolerance() + monitor.relative_tolerance() * b_norm[l];
+        ws.iterations[l] = 0;
+        ws.active[l]     = l < nl;
+        ws.converged[l]  = false;
+    }
+
+    lane_check(ws, monitor.iteration_limit());
+
+    lane_iterate(method, N, Ap, Aj, ws, monitor.iteration_limit());
+
+    // scatter the solutions and the convergence report
+    for (size_t i = 0; i < N; i++)
+        for (size_t l = 0; l < nl; l++)
+            X.values[i * S + first + l] = ws.x[i * L + l];
+
+    for (size_t l = 0; l < nl; l++)
+    {
+        monitor.iteration_counts[first + l] = ws.iterations[l];
+        monitor.residual_norms[first + l]   = ws.r_norm[l];
+        monitor.converged_flags[first + l]  = ws.converged[l];
+    }
+}
+
+template <typename Method, typename BatchedMatrix, typename Array2d1, typename Array2d2,
+          typename Monitor, typename Preconditioner>
+void batched_solve(Method method,
+                   const BatchedMatrix& A,
+                         Array2d1& X,
+                   const Array2d2& B,
+                         Monitor& monitor,
+                   const Preconditioner& M,
+                   cusp::host_memory)
+{
+    typedef typename BatchedMatrix::value_type ValueType;
+
+    const size_t N = A.num_rows;
+    const size_t S = A.num_systems;
+
+    if (A.num_rows != A.num_cols)
+        throw cusp::invalid_input_exception("batched solvers require square matrices");
+
+    if (X.num_rows != N || X.num_cols != S || B.num_rows != N || B.num_cols != S ||
+        X.pitch != S || B.pitch != S)
+        throw cusp::invalid_input_exception("batched solvers require row-major num_rows x num_systems arrays");
+
+    monitor.reset(S);
+
+    if (N == 0 || S == 0)
+        return;
+
+    const int num_groups = int((S + lane_width - 1) / lane_width);
+
+    #pragma omp parallel
+    {
+        // workspace is allocated once per thread
+        lane_workspace<ValueType> ws(N, A.num_entries);
+
+        #pragma omp for schedule(dynamic)
+        for (int g = 0; g < num_groups; g++)
+            solve_group(method, A, X, B, monitor, M, g * lane_width, ws);
+    }
+}
+
+template <typename Method, typename BatchedMatrix, typename Array2d1, typename Array2d2,
+          typename Monitor, typename Preconditioner, typename MemorySpace>
+void batched_solve(Method method,
+                   const BatchedMatrix& A,
+                         Array2d1& X,
+                   const Array2d2& B,
+                         Monitor& monitor,
+                   const Preconditioner& M,
+                   MemorySpace)
+{
+    typedef typename BatchedMatrix::index_type IndexType;
+    typedef typename BatchedMatrix::value_type ValueType;
+
+    cusp::batched_csr_matrix<IndexType, ValueType, cusp::host_memory> A_host(A);
+    cusp::array2d<ValueType, cusp::host_memory> X_host(X);
+    cusp::array2d<ValueType, cusp::host_memory> B_host(B);
+
+    batched_solve(method, A_host, X_host, B_host, monitor, M, cusp::host_memory());
+
+    X = X_host;
+}
+
+} // end batched_detail namespace
+
+template <typename BatchedMatrix,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitor,
+          typename Preconditioner>
+void batched_cg(const BatchedMatrix& A,
+                      Array2d1& X,
+                const Array2d2& B,
+                      Monitor& monitor,
+                const Preconditioner& M)
+{
+    typedef typename BatchedMatrix::memory_space MemorySpace;
+
+    batched_detail::batched_solve(batched_detail::cg_method(), A, X, B, monitor, M, MemorySpace());
+}
+
+template <typename BatchedMatrix,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitor>
+void batched_cg(const BatchedMatrix& A,
+                      Array2d1& X,
+                const Array2d2& B,
+                      Monitor& monitor)
+{
+    cusp::krylov::batched_cg(A, X, B, monitor, cusp::krylov::batched_identity());
+}
+
+template <typename BatchedMatrix,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitor,
+          typename Preconditioner>
+void batched_bicgstab(const BatchedMatrix& A,
+                            Array2d1& X,
+                      const Array2d2& B,
+                            Monitor& monitor,
+                      const Preconditioner& M)
+{
+    typedef typename BatchedMatrix::memory_space MemorySpace;
+
+    batched_detail::batched_solve(batched_detail::bicgstab_method(), A, X, B, monitor, M, MemorySpace());
+}
+
+template <typename BatchedMatrix,
+          typename Array2d1,
+          typename Array2d2,
+          typename Monitor>
+void batched_bicgstab(const BatchedMatrix& A,
+                            Array2d1& X,
+                      const Array2d2& B,
+                            Monitor& monitor)
+{
+    cusp::krylov::batched_bicgstab(A, X, B, monitor, cusp::krylov::batched_identity());
+}
+
+} // end namespace krylov
+} // end namespace cusp
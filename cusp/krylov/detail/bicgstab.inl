@@ -108,8 +108,17 @@ void bicgstab(thrust::execution_policy<DerivedPolicy> &exec,
         // x_{j+1} = x_j + alpha*M*p_j + omega*M*s_j
         blas::axpbypcz(exec, x, Mp, Ms, x, ValueType(1), alpha, omega);
 
-        // r_{j+1} = s_j - omega*A*M*s
-        blas::axpby(exec, s, AMs, r, ValueType(1), -omega);
+        if (monitor.replace_residual())
+        {
+            // r_{j+1} = b - A*x_{j+1}
+            cusp::multiply(exec, A, x, r);
+            blas::axpby(exec, b, r, r, ValueType(1), ValueType(-1));
+        }
+        else
+        {
+            // r_{j+1} = s_j - omega*A*M*s
+            blas::axpby(exec, s, AMs, r, ValueType(1), -omega);
+        }
 
         // beta_j = (r_{j+1}, r_star) / (r_j, r_star) * (alpha/omega)
         ValueType r_r_star_new = blas::dotc(exec, r_star, r);
@@ -0,0 +1,158 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file block_ops.h
+ *  \brief Operations on blocks of vectors used by the Krylov methods
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/complex.h>
+#include <cusp/functional.h>
+
+#include <cusp/blas/blas.h>
+
+#include <cusp/detail/temporary_array.h>
+
+#include <thrust/copy.h>
+#include <thrust/reduce.h>
+#include <thrust/tuple.h>
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/discard_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/iterator/zip_iterator.h>
+
+namespace cusp
+{
+namespace krylov
+{
+namespace detail
+{
+
+template <typename ValueType>
+struct conj_multiply_tuple
+{
+    template <typename Tuple>
+    __host__ __device__
+    ValueType operator()(const Tuple& t) const
+    {
+        return cusp::conj(ValueType(thrust::get<0>(t))) * ValueType(thrust::get<1>(t));
+    }
+};
+
+// y[j - first] = <X(:,j), x> for the columns first <= j < last of the
+// column-major block X with contiguous columns, computed with a single
+// reduction
+template <typename DerivedPolicy,
+          typename Array2d,
+          typename Array1d1,
+          typename Array1d2>
+void block_dotc(thrust::execution_policy<DerivedPolicy> &exec,
+                const Array2d& X,
+                const size_t first,
+                const size_t last,
+                const Array1d1& x,
+                      Array1d2& y)
+{
+    typedef typename Array2d::index_type IndexType;
+    typedef typename Array2d::value_type ValueType;
+
+    typedef thrust::counting_iterator<IndexType>                                        IndexIterator;
+    typedef thrust::transform_iterator<cusp::divide_value<IndexType>, IndexIterator>    ColumnIterator;
+    typedef thrust::transform_iterator<cusp::modulus_value<IndexType>, IndexIterator>   RowIterator;
+
+    const IndexType N     = X.num_rows;
+    const IndexType count = N * (last - first);
+
+    if (count == 0)
+        return;
+
+    ColumnIterator columns(IndexIterator(0), cusp::divide_value<IndexType>(N));
+    RowIterator    rows(IndexIterator(0), cusp::modulus_value<IndexType>(N));
+
+    thrust::reduce_by_key(exec,
+                          columns, columns + count,
+                          thrust::make_transform_iterator(
+                              thrust::make_zip_iterator(
+                                  thrust::make_tuple(X.values.begin() + first * N,
+                                                     thrust::make_permutation_iterator(x.begin(), rows))),
+                              conj_multiply_tuple<ValueType>()),
+                          thrust::make_discard_iterator(),
+                          y.begin());
+}
+
+// G(i,j) = <X(:,i), Y(:,j)> for i < nx and j < ny, G in host memory
+template <typename DerivedPolicy,
+          typename Array2d1,
+          typename Array2d2,
+          typename Array2d3>
+void block_gram(thrust::execution_policy<DerivedPolicy> &exec,
+                const Array2d1& X, const size_t nx,
+                const Array2d2& Y, const size_t ny,
+                      Array2d3& G)
+{
+    typedef typename Array2d1::value_type ValueType;
+
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> temp(exec, nx);
+    cusp::array1d<ValueType, cusp::host_memory> column(nx);
+
+    G.resize(nx, ny);
+
+    for (size_t j = 0; j < ny; j++)
+    {
+        block_dotc(exec, X, 0, nx, Y.column(j), temp);
+        thrust::copy(temp.begin(), temp.begin() + nx, column.begin());
+
+        for (size_t i = 0; i < nx; i++)
+            G(i, j) = column[i];
+    }
+}
+
+// Z(:,j) = sum_i X(:,first + i) * Y(offset + i,j) for i < n and all columns
+// j of Y, Y in host memory
+template <typename DerivedPolicy,
+          typename Array2d1,
+          typename Array2d2,
+          typename Array2d3>
+void block_combine(thrust::execution_policy<DerivedPolicy> &exec,
+                   const Array2d1& X, const size_t first,
+                   const Array2d2& Y, const size_t offset, const size_t n,
+                         Array2d3& Z,
+                   const bool accumulate = false)
+{
+    typedef typename Array2d3::value_type ValueType;
+    typedef typename Array2d3::column_view ColumnView;
+
+    for (size_t j = 0; j < Y.num_cols; j++)
+    {
+        ColumnView Zj = Z.column(j);
+
+        if (!accumulate)
+            cusp::blas::fill(exec, Zj, ValueType(0));
+
+        for (size_t i = 0; i < n; i++)
+            cusp::blas::axpy(exec, X.column(first + i), Zj, ValueType(Y(offset + i, j)));
+    }
+}
+
+} // end namespace detail
+} // end namespace krylov
+} // end namespace cusp
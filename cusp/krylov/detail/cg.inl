@@ -23,6 +23,10 @@
 
 #include <cusp/blas/blas.h>
 
+#include <thrust/detail/type_traits.h>
+
+#include <cmath>
+
 namespace blas = cusp::blas;
 
 namespace cusp
@@ -32,6 +36,30 @@ namespace krylov
 namespace cg_detail
 {
 
+template <typename Preconditioner>
+struct is_identity_preconditioner : thrust::detail::false_type {};
+
+template <typename ValueType, typename MemorySpace, typename IndexType>
+struct is_identity_preconditioner< cusp::identity_operator<ValueType,MemorySpace,IndexType> >
+  : thrust::detail::true_type {};
+
+// without preconditioning <r,z> = |r|^2 is already known
+template <typename DerivedPolicy, typename Monitor, typename Vector, typename ValueType>
+bool finished(thrust::execution_policy<DerivedPolicy> &exec,
+              Monitor& monitor, const Vector& r, const ValueType rz,
+              thrust::detail::true_type)
+{
+    return monitor.finished_norm(std::sqrt(cusp::abs(rz)));
+}
+
+template <typename DerivedPolicy, typename Monitor, typename Vector, typename ValueType>
+bool finished(thrust::execution_policy<DerivedPolicy> &exec,
+              Monitor& monitor, const Vector& r, const ValueType rz,
+              thrust::detail::false_type)
+{
+    return monitor.finished(exec, r);
+}
+
 template <typename DerivedPolicy,
           typename LinearOperator,
           typename VectorType1,
@@ -74,7 +102,9 @@ void cg(thrust::execution_policy<DerivedPolicy> &exec,
     // rz = <r^H, z>
     ValueType rz = blas::dotc(exec, r, z);
 
-    while (!monitor.finished(exec, r))
+    typename is_identity_preconditioner<Preconditioner>::type rz_is_norm;
+
+    while (!finished(exec, monitor, r, rz, rz_is_norm))
     {
         // y <- Ap
         cusp::multiply(exec, A, p, y);
@@ -85,8 +115,17 @@ void cg(thrust::execution_policy<DerivedPolicy> &exec,
         // x <- x + alpha * p
         blas::axpy(exec, p, x, alpha);
 
-        // r <- r - alpha * y
-        blas::axpy(exec, y, r, -alpha);
+        if (monitor.replace_residual())
+        {
+            // r <- b - A*x
+            cusp::multiply(exec, A, x, y);
+            blas::axpby(exec, b, y, r, ValueType(1), ValueType(-1));
+        }
+        else
+        {
+            // r <- r - alpha * y
+            blas::axpy(exec, y, r, -alpha);
+        }
 
         // z <- M*r
         cusp::multiply(exec, M, r, z);
@@ -0,0 +1,320 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/complex.h>
+#include <cusp/linear_operator.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+
+#include <cusp/detail/temporary_array.h>
+#include <cusp/krylov/detail/block_ops.h>
+
+#include <thrust/copy.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace blas = cusp::blas;
+
+namespace cusp
+{
+namespace krylov
+{
+namespace deflated_cg_detail
+{
+
+// y <- y - U(:,0:k) C(:,0:k)^H x
+template <typename DerivedPolicy,
+          typename Array2d1,
+          typename Array2d2,
+          typename Array1d1,
+          typename Array1d2,
+          typename Array1d3,
+          typename Array1d4>
+void deflate(thrust::execution_policy<DerivedPolicy> &exec,
+             const Array2d1& U, const Array2d2& C, const size_t k,
+             const Array1d1& x, Array1d2& y,
+             Array1d3& coeffs, Array1d4& c)
+{
+    if (k == 0)
+        return;
+
+    cusp::krylov::detail::block_dotc(exec, C, 0, k, x, coeffs);
+    thrust::copy(coeffs.begin(), coeffs.begin() + k, c.begin());
+
+    for (size_t j = 0; j < k; j++)
+        blas::axpy(exec, U.column(j), y, -c[j]);
+}
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace,
+          typename Monitor,
+          typename Preconditioner>
+void deflated_cg(thrust::execution_policy<DerivedPolicy> &exec,
+                 const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                       RecycleSpace& space,
+                       Monitor& monitor,
+                       Preconditioner& M)
+{
+    typedef typename LinearOperator::value_type ValueType;
+    typedef typename cusp::norm_type<ValueType>::type NormType;
+    typedef typename cusp::minimum_space<
+    typename LinearOperator::memory_space, typename VectorType1::memory_space,
+             typename Preconditioner::memory_space>::type MemorySpace;
+    typedef cusp::array2d<ValueType, MemorySpace, cusp::column_major> Block;
+    typedef typename Block::column_view ColumnView;
+    typedef cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> HostMatrix;
+
+    assert(A.num_rows == A.num_cols);  // sanity check
+
+    const size_t N = A.num_rows;
+    const size_t K = space.max_size;
+
+    // number of search directions used to update the space
+    const size_t L = 2 * K;
+
+    // recompute C = A U for the current matrix and make U A-orthonormal
+    cusp::krylov::detail::refresh_space(exec, A, space);
+    space.num_vectors = cusp::krylov::detail::a_orthonormalize_pair(exec, space.U, space.C, space.num_vectors);
+
+    const size_t k = space.num_vectors;
+
+    // allocate workspace
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> y(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> z(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> r(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> p(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> coeffs(exec, std::max(K, size_t(1)));
+
+    // Z = [U, P] and AZ = [C, A P] for the first L search directions P
+    Block Z(N, k + L);
+    Block AZ(N, k + L);
+
+    for (size_t j = 0; j < k; j++)
+    {
+        ColumnView Zj  = Z.column(j);
+        ColumnView AZj = AZ.column(j);
+        blas::copy(exec, space.U.column(j), Zj);
+        blas::copy(exec, space.C.column(j), AZj);
+    }
+
+    // HOST WORKSPACE
+    cusp::array1d<ValueType, cusp::host_memory> c(std::max(K, size_t(1)));
+
+    // r <- b - A*x
+    cusp::multiply(exec, A, x, r);
+    blas::axpby(exec, b, r, r, ValueType(1), ValueType(-1));
+
+    // x <- x + U U^H r, r <- r - C U^H r
+    if (k > 0)
+    {
+        cusp::krylov::detail::block_dotc(exec, space.U, 0, k, r, coeffs);
+        thrust::copy(coeffs.begin(), coeffs.begin() + k, c.begin());
+
+        for (size_t j = 0; j < k; j++)
+        {
+            blas::axpy(exec, space.U.column(j), x,  c[j]);
+            blas::axpy(exec, space.C.column(j), r, -c[j]);
+        }
+    }
+
+    // z <- M*r
+    cusp::multiply(exec, M, r, z);
+
+    // p <- z - U C^H z
+    blas::copy(exec, z, p);
+    deflate(exec, space.U, space.C, k, z, p, coeffs, c);
+
+    // rz = <r^H, z>
+    ValueType rz = blas::dotc(exec, r, z);
+
+    size_t l = 0;
+
+    while (!monitor.finished(exec, r))
+    {
+        // y <- Ap
+        cusp::multiply(exec, A, p, y);
+
+        ValueType yp = blas::dotc(exec, y, p);
+
+        // store the A-normalized direction
+        if (l < L && cusp::abs(yp) > NormType(0))
+        {
+            ValueType scale = NormType(1) / std::sqrt(cusp::abs(yp));
+
+            ColumnView Zl  = Z.column(k + l);
+            ColumnView AZl = AZ.column(k + l);
+            blas::copy(exec, p, Zl);
+            blas::copy(exec, y, AZl);
+            blas::scal(exec, Zl,  scale);
+            blas::scal(exec, AZl, scale);
+
+            l++;
+        }
+
+        // alpha <- <r,z>/<y,p>
+        ValueType alpha = rz / yp;
+
+        // x <- x + alpha * p
+        blas::axpy(exec, p, x, alpha);
+
+        // r <- r - alpha * y
+        blas::axpy(exec, y, r, -alpha);
+
+        // z <- M*r
+        cusp::multiply(exec, M, r, z);
+
+        ValueType rz_old = rz;
+
+        // rz = <r^H, z>
+        rz = blas::dotc(exec, r, z);
+
+        // beta <- <r_{i+1},r_{i+1}>/<r,r>
+        ValueType beta = rz / rz_old;
+
+        // p <- z + beta*p - U C^H z
+        blas::axpby(exec, z, p, p, ValueType(1), beta);
+        deflate(exec, space.U, space.C, k, z, p, coeffs, c);
+
+        ++monitor;
+    }
+
+    const size_t n = k + l;
+
+    if (K == 0 || n == 0)
+        return;
+
+    // harmonic Ritz vectors: (AZ)^H AZ y = theta Z^H AZ y
+    HostMatrix G1;
+    HostMatrix G2;
+
+    cusp::krylov::detail::block_gram(exec, Z, n, AZ, n, G1);
+    cusp::krylov::detail::block_gram(exec, AZ, n, AZ, n, G2);
+
+    // Z^H A Z is Hermitian in exact arithmetic
+    for (size_t j = 0; j < n; j++)
+    {
+        for (size_t i = 0; i < j; i++)
+        {
+            ValueType g = (G1(i, j) + cusp::conj(G1(j, i))) / NormType(2);
+            G1(i, j) = g;
+            G1(j, i) = cusp::conj(g);
+        }
+
+        G1(j, j) = cusp::krylov::detail::real_part(G1(j, j));
+    }
+
+    HostMatrix Y;
+    const size_t kk = cusp::krylov::detail::smallest_eigenvectors(G2, G1, K, Y);
+
+    cusp::krylov::detail::block_combine(exec, Z,  0, Y, 0, n, space.U);
+    cusp::krylov::detail::block_combine(exec, AZ, 0, Y, 0, n, space.C);
+
+    space.num_vectors = cusp::krylov::detail::a_orthonormalize_pair(exec, space.U, space.C, kk);
+}
+
+} // end deflated_cg_detail namespace
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace,
+          typename Monitor,
+          typename Preconditioner>
+void deflated_cg(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                       RecycleSpace& space,
+                       Monitor& monitor,
+                       Preconditioner& M)
+{
+    using cusp::krylov::deflated_cg_detail::deflated_cg;
+
+    return deflated_cg(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, x, b, space, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace,
+          typename Monitor,
+          typename Preconditioner>
+void deflated_cg(const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                       RecycleSpace& space,
+                       Monitor& monitor,
+                       Preconditioner& M)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename VectorType1::memory_space    System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::krylov::deflated_cg(select_system(system1,system2), A, x, b, space, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace,
+          typename Monitor>
+void deflated_cg(const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                       RecycleSpace& space,
+                       Monitor& monitor)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+    typedef typename LinearOperator::memory_space MemorySpace;
+
+    cusp::identity_operator<ValueType,MemorySpace> M(A.num_rows, A.num_cols);
+
+    return cusp::krylov::deflated_cg(A, x, b, space, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace>
+void deflated_cg(const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                       RecycleSpace& space)
+{
+    typedef typename LinearOperator::value_type ValueType;
+
+    cusp::monitor<ValueType> monitor(b);
+
+    return cusp::krylov::deflated_cg(A, x, b, space, monitor);
+}
+
+} // end namespace krylov
+} // end namespace cusp
@@ -0,0 +1,362 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/complex.h>
+#include <cusp/exception.h>
+#include <cusp/linear_operator.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+#include <cusp/krylov/gmres.h>
+
+#include <cusp/detail/temporary_array.h>
+#include <cusp/krylov/detail/block_ops.h>
+
+#include <thrust/copy.h>
+
+#include <algorithm>
+
+namespace blas = cusp::blas;
+
+namespace cusp
+{
+namespace krylov
+{
+namespace gcrodr_detail
+{
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace,
+          typename Monitor,
+          typename Preconditioner>
+void gcrodr(thrust::execution_policy<DerivedPolicy> &exec,
+            const LinearOperator& A,
+                  VectorType1& x,
+            const VectorType2& b,
+            const size_t m,
+                  RecycleSpace& space,
+                  Monitor& monitor,
+                  Preconditioner& M)
+{
+    typedef typename LinearOperator::value_type ValueType;
+    typedef typename cusp::norm_type<ValueType>::type NormType;
+    typedef typename cusp::minimum_space<
+    typename LinearOperator::memory_space, typename VectorType1::memory_space,
+             typename Preconditioner::memory_space>::type MemorySpace;
+    typedef cusp::array2d<ValueType, MemorySpace, cusp::column_major> Block;
+    typedef typename Block::column_view ColumnView;
+    typedef cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> HostMatrix;
+
+    assert(A.num_rows == A.num_cols);  // sanity check
+
+    const size_t N = A.num_rows;
+    const size_t K = space.max_size;
+
+    if (m <= K)
+        throw cusp::invalid_input_exception("search space dimension must exceed the size of the recycle space");
+
+    // recompute C = A U for the current matrix and make C orthonormal
+    cusp::krylov::detail::refresh_space(exec, A, space);
+    space.num_vectors = cusp::krylov::detail::orthonormalize_pair(exec, space.C, space.U, space.num_vectors);
+
+    // allocate workspace
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> r(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> w(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> coeffs(exec, std::max(K, size_t(1)));
+
+    // Arnoldi basis V and search space Z = [U, M V]
+    Block V(N, m + 1, ValueType(0));
+    Block Z(N, m);
+
+    // HOST WORKSPACE
+    HostMatrix H(m + 1, m, ValueType(0));     // rotated Hessenberg matrix
+    HostMatrix Hbar(m + 1, m, ValueType(0));  // Hessenberg matrix
+    HostMatrix B(std::max(K, size_t(1)), m);  // B = C^H A Z
+    cusp::array1d<ValueType, cusp::host_memory> s(m + 1);
+    cusp::array1d<ValueType, cusp::host_memory> cs(m);
+    cusp::array1d<ValueType, cusp::host_memory> sn(m);
+    cusp::array1d<ValueType, cusp::host_memory> y(m);
+    cusp::array1d<ValueType, cusp::host_memory> c(std::max(K, size_t(1)));
+
+    // r <- b - A*x
+    cusp::multiply(exec, A, x, r);
+    blas::axpby(exec, b, r, r, ValueType(1), ValueType(-1));
+
+    // x <- x + U C^H r, r <- r - C C^H r
+    if (space.num_vectors > 0)
+    {
+        const size_t k = space.num_vectors;
+
+        cusp::krylov::detail::block_dotc(exec, space.C, 0, k, r, coeffs);
+        thrust::copy(coeffs.begin(), coeffs.begin() + k, c.begin());
+
+        for (size_t j = 0; j < k; j++)
+        {
+            blas::axpy(exec, space.U.column(j), x,  c[j]);
+            blas::axpy(exec, space.C.column(j), r, -c[j]);
+        }
+    }
+
+    while (!monitor.finished(exec, r))
+    {
+        const size_t k = space.num_vectors;
+        const size_t p = m - k;
+
+        NormType beta = blas::nrm2(exec, r);
+
+        ColumnView V0 = V.column(0);
+        blas::copy(exec, r, V0);
+        blas::scal(exec, V0, ValueType(NormType(1) / beta));
+
+        for (size_t j = 0; j < k; j++)
+        {
+            ColumnView Zj = Z.column(j);
+            blas::copy(exec, space.U.column(j), Zj);
+        }
+
+        blas::fill(s, ValueType(0));
+        s[0] = beta;
+
+        int i = -1;
+
+        do
+        {
+            ++i;
+
+            // Z(:,k+i) = M V(:,i), w = A Z(:,k+i)
+            ColumnView Zi = Z.column(k + i);
+            cusp::multiply(exec, M, V.column(i), Zi);
+            cusp::multiply(exec, A, Zi, w);
+
+            // make w orthogonal to C
+            if (k > 0)
+            {
+                cusp::krylov::detail::block_dotc(exec, space.C, 0, k, w, coeffs);
+                thrust::copy(coeffs.begin(), coeffs.begin() + k, c.begin());
+
+                for (size_t j = 0; j < k; j++)
+                {
+                    B(j, i) = c[j];
+                    blas::axpy(exec, space.C.column(j), w, -c[j]);
+                }
+            }
+
+            // Arnoldi step
+            for (int j = 0; j <= i; j++)
+            {
+                H(j, i) = blas::dotc(exec, V.column(j), w);
+                blas::axpy(exec, V.column(j), w, -H(j, i));
+            }
+
+            H(i + 1, i) = blas::nrm2(exec, w);
+
+            for (int j = 0; j <= i + 1; j++)
+                Hbar(j, i) = H(j, i);
+
+            const bool breakdown = H(i + 1, i) == ValueType(0);
+
+            if (!breakdown)
+            {
+                ColumnView Vi = V.column(i + 1);
+                blas::copy(exec, w, Vi);
+                blas::scal(exec, Vi, ValueType(1) / H(i + 1, i));
+            }
+
+            cusp::krylov::gmres_detail::PlaneRotation(H, cs, sn, s, i);
+
+            ++monitor;
+
+            if (monitor.finished_norm(cusp::abs(s[i + 1])) || breakdown)
+                break;
+        }
+        while (i + 1 < int(p));
+
+        const size_t n = i + 1;
+
+        // solve the upper triangular system H y = s
+        for (int j = i; j >= 0; j--)
+        {
+            y[j] = s[j];
+
+            for (int l = j + 1; l <= i; l++)
+                y[j] -= H(j, l) * y[l];
+
+            y[j] /= H(j, j);
+        }
+
+        // x <- x + Z(:,k:k+n) y - U B y
+        for (size_t j = 0; j < n; j++)
+            blas::axpy(exec, Z.column(k + j), x, y[j]);
+
+        for (size_t j = 0; j < k; j++)
+        {
+            ValueType By = 0;
+
+            for (size_t l = 0; l < n; l++)
+                By += B(j, l) * y[l];
+
+            blas::axpy(exec, space.U.column(j), x, -By);
+        }
+
+        // r <- b - A*x
+        cusp::multiply(exec, A, x, r);
+        blas::axpby(exec, b, r, r, ValueType(1), ValueType(-1));
+
+        // A Z(:,0:k+n) = [C, V(:,0:n+1)] W with W = [I B; 0 Hbar]
+        const size_t nz = k + n;
+
+        HostMatrix W(nz + 1, nz, ValueType(0));
+
+        for (size_t j = 0; j < k; j++)
+        {
+            W(j, j) = ValueType(1);
+
+            for (size_t l = 0; l < n; l++)
+                W(j, k + l) = B(j, l);
+        }
+
+        for (size_t l = 0; l < n; l++)
+            for (size_t j = 0; j <= l + 1; j++)
+                W(k + j, k + l) = Hbar(j, l);
+
+        // select the directions z of the search space with smallest |A z| / |z|
+        HostMatrix WW(nz, nz, ValueType(0));
+
+        for (size_t j = 0; j < nz; j++)
+            for (size_t l = 0; l < nz; l++)
+                for (size_t q = 0; q <= nz; q++)
+                    WW(l, j) += cusp::conj(W(q, l)) * W(q, j);
+
+        HostMatrix ZZ;
+        cusp::krylov::detail::block_gram(exec, Z, nz, Z, nz, ZZ);
+
+        HostMatrix Y;
+        const size_t kk = cusp::krylov::detail::smallest_eigenvectors(WW, ZZ, K, Y);
+
+        HostMatrix WY(nz + 1, kk, ValueType(0));
+
+        for (size_t j = 0; j < kk; j++)
+            for (size_t l = 0; l < nz; l++)
+                for (size_t q = 0; q <= nz; q++)
+                    WY(q, j) += W(q, l) * Y(l, j);
+
+        // U = Z Y and C = A U = [C, V] W Y
+        Block U_new(N, K);
+        Block C_new(N, K);
+
+        cusp::krylov::detail::block_combine(exec, Z, 0, Y, 0, nz, U_new);
+        cusp::krylov::detail::block_combine(exec, space.C, 0, WY, 0, k, C_new);
+        cusp::krylov::detail::block_combine(exec, V, 0, WY, k, n + 1, C_new, true);
+
+        space.num_vectors = cusp::krylov::detail::orthonormalize_pair(exec, C_new, U_new, kk);
+        space.U.swap(U_new);
+        space.C.swap(C_new);
+    }
+}
+
+} // end gcrodr_detail namespace
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace,
+          typename Monitor,
+          typename Preconditioner>
+void gcrodr(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+            const LinearOperator& A,
+                  VectorType1& x,
+            const VectorType2& b,
+            const size_t m,
+                  RecycleSpace& space,
+                  Monitor& monitor,
+                  Preconditioner& M)
+{
+    using cusp::krylov::gcrodr_detail::gcrodr;
+
+    return gcrodr(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, x, b, m, space, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace,
+          typename Monitor,
+          typename Preconditioner>
+void gcrodr(const LinearOperator& A,
+                  VectorType1& x,
+            const VectorType2& b,
+            const size_t m,
+                  RecycleSpace& space,
+                  Monitor& monitor,
+                  Preconditioner& M)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename VectorType1::memory_space    System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::krylov::gcrodr(select_system(system1,system2), A, x, b, m, space, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace,
+          typename Monitor>
+void gcrodr(const LinearOperator& A,
+                  VectorType1& x,
+            const VectorType2& b,
+            const size_t m,
+                  RecycleSpace& space,
+                  Monitor& monitor)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+    typedef typename LinearOperator::memory_space MemorySpace;
+
+    cusp::identity_operator<ValueType,MemorySpace> M(A.num_rows, A.num_cols);
+
+    return cusp::krylov::gcrodr(A, x, b, m, space, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace>
+void gcrodr(const LinearOperator& A,
+                  VectorType1& x,
+            const VectorType2& b,
+            const size_t m,
+                  RecycleSpace& space)
+{
+    typedef typename LinearOperator::value_type ValueType;
+
+    cusp::monitor<ValueType> monitor(b);
+
+    return cusp::krylov::gcrodr(A, x, b, m, space, monitor);
+}
+
+} // end namespace krylov
+} // end namespace cusp
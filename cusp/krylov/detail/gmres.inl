@@ -133,7 +133,7 @@ void gmres(thrust::execution_policy<DerivedPolicy> &exec,
     cusp::array1d<ValueType, cusp::host_memory> s(R + 1);
     cusp::array1d<ValueType, cusp::host_memory> cs(R);
     cusp::array1d<ValueType, cusp::host_memory> sn(R);
-    cusp::array1d<ValueType, cusp::host_memory> resid(1);
+    NormType resid = 0;
 
     do
     {
@@ -149,8 +149,8 @@ void gmres(thrust::execution_policy<DerivedPolicy> &exec,
         blas::fill(host_exec, s, ValueType(0.0));
         s[0] = beta;
         i = -1;
-        resid[0] = cusp::abs(s[0]);
-        if (monitor.finished(resid))
+        resid = cusp::abs(s[0]);
+        if (monitor.finished_norm(resid))
         {
             break;
         }
@@ -181,10 +181,11 @@ void gmres(thrust::execution_policy<DerivedPolicy> &exec,
 
             PlaneRotation(H, cs, sn, s, i);
 
-            resid[0] = cusp::abs(s[i + 1]);
+            // the residual norm follows from the rotations
+            resid = cusp::abs(s[i + 1]);
 
             // check convergence condition
-            if (monitor.finished(resid))
+            if (monitor.finished_norm(resid))
             {
                 break;
             }
@@ -209,7 +210,7 @@ void gmres(thrust::execution_policy<DerivedPolicy> &exec,
             // x = x + s[j] * V(j)
             blas::axpy(exec, V.column(j), x, s[j]);
         }
-    } while (!monitor.finished(resid));
+    } while (!monitor.finished_norm(resid));
 }
 
 }  // end gmres_detail namespace
@@ -0,0 +1,168 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file hermitian_eigen.h
+ *  \brief Eigen decomposition of small Hermitian host matrices
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/complex.h>
+
+#include <cmath>
+#include <limits>
+
+namespace cusp
+{
+namespace krylov
+{
+namespace detail
+{
+
+template <typename T>
+T real_part(const T& z)
+{
+    return z;
+}
+
+template <typename T>
+T real_part(const cusp::complex<T>& z)
+{
+    return z.real();
+}
+
+// Eigen decomposition A = V diag(w) V^H of a small Hermitian host matrix
+// with the cyclic Jacobi method
+template <typename Array2d1, typename Array1d, typename Array2d2>
+void hermitian_eigen(const Array2d1& A_in, Array1d& w, Array2d2& V)
+{
+    typedef typename Array2d1::value_type ValueType;
+    typedef typename cusp::norm_type<ValueType>::type NormType;
+
+    const size_t n = A_in.num_rows;
+
+    cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> A(A_in);
+
+    V.resize(n, n);
+    w.resize(n);
+
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++)
+            V(i, j) = ValueType(i == j ? 1 : 0);
+
+    const NormType eps = std::numeric_limits<NormType>::epsilon();
+
+    for (size_t sweep = 0; sweep < 100; sweep++)
+    {
+        NormType diag = 0;
+        NormType off  = 0;
+
+        for (size_t j = 0; j < n; j++)
+        {
+            diag += cusp::abs(A(j, j)) * cusp::abs(A(j, j));
+
+            for (size_t i = 0; i < j; i++)
+                off += cusp::abs(A(i, j)) * cusp::abs(A(i, j));
+        }
+
+        if (off <= eps * eps * diag || off == NormType(0))
+            break;
+
+        for (size_t p = 0; p + 1 < n; p++)
+        {
+            for (size_t q = p + 1; q < n; q++)
+            {
+                const NormType apq = cusp::abs(A(p, q));
+
+                if (apq == NormType(0))
+                    continue;
+
+                // the rotation diag(1, conj(phase)) makes A(p,q) real
+                const ValueType phase = A(p, q) / apq;
+
+                const NormType app = real_part(A(p, p));
+                const NormType aqq = real_part(A(q, q));
+
+                const NormType theta = (aqq - app) / (2 * apq);
+                const NormType t = (theta >= 0 ? 1 : -1) / (std::abs(theta) + std::sqrt(theta * theta + 1));
+                const NormType c = 1 / std::sqrt(t * t + 1);
+                const NormType s = t * c;
+
+                // J = [c, s; -s conj(phase), c conj(phase)] acting on columns p and q
+                const ValueType Jpp = c;
+                const ValueType Jpq = s;
+                const ValueType Jqp = -s * cusp::conj(phase);
+                const ValueType Jqq =  c * cusp::conj(phase);
+
+                // A = A J
+                for (size_t k = 0; k < n; k++)
+                {
+                    ValueType akp = A(k, p);
+                    ValueType akq = A(k, q);
+                    A(k, p) = akp * Jpp + akq * Jqp;
+                    A(k, q) = akp * Jpq + akq * Jqq;
+                }
+
+                // A = J^H A
+                for (size_t k = 0; k < n; k++)
+                {
+                    ValueType apk = A(p, k);
+                    ValueType aqk = A(q, k);
+                    A(p, k) = cusp::conj(Jpp) * apk + cusp::conj(Jqp) * aqk;
+                    A(q, k) = cusp::conj(Jpq) * apk + cusp::conj(Jqq) * aqk;
+                }
+
+                A(p, q) = ValueType(0);
+                A(q, p) = ValueType(0);
+                A(p, p) = ValueType(real_part(A(p, p)));
+                A(q, q) = ValueType(real_part(A(q, q)));
+
+                // V = V J
+                for (size_t k = 0; k < n; k++)
+                {
+                    ValueType vkp = V(k, p);
+                    ValueType vkq = V(k, q);
+                    V(k, p) = vkp * Jpp + vkq * Jqp;
+                    V(k, q) = vkp * Jpq + vkq * Jqq;
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < n; i++)
+        w[i] = real_part(A(i, i));
+}
+
+template <typename Array1d>
+struct eigenvalue_less
+{
+    const Array1d& w;
+
+    eigenvalue_less(const Array1d& w) : w(w) {}
+
+    bool operator()(const size_t i, const size_t j) const
+    {
+        return w[i] < w[j];
+    }
+};
+
+} // end namespace detail
+} // end namespace krylov
+} // end namespace cusp
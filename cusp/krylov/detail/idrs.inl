@@ -0,0 +1,288 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/complex.h>
+#include <cusp/copy.h>
+#include <cusp/linear_operator.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+
+#include <cusp/detail/temporary_array.h>
+#include <cusp/krylov/detail/block_ops.h>
+
+#include <thrust/copy.h>
+
+namespace blas = cusp::blas;
+
+namespace cusp
+{
+namespace krylov
+{
+namespace idrs_detail
+{
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void idrs(thrust::execution_policy<DerivedPolicy> &exec,
+          const LinearOperator& A,
+                VectorType1& x,
+          const VectorType2& b,
+          const size_t s,
+                Monitor& monitor,
+                Preconditioner& M)
+{
+    typedef typename LinearOperator::value_type ValueType;
+    typedef typename cusp::norm_type<ValueType>::type NormType;
+    typedef typename cusp::minimum_space<
+    typename LinearOperator::memory_space, typename VectorType1::memory_space,
+             typename Preconditioner::memory_space>::type MemorySpace;
+    typedef cusp::array2d<ValueType, MemorySpace, cusp::column_major> Block;
+    typedef typename Block::column_view ColumnView;
+
+    assert(A.num_rows == A.num_cols);  // sanity check
+
+    const size_t N = A.num_rows;
+
+    // lower bound on the cosine of the angle between t and r
+    const NormType angle = 0.7;
+
+    // allocate workspace
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> r(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> v(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> t(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> f_dev(exec, s);
+
+    // shadow space P and the blocks G = A U
+    Block P(N, s);
+    Block G(N, s, ValueType(0));
+    Block U(N, s, ValueType(0));
+
+    // HOST WORKSPACE
+    cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> Ms(s, s, ValueType(0)); // Ms = P^H G
+    cusp::array1d<ValueType, cusp::host_memory> f(s);
+    cusp::array1d<ValueType, cusp::host_memory> c(s);
+
+    for (size_t i = 0; i < s; i++)
+        Ms(i, i) = ValueType(1);
+
+    // random orthonormal shadow space
+    cusp::copy(cusp::random_array<NormType>(N * s), P.values);
+
+    for (size_t j = 0; j < s; j++)
+    {
+        ColumnView Pj = P.column(j);
+
+        for (size_t i = 0; i < j; i++)
+            blas::axpy(exec, P.column(i), Pj, -blas::dotc(exec, P.column(i), Pj));
+
+        blas::scal(exec, Pj, ValueType(NormType(1) / blas::nrm2(exec, Pj)));
+    }
+
+    ValueType omega(1);
+
+    // r <- b - A*x
+    cusp::multiply(exec, A, x, r);
+    blas::axpby(exec, b, r, r, ValueType(1), ValueType(-1));
+
+    while (!monitor.finished(exec, r))
+    {
+        // f = P^H r
+        cusp::krylov::detail::block_dotc(exec, P, 0, s, r, f_dev);
+        thrust::copy(f_dev.begin(), f_dev.begin() + s, f.begin());
+
+        for (size_t k = 0; k < s; k++)
+        {
+            // solve the lower triangular system Ms(k:s,k:s) c = f(k:s)
+            for (size_t i = k; i < s; i++)
+            {
+                ValueType sum = f[i];
+
+                for (size_t j = k; j < i; j++)
+                    sum -= Ms(i, j) * c[j];
+
+                c[i] = sum / Ms(i, i);
+            }
+
+            // v = r - G(:,k:s) c
+            blas::copy(exec, r, v);
+
+            for (size_t j = k; j < s; j++)
+                blas::axpy(exec, G.column(j), v, -c[j]);
+
+            // t = M v
+            cusp::multiply(exec, M, v, t);
+
+            // U(:,k) = U(:,k:s) c + omega t
+            blas::scal(exec, t, omega);
+
+            for (size_t j = k; j < s; j++)
+                blas::axpy(exec, U.column(j), t, c[j]);
+
+            ColumnView Uk = U.column(k);
+            ColumnView Gk = G.column(k);
+
+            blas::copy(exec, t, Uk);
+
+            // G(:,k) = A U(:,k)
+            cusp::multiply(exec, A, Uk, Gk);
+
+            // make G(:,k) orthogonal to P(:,0:k)
+            for (size_t i = 0; i < k; i++)
+            {
+                ValueType alpha = blas::dotc(exec, P.column(i), Gk) / Ms(i, i);
+
+                blas::axpy(exec, G.column(i), Gk, -alpha);
+                blas::axpy(exec, U.column(i), Uk, -alpha);
+            }
+
+            // Ms(k:s,k) = P(:,k:s)^H G(:,k)
+            cusp::krylov::detail::block_dotc(exec, P, k, s, Gk, f_dev);
+            thrust::copy(f_dev.begin(), f_dev.begin() + (s - k), Ms.values.begin() + k * s + k);
+
+            if (Ms(k, k) == ValueType(0))
+                return;
+
+            // make r orthogonal to P(:,0:k+1)
+            ValueType beta = f[k] / Ms(k, k);
+
+            blas::axpy(exec, Gk, r, -beta);
+            blas::axpy(exec, Uk, x,  beta);
+
+            ++monitor;
+
+            if (monitor.finished(exec, r))
+                return;
+
+            // f(k+1:s) = f(k+1:s) - beta * Ms(k+1:s,k)
+            for (size_t i = k + 1; i < s; i++)
+                f[i] -= beta * Ms(i, k);
+        }
+
+        // dimension reduction step
+        cusp::multiply(exec, M, r, v);
+        cusp::multiply(exec, A, v, t);
+
+        NormType norm_t = blas::nrm2(exec, t);
+        NormType norm_r = blas::nrm2(exec, r);
+
+        if (norm_t == NormType(0))
+            return;
+
+        ValueType t_r = blas::dotc(exec, t, r);
+        NormType  rho = cusp::abs(t_r / (norm_t * norm_r));
+
+        omega = t_r / (norm_t * norm_t);
+
+        if (rho < angle)
+            omega *= angle / rho;
+
+        if (omega == ValueType(0))
+            return;
+
+        blas::axpy(exec, t, r, -omega);
+        blas::axpy(exec, v, x,  omega);
+
+        ++monitor;
+    }
+}
+
+} // end idrs_detail namespace
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void idrs(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+          const LinearOperator& A,
+                VectorType1& x,
+          const VectorType2& b,
+          const size_t s,
+                Monitor& monitor,
+                Preconditioner& M)
+{
+    using cusp::krylov::idrs_detail::idrs;
+
+    return idrs(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, x, b, s, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void idrs(const LinearOperator& A,
+                VectorType1& x,
+          const VectorType2& b,
+          const size_t s,
+                Monitor& monitor,
+                Preconditioner& M)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename VectorType1::memory_space    System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::krylov::idrs(select_system(system1,system2), A, x, b, s, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor>
+void idrs(const LinearOperator& A,
+                VectorType1& x,
+          const VectorType2& b,
+          const size_t s,
+                Monitor& monitor)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+    typedef typename LinearOperator::memory_space MemorySpace;
+
+    cusp::identity_operator<ValueType,MemorySpace> M(A.num_rows, A.num_cols);
+
+    return cusp::krylov::idrs(A, x, b, s, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2>
+void idrs(const LinearOperator& A,
+                VectorType1& x,
+          const VectorType2& b,
+          const size_t s)
+{
+    typedef typename LinearOperator::value_type ValueType;
+
+    cusp::monitor<ValueType> monitor(b);
+
+    return cusp::krylov::idrs(A, x, b, s, monitor);
+}
+
+} // end namespace krylov
+} // end namespace cusp
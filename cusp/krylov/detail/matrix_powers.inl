@@ -0,0 +1,332 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/exception.h>
+#include <cusp/format.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace cusp
+{
+namespace krylov
+{
+namespace matrix_powers_detail
+{
+
+template <typename IndexType>
+struct global_index_less
+{
+    const std::vector<IndexType>& rows;
+
+    global_index_less(const std::vector<IndexType>& rows) : rows(rows) {}
+
+    bool operator()(const IndexType i, const IndexType j) const
+    {
+        return rows[i] < rows[j];
+    }
+};
+
+template <typename IndexType>
+struct global_index_compare
+{
+    const std::vector<IndexType>& rows;
+
+    global_index_compare(const std::vector<IndexType>& rows) : rows(rows) {}
+
+    bool operator()(const IndexType i, const IndexType global) const
+    {
+        return rows[i] < global;
+    }
+};
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename Array2d,
+          typename ValueType>
+void matrix_powers(thrust::execution_policy<DerivedPolicy> &exec,
+                   const LinearOperator& A,
+                         Array2d& V,
+                   const polynomial_basis<ValueType>& basis,
+                   cusp::csr_format, cusp::host_memory)
+{
+    typedef typename LinearOperator::index_type IndexType;
+    typedef typename Array2d::value_type        ValueType2;
+
+    // number of rows whose s steps are computed together
+    const IndexType block_size = 4096;
+
+    const IndexType N = A.num_rows;
+    const int s = basis.size();
+    const size_t pitch = V.pitch;
+    const int num_blocks = (N + block_size - 1) / block_size;
+
+    #pragma omp parallel
+    {
+        // rows of the block followed by the rows at distance 1, 2, ...
+        std::vector<IndexType> rows;
+        std::vector<size_t> level_end(s);
+
+        // sorted global indices of rows, and a permutation sorting rows
+        std::vector<IndexType> members;
+        std::vector<IndexType> candidates;
+        std::vector<IndexType> merged;
+        std::vector<IndexType> order;
+
+        // local column indices of the rows computing more than one step
+        std::vector<IndexType> local_columns;
+
+        // steps 1, ..., s of the vectors restricted to rows
+        std::vector<ValueType2> W;
+
+        #pragma omp for schedule(dynamic)
+        for (int block = 0; block < num_blocks; block++)
+        {
+            const IndexType row_begin = block * block_size;
+            const IndexType row_end   = std::min(N, row_begin + block_size);
+
+            rows.clear();
+            members.clear();
+
+            for (IndexType i = row_begin; i < row_end; i++)
+            {
+                rows.push_back(i);
+                members.push_back(i);
+            }
+
+            level_end[0] = rows.size();
+
+            // step j is needed on the rows within distance s - j of the block
+            for (int k = 1; k < s; k++)
+            {
+                candidates.clear();
+
+                for (size_t l = (k == 1 ? 0 : level_end[k - 2]); l < level_end[k - 1]; l++)
+                    for (IndexType jj = A.row_offsets[rows[l]]; jj < A.row_offsets[rows[l] + 1]; jj++)
+                        candidates.push_back(A.column_indices[jj]);
+
+                std::sort(candidates.begin(), candidates.end());
+                candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+                const size_t first = rows.size();
+
+                std::set_difference(candidates.begin(), candidates.end(),
+                                    members.begin(), members.end(),
+                                    std::back_inserter(rows));
+
+                merged.resize(members.size() + rows.size() - first);
+                std::merge(members.begin(), members.end(), rows.begin() + first, rows.end(), merged.begin());
+                members.swap(merged);
+
+                level_end[k] = rows.size();
+            }
+
+            const size_t n = rows.size();
+            const size_t inner = s > 1 ? level_end[s - 2] : 0;
+
+            // translate the column indices of the inner rows once
+            order.resize(n);
+            for (size_t l = 0; l < n; l++)
+                order[l] = l;
+
+            std::sort(order.begin(), order.end(), global_index_less<IndexType>(rows));
+
+            local_columns.clear();
+
+            for (size_t l = 0; l < inner; l++)
+            {
+                for (IndexType jj = A.row_offsets[rows[l]]; jj < A.row_offsets[rows[l] + 1]; jj++)
+                {
+                    typename std::vector<IndexType>::const_iterator pos =
+                        std::lower_bound(order.begin(), order.end(), A.column_indices[jj],
+                                         global_index_compare<IndexType>(rows));
+                    local_columns.push_back(*pos);
+                }
+            }
+
+            W.resize(n * s);
+
+            for (int j = 1; j <= s; j++)
+            {
+                const size_t count = level_end[s - j];
+
+                const ValueType2 alpha = basis.alpha[j - 1];
+                const ValueType2 beta  = basis.beta[j - 1];
+                const ValueType2 gamma = basis.gamma[j - 1];
+
+                ValueType2*       Wj  = &W[(j - 1) * n];
+                const ValueType2* Wj1 = j > 1 ? &W[(j - 2) * n] : NULL;
+                const ValueType2* Wj2 = j > 2 ? &W[(j - 3) * n] : NULL;
+
+                size_t offset = 0;
+
+                for (size_t l = 0; l < count; l++)
+                {
+                    const IndexType i = rows[l];
+
+                    ValueType2 sum = 0;
+
+                    if (j == 1)
+                    {
+                        for (IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+                            sum += A.values[jj] * V.values[A.column_indices[jj]];
+
+                        sum -= alpha * V.values[i];
+                    }
+                    else
+                    {
+                        for (IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++, offset++)
+                            sum += A.values[jj] * Wj1[local_columns[offset]];
+
+                        sum -= alpha * Wj1[l];
+                        sum -= beta * (j == 2 ? ValueType2(V.values[i]) : Wj2[l]);
+                    }
+
+                    Wj[l] = sum / gamma;
+                }
+            }
+
+            for (int j = 1; j <= s; j++)
+                for (size_t l = 0; l < level_end[0]; l++)
+                    V.values[j * pitch + rows[l]] = W[(j - 1) * n + l];
+        }
+    }
+}
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename Array2d,
+          typename ValueType,
+          typename Format,
+          typename MemorySpace>
+void matrix_powers(thrust::execution_policy<DerivedPolicy> &exec,
+                   const LinearOperator& A,
+                         Array2d& V,
+                   const polynomial_basis<ValueType>& basis,
+                   Format, MemorySpace)
+{
+    typedef typename Array2d::value_type  ValueType2;
+    typedef typename Array2d::column_view ColumnView;
+
+    for (size_t j = 0; j < basis.size(); j++)
+    {
+        const ValueType2 alpha = basis.alpha[j];
+        const ValueType2 beta  = basis.beta[j];
+        const ValueType2 gamma = ValueType2(1) / ValueType2(basis.gamma[j]);
+
+        ColumnView Vj = V.column(j + 1);
+
+        cusp::multiply(exec, A, V.column(j), Vj);
+
+        // Vj = (Vj - alpha V(j) - beta V(j-1)) / gamma
+        if (j > 0 && beta != ValueType2(0))
+            cusp::blas::axpbypcz(exec, Vj, V.column(j), V.column(j - 1), Vj, gamma, -alpha * gamma, -beta * gamma);
+        else if (alpha != ValueType2(0) || gamma != ValueType2(1))
+            cusp::blas::axpby(exec, Vj, V.column(j), Vj, gamma, -alpha * gamma);
+    }
+}
+
+} // end matrix_powers_detail namespace
+
+template <typename ValueType>
+polynomial_basis<ValueType>
+monomial_basis(const size_t s)
+{
+    return polynomial_basis<ValueType>(s);
+}
+
+template <typename ArrayType>
+polynomial_basis<typename ArrayType::value_type>
+newton_basis(const ArrayType& shifts)
+{
+    typedef typename ArrayType::value_type ValueType;
+
+    polynomial_basis<ValueType> basis(shifts.size());
+
+    for (size_t j = 0; j < shifts.size(); j++)
+        basis.alpha[j] = shifts[j];
+
+    return basis;
+}
+
+template <typename ValueType>
+polynomial_basis<ValueType>
+chebyshev_basis(const size_t s, const ValueType lambda_min, const ValueType lambda_max)
+{
+    if (!(lambda_max > lambda_min))
+        throw cusp::invalid_input_exception("chebyshev_basis requires lambda_min < lambda_max");
+
+    const ValueType center     = (lambda_max + lambda_min) / ValueType(2);
+    const ValueType half_width = (lambda_max - lambda_min) / ValueType(2);
+
+    polynomial_basis<ValueType> basis(s);
+
+    // A v_0 = d v_1 + c v_0 and A v_j = d/2 v_{j+1} + c v_j + d/2 v_{j-1}
+    for (size_t j = 0; j < s; j++)
+    {
+        basis.alpha[j] = center;
+        basis.beta[j]  = j == 0 ? ValueType(0) : half_width / ValueType(2);
+        basis.gamma[j] = j == 0 ? half_width   : half_width / ValueType(2);
+    }
+
+    return basis;
+}
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename Array2d,
+          typename ValueType>
+void matrix_powers(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                   const LinearOperator& A,
+                         Array2d& V,
+                   const polynomial_basis<ValueType>& basis)
+{
+    using cusp::krylov::matrix_powers_detail::matrix_powers;
+
+    typedef typename LinearOperator::format       Format;
+    typedef typename LinearOperator::memory_space MemorySpace;
+
+    if (A.num_rows != A.num_cols || V.num_rows != A.num_rows || V.num_cols < basis.size() + 1)
+        throw cusp::invalid_input_exception("matrix_powers requires a square matrix and basis.size() + 1 columns");
+
+    matrix_powers(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, V, basis,
+                  Format(), MemorySpace());
+}
+
+template <typename LinearOperator,
+          typename Array2d,
+          typename ValueType>
+void matrix_powers(const LinearOperator& A,
+                         Array2d& V,
+                   const polynomial_basis<ValueType>& basis)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename Array2d::memory_space        System2;
+
+    System1 system1;
+    System2 system2;
+
+    cusp::krylov::matrix_powers(select_system(system1,system2), A, V, basis);
+}
+
+} // end namespace krylov
+} // end namespace cusp
@@ -0,0 +1,260 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/complex.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+
+#include <cusp/krylov/detail/hermitian_eigen.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace cusp
+{
+namespace krylov
+{
+namespace detail
+{
+
+// Computes the eigenvectors Y of the k smallest eigenvalues of the
+// Hermitian pencil A y = lambda B y with B positive semidefinite. The
+// numerical null space of B is discarded first, so B may be singular.
+// Returns the number of computed eigenvectors.
+template <typename Array2d1, typename Array2d2, typename Array2d3>
+size_t smallest_eigenvectors(const Array2d1& A, const Array2d2& B, const size_t k, Array2d3& Y)
+{
+    typedef typename Array2d1::value_type ValueType;
+    typedef typename cusp::norm_type<ValueType>::type NormType;
+    typedef cusp::array1d<NormType, cusp::host_memory> NormArray;
+
+    const size_t n = A.num_rows;
+    const NormType eps = std::numeric_limits<NormType>::epsilon();
+
+    cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> Q;
+    NormArray mu;
+
+    hermitian_eigen(B, mu, Q);
+
+    NormType mu_max = 0;
+    for (size_t i = 0; i < n; i++)
+        mu_max = std::max(mu_max, mu[i]);
+
+    // T = Q(:,J) diag(mu(J))^{-1/2} for the numerically nonzero mu(J)
+    std::vector<size_t> J;
+    for (size_t i = 0; i < n; i++)
+        if (mu[i] > NormType(100 * n) * eps * mu_max)
+            J.push_back(i);
+
+    const size_t r = J.size();
+
+    cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> T(n, r);
+
+    for (size_t j = 0; j < r; j++)
+        for (size_t i = 0; i < n; i++)
+            T(i, j) = Q(i, J[j]) / std::sqrt(mu[J[j]]);
+
+    // Ar = T^H A T
+    cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> AT(n, r, ValueType(0));
+    cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> Ar(r, r, ValueType(0));
+
+    for (size_t j = 0; j < r; j++)
+        for (size_t l = 0; l < n; l++)
+            for (size_t i = 0; i < n; i++)
+                AT(i, j) += A(i, l) * T(l, j);
+
+    for (size_t j = 0; j < r; j++)
+        for (size_t i = 0; i < r; i++)
+            for (size_t l = 0; l < n; l++)
+                Ar(i, j) += cusp::conj(T(l, i)) * AT(l, j);
+
+    cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> S;
+    NormArray lambda;
+
+    hermitian_eigen(Ar, lambda, S);
+
+    std::vector<size_t> order(r);
+    for (size_t i = 0; i < r; i++)
+        order[i] = i;
+
+    std::sort(order.begin(), order.end(), eigenvalue_less<NormArray>(lambda));
+
+    const size_t m = std::min(k, r);
+
+    Y.resize(n, m);
+
+    for (size_t j = 0; j < m; j++)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            ValueType sum = 0;
+
+            for (size_t l = 0; l < r; l++)
+                sum += T(i, l) * S(l, order[j]);
+
+            Y(i, j) = sum;
+        }
+    }
+
+    return m;
+}
+
+// Orthonormalize the first n columns of C with modified Gram-Schmidt and
+// apply the same column operations to U, so that C = A U is preserved.
+// Dependent columns are dropped. Returns the number of remaining columns.
+template <typename DerivedPolicy, typename Array2d1, typename Array2d2>
+size_t orthonormalize_pair(thrust::execution_policy<DerivedPolicy> &exec,
+                           Array2d1& C, Array2d2& U, const size_t n)
+{
+    typedef typename Array2d1::value_type ValueType;
+    typedef typename cusp::norm_type<ValueType>::type NormType;
+    typedef typename Array2d1::column_view ColumnView1;
+    typedef typename Array2d2::column_view ColumnView2;
+
+    const NormType eps = std::numeric_limits<NormType>::epsilon();
+
+    size_t m = 0;
+
+    for (size_t j = 0; j < n; j++)
+    {
+        ColumnView1 Cm = C.column(m);
+        ColumnView2 Um = U.column(m);
+
+        if (m != j)
+        {
+            cusp::blas::copy(exec, C.column(j), Cm);
+            cusp::blas::copy(exec, U.column(j), Um);
+        }
+
+        NormType norm0 = cusp::blas::nrm2(exec, Cm);
+
+        // two passes of Gram-Schmidt
+        for (size_t pass = 0; pass < 2; pass++)
+        {
+            for (size_t i = 0; i < m; i++)
+            {
+                ValueType h = cusp::blas::dotc(exec, C.column(i), Cm);
+
+                cusp::blas::axpy(exec, C.column(i), Cm, -h);
+                cusp::blas::axpy(exec, U.column(i), Um, -h);
+            }
+        }
+
+        NormType norm = cusp::blas::nrm2(exec, Cm);
+
+        if (norm <= NormType(100) * eps * norm0 || norm == NormType(0))
+            continue;
+
+        cusp::blas::scal(exec, Cm, ValueType(NormType(1) / norm));
+        cusp::blas::scal(exec, Um, ValueType(NormType(1) / norm));
+
+        m++;
+    }
+
+    return m;
+}
+
+// Make the first n columns of U orthonormal in the A inner product
+// <u, v>_A = u^H C v for Hermitian positive definite A, applying the same
+// column operations to C = A U. Dependent columns are dropped. Returns the
+// number of remaining columns.
+template <typename DerivedPolicy, typename Array2d1, typename Array2d2>
+size_t a_orthonormalize_pair(thrust::execution_policy<DerivedPolicy> &exec,
+                             Array2d1& U, Array2d2& C, const size_t n)
+{
+    typedef typename Array2d1::value_type ValueType;
+    typedef typename cusp::norm_type<ValueType>::type NormType;
+    typedef typename Array2d1::column_view ColumnView1;
+    typedef typename Array2d2::column_view ColumnView2;
+
+    const NormType eps = std::numeric_limits<NormType>::epsilon();
+
+    size_t m = 0;
+
+    for (size_t j = 0; j < n; j++)
+    {
+        ColumnView1 Um = U.column(m);
+        ColumnView2 Cm = C.column(m);
+
+        if (m != j)
+        {
+            cusp::blas::copy(exec, U.column(j), Um);
+            cusp::blas::copy(exec, C.column(j), Cm);
+        }
+
+        NormType norm0 = real_part(cusp::blas::dotc(exec, Um, Cm));
+
+        // two passes of Gram-Schmidt
+        for (size_t pass = 0; pass < 2; pass++)
+        {
+            for (size_t i = 0; i < m; i++)
+            {
+                ValueType h = cusp::blas::dotc(exec, C.column(i), Um);
+
+                cusp::blas::axpy(exec, U.column(i), Um, -h);
+                cusp::blas::axpy(exec, C.column(i), Cm, -h);
+            }
+        }
+
+        NormType norm = real_part(cusp::blas::dotc(exec, Um, Cm));
+
+        if (!(norm > NormType(100) * eps * norm0) || norm <= NormType(0))
+            continue;
+
+        norm = std::sqrt(norm);
+
+        cusp::blas::scal(exec, Um, ValueType(NormType(1) / norm));
+        cusp::blas::scal(exec, Cm, ValueType(NormType(1) / norm));
+
+        m++;
+    }
+
+    return m;
+}
+
+// Reset the space when the dimension of the system changes and
+// recompute C = A U for the current matrix
+template <typename DerivedPolicy, typename LinearOperator, typename ValueType, typename MemorySpace>
+void refresh_space(thrust::execution_policy<DerivedPolicy> &exec,
+                   const LinearOperator& A,
+                   cusp::krylov::recycle_space<ValueType,MemorySpace>& space)
+{
+    typedef typename cusp::array2d<ValueType, MemorySpace, cusp::column_major>::column_view ColumnView;
+
+    const size_t N = A.num_rows;
+
+    if (space.U.num_rows != N || space.U.num_cols != space.max_size)
+    {
+        space.U.resize(N, space.max_size);
+        space.C.resize(N, space.max_size);
+        space.num_vectors = 0;
+    }
+
+    for (size_t j = 0; j < space.num_vectors; j++)
+    {
+        ColumnView Cj = space.C.column(j);
+        cusp::multiply(exec, A, space.U.column(j), Cj);
+    }
+}
+
+} // end namespace detail
+} // end namespace krylov
+} // end namespace cusp
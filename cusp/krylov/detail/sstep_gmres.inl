@@ -0,0 +1,609 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/complex.h>
+#include <cusp/exception.h>
+#include <cusp/linear_operator.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+#include <cusp/operator_expressions.h>
+
+#include <cusp/blas/blas.h>
+#include <cusp/krylov/gmres.h>
+#include <cusp/krylov/matrix_powers.h>
+
+#include <cusp/detail/temporary_array.h>
+#include <cusp/krylov/detail/block_ops.h>
+#include <cusp/krylov/detail/hermitian_eigen.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace blas = cusp::blas;
+
+namespace cusp
+{
+namespace krylov
+{
+namespace sstep_gmres_detail
+{
+
+// Upper triangular R with R^H R = G. Returns false if G is not
+// numerically positive definite.
+template <typename Array2d1, typename Array2d2>
+bool cholesky(const Array2d1& G, Array2d2& R)
+{
+    typedef typename Array2d1::value_type ValueType;
+    typedef typename cusp::norm_type<ValueType>::type NormType;
+
+    const size_t n = G.num_rows;
+    const NormType eps = std::numeric_limits<NormType>::epsilon();
+
+    R.resize(n, n);
+    cusp::blas::fill(R.values, ValueType(0));
+
+    for (size_t j = 0; j < n; j++)
+    {
+        for (size_t i = 0; i <= j; i++)
+        {
+            ValueType sum = G(i, j);
+
+            for (size_t l = 0; l < i; l++)
+                sum -= cusp::conj(R(l, i)) * R(l, j);
+
+            if (i < j)
+            {
+                R(i, j) = sum / R(i, i);
+            }
+            else
+            {
+                NormType d = cusp::krylov::detail::real_part(sum);
+
+                if (!(d > NormType(100 * n) * eps * cusp::abs(G(j, j))))
+                    return false;
+
+                R(j, j) = std::sqrt(d);
+            }
+        }
+    }
+
+    return true;
+}
+
+// R = R1 R with upper triangular R1 and R
+template <typename Array2d1, typename Array2d2>
+void upper_multiply(const Array2d1& R1, Array2d2& R)
+{
+    typedef typename Array2d2::value_type ValueType;
+
+    const size_t n = R.num_rows;
+
+    for (size_t j = 0; j < n; j++)
+    {
+        for (size_t i = 0; i <= j; i++)
+        {
+            ValueType sum = 0;
+
+            for (size_t l = i; l <= j; l++)
+                sum += R1(i, l) * R(l, j);
+
+            R(i, j) = sum;
+        }
+    }
+}
+
+// Orthonormalize the columns of W with two passes of modified Gram-Schmidt
+// and accumulate the triangular factor into R. Returns the number of
+// leading independent columns.
+template <typename DerivedPolicy, typename Array2d1, typename Array2d2>
+size_t modified_gram_schmidt(thrust::execution_policy<DerivedPolicy> &exec, Array2d1& W, Array2d2& R)
+{
+    typedef typename Array2d1::value_type ValueType;
+    typedef typename cusp::norm_type<ValueType>::type NormType;
+    typedef typename Array2d1::column_view ColumnView;
+
+    const size_t n = W.num_cols;
+    const NormType eps = std::numeric_limits<NormType>::epsilon();
+
+    cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> R1(n, n, ValueType(0));
+
+    size_t rank = n;
+
+    for (size_t i = 0; i < n && rank == n; i++)
+    {
+        ColumnView Wi = W.column(i);
+
+        NormType norm0 = blas::nrm2(exec, Wi);
+
+        for (size_t pass = 0; pass < 2; pass++)
+        {
+            for (size_t l = 0; l < i; l++)
+            {
+                ValueType h = blas::dotc(exec, W.column(l), Wi);
+                blas::axpy(exec, W.column(l), Wi, -h);
+                R1(l, i) += h;
+            }
+        }
+
+        NormType norm = blas::nrm2(exec, Wi);
+
+        if (norm <= NormType(100) * eps * norm0 || norm == NormType(0))
+        {
+            rank = i;
+        }
+        else
+        {
+            blas::scal(exec, Wi, ValueType(NormType(1) / norm));
+            R1(i, i) = norm;
+        }
+    }
+
+    upper_multiply(R1, R);
+
+    return rank;
+}
+
+// QR factorization W = Q R of a tall and skinny block with two passes of
+// Cholesky QR, falling back to Gram-Schmidt for ill-conditioned blocks.
+// Q overwrites W. Returns the number of leading independent columns.
+template <typename DerivedPolicy, typename Array2d1, typename Array2d2>
+size_t tall_skinny_qr(thrust::execution_policy<DerivedPolicy> &exec, Array2d1& W, Array2d2& R)
+{
+    typedef typename Array2d1::value_type ValueType;
+    typedef typename Array2d1::column_view ColumnView;
+    typedef cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> HostMatrix;
+
+    const size_t n = W.num_cols;
+
+    R.resize(n, n);
+    cusp::blas::fill(R.values, ValueType(0));
+
+    for (size_t i = 0; i < n; i++)
+        R(i, i) = ValueType(1);
+
+    HostMatrix G;
+    HostMatrix R1;
+
+    for (size_t pass = 0; pass < 2; pass++)
+    {
+        cusp::krylov::detail::block_gram(exec, W, n, W, n, G);
+
+        if (!cholesky(G, R1))
+            return modified_gram_schmidt(exec, W, R);
+
+        // W = W R1^{-1}
+        for (size_t i = 0; i < n; i++)
+        {
+            ColumnView Wi = W.column(i);
+
+            for (size_t l = 0; l < i; l++)
+                blas::axpy(exec, W.column(l), Wi, -R1(l, i));
+
+            blas::scal(exec, Wi, ValueType(1) / R1(i, i));
+        }
+
+        upper_multiply(R1, R);
+    }
+
+    return n;
+}
+
+// The first k of the values z in Leja order
+template <typename Array1d1, typename Array1d2>
+void leja_order(const Array1d1& z, const size_t k, Array1d2& shifts)
+{
+    typedef typename Array1d1::value_type NormType;
+
+    const size_t n = z.size();
+
+    std::vector<bool> used(n, false);
+
+    shifts.resize(std::min(k, n));
+
+    for (size_t j = 0; j < shifts.size(); j++)
+    {
+        size_t   best = n;
+        NormType best_value = -std::numeric_limits<NormType>::max();
+
+        for (size_t i = 0; i < n; i++)
+        {
+            if (used[i])
+                continue;
+
+            // log of the distance product to the chosen values, the largest
+            // magnitude for the first value
+            NormType value = j == 0 ? std::abs(z[i]) : NormType(0);
+
+            for (size_t l = 0; l < j; l++)
+                value += std::log(std::abs(z[i] - shifts[l]) + std::numeric_limits<NormType>::min());
+
+            if (value > best_value)
+            {
+                best = i;
+                best_value = value;
+            }
+        }
+
+        used[best] = true;
+        shifts[j] = z[best];
+    }
+}
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename PreconditionedOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void sstep_gmres(thrust::execution_policy<DerivedPolicy> &exec,
+                 const LinearOperator& A,
+                 const PreconditionedOperator& MA,
+                       VectorType1& x,
+                 const VectorType2& b,
+                 const size_t restart,
+                 const size_t s,
+                       Monitor& monitor,
+                       Preconditioner& M)
+{
+    typedef typename LinearOperator::value_type ValueType;
+    typedef typename cusp::norm_type<ValueType>::type NormType;
+    typedef typename cusp::minimum_space<
+    typename LinearOperator::memory_space, typename VectorType1::memory_space,
+             typename Preconditioner::memory_space>::type MemorySpace;
+    typedef cusp::array2d<ValueType, MemorySpace, cusp::column_major> Block;
+    typedef typename Block::view View;
+    typedef cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> HostMatrix;
+
+    assert(A.num_rows == A.num_cols);  // sanity check
+
+    if (s == 0 || s > restart)
+        throw cusp::invalid_input_exception("sstep_gmres requires 0 < s <= restart");
+
+    const size_t N = A.num_rows;
+    const size_t R = restart;
+
+    // allocate workspace
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> w(exec, N);
+    cusp::detail::temporary_array<ValueType, DerivedPolicy> r(exec, N);
+
+    // Krylov basis
+    Block V(N, R + 1, ValueType(0));
+
+    // HOST WORKSPACE
+    HostMatrix Hraw(R + 1, R, ValueType(0));  // Hessenberg matrix
+    HostMatrix H(R + 1, R, ValueType(0));     // rotated Hessenberg matrix
+    cusp::array1d<ValueType, cusp::host_memory> g(R + 1);
+    cusp::array1d<ValueType, cusp::host_memory> cs(R);
+    cusp::array1d<ValueType, cusp::host_memory> sn(R);
+    NormType resid = 0;
+
+    // the first cycle computes the shifts of the Newton basis
+    cusp::krylov::polynomial_basis<ValueType> basis(1);
+    bool first_cycle = true;
+
+    do
+    {
+        // V(0) = M (b - A x) / beta
+        cusp::multiply(exec, A, x, w);
+        blas::axpby(exec, b, w, w, ValueType(1), ValueType(-1));
+        cusp::multiply(exec, M, w, r);
+
+        NormType beta = blas::nrm2(exec, r);
+
+        blas::fill(g, ValueType(0));
+        blas::fill(Hraw.values, ValueType(0));
+        blas::fill(H.values, ValueType(0));
+        g[0] = beta;
+        resid = beta;
+
+        if (monitor.finished_norm(resid))
+            break;
+
+        typename Block::column_view V0 = V.column(0);
+        blas::copy(exec, r, V0);
+        blas::scal(exec, V0, ValueType(NormType(1) / beta));
+
+        size_t j = 0;
+        size_t n = 0;
+        bool done = false;
+
+        while (!done)
+        {
+            const size_t sb = std::min(basis.size(), R - j);
+
+            cusp::krylov::polynomial_basis<ValueType> block_basis(basis);
+            block_basis.alpha.resize(sb);
+            block_basis.beta.resize(sb);
+            block_basis.gamma.resize(sb);
+
+            // W = [V(j), p_1(MA) V(j), ..., p_sb(MA) V(j)]
+            View W(N, sb + 1, N, cusp::make_array1d_view(V.values.begin() + j * N, V.values.begin() + (j + sb + 1) * N));
+            View W1(N, sb, N, cusp::make_array1d_view(V.values.begin() + (j + 1) * N, V.values.begin() + (j + sb + 1) * N));
+
+            cusp::krylov::matrix_powers(exec, MA, W, block_basis);
+
+            // block Gram-Schmidt against V(0:j+1), C accumulates the projections
+            HostMatrix C(j + 1, sb, ValueType(0));
+            HostMatrix Cp;
+
+            for (size_t pass = 0; pass < 2; pass++)
+            {
+                cusp::krylov::detail::block_gram(exec, V, j + 1, W1, sb, Cp);
+
+                for (size_t i = 0; i < Cp.values.size(); i++)
+                {
+                    C.values[i] += Cp.values[i];
+                    Cp.values[i] = -Cp.values[i];
+                }
+
+                cusp::krylov::detail::block_combine(exec, V, 0, Cp, 0, j + 1, W1, true);
+            }
+
+            HostMatrix Rs;
+            const size_t rank = tall_skinny_qr(exec, W1, Rs);
+            const size_t nb = std::max(rank, size_t(1));
+
+            if (rank == 0)
+                Rs(0, 0) = ValueType(0);
+
+            // W(:,0:nb+1) = V(:,0:j+nb+1) Rhat
+            HostMatrix Rhat(j + nb + 1, nb + 1, ValueType(0));
+
+            Rhat(j, 0) = ValueType(1);
+
+            for (size_t c = 1; c <= nb; c++)
+            {
+                for (size_t i = 0; i <= j; i++)
+                    Rhat(i, c) = C(i, c - 1);
+
+                for (size_t i = 0; i < c; i++)
+                    Rhat(j + 1 + i, c) = Rs(i, c - 1);
+            }
+
+            // MA W(:,0:nb) = W(:,0:nb+1) B
+            HostMatrix B(nb + 1, nb, ValueType(0));
+
+            for (size_t c = 0; c < nb; c++)
+            {
+                B(c, c)     = block_basis.alpha[c];
+                B(c + 1, c) = block_basis.gamma[c];
+
+                if (c > 0)
+                    B(c - 1, c) = block_basis.beta[c];
+            }
+
+            // MA V(:,j:j+nb) Rhat(j:j+nb,0:nb) = V (Rhat B - H(:,0:j) Rhat(0:j,0:nb))
+            HostMatrix T(j + nb + 1, nb, ValueType(0));
+
+            for (size_t c = 0; c < nb; c++)
+            {
+                for (size_t i = 0; i <= j + nb; i++)
+                {
+                    ValueType sum = 0;
+
+                    for (size_t l = 0; l <= nb; l++)
+                        sum += Rhat(i, l) * B(l, c);
+
+                    if (i <= j)
+                        for (size_t l = 0; l < j; l++)
+                            sum -= Hraw(i, l) * Rhat(l, c);
+
+                    T(i, c) = sum;
+                }
+            }
+
+            // H(:,j:j+nb) = T Rhat(j:j+nb,0:nb)^{-1}
+            for (size_t c = 0; c < nb; c++)
+            {
+                for (size_t i = 0; i <= j + nb; i++)
+                {
+                    ValueType sum = T(i, c);
+
+                    for (size_t l = 0; l < c; l++)
+                        sum -= Hraw(i, j + l) * Rhat(j + l, c);
+
+                    Hraw(i, j + c) = i <= j + c + 1 ? sum / Rhat(j + c, c) : ValueType(0);
+                }
+            }
+
+            // update the QR factorization of H column by column
+            for (size_t c = 0; c < nb && !done; c++)
+            {
+                const size_t i = j + c;
+
+                for (size_t l = 0; l <= i + 1; l++)
+                    H(l, i) = Hraw(l, i);
+
+                cusp::krylov::gmres_detail::PlaneRotation(H, cs, sn, g, i);
+
+                resid = cusp::abs(g[i + 1]);
+
+                ++monitor;
+
+                n = i + 1;
+
+                if (monitor.finished_norm(resid))
+                    done = true;
+            }
+
+            j += nb;
+
+            if (rank < sb || j >= R)
+                done = true;
+        }
+
+        // solve upper triangular system in place
+        for (int i = n - 1; i >= 0; i--)
+        {
+            g[i] /= H(i, i);
+
+            for (int k = i - 1; k >= 0; k--)
+                g[k] -= H(k, i) * g[i];
+        }
+
+        // x = x + V(:,0:n) g(0:n)
+        for (size_t i = 0; i < n; i++)
+            blas::axpy(exec, V.column(i), x, g[i]);
+
+        // shifts for the following cycles
+        if (first_cycle && s > 1 && n >= s)
+        {
+            HostMatrix S(n, n);
+
+            for (size_t c = 0; c < n; c++)
+                for (size_t i = 0; i < n; i++)
+                    S(i, c) = (Hraw(i, c) + cusp::conj(Hraw(c, i))) / NormType(2);
+
+            cusp::array1d<NormType, cusp::host_memory> theta;
+            cusp::array1d<NormType, cusp::host_memory> leja;
+            HostMatrix Y;
+
+            cusp::krylov::detail::hermitian_eigen(S, theta, Y);
+            leja_order(theta, s, leja);
+
+            cusp::array1d<ValueType, cusp::host_memory> shifts(leja);
+            basis = cusp::krylov::newton_basis(shifts);
+        }
+
+        first_cycle = false;
+    }
+    while (!monitor.finished_norm(resid));
+}
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void sstep_gmres(thrust::execution_policy<DerivedPolicy> &exec,
+                 const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                 const size_t restart,
+                 const size_t s,
+                       Monitor& monitor,
+                       Preconditioner& M)
+{
+    sstep_gmres(exec, A, cusp::product(M, A), x, b, restart, s, monitor, M);
+}
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename ValueType,
+          typename MemorySpace>
+void sstep_gmres(thrust::execution_policy<DerivedPolicy> &exec,
+                 const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                 const size_t restart,
+                 const size_t s,
+                       Monitor& monitor,
+                       cusp::identity_operator<ValueType,MemorySpace>& M)
+{
+    sstep_gmres(exec, A, A, x, b, restart, s, monitor, M);
+}
+
+} // end sstep_gmres_detail namespace
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void sstep_gmres(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                 const size_t restart,
+                 const size_t s,
+                       Monitor& monitor,
+                       Preconditioner& M)
+{
+    using cusp::krylov::sstep_gmres_detail::sstep_gmres;
+
+    return sstep_gmres(thrust::detail::derived_cast(thrust::detail::strip_const(exec)), A, x, b, restart, s, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void sstep_gmres(const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                 const size_t restart,
+                 const size_t s,
+                       Monitor& monitor,
+                       Preconditioner& M)
+{
+    using thrust::system::detail::generic::select_system;
+
+    typedef typename LinearOperator::memory_space System1;
+    typedef typename VectorType1::memory_space    System2;
+
+    System1 system1;
+    System2 system2;
+
+    return cusp::krylov::sstep_gmres(select_system(system1,system2), A, x, b, restart, s, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor>
+void sstep_gmres(const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                 const size_t restart,
+                 const size_t s,
+                       Monitor& monitor)
+{
+    typedef typename LinearOperator::value_type   ValueType;
+    typedef typename LinearOperator::memory_space MemorySpace;
+
+    cusp::identity_operator<ValueType,MemorySpace> M(A.num_rows, A.num_cols);
+
+    return cusp::krylov::sstep_gmres(A, x, b, restart, s, monitor, M);
+}
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2>
+void sstep_gmres(const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                 const size_t restart,
+                 const size_t s)
+{
+    typedef typename LinearOperator::value_type ValueType;
+
+    cusp::monitor<ValueType> monitor(b);
+
+    return cusp::krylov::sstep_gmres(A, x, b, restart, s, monitor);
+}
+
+} // end namespace krylov
+} // end namespace cusp
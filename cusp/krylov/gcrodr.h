@@ -0,0 +1,174 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file gcrodr.h
+ *  \brief GCRO with deflated restarting (GCRO-DR) method
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/detail/execution_policy.h>
+#include <cusp/krylov/recycle_space.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace krylov
+{
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup krylov_methods Krylov Methods
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/* \cond */
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace,
+          typename Monitor,
+          typename Preconditioner>
+void gcrodr(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+            const LinearOperator& A,
+                  VectorType1& x,
+            const VectorType2& b,
+            const size_t m,
+                  RecycleSpace& space,
+                  Monitor& monitor,
+                  Preconditioner& M);
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace,
+          typename Monitor>
+void gcrodr(const LinearOperator& A,
+                  VectorType1& x,
+            const VectorType2& b,
+            const size_t m,
+                  RecycleSpace& space,
+                  Monitor& monitor);
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace>
+void gcrodr(const LinearOperator& A,
+                  VectorType1& x,
+            const VectorType2& b,
+            const size_t m,
+                  RecycleSpace& space);
+
+/* \endcond */
+
+/**
+ * \brief GCRO-DR method
+ *
+ * \tparam LinearOperator is a matrix or subclass of \p linear_operator
+ * \tparam VectorType1 vector
+ * \tparam RecycleSpace is a \p recycle_space
+ * \tparam Monitor is a \p monitor
+ * \tparam Preconditioner is a matrix or subclass of \p linear_operator
+ *
+ * \param A matrix of the linear system
+ * \param x approximate solution of the linear system
+ * \param b right-hand side of the linear system
+ * \param m dimension of the search space of every cycle, including the
+ * recycled vectors
+ * \param space recycled subspace, updated on return
+ * \param monitor montiors iteration and determines stopping conditions
+ * \param M preconditioner for A
+ *
+ * \par Overview
+ * Solves the nonsymmetric, linear system A x = b with right
+ * preconditioner \p M. Like restarted GMRES every cycle minimizes the
+ * residual over a Krylov space, but the space is augmented by the
+ * vectors of \p space and the directions of \p A that are hardest to
+ * resolve are carried over from one cycle to the next and into the next
+ * call. When solving a sequence of related systems pass the same \p space
+ * to every call. The preconditioned directions are stored as in flexible
+ * GMRES, hence \p M may change between the systems of a sequence.
+ *
+ * The recycled vectors are the \p space.max_size directions of the
+ * current search space on which \p A has the smallest gain
+ * <tt>|A z| / |z|</tt>. This selection reduces to a small Hermitian
+ * eigenvalue problem that is solved on the host.
+ *
+ * \par Example
+ *
+ *  The following code snippet demonstrates how to use \p gcrodr to
+ *  solve a sequence of 10x10 Poisson problems.
+ *
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/monitor.h>
+ *  #include <cusp/krylov/gcrodr.h>
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main(void)
+ *  {
+ *      cusp::csr_matrix<int, float, cusp::device_memory> A;
+ *      cusp::gallery::poisson5pt(A, 10, 10);
+ *
+ *      cusp::array1d<float, cusp::device_memory> x(A.num_rows, 0);
+ *      cusp::array1d<float, cusp::device_memory> b(A.num_rows, 1);
+ *
+ *      // keep up to 10 vectors between the solves
+ *      cusp::krylov::recycle_space<float, cusp::device_memory> space(10);
+ *
+ *      for (int i = 0; i < 4; i++)
+ *      {
+ *          cusp::monitor<float> monitor(b, 100, 1e-6, 0, true);
+ *
+ *          // search spaces of dimension 30, 20 new vectors per cycle
+ *          cusp::krylov::gcrodr(A, x, b, 30, space, monitor);
+ *
+ *          // ... update A and b
+ *      }
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ *
+ *  \see \p recycle_space
+ *  \see \p monitor
+ */
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename RecycleSpace,
+          typename Monitor,
+          typename Preconditioner>
+void gcrodr(const LinearOperator& A,
+                  VectorType1& x,
+            const VectorType2& b,
+            const size_t m,
+                  RecycleSpace& space,
+                  Monitor& monitor,
+                  Preconditioner& M);
+/*! \}
+ */
+
+} // end namespace krylov
+} // end namespace cusp
+
+#include <cusp/krylov/detail/gcrodr.inl>
@@ -0,0 +1,194 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file matrix_powers.h
+ *  \brief Matrix powers kernel for s-step Krylov methods
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/detail/execution_policy.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace krylov
+{
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup krylov_methods Krylov Methods
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/**
+ * \brief Polynomial basis of a Krylov space
+ *
+ * \tparam ValueType Type of the recurrence coefficients.
+ *
+ * \par Overview
+ * Describes the vectors <tt>v_0, ..., v_s</tt> of a Krylov space by the
+ * three-term recurrence
+ * <tt>A v_j = gamma[j] v_{j+1} + alpha[j] v_j + beta[j] v_{j-1}</tt>.
+ * The monomial basis is badly conditioned beyond a few steps, the Newton
+ * and Chebyshev bases keep the vectors of an s-step method independent
+ * for larger \c s when the shifts or the interval approximate the
+ * spectrum of \c A.
+ *
+ * \see \p monomial_basis, \p newton_basis, \p chebyshev_basis
+ */
+template <typename ValueType>
+class polynomial_basis
+{
+public:
+
+    /*! Shifts of the recurrence. */
+    cusp::array1d<ValueType, cusp::host_memory> alpha;
+
+    /*! Coefficients of the previous vector. */
+    cusp::array1d<ValueType, cusp::host_memory> beta;
+
+    /*! Scaling of the next vector. */
+    cusp::array1d<ValueType, cusp::host_memory> gamma;
+
+    /*! Construct an empty basis.
+     */
+    polynomial_basis(void) {}
+
+    /*! Construct the monomial basis of \p s steps.
+     *
+     *  \param s Number of steps.
+     */
+    polynomial_basis(const size_t s)
+        : alpha(s, ValueType(0)), beta(s, ValueType(0)), gamma(s, ValueType(1)) {}
+
+    /*! Number of steps of the basis.
+     */
+    size_t size(void) const
+    {
+        return alpha.size();
+    }
+};
+
+/**
+ * \brief Monomial basis <tt>v_{j+1} = A v_j</tt>
+ *
+ * \param s number of steps
+ */
+template <typename ValueType>
+polynomial_basis<ValueType>
+monomial_basis(const size_t s);
+
+/**
+ * \brief Newton basis <tt>v_{j+1} = (A - shifts[j] I) v_j</tt>
+ *
+ * \tparam ArrayType host array of shifts
+ *
+ * \param shifts shifts of the basis, preferably approximate eigenvalues
+ * of \c A in Leja order
+ */
+template <typename ArrayType>
+polynomial_basis<typename ArrayType::value_type>
+newton_basis(const ArrayType& shifts);
+
+/**
+ * \brief Chebyshev basis for the interval <tt>[lambda_min, lambda_max]</tt>
+ *
+ * \param s number of steps
+ * \param lambda_min lower end of the interval containing the spectrum
+ * \param lambda_max upper end of the interval containing the spectrum
+ *
+ * \par Overview
+ * <tt>v_j = T_j((A - c I) / d) v_0</tt> with the Chebyshev polynomials
+ * \c T_j, the center \c c and the half width \c d of the interval.
+ */
+template <typename ValueType>
+polynomial_basis<ValueType>
+chebyshev_basis(const size_t s, const ValueType lambda_min, const ValueType lambda_max);
+
+/* \cond */
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename Array2d,
+          typename ValueType>
+void matrix_powers(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                   const LinearOperator& A,
+                         Array2d& V,
+                   const polynomial_basis<ValueType>& basis);
+/* \endcond */
+
+/**
+ * \brief Matrix powers kernel
+ *
+ * \tparam LinearOperator is a matrix or subclass of \p linear_operator
+ * \tparam Array2d column-major \p array2d or \p array2d_view
+ * \tparam ValueType type of the basis coefficients
+ *
+ * \param A square matrix
+ * \param V block with <tt>basis.size() + 1</tt> columns, the first column
+ * holds the starting vector and the remaining columns are overwritten
+ * with the basis vectors
+ * \param basis polynomial basis
+ *
+ * \par Overview
+ * Computes the Krylov basis
+ * <tt>[v_0, p_1(A) v_0, ..., p_s(A) v_0]</tt> of \c s steps. For host
+ * \p csr_matrix the rows are processed in blocks, each block computes all
+ * \c s steps of its rows together with the rows it depends on, so every
+ * block of the matrix is read from memory once for all steps instead of
+ * once per step. Other matrices perform one multiplication per step.
+ *
+ * \par Example
+ *
+ *  \code
+ *  #include <cusp/array2d.h>
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/gallery/poisson.h>
+ *  #include <cusp/krylov/matrix_powers.h>
+ *
+ *  int main(void)
+ *  {
+ *      cusp::csr_matrix<int, float, cusp::host_memory> A;
+ *      cusp::gallery::poisson5pt(A, 10, 10);
+ *
+ *      // V(:,0) = 1
+ *      cusp::array2d<float, cusp::host_memory, cusp::column_major> V(A.num_rows, 5, 0.0f);
+ *      thrust::fill(V.values.begin(), V.values.begin() + A.num_rows, 1.0f);
+ *
+ *      // V(:,j) = T_j((A - 4 I) / 4) V(:,0)
+ *      cusp::krylov::matrix_powers(A, V, cusp::krylov::chebyshev_basis(4, 0.0f, 8.0f));
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ */
+template <typename LinearOperator,
+          typename Array2d,
+          typename ValueType>
+void matrix_powers(const LinearOperator& A,
+                         Array2d& V,
+                   const polynomial_basis<ValueType>& basis);
+/*! \}
+ */
+
+} // end namespace krylov
+} // end namespace cusp
+
+#include <cusp/krylov/detail/matrix_powers.inl>
@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file recycle_space.h
+ *  \brief Subspace carried between the solves of a sequence of linear systems
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array2d.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace krylov
+{
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup krylov_methods Krylov Methods
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/**
+ * \brief Recycled subspace for sequences of linear systems
+ *
+ * \tparam ValueType Type used for the basis vectors (e.g. \c float or \c double).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ * Holds a basis \c U of up to \p max_size vectors together with
+ * <tt>C = A U</tt>. The recycling solvers \p gcrodr and \p deflated_cg
+ * deflate the system with this space and replace it by approximate
+ * invariant subspaces extracted from their own Krylov spaces, so passing the
+ * same object to the solves of a slowly varying sequence of systems
+ * avoids rediscovering the same slow modes every time. \c C is recomputed
+ * with the current matrix at the start of every solve.
+ *
+ * \see \p gcrodr, \p deflated_cg
+ */
+template <typename ValueType, typename MemorySpace>
+class recycle_space
+{
+public:
+
+    /*! Maximum number of vectors of the space.
+     */
+    size_t max_size;
+
+    /*! Current number of vectors of the space.
+     */
+    size_t num_vectors;
+
+    /* \cond */
+    // basis (first num_vectors columns are valid)
+    cusp::array2d<ValueType, MemorySpace, cusp::column_major> U;
+
+    // C = A U
+    cusp::array2d<ValueType, MemorySpace, cusp::column_major> C;
+    /* \endcond */
+
+    /*! Construct an empty \p recycle_space.
+     *
+     *  \param max_size Maximum number of vectors.
+     */
+    recycle_space(const size_t max_size)
+        : max_size(max_size), num_vectors(0) {}
+
+    /*! Number of vectors of the space.
+     */
+    size_t size(void) const
+    {
+        return num_vectors;
+    }
+
+    /*! Discard all vectors.
+     */
+    void clear(void)
+    {
+        num_vectors = 0;
+    }
+};
+/*! \}
+ */
+
+} // end namespace krylov
+} // end namespace cusp
+
+#include <cusp/krylov/detail/recycle_space.inl>
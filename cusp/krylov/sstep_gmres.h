@@ -0,0 +1,159 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file sstep_gmres.h
+ *  \brief Communication-avoiding s-step GMRES method
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/detail/execution_policy.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace krylov
+{
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup krylov_methods Krylov Methods
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/* \cond */
+
+template <typename DerivedPolicy,
+          typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void sstep_gmres(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                 const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                 const size_t restart,
+                 const size_t s,
+                       Monitor& monitor,
+                       Preconditioner& M);
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor>
+void sstep_gmres(const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                 const size_t restart,
+                 const size_t s,
+                       Monitor& monitor);
+
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2>
+void sstep_gmres(const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                 const size_t restart,
+                 const size_t s = 4);
+
+/* \endcond */
+
+/**
+ * \brief s-step GMRES method
+ *
+ * \tparam LinearOperator is a matrix or subclass of \p linear_operator
+ * \tparam VectorType1 vector
+ * \tparam Monitor is a \p monitor
+ * \tparam Preconditioner is a matrix or subclass of \p linear_operator
+ *
+ * \param A matrix of the linear system
+ * \param x approximate solution of the linear system
+ * \param b right-hand side of the linear system
+ * \param restart the method every restart inner iterations
+ * \param s number of Krylov vectors generated at once
+ * \param monitor montiors iteration and determines stopping conditions
+ * \param M preconditioner for A
+ *
+ * \par Overview
+ * Solves the nonsymmetric, linear system A x = b with preconditioner \p M
+ * and produces the same iterates as \p gmres in exact arithmetic. Instead
+ * of one multiplication followed by one Gram-Schmidt step per iteration,
+ * the method generates \p s Krylov vectors at once with \p matrix_powers
+ * and orthogonalizes them with two passes of block Gram-Schmidt and a
+ * Cholesky QR factorization of the tall and skinny block. Every \p s
+ * iterations therefore read the matrix once on host \p csr_matrix and
+ * perform a constant number of block reductions. The Hessenberg matrix
+ * of GMRES is recovered from the factors on the host.
+ *
+ * The first cycle runs with <tt>s = 1</tt>. The eigenvalues of the
+ * Hermitian part of its Hessenberg matrix in Leja order are used as the
+ * shifts of a Newton basis for the following cycles, which keeps the
+ * blocks well conditioned. Small values of \p s such as 4 or 8 are
+ * recommended.
+ *
+ * \par Example
+ *
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/monitor.h>
+ *  #include <cusp/krylov/sstep_gmres.h>
+ *  #include <cusp/gallery/poisson.h>
+ *
+ *  int main(void)
+ *  {
+ *      cusp::csr_matrix<int, double, cusp::host_memory> A;
+ *      cusp::gallery::poisson5pt(A, 100, 100);
+ *
+ *      cusp::array1d<double, cusp::host_memory> x(A.num_rows, 0);
+ *      cusp::array1d<double, cusp::host_memory> b(A.num_rows, 1);
+ *
+ *      cusp::monitor<double> monitor(b, 1000, 1e-8, 0, true);
+ *
+ *      // restart after 40 iterations, generate 4 vectors at once
+ *      cusp::identity_operator<double, cusp::host_memory> M(A.num_rows, A.num_rows);
+ *      cusp::krylov::sstep_gmres(A, x, b, 40, 4, monitor, M);
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ *
+ *  \see \p gmres
+ *  \see \p matrix_powers
+ */
+template <typename LinearOperator,
+          typename VectorType1,
+          typename VectorType2,
+          typename Monitor,
+          typename Preconditioner>
+void sstep_gmres(const LinearOperator& A,
+                       VectorType1& x,
+                 const VectorType2& b,
+                 const size_t restart,
+                 const size_t s,
+                       Monitor& monitor,
+                       Preconditioner& M);
+/*! \}
+ */
+
+} // end namespace krylov
+} // end namespace cusp
+
+#include <cusp/krylov/detail/sstep_gmres.inl>
@@ -113,13 +113,16 @@ public:
      *  \param relative_tolerance determines convergence criteria
      *  \param absolute_tolerance determines convergence criteria
      *  \param verbose Controls printing status updates during execution
+     *  \param print_interval Number of iterations between status updates
+     *  when \p verbose is set, 0 to report only the final status
      */
     template <typename VectorType>
     monitor(const VectorType& b,
             const size_t iteration_limit = 500,
             const Real relative_tolerance = 1e-5,
             const Real absolute_tolerance = 0,
-            const bool verbose = false);
+            const bool verbose = false,
+            const size_t print_interval = 1);
 
     /**
      * \brief Increments the iteration count
@@ -187,6 +190,50 @@ public:
     template <typename DerivedPolicy, typename Vector>
     bool finished(thrust::execution_policy<DerivedPolicy> &exec, const Vector& r);
 
+    /**
+     *  \brief Applies convergence criteria to a residual norm computed by
+     *  the solver
+     *
+     *  Solvers that already know the residual norm, e.g. from the Givens
+     *  rotations of GMRES, pass it here instead of the residual vector to
+     *  avoid another pass over the vector.
+     *
+     *  \param r_norm Euclidean norm of the residual of the linear system
+     */
+    bool finished_norm(const Real r_norm);
+
+    /**
+     *  \brief Sets how often solvers that update the residual by a
+     *  recurrence recompute it as b - A x
+     *
+     *  \param interval Number of iterations between replacements, 0 to
+     *  never replace the residual
+     */
+    void set_replacement_interval(const size_t interval);
+
+    /**
+     *  \brief Returns the number of iterations between residual replacements
+     *
+     *  \return replacement interval, 0 if the residual is never replaced
+     */
+    size_t replacement_interval(void) const;
+
+    /**
+     *  \brief Indicates whether the solver should compute the residual of
+     *  the current iteration as b - A x instead of by its recurrence
+     *
+     *  \return Boolean replacement indicator
+     */
+    bool replace_residual(void) const;
+
+    /**
+     *  \brief Sets the number of iterations between status updates
+     *
+     *  \param interval Number of iterations between status updates when the
+     *  monitor is verbose, 0 to report only the final status
+     */
+    void set_print_interval(const size_t interval);
+
     /**
      *  \brief Sets the verbosity level of the monitor
      *
@@ -238,7 +285,8 @@ public:
     Real average_rate(void);
 
     /*
-     * Array holding the residuals per iteration
+     * Array holding the residuals per iteration, allocated for
+     * iteration_limit + 1 entries on construction
      */
     cusp::array1d<Real,cusp::host_memory> residuals;
 
@@ -252,6 +300,8 @@ private:
     Real relative_tolerance_;
     Real absolute_tolerance_;
     bool verbose;
+    size_t print_interval_;
+    size_t replacement_interval_;
     /*! \endcond */
 };
 
@@ -346,6 +396,9 @@ public:
      *  \param absolute_tolerance determines convergence criteria
      *  \param verbose Controls printing status updates during execution
      *
+     *  \param print_interval Number of iterations between status updates,
+     *  0 to report only the final status
+     *
      *  \deprecated As of v0.4.0 monitors have been unified. Use monitor
      *  instead.
      */
@@ -354,8 +407,9 @@ public:
     verbose_monitor(const VectorType& b,
                     const size_t iteration_limit = 500,
                     const Real relative_tolerance = 1e-5,
-                    const Real absolute_tolerance = 0)
-    : Parent(b, iteration_limit, relative_tolerance, absolute_tolerance, true) {}
+                    const Real absolute_tolerance = 0,
+                    const size_t print_interval = 1)
+    : Parent(b, iteration_limit, relative_tolerance, absolute_tolerance, true, print_interval) {}
 };
 
 } // end namespace cusp
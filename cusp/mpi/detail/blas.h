@@ -0,0 +1,127 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/functional.h>
+
+#include <cusp/system/detail/generic/blas.h>
+
+#include <thrust/functional.h>
+#include <thrust/transform_reduce.h>
+
+#include <cmath>
+
+namespace cusp
+{
+namespace mpi
+{
+
+// The reductions of cusp::blas with a distributed policy compute the
+// local result with the generic implementation and combine the results
+// of all processes. The remaining routines are local and use the generic
+// implementations.
+
+template <typename Array>
+typename cusp::norm_type<typename Array::value_type>::type
+asum(par_t& exec,
+     const Array& x)
+{
+    typedef typename cusp::norm_type<typename Array::value_type>::type NormType;
+
+    NormType result = cusp::system::detail::generic::blas::asum(exec, x);
+
+    MPI_Allreduce(MPI_IN_PLACE, &result, 1, detail::datatype<NormType>::value(), MPI_SUM, exec.comm);
+
+    return result;
+}
+
+template <typename Array1,
+          typename Array2>
+typename Array1::value_type
+dot(par_t& exec,
+    const Array1& x,
+    const Array2& y)
+{
+    typedef typename Array1::value_type ValueType;
+
+    ValueType result = cusp::system::detail::generic::blas::dot(exec, x, y);
+
+    MPI_Allreduce(MPI_IN_PLACE, &result, 1, detail::datatype<ValueType>::value(), MPI_SUM, exec.comm);
+
+    return result;
+}
+
+template <typename Array1,
+          typename Array2>
+typename Array1::value_type
+dotc(par_t& exec,
+     const Array1& x,
+     const Array2& y)
+{
+    typedef typename Array1::value_type ValueType;
+
+    ValueType result = cusp::system::detail::generic::blas::dotc(exec, x, y);
+
+    MPI_Allreduce(MPI_IN_PLACE, &result, 1, detail::datatype<ValueType>::value(), MPI_SUM, exec.comm);
+
+    return result;
+}
+
+template <typename Array>
+typename cusp::norm_type<typename Array::value_type>::type
+nrm1(par_t& exec,
+     const Array& x)
+{
+    return cusp::mpi::asum(exec, x);
+}
+
+template <typename Array>
+typename cusp::norm_type<typename Array::value_type>::type
+nrm2(par_t& exec,
+     const Array& x)
+{
+    typedef typename Array::value_type ValueType;
+    typedef typename cusp::norm_type<ValueType>::type NormType;
+
+    cusp::abs_squared_functor<ValueType> unary_op;
+    thrust::plus<NormType>               binary_op;
+
+    NormType result = thrust::transform_reduce(exec, x.begin(), x.end(), unary_op, NormType(0), binary_op);
+
+    MPI_Allreduce(MPI_IN_PLACE, &result, 1, detail::datatype<NormType>::value(), MPI_SUM, exec.comm);
+
+    return std::sqrt(result);
+}
+
+template <typename Array>
+typename cusp::norm_type<typename Array::value_type>::type
+nrmmax(par_t& exec,
+       const Array& x)
+{
+    typedef typename cusp::norm_type<typename Array::value_type>::type NormType;
+
+    NormType result = (x.size() == 0) ? NormType(0) : cusp::system::detail::generic::blas::nrmmax(exec, x);
+
+    MPI_Allreduce(MPI_IN_PLACE, &result, 1, detail::datatype<NormType>::value(), MPI_MAX, exec.comm);
+
+    return result;
+}
+
+} // end namespace mpi
+} // end namespace cusp
@@ -0,0 +1,242 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#include <cusp/convert.h>
+#include <cusp/exception.h>
+#include <cusp/multiply.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace mpi
+{
+namespace detail
+{
+
+// tag of the messages of the ghost exchange
+const int halo_tag = 1001;
+
+} // end namespace detail
+
+template <typename IndexType, typename ValueType>
+template <typename MatrixType>
+distributed_csr_matrix<IndexType,ValueType>
+::distributed_csr_matrix(MPI_Comm comm, const MatrixType& A)
+    : Parent(), comm(comm)
+{
+    local_matrix_type B;
+    cusp::convert(A, B);
+
+    int rank, num_procs;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &num_procs);
+
+    const IndexType N = B.num_rows;
+
+    // row partition from the number of owned rows of every process
+    std::vector<IndexType> counts(num_procs);
+    MPI_Allgather(const_cast<IndexType*>(&N), 1, detail::datatype<IndexType>::value(),
+                  &counts[0], 1, detail::datatype<IndexType>::value(), comm);
+
+    row_partition.resize(num_procs + 1);
+    row_partition[0] = 0;
+
+    for (int p = 0; p < num_procs; p++)
+        row_partition[p + 1] = row_partition[p] + counts[p];
+
+    global_num_rows = row_partition[num_procs];
+
+    if (B.num_cols != global_num_rows)
+        throw cusp::invalid_input_exception("distributed_csr_matrix requires a square global matrix");
+
+    const IndexType first = row_partition[rank];
+    const IndexType last  = first + N;
+
+    // ghost columns are the referenced columns owned by other processes
+    std::vector<IndexType> ghosts;
+
+    for (size_t n = 0; n < B.num_entries; n++)
+        if (B.column_indices[n] < first || B.column_indices[n] >= last)
+            ghosts.push_back(B.column_indices[n]);
+
+    std::sort(ghosts.begin(), ghosts.end());
+    ghosts.erase(std::unique(ghosts.begin(), ghosts.end()), ghosts.end());
+
+    ghost_columns.resize(ghosts.size());
+    std::copy(ghosts.begin(), ghosts.end(), ghost_columns.begin());
+
+    // local matrix with owned columns first and ghost columns after them
+    local = B;
+    local.num_cols = N + ghosts.size();
+
+    for (IndexType i = 0; i < N; i++)
+    {
+        bool boundary = false;
+
+        for (IndexType jj = B.row_offsets[i]; jj < B.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = B.column_indices[jj];
+
+            if (j >= first && j < last)
+            {
+                local.column_indices[jj] = j - first;
+            }
+            else
+            {
+                local.column_indices[jj] = N + (std::lower_bound(ghosts.begin(), ghosts.end(), j) - ghosts.begin());
+                boundary = true;
+            }
+        }
+
+        if (boundary)
+            boundary_rows.push_back(i);
+        else
+            interior_rows.push_back(i);
+    }
+
+    // the ghost columns are sorted, hence grouped by owner
+    std::vector<int> recv_counts(num_procs, 0);
+
+    for (size_t k = 0; k < ghosts.size(); k++)
+    {
+        const int owner = std::upper_bound(row_partition.begin(), row_partition.end(), ghosts[k]) - row_partition.begin() - 1;
+        recv_counts[owner]++;
+    }
+
+    std::vector<int> send_counts(num_procs, 0);
+    MPI_Alltoall(&recv_counts[0], 1, MPI_INT, &send_counts[0], 1, MPI_INT, comm);
+
+    // tell every owner which of its entries are needed
+    std::vector<int> recv_displs(num_procs + 1, 0);
+    std::vector<int> send_displs(num_procs + 1, 0);
+
+    for (int p = 0; p < num_procs; p++)
+    {
+        recv_displs[p + 1] = recv_displs[p] + recv_counts[p];
+        send_displs[p + 1] = send_displs[p] + send_counts[p];
+    }
+
+    std::vector<IndexType> requested(std::max(send_displs[num_procs], 1));
+
+    MPI_Alltoallv(ghosts.empty() ? NULL : &ghosts[0], &recv_counts[0], &recv_displs[0], detail::datatype<IndexType>::value(),
+                  &requested[0], &send_counts[0], &send_displs[0], detail::datatype<IndexType>::value(), comm);
+
+    recv_offsets.push_back(0);
+    send_offsets.push_back(0);
+
+    for (int p = 0; p < num_procs; p++)
+    {
+        if (recv_counts[p] > 0)
+        {
+            recv_ranks.push_back(p);
+            recv_offsets.push_back(recv_displs[p + 1]);
+        }
+
+        if (send_counts[p] > 0)
+        {
+            send_ranks.push_back(p);
+            send_offsets.push_back(send_displs[p + 1]);
+        }
+    }
+
+    send_indices.resize(send_displs[num_procs]);
+
+    for (size_t k = 0; k < send_indices.size(); k++)
+        send_indices[k] = requested[k] - first;
+
+    send_buffer.resize(send_indices.size());
+    ghost_values.resize(ghosts.size());
+
+    this->num_rows    = N;
+    this->num_cols    = N;
+    this->num_entries = B.num_entries;
+}
+
+template <typename IndexType, typename ValueType>
+template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+void distributed_csr_matrix<IndexType,ValueType>
+::operator()(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y)
+{
+    const int num_recvs = recv_ranks.size();
+    const int num_sends = send_ranks.size();
+
+    std::vector<MPI_Request> requests(num_recvs + num_sends);
+
+    // start receiving the ghost entries
+    for (int k = 0; k < num_recvs; k++)
+        MPI_Irecv(&ghost_values[0] + recv_offsets[k], recv_offsets[k + 1] - recv_offsets[k],
+                  detail::datatype<ValueType>::value(), recv_ranks[k], detail::halo_tag, comm, &requests[k]);
+
+    // pack and send the owned entries needed by the neighbours
+    #pragma omp parallel for
+    for (int k = 0; k < int(send_indices.size()); k++)
+        send_buffer[k] = x[send_indices[k]];
+
+    for (int k = 0; k < num_sends; k++)
+        MPI_Isend(&send_buffer[0] + send_offsets[k], send_offsets[k + 1] - send_offsets[k],
+                  detail::datatype<ValueType>::value(), send_ranks[k], detail::halo_tag, comm, &requests[num_recvs + k]);
+
+    const IndexType N = this->num_rows;
+
+    // interior rows overlap the exchange
+    #pragma omp parallel for
+    for (int n = 0; n < int(interior_rows.size()); n++)
+    {
+        const IndexType i = interior_rows[n];
+
+        ValueType sum = 0;
+
+        for (IndexType jj = local.row_offsets[i]; jj < local.row_offsets[i + 1]; jj++)
+            sum += local.values[jj] * x[local.column_indices[jj]];
+
+        y[i] = sum;
+    }
+
+    if (!requests.empty())
+        MPI_Waitall(requests.size(), &requests[0], MPI_STATUSES_IGNORE);
+
+    // rows that reference ghost entries
+    #pragma omp parallel for
+    for (int n = 0; n < int(boundary_rows.size()); n++)
+    {
+        const IndexType i = boundary_rows[n];
+
+        ValueType sum = 0;
+
+        for (IndexType jj = local.row_offsets[i]; jj < local.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = local.column_indices[jj];
+            sum += local.values[jj] * (j < N ? ValueType(x[j]) : ghost_values[j - N]);
+        }
+
+        y[i] = sum;
+    }
+}
+
+template <typename IndexType, typename ValueType>
+template <typename VectorType1, typename VectorType2>
+void distributed_csr_matrix<IndexType,ValueType>
+::operator()(const VectorType1& x, VectorType2& y)
+{
+    cusp::mpi::par_t exec(comm);
+
+    (*this)(exec, x, y);
+}
+
+} // end namespace mpi
+} // end namespace cusp
@@ -0,0 +1,209 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file cusp/mpi/distributed_csr_matrix.h
+ *  \brief CSR matrix whose rows are distributed over MPI processes
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/linear_operator.h>
+
+#include <cusp/mpi/execution_policy.h>
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace cusp
+{
+namespace mpi
+{
+
+/*! \addtogroup sparse_matrices Sparse Matrices
+ */
+
+/*! \addtogroup sparse_matrix_containers Sparse Matrix Containers
+ *  \ingroup sparse_matrices
+ *  \{
+ */
+
+/**
+ * \brief Square sparse matrix whose rows are distributed over the
+ * processes of an MPI communicator
+ *
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam ValueType Type used for matrix values (e.g. \c float).
+ *
+ * \par Overview
+ * Every process owns a contiguous block of rows and the entries of a
+ * distributed vector with the same indices. The owned rows are stored in
+ * a local \p csr_matrix whose first \c num_rows columns are the owned
+ * entries of \c x and whose remaining columns are the ghost entries owned
+ * by other processes, in the order of \p ghost_columns.
+ *
+ * Applying the matrix packs the owned entries needed by the neighbours,
+ * starts a nonblocking exchange of the ghost entries, multiplies the
+ * interior rows that reference only owned entries while the messages are
+ * in flight, and completes the rows that reference ghost entries after
+ * the exchange. The communication pattern is set up once by the
+ * constructor, which is collective over the communicator.
+ *
+ * The local vectors are <tt>cusp::array1d<ValueType, distributed_memory></tt>
+ * of length \c num_rows, with which \p cusp::multiply, the reductions of
+ * \p cusp::blas and the Krylov solvers work on the global system.
+ *
+ * \par Example
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/monitor.h>
+ *  #include <cusp/krylov/cg.h>
+ *  #include <cusp/mpi/distributed_csr_matrix.h>
+ *
+ *  int main(int argc, char** argv)
+ *  {
+ *    MPI_Init(&argc, &argv);
+ *
+ *    // rows owned by this process with global column indices
+ *    cusp::csr_matrix<int, double, cusp::host_memory> rows;
+ *    // ... assemble the owned rows
+ *
+ *    cusp::mpi::distributed_csr_matrix<int, double> A(MPI_COMM_WORLD, rows);
+ *
+ *    cusp::array1d<double, cusp::mpi::distributed_memory> x(A.num_rows, 0);
+ *    cusp::array1d<double, cusp::mpi::distributed_memory> b(A.num_rows, 1);
+ *
+ *    cusp::monitor<double> monitor(b, 100, 1e-6);
+ *    cusp::krylov::cg(A, x, b, monitor);
+ *
+ *    MPI_Finalize();
+ *
+ *    return 0;
+ *  }
+ *  \endcode
+ *
+ *  \see \p par_t
+ */
+template <typename IndexType, typename ValueType>
+class distributed_csr_matrix
+  : public cusp::linear_operator<ValueType, cusp::mpi::distributed_memory, IndexType>
+{
+private:
+
+    typedef cusp::linear_operator<ValueType, cusp::mpi::distributed_memory, IndexType> Parent;
+
+public:
+
+    /* \cond */
+    typedef cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> local_matrix_type;
+    typedef cusp::array1d<IndexType, cusp::host_memory>              index_array_type;
+    typedef cusp::array1d<ValueType, cusp::host_memory>              value_array_type;
+    /* \endcond */
+
+    /*! Communicator of the processes sharing the matrix. */
+    MPI_Comm comm;
+
+    /*! Number of rows and columns of the global matrix. */
+    size_t global_num_rows;
+
+    /*! Process \c p owns the rows <tt>[row_partition[p], row_partition[p+1])</tt>. */
+    index_array_type row_partition;
+
+    /*! Owned rows with local column indices. */
+    local_matrix_type local;
+
+    /*! Global indices of the ghost columns. */
+    index_array_type ghost_columns;
+
+    /* \cond */
+    // rows that reference only owned columns and rows that reference ghosts
+    index_array_type interior_rows;
+    index_array_type boundary_rows;
+
+    // ghost columns received from recv_ranks[k] are
+    // ghost_columns[recv_offsets[k], recv_offsets[k+1])
+    std::vector<int> recv_ranks;
+    std::vector<int> recv_offsets;
+
+    // owned entries send_indices[send_offsets[k], send_offsets[k+1]) are
+    // sent to send_ranks[k]
+    std::vector<int> send_ranks;
+    std::vector<int> send_offsets;
+    index_array_type send_indices;
+
+    value_array_type send_buffer;
+    value_array_type ghost_values;
+    /* \endcond */
+
+    /*! Construct a \p distributed_csr_matrix from the rows owned by this
+     *  process. Collective over \p comm.
+     *
+     *  \tparam MatrixType Type of the matrix of owned rows.
+     *
+     *  \param comm MPI communicator.
+     *  \param A Owned rows with global column indices. The processes own
+     *  consecutive blocks of rows in the order of their ranks and
+     *  <tt>A.num_cols</tt> is the global number of rows.
+     */
+    template <typename MatrixType>
+    distributed_csr_matrix(MPI_Comm comm, const MatrixType& A);
+
+    /*! Global index of the first owned row.
+     */
+    size_t first_row(void) const
+    {
+        int rank;
+        MPI_Comm_rank(comm, &rank);
+
+        return row_partition[rank];
+    }
+
+    /*! Number of ghost columns.
+     */
+    size_t num_ghosts(void) const
+    {
+        return ghost_columns.size();
+    }
+
+    /* \cond */
+    template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+    void operator()(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y);
+    /* \endcond */
+
+    /*! Apply the matrix to the local part of \p x and produce the local
+     *  part of \p y. Collective over \p comm.
+     *
+     * \tparam VectorType1 Type of the input vector
+     * \tparam VectorType2 Type of the output vector
+     *
+     *  \param x Input vector.
+     *  \param y Output vector.
+     */
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& x, VectorType2& y);
+};
+/*! \} // end Containers
+ */
+
+} // end namespace mpi
+} // end namespace cusp
+
+#include <cusp/mpi/detail/distributed_csr_matrix.inl>
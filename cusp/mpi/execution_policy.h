@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file cusp/mpi/execution_policy.h
+ *  \brief Execution policy for data distributed over MPI processes
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/complex.h>
+#include <cusp/memory.h>
+
+#include <cusp/iterator/detail/host_system_tag.h>
+
+#include <mpi.h>
+
+#include <memory>
+
+namespace cusp
+{
+namespace mpi
+{
+
+/*! \addtogroup execution_policies Execution Policies
+ *  \{
+ */
+
+/**
+ * \brief Execution policy of data distributed over the processes of an
+ * MPI communicator
+ *
+ * \par Overview
+ * Every process stores its local part of a distributed vector in host
+ * memory and computes on it with the host system. The reductions of
+ * \p cusp::blas (\p dot, \p dotc, \p nrm1, \p nrm2, \p nrmmax) combine the
+ * local results of all processes of \p comm, so the Krylov solvers and
+ * \p monitor compute global inner products and norms without changes.
+ *
+ * \p distributed_memory is the memory space of the distributed types.
+ * Algorithms invoked without an explicit policy construct a default
+ * policy that reduces over \c MPI_COMM_WORLD. Pass a policy constructed
+ * with another communicator to reduce over a subset of the processes.
+ *
+ * \see \p distributed_csr_matrix
+ */
+struct par_t : public cusp::system::__THRUST_HOST_SYSTEM_NAMESPACE::detail::execution_policy<par_t>
+{
+  public:
+  /*! Communicator of the processes sharing the distributed data. */
+  MPI_Comm comm;
+
+  /*! Construct a policy for the processes of \p comm.
+   *
+   *  \param comm MPI communicator.
+   */
+  par_t(MPI_Comm comm = MPI_COMM_WORLD)
+    : cusp::system::__THRUST_HOST_SYSTEM_NAMESPACE::detail::execution_policy<par_t>(), comm(comm) {}
+};
+
+/*! Memory space of data distributed over MPI processes.
+ */
+typedef par_t distributed_memory;
+
+/*! \}
+ */
+
+namespace detail
+{
+
+// MPI datatype of a value type
+template <typename T> struct datatype;
+
+template <> struct datatype<int>
+{ static MPI_Datatype value(void) { return MPI_INT; } };
+
+template <> struct datatype<unsigned int>
+{ static MPI_Datatype value(void) { return MPI_UNSIGNED; } };
+
+template <> struct datatype<long>
+{ static MPI_Datatype value(void) { return MPI_LONG; } };
+
+template <> struct datatype<long long>
+{ static MPI_Datatype value(void) { return MPI_LONG_LONG; } };
+
+template <> struct datatype<float>
+{ static MPI_Datatype value(void) { return MPI_FLOAT; } };
+
+template <> struct datatype<double>
+{ static MPI_Datatype value(void) { return MPI_DOUBLE; } };
+
+template <> struct datatype< cusp::complex<float> >
+{ static MPI_Datatype value(void) { return MPI_C_FLOAT_COMPLEX; } };
+
+template <> struct datatype< cusp::complex<double> >
+{ static MPI_Datatype value(void) { return MPI_C_DOUBLE_COMPLEX; } };
+
+} // end namespace detail
+} // end namespace mpi
+
+// the local parts of distributed arrays live in host memory
+template<typename T>
+struct default_memory_allocator<T, cusp::mpi::distributed_memory>
+{
+    typedef std::allocator<T> type;
+};
+
+} // end namespace cusp
+
+#include <cusp/mpi/detail/blas.h>
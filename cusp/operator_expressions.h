@@ -0,0 +1,442 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file operator_expressions.h
+ *  \brief Lazy expressions of linear operators
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/linear_operator.h>
+
+namespace cusp
+{
+
+/* \cond */
+template <typename LinearOperator, typename ArrayType> class affine_operator;
+template <typename LinearOperator1, typename LinearOperator2> class sum_operator;
+template <typename LinearOperator1, typename LinearOperator2> class product_operator;
+template <typename MatrixType> class transpose_operator;
+
+namespace detail
+{
+
+// Matrices and user operators are referenced by expressions, expressions
+// themselves are small and held by value so that nested temporaries such
+// as sum(shift(A, s), B) remain valid.
+template <typename T>
+struct operand_storage
+{
+    typedef const T& type;
+};
+
+template <typename LinearOperator, typename ArrayType>
+struct operand_storage< cusp::affine_operator<LinearOperator,ArrayType> >
+{
+    typedef cusp::affine_operator<LinearOperator,ArrayType> type;
+};
+
+template <typename LinearOperator1, typename LinearOperator2>
+struct operand_storage< cusp::sum_operator<LinearOperator1,LinearOperator2> >
+{
+    typedef cusp::sum_operator<LinearOperator1,LinearOperator2> type;
+};
+
+template <typename LinearOperator1, typename LinearOperator2>
+struct operand_storage< cusp::product_operator<LinearOperator1,LinearOperator2> >
+{
+    typedef cusp::product_operator<LinearOperator1,LinearOperator2> type;
+};
+
+template <typename MatrixType>
+struct operand_storage< cusp::transpose_operator<MatrixType> >
+{
+    typedef cusp::transpose_operator<MatrixType> type;
+};
+
+} // end namespace detail
+/* \endcond */
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup operator_expressions Operator Expressions
+ *  \ingroup iterative_solvers
+ *  \brief Lazily evaluated combinations of matrices and linear operators
+ *  \{
+ */
+
+/**
+ * \brief Lazy affine operator <tt>y = alpha * D * A * x + sigma * x</tt>
+ *
+ * \tparam LinearOperator Type of the wrapped matrix or operator \c A
+ * \tparam ArrayType Type of the diagonal \c D
+ *
+ * \par Overview
+ * Represents shifted, scaled and diagonally scaled operators without
+ * forming a new matrix. When \c A is a CSR matrix in host memory the whole
+ * expression is evaluated inside the SpMV loop, otherwise the SpMV is
+ * followed by a single fused vector pass. Chains of \p shift, \p scale and
+ * \p diag_scale applied to the same operator collapse into one
+ * \p affine_operator.
+ *
+ * \see \p shift, \p scale, \p diag_scale
+ */
+template <typename LinearOperator,
+          typename ArrayType = cusp::array1d<typename LinearOperator::value_type, typename LinearOperator::memory_space> >
+class affine_operator
+  : public cusp::linear_operator<typename LinearOperator::value_type,
+                                 typename LinearOperator::memory_space,
+                                 typename LinearOperator::index_type>
+{
+private:
+
+    typedef cusp::linear_operator<typename LinearOperator::value_type,
+                                  typename LinearOperator::memory_space,
+                                  typename LinearOperator::index_type> Parent;
+
+public:
+
+    typedef typename LinearOperator::value_type   ValueType;
+    typedef typename LinearOperator::memory_space MemorySpace;
+
+    /* \cond */
+    typename detail::operand_storage<LinearOperator>::type A;
+    const ArrayType* diagonal;
+    ValueType alpha;
+    ValueType sigma;
+    /* \endcond */
+
+    /*! Construct <tt>alpha * D * A + sigma * I</tt>.
+     *
+     *  \param A operator to wrap.
+     *  \param diagonal pointer to the diagonal \c D or \c NULL for the identity.
+     *  \param alpha scaling factor.
+     *  \param sigma shift.
+     */
+    affine_operator(const LinearOperator& A, const ArrayType* diagonal,
+                    const ValueType alpha, const ValueType sigma)
+        : Parent(A.num_rows, A.num_cols, A.num_entries),
+          A(A), diagonal(diagonal), alpha(alpha), sigma(sigma) {}
+
+    /* \cond */
+    template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+    void operator()(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y);
+    /* \endcond */
+
+    /*! Apply the operator to vector \p x and produce vector \p y.
+     *
+     * \tparam VectorType1 Type of the input vector
+     * \tparam VectorType2 Type of the output vector
+     *
+     *  \param x Input vector.
+     *  \param y Output vector.
+     */
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& x, VectorType2& y);
+
+protected:
+
+    /* \cond */
+    template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+    void apply(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y,
+               cusp::csr_format, cusp::host_memory);
+
+    template <typename DerivedPolicy, typename VectorType1, typename VectorType2, typename Format, typename System>
+    void apply(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y,
+               Format, System);
+    /* \endcond */
+};
+
+/**
+ * \brief Lazy sum of two operators <tt>y = A * x + B * x</tt>
+ *
+ * \tparam LinearOperator1 Type of \c A
+ * \tparam LinearOperator2 Type of \c B
+ *
+ * \see \p sum
+ */
+template <typename LinearOperator1, typename LinearOperator2>
+class sum_operator
+  : public cusp::linear_operator<typename LinearOperator1::value_type,
+                                 typename LinearOperator1::memory_space,
+                                 typename LinearOperator1::index_type>
+{
+private:
+
+    typedef cusp::linear_operator<typename LinearOperator1::value_type,
+                                  typename LinearOperator1::memory_space,
+                                  typename LinearOperator1::index_type> Parent;
+
+public:
+
+    typedef typename LinearOperator1::value_type   ValueType;
+    typedef typename LinearOperator1::memory_space MemorySpace;
+
+    /* \cond */
+    typename detail::operand_storage<LinearOperator1>::type A;
+    typename detail::operand_storage<LinearOperator2>::type B;
+    cusp::array1d<ValueType,MemorySpace> temp;
+    /* \endcond */
+
+    /*! Construct <tt>A + B</tt>.
+     */
+    sum_operator(const LinearOperator1& A, const LinearOperator2& B);
+
+    /* \cond */
+    template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+    void operator()(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y);
+    /* \endcond */
+
+    /*! Apply the operator to vector \p x and produce vector \p y.
+     */
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& x, VectorType2& y);
+};
+
+/**
+ * \brief Lazy product of two operators <tt>y = A * (B * x)</tt>
+ *
+ * \tparam LinearOperator1 Type of \c A
+ * \tparam LinearOperator2 Type of \c B
+ *
+ * \see \p product
+ */
+template <typename LinearOperator1, typename LinearOperator2>
+class product_operator
+  : public cusp::linear_operator<typename LinearOperator1::value_type,
+                                 typename LinearOperator1::memory_space,
+                                 typename LinearOperator1::index_type>
+{
+private:
+
+    typedef cusp::linear_operator<typename LinearOperator1::value_type,
+                                  typename LinearOperator1::memory_space,
+                                  typename LinearOperator1::index_type> Parent;
+
+public:
+
+    typedef typename LinearOperator1::value_type   ValueType;
+    typedef typename LinearOperator1::memory_space MemorySpace;
+
+    /* \cond */
+    typename detail::operand_storage<LinearOperator1>::type A;
+    typename detail::operand_storage<LinearOperator2>::type B;
+    cusp::array1d<ValueType,MemorySpace> temp;
+    /* \endcond */
+
+    /*! Construct <tt>A * B</tt>.
+     */
+    product_operator(const LinearOperator1& A, const LinearOperator2& B);
+
+    /* \cond */
+    template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+    void operator()(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y);
+    /* \endcond */
+
+    /*! Apply the operator to vector \p x and produce vector \p y.
+     */
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& x, VectorType2& y);
+};
+
+/**
+ * \brief Lazy transpose of a sparse matrix <tt>y = A^T * x</tt>
+ *
+ * \tparam MatrixType Type of \c A
+ *
+ * \par Overview
+ * For COO and CSR matrices in host memory the product is computed by
+ * scattering the rows of \c A, so no transposed copy is formed. For all
+ * other formats and memory spaces the transpose is formed on first use
+ * and cached, so \p refresh must be called after the values of \c A
+ * change.
+ *
+ * \see \p transpose_view
+ */
+template <typename MatrixType>
+class transpose_operator
+  : public cusp::linear_operator<typename MatrixType::value_type,
+                                 typename MatrixType::memory_space,
+                                 typename MatrixType::index_type>
+{
+private:
+
+    typedef cusp::linear_operator<typename MatrixType::value_type,
+                                  typename MatrixType::memory_space,
+                                  typename MatrixType::index_type> Parent;
+
+public:
+
+    typedef typename MatrixType::index_type   IndexType;
+    typedef typename MatrixType::value_type   ValueType;
+    typedef typename MatrixType::memory_space MemorySpace;
+
+    /* \cond */
+    const MatrixType& A;
+    cusp::csr_matrix<IndexType,ValueType,MemorySpace> At;
+    /* \endcond */
+
+    /*! Construct <tt>A^T</tt>.
+     */
+    transpose_operator(const MatrixType& A)
+        : Parent(A.num_cols, A.num_rows, A.num_entries), A(A) {}
+
+    /* \cond */
+    template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+    void operator()(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y);
+    /* \endcond */
+
+    /*! Apply the operator to vector \p x and produce vector \p y.
+     */
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& x, VectorType2& y);
+
+    /*! Discard the cached transpose, which is formed again from \c A on
+     *  the next application. Required after the entries of \c A change.
+     */
+    void refresh(void);
+
+protected:
+
+    /* \cond */
+    template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+    void apply(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y,
+               cusp::csr_format, cusp::host_memory);
+
+    template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+    void apply(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y,
+               cusp::coo_format, cusp::host_memory);
+
+    template <typename DerivedPolicy, typename VectorType1, typename VectorType2, typename Format, typename System>
+    void apply(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y,
+               Format, System);
+    /* \endcond */
+};
+
+/**
+ * \brief Shift an operator by a multiple of the identity
+ *
+ * \tparam LinearOperator Type of matrix or operator
+ *
+ * \param A matrix or operator
+ * \param sigma shift
+ *
+ * \return lazy operator <tt>A + sigma * I</tt>
+ *
+ * \par Example
+ * \code
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/monitor.h>
+ * #include <cusp/operator_expressions.h>
+ * #include <cusp/gallery/poisson.h>
+ * #include <cusp/krylov/cg.h>
+ *
+ * int main(void)
+ * {
+ *    cusp::csr_matrix<int, float, cusp::host_memory> A;
+ *    cusp::gallery::poisson5pt(A, 10, 10);
+ *
+ *    cusp::array1d<float, cusp::host_memory> x(A.num_rows, 0);
+ *    cusp::array1d<float, cusp::host_memory> b(A.num_rows, 1);
+ *
+ *    cusp::monitor<float> monitor(b, 100, 1e-6);
+ *
+ *    // solve (A + 0.5 I) x = b without forming A + 0.5 I
+ *    cusp::krylov::cg(cusp::shift(A, 0.5f), x, b, monitor);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template <typename LinearOperator>
+affine_operator<LinearOperator>
+shift(const LinearOperator& A, const typename LinearOperator::value_type sigma);
+
+/* \cond */
+template <typename LinearOperator, typename ArrayType>
+affine_operator<LinearOperator,ArrayType>
+shift(const affine_operator<LinearOperator,ArrayType>& A, const typename LinearOperator::value_type sigma);
+/* \endcond */
+
+/**
+ * \brief Scale an operator
+ *
+ * \tparam LinearOperator Type of matrix or operator
+ *
+ * \param A matrix or operator
+ * \param alpha scaling factor
+ *
+ * \return lazy operator <tt>alpha * A</tt>
+ */
+template <typename LinearOperator>
+affine_operator<LinearOperator>
+scale(const LinearOperator& A, const typename LinearOperator::value_type alpha);
+
+/* \cond */
+template <typename LinearOperator, typename ArrayType>
+affine_operator<LinearOperator,ArrayType>
+scale(const affine_operator<LinearOperator,ArrayType>& A, const typename LinearOperator::value_type alpha);
+/* \endcond */
+
+/**
+ * \brief Scale the rows of an operator by a diagonal matrix
+ *
+ * \tparam ArrayType Type of the diagonal
+ * \tparam LinearOperator Type of matrix or operator
+ *
+ * \param D diagonal entries (referenced, not copied)
+ * \param A matrix or operator
+ *
+ * \return lazy operator <tt>D * A</tt>
+ */
+template <typename ArrayType, typename LinearOperator>
+affine_operator<LinearOperator,ArrayType>
+diag_scale(const ArrayType& D, const LinearOperator& A);
+
+/**
+ * \brief Sum of two operators
+ *
+ * \return lazy operator <tt>A + B</tt>
+ */
+template <typename LinearOperator1, typename LinearOperator2>
+sum_operator<LinearOperator1,LinearOperator2>
+sum(const LinearOperator1& A, const LinearOperator2& B);
+
+/**
+ * \brief Product of two operators
+ *
+ * \return lazy operator <tt>A * B</tt>
+ */
+template <typename LinearOperator1, typename LinearOperator2>
+product_operator<LinearOperator1,LinearOperator2>
+product(const LinearOperator1& A, const LinearOperator2& B);
+
+/**
+ * \brief Transpose of a sparse matrix
+ *
+ * \return lazy operator <tt>A^T</tt>
+ */
+template <typename MatrixType>
+transpose_operator<MatrixType>
+transpose_view(const MatrixType& A);
+/*! \}
+ */
+
+} // end namespace cusp
+
+#include <cusp/detail/operator_expressions.inl>
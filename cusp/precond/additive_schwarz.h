@@ -0,0 +1,206 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file additive_schwarz.h
+ *  \brief Restricted additive Schwarz preconditioner.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/linear_operator.h>
+#include <cusp/precond/ilu.h>
+
+#include <vector>
+
+namespace cusp
+{
+namespace precond
+{
+namespace detail
+{
+
+/* \cond */
+template <typename ValueType>
+class schwarz_subdomain
+{
+public:
+
+    // global indices of the local rows in increasing order, and the
+    // local positions of the rows owned by the subdomain
+    cusp::array1d<int, cusp::host_memory> rows;
+    cusp::array1d<int, cusp::host_memory> owned;
+
+    // dense LU factors with row pivots, or ILU(0) factors
+    bool dense;
+    cusp::array1d<ValueType, cusp::host_memory> lu;
+    cusp::array1d<int, cusp::host_memory> pivots;
+    level_scheduled_factor<int, ValueType> L;
+    level_scheduled_factor<int, ValueType> U;
+
+    cusp::array1d<ValueType, cusp::host_memory> x;
+    cusp::array1d<ValueType, cusp::host_memory> y;
+
+    template <typename MatrixType>
+    void initialize(const MatrixType& A, size_t max_dense_size);
+
+    void solve(void);
+};
+/* \endcond */
+
+} // end namespace detail
+
+/**
+ *  \ingroup preconditioners
+ *  \{
+ */
+
+/**
+ * \brief Restricted additive Schwarz preconditioner
+ *
+ * \tparam ValueType Type used for matrix values (e.g. \c float or \c double).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ * Partitions the rows of \c A into subdomains, extends every subdomain by
+ * the rows within \p overlap edges of it in the graph of \c A and
+ * factors the submatrix of \c A on the extended subdomain. Applying the
+ * preconditioner solves the local system of every subdomain with the
+ * restriction of \p x and writes the solution only to the rows owned by
+ * the subdomain (the restricted variant of additive Schwarz).
+ *
+ * Subdomains are factored and solved independently of each other,
+ * distributed over OpenMP threads, so the application needs no
+ * synchronization beyond the end of the parallel loop. Local matrices of
+ * at most \p max_dense_size rows are factored with dense LU with partial
+ * pivoting, larger ones with ILU(0).
+ *
+ * The subdomains are either contiguous ranges of rows or given by a
+ * partition of the rows, for instance from \p cusp::graph::hilbert_curve
+ * or \p cusp::graph::multilevel_partition. Using at least as many
+ * subdomains as host threads keeps all threads busy.
+ *
+ * Setup and application run on the host. When \p MemorySpace is a device
+ * memory space the vectors are staged through host memory on every
+ * application. The preconditioner is not symmetric, so it should be used
+ * with Krylov methods for nonsymmetric systems such as GMRES.
+ *
+ * \note \p A must be square and have a nonzero main diagonal. A
+ * \c cusp::runtime_exception is thrown if a local factorization fails.
+ *
+ * \par Example
+ * \code
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/monitor.h>
+ * #include <cusp/gallery/poisson.h>
+ * #include <cusp/krylov/gmres.h>
+ * #include <cusp/precond/additive_schwarz.h>
+ *
+ * int main(void)
+ * {
+ *    cusp::csr_matrix<int, double, cusp::host_memory> A;
+ *    cusp::gallery::poisson5pt(A, 256, 256);
+ *
+ *    cusp::array1d<double, cusp::host_memory> x(A.num_rows, 0);
+ *    cusp::array1d<double, cusp::host_memory> b(A.num_rows, 1);
+ *
+ *    cusp::monitor<double> monitor(b, 1000, 1e-8);
+ *
+ *    // 16 subdomains overlapping by 2 layers of neighbors
+ *    cusp::precond::additive_schwarz<double, cusp::host_memory> M(A, 16, 2);
+ *
+ *    cusp::krylov::gmres(A, x, b, 50, monitor, M);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template <typename ValueType, typename MemorySpace>
+class additive_schwarz : public linear_operator<ValueType, MemorySpace>
+{
+private:
+    typedef linear_operator<ValueType, MemorySpace> Parent;
+
+public:
+
+    /*! construct a \p additive_schwarz preconditioner with subdomains of
+     * contiguous rows
+     *
+     * \param A matrix to precondition
+     * \param num_subdomains number of subdomains
+     * \param overlap number of layers of neighbors added to every subdomain
+     * \param max_dense_size largest local matrix factored with dense LU
+     * \tparam MatrixType matrix
+     */
+    template <typename MatrixType>
+    additive_schwarz(const MatrixType& A, size_t num_subdomains, size_t overlap = 1, size_t max_dense_size = 64);
+
+    /*! construct a \p additive_schwarz preconditioner from a partition of
+     * the rows
+     *
+     * \param A matrix to precondition
+     * \param parts subdomain of every row, in <tt>[0, num_subdomains)</tt>
+     * \param overlap number of layers of neighbors added to every subdomain
+     * \param max_dense_size largest local matrix factored with dense LU
+     * \tparam MatrixType matrix
+     */
+    template <typename MatrixType, typename IndexType, typename MemorySpace2>
+    additive_schwarz(const MatrixType& A, const cusp::array1d<IndexType,MemorySpace2>& parts,
+                     size_t overlap = 1, size_t max_dense_size = 64);
+
+    /*! number of subdomains
+     */
+    size_t num_subdomains(void) const
+    {
+        return subdomains.size();
+    }
+
+    /*! apply the preconditioner to vector \p x and store the result in \p y
+     *
+     * \param x input vector
+     * \param y ouput vector
+     * \tparam VectorType1 vector
+     * \tparam VectorType2 vector
+     */
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& x, VectorType2& y);
+
+protected:
+    std::vector< detail::schwarz_subdomain<ValueType> > subdomains;
+
+    cusp::array1d<ValueType, cusp::host_memory> x_host;
+    cusp::array1d<ValueType, cusp::host_memory> y_host;
+
+    template <typename MatrixType>
+    void initialize(const MatrixType& A, const cusp::array1d<int, cusp::host_memory>& parts,
+                    size_t num_parts, size_t overlap, size_t max_dense_size);
+
+    template <typename VectorType1, typename VectorType2>
+    void apply(const VectorType1& x, VectorType2& y, cusp::host_memory);
+
+    template <typename VectorType1, typename VectorType2, typename System>
+    void apply(const VectorType1& x, VectorType2& y, System);
+};
+/*! \}
+ */
+
+} // end namespace precond
+} // end namespace cusp
+
+#include <cusp/precond/detail/additive_schwarz.inl>
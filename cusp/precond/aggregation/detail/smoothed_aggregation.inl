@@ -15,6 +15,8 @@
  */
 
 #include <cusp/array1d.h>
+#include <cusp/complex.h>
+#include <cusp/csr_matrix.h>
 #include <cusp/precond/aggregation/strength.h>
 #include <cusp/precond/aggregation/aggregate.h>
 #include <cusp/precond/aggregation/tentative.h>
@@ -24,6 +26,13 @@
 
 #include <cusp/detail/temporary_array.h>
 
+#include <thrust/copy.h>
+#include <thrust/fill.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 namespace cusp
 {
 namespace precond
@@ -31,11 +40,218 @@ namespace precond
 namespace aggregation
 {
 
+namespace detail
+{
+
+// aggregate the graph of the aggregates of C a second time and
+// compose both passes, so each node is assigned to its coarse aggregate
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType>
+void aggregate_aggregates(const thrust::detail::execution_policy_base<DerivedPolicy> &exec,
+                          const MatrixType& C,
+                                ArrayType& aggregates,
+                                ArrayType& roots)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> G(C);
+    cusp::array1d<IndexType,cusp::host_memory> agg(aggregates);
+    cusp::array1d<IndexType,cusp::host_memory> agg_roots(roots);
+
+    const IndexType num_rows = G.num_rows;
+
+    IndexType num_aggregates = 0;
+    for (IndexType i = 0; i < num_rows; i++)
+        num_aggregates = std::max(num_aggregates, agg[i] + 1);
+
+    if (num_aggregates < 2)
+        return;
+
+    // group the nodes by aggregate
+    std::vector<IndexType> member_offsets(num_aggregates + 1, 0);
+    std::vector<IndexType> members(num_rows);
+
+    for (IndexType i = 0; i < num_rows; i++)
+        if (agg[i] >= 0)
+            member_offsets[agg[i] + 1]++;
+
+    for (IndexType a = 0; a < num_aggregates; a++)
+        member_offsets[a + 1] += member_offsets[a];
+
+    {
+        std::vector<IndexType> next(member_offsets.begin(), member_offsets.end() - 1);
+
+        for (IndexType i = 0; i < num_rows; i++)
+            if (agg[i] >= 0)
+                members[next[agg[i]]++] = i;
+    }
+
+    // aggregates a and b are adjacent when a strong connection joins them
+    std::vector<IndexType> offsets(num_aggregates + 1, 0);
+    std::vector<IndexType> columns;
+    std::vector<IndexType> marker(num_aggregates, -1);
+
+    for (IndexType a = 0; a < num_aggregates; a++)
+    {
+        marker[a] = a;
+        columns.push_back(a);
+
+        for (IndexType n = member_offsets[a]; n < member_offsets[a + 1]; n++)
+        {
+            const IndexType i = members[n];
+
+            for (IndexType jj = G.row_offsets[i]; jj < G.row_offsets[i + 1]; jj++)
+            {
+                const IndexType b = agg[G.column_indices[jj]];
+
+                if (b >= 0 && marker[b] != a)
+                {
+                    marker[b] = a;
+                    columns.push_back(b);
+                }
+            }
+        }
+
+        offsets[a + 1] = columns.size();
+        std::sort(columns.begin() + offsets[a], columns.end());
+    }
+
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> G_agg(num_aggregates, num_aggregates, columns.size());
+    thrust::copy(offsets.begin(), offsets.end(), G_agg.row_offsets.begin());
+    thrust::copy(columns.begin(), columns.end(), G_agg.column_indices.begin());
+    thrust::fill(G_agg.values.begin(), G_agg.values.end(), ValueType(1));
+
+    // second pass with the same aggregation method as the first
+    MatrixType C_agg(G_agg);
+    ArrayType coarse_aggregates(num_aggregates);
+    ArrayType coarse_roots(num_aggregates);
+    cusp::precond::aggregation::aggregate(exec, C_agg, coarse_aggregates, coarse_roots);
+
+    cusp::array1d<IndexType,cusp::host_memory> coarse(coarse_aggregates);
+    cusp::array1d<IndexType,cusp::host_memory> coarse_root(coarse_roots);
+
+    IndexType num_coarse = 0;
+    for (IndexType a = 0; a < num_aggregates; a++)
+        num_coarse = std::max(num_coarse, coarse[a] + 1);
+
+    // aggregates left isolated by the second pass stay on their own
+    for (IndexType a = 0; a < num_aggregates; a++)
+    {
+        if (coarse[a] < 0)
+        {
+            coarse[a] = num_coarse;
+            coarse_root[num_coarse] = a;
+            num_coarse++;
+        }
+    }
+
+    for (IndexType i = 0; i < num_rows; i++)
+        if (agg[i] >= 0)
+            agg[i] = coarse[agg[i]];
+
+    // the root of a coarse aggregate is the root of its root aggregate
+    cusp::array1d<IndexType,cusp::host_memory> composed_roots(agg_roots);
+    for (IndexType c = 0; c < num_coarse; c++)
+        composed_roots[c] = agg_roots[coarse_root[c]];
+
+    aggregates = agg;
+    roots = composed_roots;
+}
+
+// drop the off-diagonal entries of A with |a_ij| < theta sqrt(|a_ii a_jj|)
+// and add them to the diagonal, which preserves the row sums of A
+template <typename MatrixType, typename NormType>
+void sparsify_galerkin_product(MatrixType& A, const NormType theta)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> G(A);
+
+    const int num_rows = G.num_rows;
+
+    cusp::array1d<NormType,cusp::host_memory> diagonal(num_rows, NormType(0));
+    cusp::array1d<IndexType,cusp::host_memory> row_offsets(num_rows + 1, IndexType(0));
+
+    #pragma omp parallel for
+    for (int i = 0; i < num_rows; i++)
+    {
+        ValueType d(0);
+
+        for (IndexType jj = G.row_offsets[i]; jj < G.row_offsets[i + 1]; jj++)
+            if (G.column_indices[jj] == i)
+                d += G.values[jj];
+
+        diagonal[i] = cusp::abs(d);
+    }
+
+    // a missing or zero diagonal keeps the row and column intact, so
+    // entries are only dropped from rows that can absorb them
+    #pragma omp parallel for
+    for (int i = 0; i < num_rows; i++)
+    {
+        IndexType count = 0;
+
+        for (IndexType jj = G.row_offsets[i]; jj < G.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = G.column_indices[jj];
+
+            if (j == i || !(cusp::abs(G.values[jj]) < theta * std::sqrt(diagonal[i] * diagonal[j])))
+                count++;
+        }
+
+        row_offsets[i + 1] = count;
+    }
+
+    for (int i = 0; i < num_rows; i++)
+        row_offsets[i + 1] += row_offsets[i];
+
+    if (size_t(row_offsets[num_rows]) == G.num_entries)
+        return;
+
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> S(num_rows, G.num_cols, row_offsets[num_rows]);
+    S.row_offsets = row_offsets;
+
+    #pragma omp parallel for
+    for (int i = 0; i < num_rows; i++)
+    {
+        IndexType n = S.row_offsets[i];
+        IndexType diagonal_position = -1;
+        ValueType dropped(0);
+
+        for (IndexType jj = G.row_offsets[i]; jj < G.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = G.column_indices[jj];
+
+            if (j == i || !(cusp::abs(G.values[jj]) < theta * std::sqrt(diagonal[i] * diagonal[j])))
+            {
+                if (j == i)
+                    diagonal_position = n;
+
+                S.column_indices[n] = j;
+                S.values[n]         = G.values[jj];
+                n++;
+            }
+            else
+            {
+                dropped += G.values[jj];
+            }
+        }
+
+        if (diagonal_position >= 0)
+            S.values[diagonal_position] += dropped;
+    }
+
+    A = S;
+}
+
+} // end namespace detail
+
 template <typename IndexType, typename ValueType, typename MemorySpace, typename SmootherType, typename SolverType, typename Format>
 template <typename MatrixType>
 smoothed_aggregation<IndexType,ValueType,MemorySpace,SmootherType,SolverType,Format>
 ::smoothed_aggregation(const MatrixType& A)
-    : ML()
+    : ML(), aggressive_levels(0), sparsification_threshold(0)
 {
     initialize(A);
 }
@@ -44,7 +260,7 @@ template <typename IndexType, typename ValueType, typename MemorySpace, typename
 template <typename MatrixType, typename ArrayType>
 smoothed_aggregation<IndexType,ValueType,MemorySpace,SmootherType,SolverType,Format>
 ::smoothed_aggregation(const MatrixType& A, const ArrayType& B)
-    : ML()
+    : ML(), aggressive_levels(0), sparsification_threshold(0)
 {
     initialize(A, B);
 }
@@ -53,7 +269,7 @@ template <typename IndexType, typename ValueType, typename MemorySpace, typename
 template <typename MemorySpace2, typename SmootherType2, typename SolverType2, typename Format2>
 smoothed_aggregation<IndexType,ValueType,MemorySpace,SmootherType,SolverType,Format>
 ::smoothed_aggregation(const smoothed_aggregation<IndexType,ValueType,MemorySpace2,SmootherType2,SolverType2,Format2>& M)
-    : ML(M)
+    : ML(M), aggressive_levels(M.aggressive_levels), sparsification_threshold(M.sparsification_threshold)
 {
     for( size_t lvl = 0; lvl < M.sa_levels.size(); lvl++ )
         sa_levels.push_back(M.sa_levels[lvl]);
@@ -128,6 +344,20 @@ void smoothed_aggregation<IndexType,ValueType,MemorySpace,SmootherType,SolverTyp
     ML::initialize_coarse_solver();
 }
 
+template <typename IndexType, typename ValueType, typename MemorySpace, typename SmootherType, typename SolverType, typename Format>
+void smoothed_aggregation<IndexType,ValueType,MemorySpace,SmootherType,SolverType,Format>
+::set_aggressive_levels(size_t num_levels)
+{
+    aggressive_levels = num_levels;
+}
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename SmootherType, typename SolverType, typename Format>
+void smoothed_aggregation<IndexType,ValueType,MemorySpace,SmootherType,SolverType,Format>
+::set_sparsification_threshold(NormType theta)
+{
+    sparsification_threshold = theta;
+}
+
 template <typename IndexType, typename ValueType, typename MemorySpace, typename SmootherType, typename SolverType, typename Format>
 template <typename DerivedPolicy, typename MatrixType>
 void smoothed_aggregation<IndexType,ValueType,MemorySpace,SmootherType,SolverType,Format>
@@ -145,6 +375,9 @@ void smoothed_aggregation<IndexType,ValueType,MemorySpace,SmootherType,SolverTyp
         sa_levels.back().aggregates.resize(A.num_rows, IndexType(0));
         sa_levels.back().roots.resize(A.num_rows);
         aggregate(exec, C, sa_levels.back().aggregates, sa_levels.back().roots);
+
+        if (sa_levels.size() <= aggressive_levels)
+            detail::aggregate_aggregates(exec, C, sa_levels.back().aggregates, sa_levels.back().roots);
     }
 
     SetupMatrixType P;
@@ -164,6 +397,9 @@ void smoothed_aggregation<IndexType,ValueType,MemorySpace,SmootherType,SolverTyp
     SetupMatrixType RAP;
     galerkin_product(exec, R, A, P, RAP);
 
+    if (sparsification_threshold > 0)
+        detail::sparsify_galerkin_product(RAP, sparsification_threshold);
+
     // Setup components for next level in hierarchy
     sa_levels.push_back(sa_level<SetupMatrixType>());
     sa_levels.back().A_.swap(RAP);
@@ -165,6 +165,7 @@ class smoothed_aggregation :
 
     typedef typename detail::select_sa_matrix_type<IndexType,ValueType,MemorySpace>::type	SetupMatrixType;
     typedef typename cusp::multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>::container ML;
+    typedef typename cusp::norm_type<ValueType>::type NormType;
 
   public:
 
@@ -172,10 +173,16 @@ class smoothed_aggregation :
     std::vector< sa_level<SetupMatrixType> > sa_levels;
     /* \endcond */
 
+    // number of leading levels that aggregate the aggregate graph a second time
+    size_t aggressive_levels;
+
+    // relative threshold for dropping weak entries of the coarse operators
+    NormType sparsification_threshold;
+
     /**
      * Construct an empty \p smoothed_aggregation preconditioner.
      */
-    smoothed_aggregation(void) : ML() {};
+    smoothed_aggregation(void) : ML(), aggressive_levels(0), sparsification_threshold(0) {};
 
     /*! Construct a \p smoothed_aggregation preconditioner from a matrix.
      *
@@ -237,6 +244,25 @@ class smoothed_aggregation :
                     const ArrayType&  B);
     /* \endcond */
 
+    /*! Coarsen the first \p num_levels levels of the hierarchy
+     *  aggressively: after the nodes are aggregated, the graph of the
+     *  aggregates is aggregated a second time, so each coarse unknown
+     *  covers roughly the nodes of a distance-two neighbourhood. This
+     *  shrinks the coarse levels and the operator complexity at the
+     *  cost of a weaker coarse correction. Takes effect at the next
+     *  call to \p initialize.
+     */
+    void set_aggressive_levels(size_t num_levels);
+
+    /*! Sparsify every coarse operator after the Galerkin product. The
+     *  off-diagonal entries with |a_ij| < theta sqrt(|a_ii a_jj|) are
+     *  dropped and added to the diagonal of their row, which preserves
+     *  the row sums and with them the action on the constant vector.
+     *  0 keeps the exact Galerkin operators. Takes effect at the next
+     *  call to \p initialize.
+     */
+    void set_sparsification_threshold(NormType theta);
+
 protected:
 
     /* \cond */
@@ -0,0 +1,163 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file block_jacobi.h
+ *  \brief Block Jacobi preconditioner.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/linear_operator.h>
+
+namespace cusp
+{
+namespace precond
+{
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup preconditioners Preconditioners
+ *  \brief Several preconditioners for iterative solvers
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/** \brief Block Jacobi preconditioner
+ *
+ *  \tparam ValueType Type used for matrix values (e.g. \c float or \c double).
+ *  \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ *  \par Overview
+ *  Given a matrix \c A and a partition of its rows into contiguous blocks,
+ *  the block Jacobi preconditioner extracts the dense diagonal blocks
+ *  \c D of \c A, inverts them and implements <tt>y = D^-1 x</tt> when
+ *  applied to a vector \p x. Systems with several coupled unknowns per
+ *  node benefit when the unknowns of a node form a block.
+ *
+ *  The blocks either have a uniform size or are given by an array of
+ *  block offsets. Uniform blocks of up to 8 rows use kernels specialized
+ *  for the block size: the setup inverts 8 blocks at a time with their
+ *  entries interleaved, so that the elimination vectorizes across the
+ *  blocks, and falls back to partial pivoting for blocks with small
+ *  pivots. Other blocks are inverted one at a time with partial
+ *  pivoting. The setup runs on the host and throws
+ *  \p cusp::runtime_exception if a diagonal block is singular.
+ *
+ *  \par Example
+ *  The following code snippet demonstrates how to use a
+ *  \p block_jacobi preconditioner to solve a linear system with 3
+ *  unknowns per node.
+ *
+ *  \code
+ *  #include <cusp/precond/block_jacobi.h>
+ *
+ *  int main(void)
+ *  {
+ *    // allocate storage for solution (x) and right hand side (b)
+ *    cusp::array1d<float, cusp::device_memory> x(A.num_rows, 0);
+ *    cusp::array1d<float, cusp::device_memory> b(A.num_rows, 1);
+ *
+ *    cusp::monitor<float> monitor(b, 100, 1e-6);
+ *
+ *    // setup preconditioner with 3x3 diagonal blocks
+ *    cusp::precond::block_jacobi<float, cusp::device_memory> M(A, 3);
+ *
+ *    // solve
+ *    cusp::krylov::gmres(A, x, b, 50, monitor, M);
+ *
+ *    return 0;
+ *  }
+ *  \endcode
+ */
+template <typename ValueType, typename MemorySpace>
+class block_jacobi : public linear_operator<ValueType, MemorySpace>
+{
+    typedef linear_operator<ValueType, MemorySpace> Parent;
+
+public:
+    /* \cond */
+    size_t block_size;
+
+    // rows of block i are [block_offsets[i], block_offsets[i+1]) and its
+    // inverse is stored row-major starting at value_offsets[i]
+    cusp::array1d<int, MemorySpace> block_offsets;
+    cusp::array1d<int, MemorySpace> value_offsets;
+    cusp::array1d<ValueType, MemorySpace> block_inverses;
+    /* \endcond */
+
+    /*! construct an empty \p block_jacobi preconditioner
+     */
+    block_jacobi(void) : block_size(0) {}
+
+    /*! construct a \p block_jacobi preconditioner with uniform blocks
+     *
+     * \param A matrix to precondition
+     * \param block_size number of rows of each block, the last block is
+     * shorter if \p block_size does not divide the number of rows
+     * \tparam MatrixType matrix
+     */
+    template <typename MatrixType>
+    block_jacobi(const MatrixType& A, const size_t block_size);
+
+    /*! construct a \p block_jacobi preconditioner with variable blocks
+     *
+     * \param A matrix to precondition
+     * \param block_offsets first row of each block followed by the number
+     * of rows of \p A
+     * \tparam MatrixType matrix
+     */
+    template <typename MatrixType, typename IndexType, typename MemorySpace2>
+    block_jacobi(const MatrixType& A, const cusp::array1d<IndexType,MemorySpace2>& block_offsets);
+
+    /*! copy a \p block_jacobi preconditioner from another memory space
+     */
+    template <typename MemorySpace2>
+    block_jacobi(const block_jacobi<ValueType,MemorySpace2>& M)
+        : Parent(M.num_rows, M.num_cols, M.num_entries),
+          block_size(M.block_size), block_offsets(M.block_offsets),
+          value_offsets(M.value_offsets), block_inverses(M.block_inverses) {}
+
+    /*! number of diagonal blocks
+     */
+    size_t num_blocks(void) const
+    {
+        return block_offsets.empty() ? 0 : block_offsets.size() - 1;
+    }
+
+    /*! apply the preconditioner to vector \p x and store the result in \p y
+     *
+     * \param x input vector
+     * \param y ouput vector
+     * \tparam VectorType1 vector
+     * \tparam VectorType2 vector
+     */
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& x, VectorType2& y) const;
+
+protected:
+    template <typename MatrixType>
+    void initialize(const MatrixType& A, const cusp::array1d<int, cusp::host_memory>& offsets);
+};
+/*! \}
+ */
+
+} // end namespace precond
+} // end namespace cusp
+
+#include <cusp/precond/detail/block_jacobi.inl>
@@ -0,0 +1,75 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file cf_splitting.h
+ *  \brief Parallel coarse/fine splittings for classical AMG
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+namespace cusp
+{
+namespace precond
+{
+namespace classical
+{
+
+/*  Compute a coarse/fine splitting of the strength matrix S with the
+ *  parallel modified independent set (PMIS) algorithm. On return
+ *  splitting[i] is 1 for coarse (C) points and 0 for fine (F) points.
+ *
+ *  Every point is weighted by the number of points that depend strongly on
+ *  it plus a random number in [0,1). Points that no other point depends on
+ *  become F points. In every round the undecided points whose weight is
+ *  maximal among their undecided neighbors in S + S^T become C points and
+ *  the undecided points that depend strongly on a new C point become F
+ *  points. The C points chosen in one round are independent in S + S^T
+ *  and, for a symmetric S, every F point with strong connections depends
+ *  strongly on a C point.
+ *
+ *  Note: S is a CSR matrix in host memory, e.g. the result of
+ *  classical_strength_of_connection.
+ */
+template <typename MatrixType,
+          typename ArrayType>
+void pmis_splitting(const MatrixType& S,
+                          ArrayType& splitting);
+
+/*  Compute a coarse/fine splitting of the strength matrix S with the
+ *  hybrid modified independent set (HMIS) algorithm. On return
+ *  splitting[i] is 1 for coarse (C) points and 0 for fine (F) points.
+ *
+ *  The rows are divided into contiguous blocks and the first pass of the
+ *  sequential Ruge-Stuben coarsening is run on every block independently,
+ *  using only the connections inside the block. The resulting C points
+ *  seed the PMIS algorithm, which decides the remaining points.
+ *
+ *  Note: S is a CSR matrix in host memory, e.g. the result of
+ *  classical_strength_of_connection.
+ */
+template <typename MatrixType,
+          typename ArrayType>
+void hmis_splitting(const MatrixType& S,
+                          ArrayType& splitting);
+
+} // end namespace classical
+} // end namespace precond
+} // end namespace cusp
+
+#include <cusp/precond/classical/detail/cf_splitting.inl>
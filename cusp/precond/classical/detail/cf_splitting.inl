@@ -0,0 +1,304 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/copy.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/transpose.h>
+
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace cusp
+{
+namespace precond
+{
+namespace classical
+{
+namespace detail
+{
+
+enum { F_POINT = 0, C_POINT = 1, U_POINT = 2 };
+
+// true if no undecided neighbor of i in S has a larger (weight, index) pair
+template <typename MatrixType, typename ArrayType1, typename ArrayType2>
+bool is_undecided_maximum(const MatrixType& S,
+                          const ArrayType1& weights,
+                          const ArrayType2& state,
+                          const typename MatrixType::index_type i)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    for (IndexType jj = S.row_offsets[i]; jj < S.row_offsets[i + 1]; jj++)
+    {
+        const IndexType j = S.column_indices[jj];
+
+        if (state[j] == U_POINT && (weights[j] > weights[i] || (weights[j] == weights[i] && j > i)))
+            return false;
+    }
+
+    return true;
+}
+
+// Decide the undecided points of state with the PMIS rounds. The points
+// that are already C points act as the initial independent set.
+template <typename MatrixType, typename ArrayType1, typename ArrayType2>
+void pmis_iterate(const MatrixType& S,
+                  const MatrixType& ST,
+                  const ArrayType1& weights,
+                        ArrayType2& state)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const IndexType N = S.num_rows;
+
+    std::vector<IndexType> undecided;
+    std::vector<char> update;
+
+    // points without dependents never interpolate to others
+    for (IndexType i = 0; i < N; i++)
+    {
+        if (state[i] != U_POINT)
+            continue;
+
+        if (weights[i] < 1.0)
+            state[i] = F_POINT;
+        else
+            undecided.push_back(i);
+    }
+
+    bool select = false;
+
+    while (!undecided.empty())
+    {
+        const IndexType num_undecided = undecided.size();
+
+        update.assign(num_undecided, U_POINT);
+
+        if (select)
+        {
+            // undecided local maxima of the weights become C points
+            #pragma omp parallel for
+            for (IndexType n = 0; n < num_undecided; n++)
+            {
+                const IndexType i = undecided[n];
+
+                if (is_undecided_maximum(S, weights, state, i) && is_undecided_maximum(ST, weights, state, i))
+                    update[n] = C_POINT;
+            }
+
+            for (IndexType n = 0; n < num_undecided; n++)
+                if (update[n] == C_POINT)
+                    state[undecided[n]] = C_POINT;
+        }
+
+        // undecided points depending strongly on a C point become F points
+        #pragma omp parallel for
+        for (IndexType n = 0; n < num_undecided; n++)
+        {
+            const IndexType i = undecided[n];
+
+            if (state[i] != U_POINT)
+                continue;
+
+            for (IndexType jj = S.row_offsets[i]; jj < S.row_offsets[i + 1]; jj++)
+            {
+                if (state[S.column_indices[jj]] == C_POINT)
+                {
+                    update[n] = F_POINT;
+                    break;
+                }
+            }
+        }
+
+        IndexType num_remaining = 0;
+
+        for (IndexType n = 0; n < num_undecided; n++)
+        {
+            const IndexType i = undecided[n];
+
+            if (update[n] == F_POINT)
+                state[i] = F_POINT;
+            else if (state[i] == U_POINT)
+                undecided[num_remaining++] = i;
+        }
+
+        undecided.resize(num_remaining);
+        select = true;
+    }
+}
+
+// Number of points depending strongly on each point plus a random number
+// in [0,1) that breaks the ties
+template <typename MatrixType, typename ArrayType>
+void pmis_weights(const MatrixType& ST, ArrayType& weights)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const IndexType N = ST.num_rows;
+
+    cusp::copy(cusp::random_array<double>(N), weights);
+
+    #pragma omp parallel for
+    for (IndexType i = 0; i < N; i++)
+        weights[i] += double(ST.row_offsets[i + 1] - ST.row_offsets[i]);
+}
+
+// First pass of the Ruge-Stuben coarsening restricted to the rows
+// [row_begin, row_end). Points whose measure drops to zero stay undecided.
+template <typename MatrixType, typename ArrayType>
+void ruge_stuben_first_pass(const MatrixType& S,
+                            const MatrixType& ST,
+                            const typename MatrixType::index_type row_begin,
+                            const typename MatrixType::index_type row_end,
+                                  ArrayType& state)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef std::pair<IndexType, IndexType> Key;
+
+    // lambda = |undecided dependents| + 2 |F dependents| inside the block
+    std::vector<IndexType> lambda(row_end - row_begin, 0);
+    std::set<Key> queue;
+
+    for (IndexType i = row_begin; i < row_end; i++)
+    {
+        for (IndexType jj = ST.row_offsets[i]; jj < ST.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = ST.column_indices[jj];
+
+            if (j >= row_begin && j < row_end)
+                lambda[i - row_begin]++;
+        }
+
+        if (lambda[i - row_begin] > 0)
+            queue.insert(Key(lambda[i - row_begin], i));
+    }
+
+    while (!queue.empty())
+    {
+        const IndexType i = (--queue.end())->second;
+
+        queue.erase(--queue.end());
+        state[i] = C_POINT;
+
+        // undecided dependents of i become F points
+        for (IndexType jj = ST.row_offsets[i]; jj < ST.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = ST.column_indices[jj];
+
+            if (j < row_begin || j >= row_end || state[j] != U_POINT)
+                continue;
+
+            queue.erase(Key(lambda[j - row_begin], j));
+            state[j] = F_POINT;
+
+            // points that j depends on become more attractive C points
+            for (IndexType kk = S.row_offsets[j]; kk < S.row_offsets[j + 1]; kk++)
+            {
+                const IndexType k = S.column_indices[kk];
+
+                if (k < row_begin || k >= row_end || state[k] != U_POINT)
+                    continue;
+
+                queue.erase(Key(lambda[k - row_begin], k));
+                queue.insert(Key(++lambda[k - row_begin], k));
+            }
+        }
+
+        // points that i depends on lose an undecided dependent
+        for (IndexType jj = S.row_offsets[i]; jj < S.row_offsets[i + 1]; jj++)
+        {
+            const IndexType k = S.column_indices[jj];
+
+            if (k < row_begin || k >= row_end || state[k] != U_POINT)
+                continue;
+
+            queue.erase(Key(lambda[k - row_begin], k));
+
+            if (--lambda[k - row_begin] > 0)
+                queue.insert(Key(lambda[k - row_begin], k));
+        }
+    }
+}
+
+} // end namespace detail
+
+template <typename MatrixType, typename ArrayType>
+void pmis_splitting(const MatrixType& S, ArrayType& splitting)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+
+    const IndexType N = S.num_rows;
+
+    cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> ST;
+    cusp::transpose(S, ST);
+
+    cusp::array1d<double, cusp::host_memory> weights(N);
+    detail::pmis_weights(ST, weights);
+
+    cusp::array1d<char, cusp::host_memory> state(N, detail::U_POINT);
+    detail::pmis_iterate(S, ST, weights, state);
+
+    splitting.resize(N);
+    cusp::copy(state, splitting);
+}
+
+template <typename MatrixType, typename ArrayType>
+void hmis_splitting(const MatrixType& S, ArrayType& splitting)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+
+    const IndexType N = S.num_rows;
+
+    // independent blocks of the first pass
+    const IndexType max_blocks = 64;
+    const IndexType min_block_size = 8192;
+    const IndexType num_blocks = std::max(IndexType(1), std::min(max_blocks, N / min_block_size));
+    const IndexType block_size = (N + num_blocks - 1) / num_blocks;
+
+    cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> ST;
+    cusp::transpose(S, ST);
+
+    cusp::array1d<char, cusp::host_memory> state(N, detail::U_POINT);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (IndexType block = 0; block < num_blocks; block++)
+    {
+        const IndexType row_begin = block * block_size;
+        const IndexType row_end   = std::min(N, row_begin + block_size);
+
+        detail::ruge_stuben_first_pass(S, ST, row_begin, row_end, state);
+    }
+
+    cusp::array1d<double, cusp::host_memory> weights(N);
+    detail::pmis_weights(ST, weights);
+
+    detail::pmis_iterate(S, ST, weights, state);
+
+    splitting.resize(N);
+    cusp::copy(state, splitting);
+}
+
+} // end namespace classical
+} // end namespace precond
+} // end namespace cusp
@@ -0,0 +1,487 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/precond/classical/cf_splitting.h>
+
+#include <thrust/scan.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace cusp
+{
+namespace precond
+{
+namespace classical
+{
+namespace detail
+{
+
+template <typename Entry>
+struct interpolation_column_less
+{
+    bool operator()(const Entry& a, const Entry& b) const
+    {
+        return a.first < b.first;
+    }
+};
+
+template <typename Entry>
+struct interpolation_weight_greater
+{
+    bool operator()(const Entry& a, const Entry& b) const
+    {
+        return std::abs(a.second) > std::abs(b.second);
+    }
+};
+
+template <typename Entry>
+struct interpolation_weight_small
+{
+    typedef typename Entry::second_type ValueType;
+
+    ValueType threshold;
+
+    interpolation_weight_small(const ValueType threshold) : threshold(threshold) {}
+
+    bool operator()(const Entry& a) const
+    {
+        return std::abs(a.second) < threshold;
+    }
+};
+
+// drop small weights and rescale the remaining ones to the original row sum
+template <typename Entry>
+void truncate_interpolation_row(std::vector<Entry>& entries,
+                                const double truncation_factor,
+                                const size_t max_elements)
+{
+    typedef typename Entry::second_type ValueType;
+
+    if (entries.empty())
+        return;
+
+    ValueType max_weight = 0;
+    ValueType row_sum = 0;
+
+    for (size_t n = 0; n < entries.size(); n++)
+    {
+        max_weight = std::max(max_weight, ValueType(std::abs(entries[n].second)));
+        row_sum += entries[n].second;
+    }
+
+    const size_t num_entries = entries.size();
+
+    if (truncation_factor > 0.0)
+    {
+        const ValueType threshold = ValueType(truncation_factor) * max_weight;
+
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     interpolation_weight_small<Entry>(threshold)),
+                      entries.end());
+    }
+
+    if (max_elements > 0 && entries.size() > max_elements)
+    {
+        std::nth_element(entries.begin(), entries.begin() + max_elements, entries.end(),
+                         interpolation_weight_greater<Entry>());
+        entries.resize(max_elements);
+    }
+
+    if (entries.size() == num_entries)
+        return;
+
+    ValueType kept_sum = 0;
+
+    for (size_t n = 0; n < entries.size(); n++)
+        kept_sum += entries[n].second;
+
+    if (kept_sum != ValueType(0))
+        for (size_t n = 0; n < entries.size(); n++)
+            entries[n].second *= row_sum / kept_sum;
+}
+
+template <typename MatrixType, typename ArrayType>
+void interpolation_diagonal(const MatrixType& A, ArrayType& diagonal)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+
+    const IndexType N = A.num_rows;
+
+    diagonal.resize(N);
+
+    #pragma omp parallel for
+    for (IndexType i = 0; i < N; i++)
+    {
+        ValueType sum = 0;
+
+        for (IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            if (A.column_indices[jj] == i)
+                sum += A.values[jj];
+
+        diagonal[i] = sum;
+    }
+}
+
+// weights of an F point for direct interpolation
+template <typename MatrixType1, typename MatrixType2, typename ArrayType1, typename ArrayType2>
+class direct_interpolation_row
+{
+    typedef typename MatrixType1::index_type IndexType;
+    typedef typename MatrixType1::value_type ValueType;
+
+    const MatrixType1& A;
+    const MatrixType2& S;
+    const ArrayType1& splitting;
+    const ArrayType2& diagonal;
+
+    // strong[j] is set while j is a strong neighbor of the current row
+    std::vector<char> strong;
+
+public:
+
+    direct_interpolation_row(const MatrixType1& A, const MatrixType2& S,
+                             const ArrayType1& splitting, const ArrayType2& diagonal)
+        : A(A), S(S), splitting(splitting), diagonal(diagonal), strong(A.num_rows, 0) {}
+
+    direct_interpolation_row(const direct_interpolation_row& other)
+        : A(other.A), S(other.S), splitting(other.splitting), diagonal(other.diagonal),
+          strong(other.A.num_rows, 0) {}
+
+    void operator()(const IndexType i, std::vector< std::pair<IndexType, ValueType> >& entries)
+    {
+        entries.clear();
+
+        for (IndexType jj = S.row_offsets[i]; jj < S.row_offsets[i + 1]; jj++)
+            strong[S.column_indices[jj]] = 1;
+
+        const ValueType sign = diagonal[i] < ValueType(0) ? ValueType(-1) : ValueType(1);
+
+        // sums of the couplings of the opposite and of the same sign as the diagonal
+        ValueType all_opposite = 0, all_same = 0;
+        ValueType interp_opposite = 0, interp_same = 0;
+
+        for (IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = A.column_indices[jj];
+            const ValueType a = A.values[jj];
+
+            if (j == i)
+                continue;
+
+            const bool interpolatory = strong[j] && splitting[j] == C_POINT;
+
+            if (sign * a < ValueType(0))
+            {
+                all_opposite += a;
+                if (interpolatory) interp_opposite += a;
+            }
+            else
+            {
+                all_same += a;
+                if (interpolatory) interp_same += a;
+            }
+        }
+
+        ValueType diag = diagonal[i];
+
+        const ValueType alpha = interp_opposite != ValueType(0) ? all_opposite / interp_opposite : ValueType(0);
+        ValueType beta = 0;
+
+        if (interp_same != ValueType(0))
+            beta = all_same / interp_same;
+        else
+            diag += all_same;
+
+        if (diag != ValueType(0))
+        {
+            for (IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            {
+                const IndexType j = A.column_indices[jj];
+                const ValueType a = A.values[jj];
+
+                if (j == i || !strong[j] || splitting[j] != C_POINT)
+                    continue;
+
+                const ValueType scale = sign * a < ValueType(0) ? alpha : beta;
+
+                entries.push_back(std::make_pair(j, -scale * a / diag));
+            }
+        }
+
+        for (IndexType jj = S.row_offsets[i]; jj < S.row_offsets[i + 1]; jj++)
+            strong[S.column_indices[jj]] = 0;
+    }
+};
+
+// weights of an F point for extended+i interpolation
+template <typename MatrixType1, typename MatrixType2, typename ArrayType1, typename ArrayType2>
+class extended_i_interpolation_row
+{
+    typedef typename MatrixType1::index_type IndexType;
+    typedef typename MatrixType1::value_type ValueType;
+
+    const MatrixType1& A;
+    const MatrixType2& S;
+    const ArrayType1& splitting;
+    const ArrayType2& diagonal;
+
+    // strong[j] is set while j is a strong neighbor of the current row and
+    // position[j] is the index of C point j in points, or -1
+    std::vector<char> strong;
+    std::vector<IndexType> position;
+    std::vector<IndexType> points;
+    std::vector<ValueType> weights;
+
+    void add_point(const IndexType j)
+    {
+        if (position[j] < 0)
+        {
+            position[j] = points.size();
+            points.push_back(j);
+        }
+    }
+
+public:
+
+    extended_i_interpolation_row(const MatrixType1& A, const MatrixType2& S,
+                                 const ArrayType1& splitting, const ArrayType2& diagonal)
+        : A(A), S(S), splitting(splitting), diagonal(diagonal),
+          strong(A.num_rows, 0), position(A.num_rows, -1) {}
+
+    extended_i_interpolation_row(const extended_i_interpolation_row& other)
+        : A(other.A), S(other.S), splitting(other.splitting), diagonal(other.diagonal),
+          strong(other.A.num_rows, 0), position(other.A.num_rows, -1) {}
+
+    void operator()(const IndexType i, std::vector< std::pair<IndexType, ValueType> >& entries)
+    {
+        entries.clear();
+        points.clear();
+
+        // interpolatory set: strong C neighbors of i and of its strong F neighbors
+        for (IndexType jj = S.row_offsets[i]; jj < S.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = S.column_indices[jj];
+
+            strong[j] = 1;
+
+            if (splitting[j] == C_POINT)
+            {
+                add_point(j);
+                continue;
+            }
+
+            for (IndexType kk = S.row_offsets[j]; kk < S.row_offsets[j + 1]; kk++)
+                if (splitting[S.column_indices[kk]] == C_POINT)
+                    add_point(S.column_indices[kk]);
+        }
+
+        weights.assign(points.size(), ValueType(0));
+
+        ValueType diag = diagonal[i];
+
+        for (IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+        {
+            const IndexType j = A.column_indices[jj];
+            const ValueType a = A.values[jj];
+
+            if (j == i)
+                continue;
+
+            if (position[j] >= 0)
+            {
+                weights[position[j]] += a;
+            }
+            else if (strong[j])
+            {
+                // distribute a over the couplings of row j to the
+                // interpolatory points and to i of sign opposite to A[j,j]
+                const ValueType sign = diagonal[j] < ValueType(0) ? ValueType(-1) : ValueType(1);
+
+                ValueType sum = 0;
+
+                for (IndexType kk = A.row_offsets[j]; kk < A.row_offsets[j + 1]; kk++)
+                {
+                    const IndexType k = A.column_indices[kk];
+
+                    if ((k == i || position[k] >= 0) && sign * A.values[kk] < ValueType(0))
+                        sum += A.values[kk];
+                }
+
+                if (sum == ValueType(0))
+                {
+                    diag += a;
+                    continue;
+                }
+
+                for (IndexType kk = A.row_offsets[j]; kk < A.row_offsets[j + 1]; kk++)
+                {
+                    const IndexType k = A.column_indices[kk];
+
+                    if (sign * A.values[kk] >= ValueType(0))
+                        continue;
+
+                    if (k == i)
+                        diag += a * A.values[kk] / sum;
+                    else if (position[k] >= 0)
+                        weights[position[k]] += a * A.values[kk] / sum;
+                }
+            }
+            else
+            {
+                // weak connections are lumped to the diagonal
+                diag += a;
+            }
+        }
+
+        if (diag != ValueType(0))
+            for (size_t n = 0; n < points.size(); n++)
+                entries.push_back(std::make_pair(points[n], -weights[n] / diag));
+
+        for (size_t n = 0; n < points.size(); n++)
+            position[points[n]] = -1;
+
+        for (IndexType jj = S.row_offsets[i]; jj < S.row_offsets[i + 1]; jj++)
+            strong[S.column_indices[jj]] = 0;
+    }
+};
+
+// Assemble P from the rows computed by row. C points inject their coarse
+// value and the weights of the F points are truncated.
+template <typename MatrixType, typename ArrayType, typename RowType>
+void assemble_interpolation(const ArrayType& splitting,
+                            const RowType& prototype,
+                                  MatrixType& P,
+                            const double truncation_factor,
+                            const size_t max_elements)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+    typedef std::pair<IndexType, ValueType> Entry;
+
+    const IndexType N = splitting.size();
+
+    // rows are computed in chunks whose entries are concatenated afterwards
+    const IndexType chunk_size = 1024;
+    const IndexType num_chunks = (N + chunk_size - 1) / chunk_size;
+
+    cusp::array1d<IndexType, cusp::host_memory> coarse_index(N + 1, 0);
+
+    for (IndexType i = 0; i < N; i++)
+        coarse_index[i + 1] = coarse_index[i] + (splitting[i] == C_POINT ? 1 : 0);
+
+    cusp::array1d<IndexType, cusp::host_memory> row_offsets(N + 1, 0);
+    std::vector< std::vector<Entry> > chunk_entries(num_chunks);
+
+    #pragma omp parallel
+    {
+        RowType row(prototype);
+        std::vector<Entry> entries;
+
+        #pragma omp for schedule(dynamic)
+        for (IndexType chunk = 0; chunk < num_chunks; chunk++)
+        {
+            const IndexType row_begin = chunk * chunk_size;
+            const IndexType row_end   = std::min(N, row_begin + chunk_size);
+
+            for (IndexType i = row_begin; i < row_end; i++)
+            {
+                if (splitting[i] == C_POINT)
+                {
+                    entries.assign(1, Entry(i, ValueType(1)));
+                }
+                else
+                {
+                    row(i, entries);
+                    truncate_interpolation_row(entries, truncation_factor, max_elements);
+                    std::sort(entries.begin(), entries.end(), interpolation_column_less<Entry>());
+                }
+
+                for (size_t n = 0; n < entries.size(); n++)
+                    entries[n].first = coarse_index[entries[n].first];
+
+                row_offsets[i] = entries.size();
+                chunk_entries[chunk].insert(chunk_entries[chunk].end(), entries.begin(), entries.end());
+            }
+        }
+    }
+
+    thrust::exclusive_scan(row_offsets.begin(), row_offsets.end(), row_offsets.begin());
+
+    P.resize(N, coarse_index[N], row_offsets[N]);
+    P.row_offsets = row_offsets;
+
+    #pragma omp parallel for schedule(dynamic)
+    for (IndexType chunk = 0; chunk < num_chunks; chunk++)
+    {
+        const IndexType offset = row_offsets[chunk * chunk_size];
+
+        for (size_t n = 0; n < chunk_entries[chunk].size(); n++)
+        {
+            P.column_indices[offset + n] = chunk_entries[chunk][n].first;
+            P.values[offset + n]         = chunk_entries[chunk][n].second;
+        }
+
+        std::vector<Entry>().swap(chunk_entries[chunk]);
+    }
+}
+
+} // end namespace detail
+
+template <typename MatrixType1, typename MatrixType2, typename ArrayType, typename MatrixType3>
+void direct_interpolation(const MatrixType1& A, const MatrixType2& S, const ArrayType& splitting, MatrixType3& P,
+                          const double truncation_factor, const size_t max_elements)
+{
+    typedef typename MatrixType1::index_type IndexType;
+    typedef typename MatrixType1::value_type ValueType;
+    typedef cusp::array1d<IndexType, cusp::host_memory> SplittingArray;
+    typedef cusp::array1d<ValueType, cusp::host_memory> DiagonalArray;
+
+    SplittingArray splitting_(splitting);
+    DiagonalArray diagonal;
+    detail::interpolation_diagonal(A, diagonal);
+
+    detail::direct_interpolation_row<MatrixType1, MatrixType2, SplittingArray, DiagonalArray> row(A, S, splitting_, diagonal);
+    detail::assemble_interpolation(splitting_, row, P, truncation_factor, max_elements);
+}
+
+template <typename MatrixType1, typename MatrixType2, typename ArrayType, typename MatrixType3>
+void extended_i_interpolation(const MatrixType1& A, const MatrixType2& S, const ArrayType& splitting, MatrixType3& P,
+                              const double truncation_factor, const size_t max_elements)
+{
+    typedef typename MatrixType1::index_type IndexType;
+    typedef typename MatrixType1::value_type ValueType;
+    typedef cusp::array1d<IndexType, cusp::host_memory> SplittingArray;
+    typedef cusp::array1d<ValueType, cusp::host_memory> DiagonalArray;
+
+    SplittingArray splitting_(splitting);
+    DiagonalArray diagonal;
+    detail::interpolation_diagonal(A, diagonal);
+
+    detail::extended_i_interpolation_row<MatrixType1, MatrixType2, SplittingArray, DiagonalArray> row(A, S, splitting_, diagonal);
+    detail::assemble_interpolation(splitting_, row, P, truncation_factor, max_elements);
+}
+
+} // end namespace classical
+} // end namespace precond
+} // end namespace cusp
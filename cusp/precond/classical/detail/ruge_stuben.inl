@@ -0,0 +1,153 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <cusp/array1d.h>
+#include <cusp/transpose.h>
+
+#include <cusp/precond/aggregation/galerkin_product.h>
+#include <cusp/precond/classical/strength.h>
+#include <cusp/precond/classical/cf_splitting.h>
+#include <cusp/precond/classical/interpolate.h>
+
+namespace cusp
+{
+namespace precond
+{
+namespace classical
+{
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename SmootherType, typename SolverType, typename Format>
+template <typename MatrixType>
+ruge_stuben<IndexType,ValueType,MemorySpace,SmootherType,SolverType,Format>
+::ruge_stuben(const MatrixType& A, const double theta,
+              const CoarseningType coarsening, const InterpolationType interpolation)
+    : ML(), theta(theta), coarsening(coarsening), interpolation(interpolation),
+      truncation_factor(0.2), max_interpolation_elements(4)
+{
+    initialize(A);
+}
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename SmootherType, typename SolverType, typename Format>
+template <typename MemorySpace2, typename SmootherType2, typename SolverType2, typename Format2>
+ruge_stuben<IndexType,ValueType,MemorySpace,SmootherType,SolverType,Format>
+::ruge_stuben(const ruge_stuben<IndexType,ValueType,MemorySpace2,SmootherType2,SolverType2,Format2>& M)
+    : ML(M), theta(M.theta), coarsening(M.coarsening), interpolation(M.interpolation),
+      truncation_factor(M.truncation_factor), max_interpolation_elements(M.max_interpolation_elements)
+{
+    for( size_t lvl = 0; lvl < M.rs_levels.size(); lvl++ )
+        rs_levels.push_back(M.rs_levels[lvl]);
+}
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename SmootherType, typename SolverType, typename Format>
+template <typename MatrixType>
+void ruge_stuben<IndexType,ValueType,MemorySpace,SmootherType,SolverType,Format>
+::initialize(const MatrixType& A)
+{
+    typedef typename ML::level Level;
+
+    if(rs_levels.size() > 0)
+    {
+        rs_levels.resize(0);
+        ML::levels.resize(0);
+    }
+
+    ML::resize(A.num_rows, A.num_cols, A.num_entries);
+    ML::levels.reserve(ML::max_levels); // avoid reallocations which force matrix copies
+    ML::levels.push_back(Level());
+
+    rs_levels.push_back(rs_level<SetupMatrixType>());
+
+    // Setup the first level using a host copy of A
+    if(A.num_rows > ML::min_level_size)
+    {
+        SetupMatrixType A_(A);
+        extend_hierarchy(A_);
+    }
+
+    // Iteratively setup lower levels until stopping criteria are reached
+    while ((rs_levels.size() > 1) &&
+           (rs_levels.back().A_.num_rows > ML::min_level_size) &&
+           (rs_levels.size() < ML::max_levels))
+        if (!extend_hierarchy(rs_levels.back().A_))
+            break;
+
+    // Setup multilevel arrays and matrices on each level
+    ML::setup_level(0, A, rs_levels[0]);
+
+    for( size_t lvl = 1; lvl < rs_levels.size(); lvl++ )
+        ML::setup_level(lvl, rs_levels[lvl].A_, rs_levels[lvl]);
+
+    // A hierarchy with a single level solves A directly
+    if(ML::levels.size() == 1)
+        ML::levels[0].A = A;
+
+    // Initialize coarse solver
+    ML::initialize_coarse_solver();
+}
+
+template <typename IndexType, typename ValueType, typename MemorySpace, typename SmootherType, typename SolverType, typename Format>
+bool ruge_stuben<IndexType,ValueType,MemorySpace,SmootherType,SolverType,Format>
+::extend_hierarchy(const SetupMatrixType& A)
+{
+    typedef typename ML::level Level;
+
+    SetupMatrixType P;
+
+    {
+        // compute strength of connection matrix
+        SetupMatrixType S;
+        classical_strength_of_connection(A, S, theta);
+
+        // select the coarse grid
+        if (coarsening == PMIS)
+            pmis_splitting(S, rs_levels.back().splitting);
+        else
+            hmis_splitting(S, rs_levels.back().splitting);
+
+        // compute prolongation operator
+        if (interpolation == Direct)
+            direct_interpolation(A, S, rs_levels.back().splitting, P, truncation_factor, max_interpolation_elements);
+        else
+            extended_i_interpolation(A, S, rs_levels.back().splitting, P, truncation_factor, max_interpolation_elements);
+    }
+
+    // stop when the coarsening stagnates
+    if (P.num_cols == 0 || P.num_cols == A.num_rows)
+        return false;
+
+    // compute restriction operator (transpose of prolongator)
+    SetupMatrixType R;
+    cusp::transpose(P, R);
+
+    // construct Galerkin product R*A*P
+    SetupMatrixType RAP;
+    cusp::precond::aggregation::galerkin_product(R, A, P, RAP);
+
+    // Setup components for next level in hierarchy
+    rs_levels.push_back(rs_level<SetupMatrixType>());
+    rs_levels.back().A_.swap(RAP);
+
+    ML::copy_or_swap_matrix(ML::levels.back().R, R);
+    ML::copy_or_swap_matrix(ML::levels.back().P, P);
+    ML::levels.push_back(Level());
+
+    return true;
+}
+
+} // end namespace classical
+} // end namespace precond
+} // end namespace cusp
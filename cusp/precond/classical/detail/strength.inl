@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+
+#include <thrust/scan.h>
+
+#include <algorithm>
+
+namespace cusp
+{
+namespace precond
+{
+namespace classical
+{
+
+template <typename MatrixType1, typename MatrixType2>
+void classical_strength_of_connection(const MatrixType1& A, MatrixType2& S, const double theta)
+{
+    typedef typename MatrixType1::index_type IndexType;
+    typedef typename MatrixType1::value_type ValueType;
+
+    const IndexType N = A.num_rows;
+
+    // -sign(A[i,i]) and the strength threshold of every row
+    cusp::array1d<ValueType, cusp::host_memory> scale(N);
+    cusp::array1d<ValueType, cusp::host_memory> threshold(N);
+    cusp::array1d<IndexType, cusp::host_memory> row_offsets(N + 1, 0);
+
+    #pragma omp parallel for
+    for (IndexType i = 0; i < N; i++)
+    {
+        ValueType diagonal = 0;
+
+        for (IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            if (A.column_indices[jj] == i)
+                diagonal += A.values[jj];
+
+        const ValueType s = diagonal < ValueType(0) ? ValueType(1) : ValueType(-1);
+
+        ValueType max_coupling = 0;
+
+        for (IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            if (A.column_indices[jj] != i)
+                max_coupling = std::max(max_coupling, s * A.values[jj]);
+
+        scale[i]     = s;
+        threshold[i] = ValueType(theta) * max_coupling;
+
+        IndexType count = 0;
+
+        for (IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+        {
+            const ValueType coupling = s * A.values[jj];
+
+            if (A.column_indices[jj] != i && coupling > ValueType(0) && coupling >= threshold[i])
+                count++;
+        }
+
+        row_offsets[i] = count;
+    }
+
+    thrust::exclusive_scan(row_offsets.begin(), row_offsets.end(), row_offsets.begin());
+
+    S.resize(N, A.num_cols, row_offsets[N]);
+    S.row_offsets = row_offsets;
+
+    #pragma omp parallel for
+    for (IndexType i = 0; i < N; i++)
+    {
+        IndexType nn = row_offsets[i];
+
+        for (IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+        {
+            const ValueType coupling = scale[i] * A.values[jj];
+
+            if (A.column_indices[jj] != i && coupling > ValueType(0) && coupling >= threshold[i])
+            {
+                S.column_indices[nn] = A.column_indices[jj];
+                S.values[nn]         = ValueType(1);
+                nn++;
+            }
+        }
+    }
+}
+
+} // end namespace classical
+} // end namespace precond
+} // end namespace cusp
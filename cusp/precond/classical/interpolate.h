@@ -0,0 +1,93 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file interpolate.h
+ *  \brief Interpolation operators for classical AMG
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+namespace precond
+{
+namespace classical
+{
+
+/*  Compute the direct interpolation operator P from the matrix A, its
+ *  strength matrix S and a coarse/fine splitting (1 for C points, 0 for
+ *  F points). The rows of C points inject the coarse value. An F point i
+ *  interpolates from the C points it depends on strongly with::
+ *
+ *     P[i,j] = -alpha_i * A[i,j] / A[i,i]
+ *
+ *  where alpha_i scales the weights so that all couplings of row i are
+ *  accounted for. Couplings of the same and of the opposite sign as the
+ *  diagonal are scaled separately.
+ *
+ *  Weights smaller than truncation_factor times the largest weight of a
+ *  row are dropped and at most max_elements weights are kept per row (all
+ *  when zero). The remaining weights are rescaled to the original row sum.
+ *
+ *  Note: A, S and P are real valued CSR matrices in host memory.
+ */
+template <typename MatrixType1,
+          typename MatrixType2,
+          typename ArrayType,
+          typename MatrixType3>
+void direct_interpolation(const MatrixType1& A,
+                          const MatrixType2& S,
+                          const ArrayType& splitting,
+                                MatrixType3& P,
+                          const double truncation_factor = 0.0,
+                          const size_t max_elements = 0);
+
+/*  Compute the extended+i interpolation operator P from the matrix A, its
+ *  strength matrix S and a coarse/fine splitting (1 for C points, 0 for
+ *  F points). An F point i interpolates from the C points it depends on
+ *  strongly and from the C points its strong F neighbors depend on
+ *  strongly. The coupling of i to a strong F neighbor k is distributed
+ *  over these C points and i itself in proportion to the couplings of
+ *  row k whose sign is opposite to A[k,k]. The remaining couplings are
+ *  added to the diagonal.
+ *
+ *  This is the interpolation of De Sterck, Falgout, Nolting and Yang,
+ *  which keeps the convergence of PMIS and HMIS coarsenings independent
+ *  of the problem size. Truncation is applied as in direct_interpolation.
+ *
+ *  Note: A, S and P are real valued CSR matrices in host memory.
+ */
+template <typename MatrixType1,
+          typename MatrixType2,
+          typename ArrayType,
+          typename MatrixType3>
+void extended_i_interpolation(const MatrixType1& A,
+                              const MatrixType2& S,
+                              const ArrayType& splitting,
+                                    MatrixType3& P,
+                              const double truncation_factor = 0.0,
+                              const size_t max_elements = 0);
+
+} // end namespace classical
+} // end namespace precond
+} // end namespace cusp
+
+#include <cusp/precond/classical/detail/interpolate.inl>
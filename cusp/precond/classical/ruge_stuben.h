@@ -0,0 +1,255 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file ruge_stuben.h
+ *  \brief Classical (Ruge-Stuben) algebraic multigrid preconditioner.
+ *
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/multilevel.h>
+
+#include <cusp/array1d.h>
+#include <cusp/complex.h>
+#include <cusp/csr_matrix.h>
+
+#include <thrust/detail/use_default.h>
+
+#include <vector>
+
+namespace cusp
+{
+namespace precond
+{
+namespace classical
+{
+
+typedef enum
+{
+    PMIS,
+    HMIS,
+} CoarseningType;
+
+typedef enum
+{
+    Direct,
+    ExtendedI,
+} InterpolationType;
+
+/* \cond */
+template<typename MatrixType>
+struct rs_level
+{
+    public:
+
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+    typedef typename MatrixType::memory_space MemorySpace;
+    typedef typename cusp::norm_type<ValueType>::type NormType;
+
+    MatrixType A_;                                        // matrix
+    cusp::array1d<IndexType,MemorySpace> splitting;       // C/F splitting
+
+    size_t   num_iters;
+    NormType rho_DinvA;
+
+    rs_level(void) : num_iters(1), rho_DinvA(0) {}
+
+    template<typename RSLevelType>
+    rs_level(const RSLevelType& L)
+      : A_(L.A_),
+        splitting(L.splitting),
+        num_iters(L.num_iters),
+        rho_DinvA(L.rho_DinvA)
+    {}
+};
+/* \endcond */
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup preconditioners Preconditioners
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/**
+ *  \brief Classical algebraic multigrid preconditioner
+ *
+ *  \tparam IndexType Type used for matrix values (e.g. \c int or \c size_t).
+ *  \tparam ValueType Type used for matrix values (e.g. \c float or \c double).
+ *  \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ *  \par Overview
+ *  Given a matrix \c A to precondition, the \p ruge_stuben preconditioner
+ *  constructs a classical algebraic multigrid (AMG) hierarchy. A subset of
+ *  the unknowns is selected as the coarse grid and the remaining unknowns
+ *  are interpolated from their strongly connected coarse neighbors.
+ *
+ *  Classical AMG is usually the method of choice for scalar elliptic
+ *  problems, including anisotropic and discontinuous coefficients, where
+ *  smoothed aggregation needs a good near nullspace. The default
+ *  configuration uses the classical strength measure with threshold 0.25,
+ *  HMIS coarsening, extended+i interpolation truncated to 4 weights per
+ *  row, Jacobi relaxation on each level and LU to solve the coarse matrix
+ *  in host memory. PMIS coarsening and direct interpolation are available
+ *  as cheaper alternatives.
+ *
+ *  The hierarchy is set up in host memory with OpenMP and the levels are
+ *  copied to \p MemorySpace. The smoother, coarse solver and cycle are
+ *  shared with \p smoothed_aggregation.
+ *
+ *  \note \p A must be real valued and is usually an M-matrix or close to
+ *  one.
+ *
+ *  \par Example
+ *  The following code snippet demonstrates how to use a
+ *  \p ruge_stuben preconditioner to solve a linear system.
+ *
+ *  \code
+ *  #include <cusp/csr_matrix.h>
+ *  #include <cusp/gallery/poisson.h>
+ *  #include <cusp/krylov/cg.h>
+ *  #include <cusp/precond/classical/ruge_stuben.h>
+ *
+ *  #include <iostream>
+ *
+ *  int main(int argc, char *argv[])
+ *  {
+ *      typedef int                 IndexType;
+ *      typedef double              ValueType;
+ *      typedef cusp::device_memory MemorySpace;
+ *
+ *      // create an empty sparse matrix structure
+ *      cusp::hyb_matrix<IndexType, ValueType, MemorySpace> A;
+ *
+ *      // construct 2d poisson matrix
+ *      IndexType N = 256;
+ *      cusp::gallery::poisson5pt(A, N, N);
+ *
+ *      // HMIS coarsening and extended+i interpolation
+ *      cusp::precond::classical::ruge_stuben<IndexType, ValueType, MemorySpace> M(A);
+ *
+ *      // print AMG statistics
+ *      M.print();
+ *
+ *      // allocate storage for solution (x) and right hand side (b)
+ *      cusp::array1d<ValueType, MemorySpace> x(A.num_rows, 0);
+ *      cusp::array1d<ValueType, MemorySpace> b(A.num_rows, 1);
+ *
+ *      // set stopping criteria (iteration_limit = 1000, relative_tolerance = 1e-10)
+ *      cusp::monitor<ValueType> monitor(b, 1000, 1e-10);
+ *
+ *      // solve
+ *      cusp::krylov::cg(A, x, b, monitor, M);
+ *
+ *      // report status
+ *      monitor.print();
+ *
+ *      return 0;
+ *  }
+ *  \endcode
+ */
+template <typename IndexType,
+          typename ValueType,
+          typename MemorySpace,
+          typename SmootherType = thrust::use_default,
+          typename SolverType   = thrust::use_default,
+          typename Format       = thrust::use_default>
+class ruge_stuben :
+    public cusp::multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>::container
+{
+  private:
+
+    typedef cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> SetupMatrixType;
+    typedef typename cusp::multilevel<IndexType,ValueType,MemorySpace,Format,SmootherType,SolverType>::container ML;
+
+  public:
+
+    /* \cond */
+    std::vector< rs_level<SetupMatrixType> > rs_levels;
+    /* \endcond */
+
+    /*! threshold of the classical strength of connection measure */
+    double theta;
+
+    /*! coarsening algorithm, \p PMIS or \p HMIS */
+    CoarseningType coarsening;
+
+    /*! interpolation operator, \p Direct or \p ExtendedI */
+    InterpolationType interpolation;
+
+    /*! interpolation weights below this fraction of the largest weight of a row are dropped */
+    double truncation_factor;
+
+    /*! maximum number of interpolation weights per row, zero for no limit */
+    size_t max_interpolation_elements;
+
+    /**
+     * Construct an empty \p ruge_stuben preconditioner.
+     */
+    ruge_stuben(void)
+      : ML(), theta(0.25), coarsening(HMIS), interpolation(ExtendedI),
+        truncation_factor(0.2), max_interpolation_elements(4) {};
+
+    /*! Construct a \p ruge_stuben preconditioner from a matrix.
+     *
+     *  \param A matrix used to create the AMG hierarchy.
+     *  \param theta threshold of the strength of connection measure.
+     *  \param coarsening coarsening algorithm.
+     *  \param interpolation interpolation operator.
+     */
+    template <typename MatrixType>
+    ruge_stuben(const MatrixType& A,
+                const double theta = 0.25,
+                const CoarseningType coarsening = HMIS,
+                const InterpolationType interpolation = ExtendedI);
+
+    /*! Construct a \p ruge_stuben preconditioner from an existing
+     * \p ruge_stuben preconditioner.
+     *
+     *  \param M other ruge_stuben preconditioner.
+     */
+    template <typename MemorySpace2,
+              typename SmootherType2,
+              typename SolverType2,
+              typename Format2>
+    ruge_stuben(const ruge_stuben<IndexType,ValueType,MemorySpace2,SmootherType2,SolverType2,Format2>& M);
+
+    /*! Initialize a \p ruge_stuben preconditioner from a matrix with the
+     * current options. Used to initialize a \p ruge_stuben preconditioner
+     * constructed with no input matrix specified.
+     *
+     *  \param A matrix used to create the AMG hierarchy.
+     */
+    template <typename MatrixType>
+    void initialize(const MatrixType& A);
+
+protected:
+
+    /* \cond */
+    bool extend_hierarchy(const SetupMatrixType& A);
+    /* \endcond */
+};
+/*! \}
+ */
+
+} // end namespace classical
+} // end namespace precond
+} // end namespace cusp
+
+#include <cusp/precond/classical/detail/ruge_stuben.inl>
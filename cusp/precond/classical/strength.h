@@ -0,0 +1,54 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file strength.h
+ *  \brief Classical strength of connection measure
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+namespace cusp
+{
+namespace precond
+{
+namespace classical
+{
+
+/*  Compute the classical (Ruge-Stuben) strength of connection matrix.
+ *  Row i depends strongly on column j != i iff::
+ *
+ *     -sign(A[i,i]) * A[i,j] >= theta * max_{k != i} -sign(A[i,i]) * A[i,k]
+ *
+ *  and the coupling has the opposite sign of the diagonal. Rows without
+ *  such couplings have no strong connections. The diagonal is not stored
+ *  in S and all entries of S are one.
+ *
+ *  Note: A and S are real valued CSR matrices in host memory.
+ */
+template <typename MatrixType1,
+          typename MatrixType2>
+void classical_strength_of_connection(const MatrixType1& A,
+                                            MatrixType2& S,
+                                      const double theta = 0.25);
+
+} // end namespace classical
+} // end namespace precond
+} // end namespace cusp
+
+#include <cusp/precond/classical/detail/strength.inl>
@@ -0,0 +1,420 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file additive_schwarz.inl
+ *  \brief Inline file for additive_schwarz.h
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/complex.h>
+#include <cusp/copy.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/exception.h>
+
+#include <thrust/fill.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace precond
+{
+namespace detail
+{
+
+// in-place LU factorization with partial pivoting of a dense row-major
+// matrix, returns false if the matrix is singular
+template <typename ValueType>
+bool dense_lu_factor(ValueType* a, int* pivots, const int n)
+{
+    for (int k = 0; k < n; k++)
+    {
+        int pivot = k;
+
+        for (int r = k + 1; r < n; r++)
+            if (cusp::abs(a[r * n + k]) > cusp::abs(a[pivot * n + k]))
+                pivot = r;
+
+        pivots[k] = pivot;
+
+        if (a[pivot * n + k] == ValueType(0))
+            return false;
+
+        if (pivot != k)
+            for (int c = 0; c < n; c++)
+                std::swap(a[k * n + c], a[pivot * n + c]);
+
+        for (int r = k + 1; r < n; r++)
+        {
+            const ValueType multiplier = a[r * n + k] / a[k * n + k];
+            a[r * n + k] = multiplier;
+
+            if (multiplier == ValueType(0))
+                continue;
+
+            for (int c = k + 1; c < n; c++)
+                a[r * n + c] -= multiplier * a[k * n + c];
+        }
+    }
+
+    return true;
+}
+
+template <typename ValueType>
+void dense_lu_solve(const ValueType* a, const int* pivots, const int n, ValueType* x)
+{
+    for (int k = 0; k < n; k++)
+        std::swap(x[k], x[pivots[k]]);
+
+    for (int r = 1; r < n; r++)
+        for (int c = 0; c < r; c++)
+            x[r] -= a[r * n + c] * x[c];
+
+    for (int r = n - 1; r >= 0; r--)
+    {
+        for (int c = r + 1; c < n; c++)
+            x[r] -= a[r * n + c] * x[c];
+
+        x[r] /= a[r * n + r];
+    }
+}
+
+template <typename ValueType>
+template <typename MatrixType>
+void schwarz_subdomain<ValueType>
+::initialize(const MatrixType& A, size_t max_dense_size)
+{
+    const int n = A.num_rows;
+
+    x.resize(n);
+    y.resize(n);
+
+    dense = size_t(n) <= max_dense_size;
+
+    if (dense)
+    {
+        lu.resize(n * n);
+        pivots.resize(n);
+
+        thrust::fill(lu.begin(), lu.end(), ValueType(0));
+
+        for (int i = 0; i < n; i++)
+            for (int jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+                lu[i * n + A.column_indices[jj]] += A.values[jj];
+
+        if (n > 0 && !dense_lu_factor(&lu[0], &pivots[0], n))
+            throw cusp::runtime_exception("singular local matrix in additive Schwarz setup");
+    }
+    else
+    {
+        MatrixType LU(A);
+
+        ilu0_factor(LU);
+
+        L.initialize(LU, true,  true);
+        U.initialize(LU, false, false);
+    }
+}
+
+template <typename ValueType>
+void schwarz_subdomain<ValueType>
+::solve(void)
+{
+    if (dense)
+    {
+        y = x;
+
+        if (y.size() > 0)
+            dense_lu_solve(&lu[0], &pivots[0], y.size(), &y[0]);
+    }
+    else
+    {
+        L.solve(x, y);
+        U.solve(y, y);
+    }
+}
+
+// Collects the rows of subdomain s and the rows within overlap edges of
+// them, and extracts the local matrix.  The local rows keep their global
+// order so the local matrix inherits sorted rows and its main diagonal.
+template <typename MatrixType, typename ValueType>
+void extract_subdomain(const MatrixType& A,
+                       const cusp::array1d<int, cusp::host_memory>& parts,
+                       const int* part_rows, const int num_part_rows,
+                       const int s, const size_t overlap,
+                       cusp::array1d<int, cusp::host_memory>& local_index,
+                       schwarz_subdomain<ValueType>& subdomain,
+                       cusp::csr_matrix<int, ValueType, cusp::host_memory>& local_A)
+{
+    std::vector<int> rows(part_rows, part_rows + num_part_rows);
+
+    for (size_t r = 0; r < rows.size(); r++)
+        local_index[rows[r]] = 0;
+
+    size_t frontier_begin = 0;
+
+    for (size_t level = 0; level < overlap; level++)
+    {
+        const size_t frontier_end = rows.size();
+
+        for (size_t r = frontier_begin; r < frontier_end; r++)
+        {
+            const int i = rows[r];
+
+            for (int jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            {
+                const int j = A.column_indices[jj];
+
+                if (local_index[j] < 0)
+                {
+                    local_index[j] = 0;
+                    rows.push_back(j);
+                }
+            }
+        }
+
+        if (frontier_end == rows.size())
+            break;
+
+        frontier_begin = frontier_end;
+    }
+
+    std::sort(rows.begin(), rows.end());
+
+    const int n = rows.size();
+    int num_entries = 0;
+
+    for (int r = 0; r < n; r++)
+        local_index[rows[r]] = r;
+
+    for (int r = 0; r < n; r++)
+        for (int jj = A.row_offsets[rows[r]]; jj < A.row_offsets[rows[r] + 1]; jj++)
+            if (local_index[A.column_indices[jj]] >= 0)
+                num_entries++;
+
+    local_A.resize(n, n, num_entries);
+    local_A.row_offsets[0] = 0;
+    num_entries = 0;
+
+    subdomain.rows.resize(n);
+    subdomain.owned.resize(num_part_rows);
+
+    int num_owned = 0;
+
+    for (int r = 0; r < n; r++)
+    {
+        const int i = rows[r];
+
+        for (int jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+        {
+            const int j = local_index[A.column_indices[jj]];
+
+            if (j >= 0)
+            {
+                local_A.column_indices[num_entries] = j;
+                local_A.values[num_entries] = A.values[jj];
+                num_entries++;
+            }
+        }
+
+        local_A.row_offsets[r + 1] = num_entries;
+
+        subdomain.rows[r] = i;
+
+        if (parts[i] == s)
+            subdomain.owned[num_owned++] = r;
+    }
+
+    for (int r = 0; r < n; r++)
+        local_index[rows[r]] = -1;
+}
+
+} // end namespace detail
+
+
+// constructors
+template <typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+additive_schwarz<ValueType,MemorySpace>
+::additive_schwarz(const MatrixType& A, size_t num_subdomains, size_t overlap, size_t max_dense_size)
+    : Parent(A.num_rows, A.num_cols, 0)
+{
+    if (num_subdomains == 0)
+        throw cusp::invalid_input_exception("number of subdomains must be positive");
+
+    const size_t N = A.num_rows;
+
+    // balanced contiguous ranges of rows
+    cusp::array1d<int, cusp::host_memory> parts(N);
+
+    for (size_t i = 0; i < N; i++)
+        parts[i] = (i * num_subdomains) / N;
+
+    initialize(A, parts, num_subdomains, overlap, max_dense_size);
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename MatrixType, typename IndexType, typename MemorySpace2>
+additive_schwarz<ValueType,MemorySpace>
+::additive_schwarz(const MatrixType& A, const cusp::array1d<IndexType,MemorySpace2>& parts,
+                   size_t overlap, size_t max_dense_size)
+    : Parent(A.num_rows, A.num_cols, 0)
+{
+    cusp::array1d<int, cusp::host_memory> parts_host(parts);
+
+    if (parts_host.size() != A.num_rows)
+        throw cusp::invalid_input_exception("partition must assign a subdomain to every row");
+
+    int num_parts = 0;
+
+    for (size_t i = 0; i < parts_host.size(); i++)
+    {
+        if (parts_host[i] < 0)
+            throw cusp::invalid_input_exception("subdomain indices must be nonnegative");
+
+        num_parts = std::max(num_parts, parts_host[i] + 1);
+    }
+
+    initialize(A, parts_host, num_parts, overlap, max_dense_size);
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+void additive_schwarz<ValueType,MemorySpace>
+::initialize(const MatrixType& A, const cusp::array1d<int, cusp::host_memory>& parts,
+             size_t num_parts, size_t overlap, size_t max_dense_size)
+{
+    typedef cusp::csr_matrix<int, ValueType, cusp::host_memory> HostMatrix;
+
+    HostMatrix A_host;
+    detail::sorted_host_csr(A, A_host);
+
+    cusp::array1d<int, cusp::host_memory> diagonal_positions;
+    detail::find_diagonal_positions(A_host, diagonal_positions);
+
+    const int N = A_host.num_rows;
+
+    // counting sort of the rows by subdomain
+    cusp::array1d<int, cusp::host_memory> part_offsets(num_parts + 1, 0);
+    cusp::array1d<int, cusp::host_memory> part_rows(N);
+
+    for (int i = 0; i < N; i++)
+        part_offsets[parts[i] + 1]++;
+
+    for (size_t s = 0; s < num_parts; s++)
+        part_offsets[s + 1] += part_offsets[s];
+
+    {
+        cusp::array1d<int, cusp::host_memory> next(part_offsets.begin(), part_offsets.end() - 1);
+
+        for (int i = 0; i < N; i++)
+            part_rows[next[parts[i]]++] = i;
+    }
+
+    subdomains.resize(num_parts);
+
+    size_t num_failed = 0;
+    size_t num_local_entries = 0;
+
+    #pragma omp parallel reduction(+ : num_failed, num_local_entries)
+    {
+        cusp::array1d<int, cusp::host_memory> local_index(N, -1);
+        HostMatrix local_A;
+
+        #pragma omp for schedule(dynamic, 1)
+        for (int s = 0; s < int(num_parts); s++)
+        {
+            const int start = part_offsets[s];
+            const int count = part_offsets[s + 1] - start;
+
+            detail::extract_subdomain(A_host, parts, count ? &part_rows[start] : NULL, count,
+                                      s, overlap, local_index, subdomains[s], local_A);
+
+            num_local_entries += local_A.num_entries;
+
+            try
+            {
+                subdomains[s].initialize(local_A, max_dense_size);
+            }
+            catch (const cusp::runtime_exception&)
+            {
+                num_failed++;
+            }
+        }
+    }
+
+    if (num_failed > 0)
+        throw cusp::runtime_exception("local factorization failed in additive Schwarz setup");
+
+    Parent::num_entries = num_local_entries;
+}
+
+// linear operator
+template <typename ValueType, typename MemorySpace>
+template <typename VectorType1, typename VectorType2>
+void additive_schwarz<ValueType,MemorySpace>
+::operator()(const VectorType1& x, VectorType2& y)
+{
+    apply(x, y, typename VectorType2::memory_space());
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename VectorType1, typename VectorType2>
+void additive_schwarz<ValueType,MemorySpace>
+::apply(const VectorType1& x, VectorType2& y, cusp::host_memory)
+{
+    const int num_parts = subdomains.size();
+
+    // the owned rows partition the rows, so every row of y is written once
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int s = 0; s < num_parts; s++)
+    {
+        detail::schwarz_subdomain<ValueType>& subdomain = subdomains[s];
+
+        const int n = subdomain.rows.size();
+
+        if (n == 0)
+            continue;
+
+        for (int r = 0; r < n; r++)
+            subdomain.x[r] = x[subdomain.rows[r]];
+
+        subdomain.solve();
+
+        for (size_t o = 0; o < subdomain.owned.size(); o++)
+        {
+            const int r = subdomain.owned[o];
+            y[subdomain.rows[r]] = subdomain.y[r];
+        }
+    }
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename VectorType1, typename VectorType2, typename System>
+void additive_schwarz<ValueType,MemorySpace>
+::apply(const VectorType1& x, VectorType2& y, System)
+{
+    cusp::copy(x, x_host);
+    y_host.resize(x_host.size());
+    apply(x_host, y_host, cusp::host_memory());
+    cusp::copy(y_host, y);
+}
+
+} // end namespace precond
+} // end namespace cusp
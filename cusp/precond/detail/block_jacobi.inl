@@ -0,0 +1,487 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file block_jacobi.inl
+ *  \brief Inline file for block_jacobi.h
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/complex.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/exception.h>
+
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace precond
+{
+namespace detail
+{
+
+// y = D^-1 x for diagonal blocks of BlockSize rows
+template <int BlockSize, typename ValueType>
+struct uniform_block_multiply
+{
+    const ValueType* inverses;
+    const ValueType* x;
+    ValueType*       y;
+
+    uniform_block_multiply(const ValueType* inverses, const ValueType* x, ValueType* y)
+        : inverses(inverses), x(x), y(y) {}
+
+    __host__ __device__
+    void operator()(const int block) const
+    {
+        const ValueType* inverse = inverses + block * BlockSize * BlockSize;
+
+        ValueType xb[BlockSize];
+
+        for (int c = 0; c < BlockSize; c++)
+            xb[c] = x[block * BlockSize + c];
+
+        for (int r = 0; r < BlockSize; r++)
+        {
+            ValueType sum = 0;
+
+            for (int c = 0; c < BlockSize; c++)
+                sum += inverse[r * BlockSize + c] * xb[c];
+
+            y[block * BlockSize + r] = sum;
+        }
+    }
+};
+
+// y = D^-1 x for diagonal blocks of any size
+template <typename ValueType>
+struct variable_block_multiply
+{
+    const int*       block_offsets;
+    const int*       value_offsets;
+    const ValueType* inverses;
+    const ValueType* x;
+    ValueType*       y;
+
+    variable_block_multiply(const int* block_offsets, const int* value_offsets,
+                            const ValueType* inverses, const ValueType* x, ValueType* y)
+        : block_offsets(block_offsets), value_offsets(value_offsets), inverses(inverses), x(x), y(y) {}
+
+    __host__ __device__
+    void operator()(const int block) const
+    {
+        const int start = block_offsets[block];
+        const int n     = block_offsets[block + 1] - start;
+
+        const ValueType* inverse = inverses + value_offsets[block];
+
+        for (int r = 0; r < n; r++)
+        {
+            ValueType sum = 0;
+
+            for (int c = 0; c < n; c++)
+                sum += inverse[r * n + c] * x[start + c];
+
+            y[start + r] = sum;
+        }
+    }
+};
+
+template <typename Functor>
+void for_each_block(const int num_blocks, const Functor& f, cusp::host_memory)
+{
+    #pragma omp parallel for
+    for (int block = 0; block < num_blocks; block++)
+        f(block);
+}
+
+template <typename Functor, typename System>
+void for_each_block(const int num_blocks, const Functor& f, System)
+{
+    System system;
+
+    thrust::for_each(system,
+                     thrust::counting_iterator<int>(0),
+                     thrust::counting_iterator<int>(num_blocks),
+                     f);
+}
+
+template <typename ArrayType>
+typename ArrayType::value_type * raw(ArrayType& x)
+{
+    return x.size() == 0 ? NULL : thrust::raw_pointer_cast(&x[0]);
+}
+
+template <typename ArrayType>
+const typename ArrayType::value_type * raw(const ArrayType& x)
+{
+    return x.size() == 0 ? NULL : thrust::raw_pointer_cast(&x[0]);
+}
+
+// Invert the row-major n x n matrix a in place by Gauss-Jordan elimination
+// with partial pivoting. Returns false if a is singular.
+template <typename ValueType>
+bool invert_block(ValueType* a, const int n, std::vector<ValueType>& work)
+{
+    const int m = 2 * n;
+
+    // augmented matrix [a | I]
+    work.assign(n * m, ValueType(0));
+
+    for (int r = 0; r < n; r++)
+    {
+        for (int c = 0; c < n; c++)
+            work[r * m + c] = a[r * n + c];
+
+        work[r * m + n + r] = ValueType(1);
+    }
+
+    for (int k = 0; k < n; k++)
+    {
+        int pivot = k;
+
+        for (int r = k + 1; r < n; r++)
+            if (cusp::abs(work[r * m + k]) > cusp::abs(work[pivot * m + k]))
+                pivot = r;
+
+        if (work[pivot * m + k] == ValueType(0))
+            return false;
+
+        if (pivot != k)
+            std::swap_ranges(work.begin() + k * m, work.begin() + (k + 1) * m, work.begin() + pivot * m);
+
+        const ValueType p = ValueType(1) / work[k * m + k];
+
+        for (int j = 0; j < m; j++)
+            work[k * m + j] *= p;
+
+        for (int r = 0; r < n; r++)
+        {
+            const ValueType f = work[r * m + k];
+
+            if (r == k || f == ValueType(0))
+                continue;
+
+            for (int j = 0; j < m; j++)
+                work[r * m + j] -= f * work[k * m + j];
+        }
+    }
+
+    for (int r = 0; r < n; r++)
+        for (int c = 0; c < n; c++)
+            a[r * n + c] = work[r * m + n + c];
+
+    return true;
+}
+
+// Invert num_blocks consecutive row-major blocks of BlockSize rows in
+// place. Batches of blocks are interleaved, entry e of the l-th block of a
+// batch is stored at a[e * W + l], so that every step of the elimination
+// is a loop over the blocks of the batch. The elimination does not pivot;
+// blocks with a pivot much smaller than their largest entry are inverted
+// again with partial pivoting. Returns the number of singular blocks.
+template <int BlockSize, typename ValueType>
+size_t invert_uniform_blocks(ValueType* values, const int num_blocks)
+{
+    typedef typename cusp::norm_type<ValueType>::type NormType;
+
+    const int W = 8;
+    const int S = BlockSize * BlockSize;
+    const int num_batches = (num_blocks + W - 1) / W;
+    const NormType threshold = NormType(1e-2);
+
+    size_t num_singular = 0;
+
+    #pragma omp parallel
+    {
+        ValueType a[S * W];
+        ValueType p[W];
+        ValueType f[W];
+        NormType  scale[W];
+        bool      pivoting[W];
+
+        std::vector<ValueType> work;
+
+        #pragma omp for reduction(+ : num_singular)
+        for (int batch = 0; batch < num_batches; batch++)
+        {
+            const int first = batch * W;
+            const int count = std::min(W, num_blocks - first);
+
+            // pad the last batch with identity blocks
+            for (int l = 0; l < W; l++)
+            {
+                scale[l] = 0;
+                pivoting[l] = false;
+
+                for (int e = 0; e < S; e++)
+                {
+                    a[e * W + l] = l < count ? values[(first + l) * S + e] : ValueType(e % (BlockSize + 1) == 0 ? 1 : 0);
+                    scale[l] = std::max(scale[l], NormType(cusp::abs(a[e * W + l])));
+                }
+            }
+
+            for (int k = 0; k < BlockSize; k++)
+            {
+                ValueType* ak = a + k * BlockSize * W;
+
+                for (int l = 0; l < W; l++)
+                {
+                    const ValueType pivot = ak[k * W + l];
+
+                    if (cusp::abs(pivot) <= threshold * scale[l])
+                    {
+                        pivoting[l] = true;
+                        p[l] = ValueType(0);
+                    }
+                    else
+                    {
+                        p[l] = ValueType(1) / pivot;
+                    }
+
+                    ak[k * W + l] = ValueType(1);
+                }
+
+                for (int j = 0; j < BlockSize; j++)
+                    for (int l = 0; l < W; l++)
+                        ak[j * W + l] *= p[l];
+
+                for (int i = 0; i < BlockSize; i++)
+                {
+                    if (i == k)
+                        continue;
+
+                    ValueType* ai = a + i * BlockSize * W;
+
+                    for (int l = 0; l < W; l++)
+                    {
+                        f[l] = ai[k * W + l];
+                        ai[k * W + l] = ValueType(0);
+                    }
+
+                    for (int j = 0; j < BlockSize; j++)
+                        for (int l = 0; l < W; l++)
+                            ai[j * W + l] -= f[l] * ak[j * W + l];
+                }
+            }
+
+            for (int l = 0; l < count; l++)
+            {
+                ValueType* block = values + (first + l) * S;
+
+                if (pivoting[l])
+                {
+                    if (!invert_block(block, BlockSize, work))
+                        num_singular++;
+                }
+                else
+                {
+                    for (int e = 0; e < S; e++)
+                        block[e] = a[e * W + l];
+                }
+            }
+        }
+    }
+
+    return num_singular;
+}
+
+// Invert blocks of any size in place. Returns the number of singular blocks.
+template <typename ValueType>
+size_t invert_variable_blocks(ValueType* values, const int* block_offsets, const int* value_offsets, const int num_blocks)
+{
+    size_t num_singular = 0;
+
+    #pragma omp parallel
+    {
+        std::vector<ValueType> work;
+
+        #pragma omp for schedule(dynamic, 64) reduction(+ : num_singular)
+        for (int block = 0; block < num_blocks; block++)
+        {
+            const int n = block_offsets[block + 1] - block_offsets[block];
+
+            if (!invert_block(values + value_offsets[block], n, work))
+                num_singular++;
+        }
+    }
+
+    return num_singular;
+}
+
+// Copy the diagonal blocks of A to row-major dense blocks
+template <typename MatrixType, typename ValueType>
+void extract_diagonal_blocks(const MatrixType& A, const int* block_offsets, const int* value_offsets,
+                             const int num_blocks, ValueType* values)
+{
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int block = 0; block < num_blocks; block++)
+    {
+        const int start = block_offsets[block];
+        const int end   = block_offsets[block + 1];
+        const int n     = end - start;
+
+        ValueType* dense = values + value_offsets[block];
+
+        for (int i = start; i < end; i++)
+        {
+            for (int jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            {
+                const int j = A.column_indices[jj];
+
+                if (j >= start && j < end)
+                    dense[(i - start) * n + (j - start)] += A.values[jj];
+            }
+        }
+    }
+}
+
+} // end namespace detail
+
+
+// constructors
+template <typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+block_jacobi<ValueType,MemorySpace>
+::block_jacobi(const MatrixType& A, const size_t block_size)
+    : Parent(A.num_rows, A.num_cols, 0), block_size(0)
+{
+    if (block_size == 0)
+        throw cusp::invalid_input_exception("block size must be positive");
+
+    const size_t N = A.num_rows;
+    const size_t num_blocks = (N + block_size - 1) / block_size;
+
+    cusp::array1d<int, cusp::host_memory> offsets(num_blocks + 1);
+
+    for (size_t i = 0; i <= num_blocks; i++)
+        offsets[i] = std::min(i * block_size, N);
+
+    // the specialized kernels need blocks of equal size
+    if (N % block_size == 0)
+        this->block_size = block_size;
+
+    initialize(A, offsets);
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename MatrixType, typename IndexType, typename MemorySpace2>
+block_jacobi<ValueType,MemorySpace>
+::block_jacobi(const MatrixType& A, const cusp::array1d<IndexType,MemorySpace2>& block_offsets)
+    : Parent(A.num_rows, A.num_cols, 0), block_size(0)
+{
+    cusp::array1d<int, cusp::host_memory> offsets(block_offsets);
+
+    initialize(A, offsets);
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+void block_jacobi<ValueType,MemorySpace>
+::initialize(const MatrixType& A, const cusp::array1d<int, cusp::host_memory>& offsets)
+{
+    if (A.num_rows != A.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    if (offsets.size() == 0 || offsets[0] != 0 || size_t(offsets.back()) != A.num_rows)
+        throw cusp::invalid_input_exception("block offsets must start at 0 and end at the number of rows");
+
+    const int num_blocks = offsets.size() - 1;
+
+    cusp::array1d<int, cusp::host_memory> value_offsets_host(num_blocks + 1, 0);
+
+    for (int block = 0; block < num_blocks; block++)
+    {
+        const int n = offsets[block + 1] - offsets[block];
+
+        if (n <= 0)
+            throw cusp::invalid_input_exception("block offsets must be increasing");
+
+        value_offsets_host[block + 1] = value_offsets_host[block] + n * n;
+    }
+
+    cusp::csr_matrix<int, ValueType, cusp::host_memory> A_host(A);
+    cusp::array1d<ValueType, cusp::host_memory> values(value_offsets_host[num_blocks], ValueType(0));
+
+    detail::extract_diagonal_blocks(A_host, detail::raw(offsets), detail::raw(value_offsets_host),
+                                    num_blocks, detail::raw(values));
+
+    size_t num_singular = 0;
+    ValueType* values_ptr = detail::raw(values);
+
+    switch (block_size)
+    {
+        case 1: num_singular = detail::invert_uniform_blocks<1>(values_ptr, num_blocks); break;
+        case 2: num_singular = detail::invert_uniform_blocks<2>(values_ptr, num_blocks); break;
+        case 3: num_singular = detail::invert_uniform_blocks<3>(values_ptr, num_blocks); break;
+        case 4: num_singular = detail::invert_uniform_blocks<4>(values_ptr, num_blocks); break;
+        case 5: num_singular = detail::invert_uniform_blocks<5>(values_ptr, num_blocks); break;
+        case 6: num_singular = detail::invert_uniform_blocks<6>(values_ptr, num_blocks); break;
+        case 7: num_singular = detail::invert_uniform_blocks<7>(values_ptr, num_blocks); break;
+        case 8: num_singular = detail::invert_uniform_blocks<8>(values_ptr, num_blocks); break;
+        default:
+            num_singular = detail::invert_variable_blocks(values_ptr, detail::raw(offsets),
+                                                          detail::raw(value_offsets_host), num_blocks);
+    }
+
+    if (num_singular > 0)
+        throw cusp::runtime_exception("singular diagonal block encountered in block Jacobi setup");
+
+    Parent::num_entries = values.size();
+
+    block_offsets = offsets;
+    value_offsets = value_offsets_host;
+    block_inverses = values;
+}
+
+// linear operator
+template <typename ValueType, typename MemorySpace>
+template <typename VectorType1, typename VectorType2>
+void block_jacobi<ValueType, MemorySpace>
+::operator()(const VectorType1& x, VectorType2& y) const
+{
+    typename VectorType2::memory_space system;
+
+    const int num_blocks = this->num_blocks();
+
+    const ValueType* inverses = detail::raw(block_inverses);
+    const ValueType* x_ptr    = detail::raw(x);
+    ValueType*       y_ptr    = detail::raw(y);
+
+    switch (block_size)
+    {
+        case 1: detail::for_each_block(num_blocks, detail::uniform_block_multiply<1,ValueType>(inverses, x_ptr, y_ptr), system); break;
+        case 2: detail::for_each_block(num_blocks, detail::uniform_block_multiply<2,ValueType>(inverses, x_ptr, y_ptr), system); break;
+        case 3: detail::for_each_block(num_blocks, detail::uniform_block_multiply<3,ValueType>(inverses, x_ptr, y_ptr), system); break;
+        case 4: detail::for_each_block(num_blocks, detail::uniform_block_multiply<4,ValueType>(inverses, x_ptr, y_ptr), system); break;
+        case 5: detail::for_each_block(num_blocks, detail::uniform_block_multiply<5,ValueType>(inverses, x_ptr, y_ptr), system); break;
+        case 6: detail::for_each_block(num_blocks, detail::uniform_block_multiply<6,ValueType>(inverses, x_ptr, y_ptr), system); break;
+        case 7: detail::for_each_block(num_blocks, detail::uniform_block_multiply<7,ValueType>(inverses, x_ptr, y_ptr), system); break;
+        case 8: detail::for_each_block(num_blocks, detail::uniform_block_multiply<8,ValueType>(inverses, x_ptr, y_ptr), system); break;
+        default:
+            detail::for_each_block(num_blocks,
+                                   detail::variable_block_multiply<ValueType>(detail::raw(block_offsets), detail::raw(value_offsets),
+                                                                              inverses, x_ptr, y_ptr),
+                                   system);
+    }
+}
+
+} // end namespace precond
+} // end namespace cusp
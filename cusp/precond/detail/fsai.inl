@@ -0,0 +1,434 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+
+/*! \file fsai.inl
+ *  \brief Inline file for fsai.h
+ */
+
+#include <cusp/array1d.h>
+#include <cusp/complex.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/exception.h>
+#include <cusp/multiply.h>
+#include <cusp/transpose.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace cusp
+{
+namespace precond
+{
+namespace detail
+{
+
+// orders candidate columns by decreasing gradient magnitude
+template <typename ValueType>
+struct fsai_greater_gradient
+{
+    const ValueType* gradient;
+
+    fsai_greater_gradient(const ValueType* gradient) : gradient(gradient) {}
+
+    bool operator()(const int a, const int b) const
+    {
+        return cusp::abs(gradient[a]) > cusp::abs(gradient[b]);
+    }
+};
+
+// solves B[P,P]^T y = e_last with partial pivoting, the pattern P is
+// sorted and ends with the row index so e_last selects the diagonal
+template <typename MatrixType, typename ValueType>
+bool fsai_solve_row(const MatrixType& B,
+                    const std::vector<int>& pattern,
+                    const std::vector<int>& position,
+                    std::vector<ValueType>& dense,
+                    std::vector<ValueType>& y)
+{
+    const int n = pattern.size();
+
+    dense.assign(n * n, ValueType(0));
+    y.assign(n, ValueType(0));
+    y[n - 1] = ValueType(1);
+
+    // dense(b,a) = B(P[a],P[b])
+    for (int a = 0; a < n; a++)
+    {
+        const int p = pattern[a];
+
+        for (int jj = B.row_offsets[p]; jj < B.row_offsets[p + 1]; jj++)
+        {
+            const int b = position[B.column_indices[jj]];
+
+            if (b >= 0)
+                dense[b * n + a] += B.values[jj];
+        }
+    }
+
+    for (int k = 0; k < n; k++)
+    {
+        int pivot = k;
+
+        for (int r = k + 1; r < n; r++)
+            if (cusp::abs(dense[r * n + k]) > cusp::abs(dense[pivot * n + k]))
+                pivot = r;
+
+        if (dense[pivot * n + k] == ValueType(0))
+            return false;
+
+        if (pivot != k)
+        {
+            for (int c = k; c < n; c++)
+                std::swap(dense[k * n + c], dense[pivot * n + c]);
+
+            std::swap(y[k], y[pivot]);
+        }
+
+        for (int r = k + 1; r < n; r++)
+        {
+            const ValueType factor = dense[r * n + k] / dense[k * n + k];
+
+            if (factor == ValueType(0))
+                continue;
+
+            for (int c = k + 1; c < n; c++)
+                dense[r * n + c] -= factor * dense[k * n + c];
+
+            y[r] -= factor * y[k];
+        }
+    }
+
+    for (int k = n - 1; k >= 0; k--)
+    {
+        ValueType sum = y[k];
+
+        for (int c = k + 1; c < n; c++)
+            sum -= dense[k * n + c] * y[c];
+
+        y[k] = sum / dense[k * n + k];
+    }
+
+    return true;
+}
+
+// computes the rows of the lower triangular factor G whose row i
+// satisfies (G B^T)(i,j) = delta(i,j) for all j in the pattern of row i.
+// Every row is independent of the others so the rows are distributed
+// over the host threads. Returns the number of rows whose submatrix was
+// singular.
+template <typename MatrixType, typename ValueType>
+size_t fsai_factor(const MatrixType& B,
+                   const int pattern_power,
+                   const size_t adaptive_steps,
+                   const size_t entries_per_step,
+                   cusp::csr_matrix<int, ValueType, cusp::host_memory>& G)
+{
+    const int N = B.num_rows;
+
+    std::vector< std::vector<int> >       row_columns(N);
+    std::vector< std::vector<ValueType> > row_values(N);
+
+    size_t num_failed = 0;
+
+    #pragma omp parallel reduction(+ : num_failed)
+    {
+        std::vector<int>       visited(N, -1);
+        std::vector<int>       position(N, -1);
+        std::vector<ValueType> gradient(N, ValueType(0));
+        std::vector<int>       pattern, frontier, next_frontier, candidates;
+        std::vector<ValueType> dense, y;
+
+        #pragma omp for schedule(dynamic, 64)
+        for (int i = 0; i < N; i++)
+        {
+            // lower triangle of the nodes within pattern_power edges of i
+            pattern.assign(1, i);
+            frontier.assign(1, i);
+            visited[i] = i;
+
+            for (int hop = 0; hop < pattern_power && !frontier.empty(); hop++)
+            {
+                next_frontier.clear();
+
+                for (size_t f = 0; f < frontier.size(); f++)
+                {
+                    const int u = frontier[f];
+
+                    for (int jj = B.row_offsets[u]; jj < B.row_offsets[u + 1]; jj++)
+                    {
+                        const int j = B.column_indices[jj];
+
+                        if (visited[j] == i)
+                            continue;
+
+                        visited[j] = i;
+                        next_frontier.push_back(j);
+
+                        if (j < i)
+                            pattern.push_back(j);
+                    }
+                }
+
+                frontier.swap(next_frontier);
+            }
+
+            std::sort(pattern.begin(), pattern.end());
+
+            bool solved = false;
+
+            for (size_t step = 0; ; step++)
+            {
+                for (size_t a = 0; a < pattern.size(); a++)
+                    position[pattern[a]] = a;
+
+                solved = fsai_solve_row(B, pattern, position, dense, y);
+
+                if (!solved || step == adaptive_steps)
+                    break;
+
+                // gradient of the Kaporin number with respect to the
+                // entries outside the pattern: (y^T B(P,:))(j) for j < i
+                candidates.clear();
+
+                for (size_t a = 0; a < pattern.size(); a++)
+                {
+                    const int p = pattern[a];
+
+                    for (int jj = B.row_offsets[p]; jj < B.row_offsets[p + 1]; jj++)
+                    {
+                        const int j = B.column_indices[jj];
+
+                        if (j >= i || position[j] >= 0)
+                            continue;
+
+                        if (gradient[j] == ValueType(0))
+                            candidates.push_back(j);
+
+                        gradient[j] += y[a] * B.values[jj];
+                    }
+                }
+
+                // duplicates come from gradients which cancelled back to zero
+                std::sort(candidates.begin(), candidates.end());
+                candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+                const size_t num_added = std::min(entries_per_step, candidates.size());
+
+                std::nth_element(candidates.begin(), candidates.begin() + num_added, candidates.end(),
+                                 fsai_greater_gradient<ValueType>(&gradient[0]));
+
+                for (size_t a = 0; a < pattern.size(); a++)
+                    position[pattern[a]] = -1;
+
+                size_t num_nonzero = 0;
+
+                for (size_t c = 0; c < num_added; c++)
+                {
+                    if (gradient[candidates[c]] != ValueType(0))
+                    {
+                        pattern.push_back(candidates[c]);
+                        num_nonzero++;
+                    }
+                }
+
+                for (size_t c = 0; c < candidates.size(); c++)
+                    gradient[candidates[c]] = ValueType(0);
+
+                if (num_nonzero == 0)
+                {
+                    for (size_t a = 0; a < pattern.size(); a++)
+                        position[pattern[a]] = a;
+                    break;
+                }
+
+                std::sort(pattern.begin(), pattern.end());
+            }
+
+            for (size_t a = 0; a < pattern.size(); a++)
+                position[pattern[a]] = -1;
+
+            if (!solved)
+            {
+                num_failed++;
+                continue;
+            }
+
+            row_columns[i] = pattern;
+            row_values[i]  = y;
+        }
+    }
+
+    if (num_failed > 0)
+        return num_failed;
+
+    size_t num_entries = 0;
+
+    for (int i = 0; i < N; i++)
+        num_entries += row_columns[i].size();
+
+    G.resize(N, N, num_entries);
+    G.row_offsets[0] = 0;
+
+    for (int i = 0; i < N; i++)
+        G.row_offsets[i + 1] = G.row_offsets[i] + row_columns[i].size();
+
+    #pragma omp parallel for
+    for (int i = 0; i < N; i++)
+    {
+        std::copy(row_columns[i].begin(), row_columns[i].end(), G.column_indices.begin() + G.row_offsets[i]);
+        std::copy(row_values[i].begin(), row_values[i].end(), G.values.begin() + G.row_offsets[i]);
+    }
+
+    return 0;
+}
+
+template <typename MatrixType>
+void fsai_check_input(const MatrixType& A, const int pattern_power)
+{
+    if (A.num_rows != A.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    if (pattern_power < 0)
+        throw cusp::invalid_input_exception("pattern power must be nonnegative");
+}
+
+} // end namespace detail
+
+
+// constructors
+template <typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+fsai<ValueType,MemorySpace>
+::fsai(const MatrixType& A, int pattern_power, size_t adaptive_steps, size_t entries_per_step)
+    : Parent(A.num_rows, A.num_cols, 0), temp(A.num_rows)
+{
+    detail::fsai_check_input(A, pattern_power);
+
+    cusp::csr_matrix<int, ValueType, cusp::host_memory> A_host(A);
+    cusp::csr_matrix<int, ValueType, cusp::host_memory> G_host;
+
+    if (detail::fsai_factor(A_host, pattern_power, adaptive_steps, entries_per_step, G_host) > 0)
+        throw cusp::runtime_exception("singular submatrix encountered in FSAI setup");
+
+    // the diagonal is the last entry of each row, g_i = y / sqrt(y_i)
+    const int N = G_host.num_rows;
+    size_t num_nonpositive = 0;
+
+    #pragma omp parallel for reduction(+ : num_nonpositive)
+    for (int i = 0; i < N; i++)
+    {
+        const int start = G_host.row_offsets[i];
+        const int end   = G_host.row_offsets[i + 1];
+        const ValueType diagonal = G_host.values[end - 1];
+
+        if (!(diagonal > ValueType(0)))
+        {
+            num_nonpositive++;
+            continue;
+        }
+
+        const ValueType scale = ValueType(1) / std::sqrt(diagonal);
+
+        for (int jj = start; jj < end; jj++)
+            G_host.values[jj] *= scale;
+    }
+
+    if (num_nonpositive > 0)
+        throw cusp::runtime_exception("matrix is not positive definite in FSAI setup");
+
+    Parent::num_entries = 2 * G_host.num_entries;
+
+    G = G_host;
+    cusp::transpose(G_host, G_t);
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+nonsym_fsai<ValueType,MemorySpace>
+::nonsym_fsai(const MatrixType& A, int pattern_power, size_t adaptive_steps, size_t entries_per_step)
+    : Parent(A.num_rows, A.num_cols, 0), temp(A.num_rows)
+{
+    detail::fsai_check_input(A, pattern_power);
+
+    cusp::csr_matrix<int, ValueType, cusp::host_memory> A_host(A);
+    cusp::csr_matrix<int, ValueType, cusp::host_memory> A_t_host;
+    cusp::transpose(A_host, A_t_host);
+
+    // rows of G_l make G_l A unit upper triangular on their pattern
+    cusp::csr_matrix<int, ValueType, cusp::host_memory> G_l_host;
+
+    if (detail::fsai_factor(A_host, pattern_power, adaptive_steps, entries_per_step, G_l_host) > 0)
+        throw cusp::runtime_exception("singular submatrix encountered in FSAI setup");
+
+    // columns of G_u make A G_u lower triangular, scaled to a unit diagonal
+    cusp::csr_matrix<int, ValueType, cusp::host_memory> G_u_t_host;
+
+    if (detail::fsai_factor(A_t_host, pattern_power, adaptive_steps, entries_per_step, G_u_t_host) > 0)
+        throw cusp::runtime_exception("singular submatrix encountered in FSAI setup");
+
+    const int N = G_u_t_host.num_rows;
+    size_t num_zero = 0;
+
+    #pragma omp parallel for reduction(+ : num_zero)
+    for (int i = 0; i < N; i++)
+    {
+        const int start = G_u_t_host.row_offsets[i];
+        const int end   = G_u_t_host.row_offsets[i + 1];
+        const ValueType diagonal = G_u_t_host.values[end - 1];
+
+        if (diagonal == ValueType(0))
+        {
+            num_zero++;
+            continue;
+        }
+
+        for (int jj = start; jj < end; jj++)
+            G_u_t_host.values[jj] /= diagonal;
+    }
+
+    if (num_zero > 0)
+        throw cusp::runtime_exception("zero pivot encountered in FSAI setup");
+
+    Parent::num_entries = G_l_host.num_entries + G_u_t_host.num_entries;
+
+    G_l = G_l_host;
+    cusp::transpose(G_u_t_host, G_u);
+}
+
+// linear operators
+template <typename ValueType, typename MemorySpace>
+template <typename VectorType1, typename VectorType2>
+void fsai<ValueType, MemorySpace>
+::operator()(const VectorType1& x, VectorType2& y)
+{
+    cusp::multiply(G, x, temp);
+    cusp::multiply(G_t, temp, y);
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename VectorType1, typename VectorType2>
+void nonsym_fsai<ValueType, MemorySpace>
+::operator()(const VectorType1& x, VectorType2& y)
+{
+    cusp::multiply(G_l, x, temp);
+    cusp::multiply(G_u, temp, y);
+}
+
+} // end namespace precond
+} // end namespace cusp
@@ -0,0 +1,484 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file ilu.inl
+ *  \brief Inline file for ilu.h
+ */
+
+#include <cusp/coo_matrix.h>
+#include <cusp/copy.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/exception.h>
+#include <cusp/transpose.h>
+
+#include <thrust/fill.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace cusp
+{
+namespace precond
+{
+namespace detail
+{
+
+// copy A to a host CSR matrix with sorted column indices in every row
+template <typename MatrixType, typename IndexType, typename ValueType>
+void sorted_host_csr(const MatrixType& A,
+                     cusp::csr_matrix<IndexType,ValueType,cusp::host_memory>& B)
+{
+    if (A.num_rows != A.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    cusp::coo_matrix<IndexType,ValueType,cusp::host_memory> C(A);
+    C.sort_by_row_and_column();
+    B = C;
+}
+
+// locate the main diagonal entry of every row
+template <typename MatrixType, typename ArrayType>
+void find_diagonal_positions(const MatrixType& A, ArrayType& diagonal_positions)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    diagonal_positions.resize(A.num_rows);
+
+    for (IndexType i = 0; i < IndexType(A.num_rows); i++)
+    {
+        IndexType position = -1;
+
+        for (IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+        {
+            if (A.column_indices[jj] == i)
+            {
+                position = jj;
+                break;
+            }
+        }
+
+        if (position < 0)
+            throw cusp::invalid_input_exception("matrix must have a full main diagonal");
+
+        diagonal_positions[i] = position;
+    }
+}
+
+// Level of row i in the dependency graph of a triangular solve: rows
+// without dependencies are in level 0, otherwise a row is one level past
+// the deepest row it depends on.  Rows are returned grouped by level in
+// increasing index order within every level.
+template <typename MatrixType, typename ArrayType1, typename ArrayType2>
+void compute_levels(const MatrixType& A, bool lower,
+                    ArrayType1& level_offsets, ArrayType2& row_order)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    const IndexType N = A.num_rows;
+
+    cusp::array1d<IndexType, cusp::host_memory> levels(N, 0);
+    IndexType num_levels = N > 0 ? 1 : 0;
+
+    for (IndexType n = 0; n < N; n++)
+    {
+        IndexType i = lower ? n : N - 1 - n;
+        IndexType level = 0;
+
+        for (IndexType jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+        {
+            IndexType j = A.column_indices[jj];
+
+            if ((lower && j < i) || (!lower && j > i))
+                level = std::max(level, levels[j] + 1);
+        }
+
+        levels[i] = level;
+        num_levels = std::max(num_levels, level + 1);
+    }
+
+    // counting sort of the rows by level
+    level_offsets.resize(num_levels + 1);
+    thrust::fill(level_offsets.begin(), level_offsets.end(), IndexType(0));
+
+    for (IndexType i = 0; i < N; i++)
+        level_offsets[levels[i] + 1]++;
+
+    for (IndexType l = 0; l < num_levels; l++)
+        level_offsets[l + 1] += level_offsets[l];
+
+    cusp::array1d<IndexType, cusp::host_memory> next(level_offsets.begin(), level_offsets.end() - 1);
+
+    row_order.resize(N);
+
+    for (IndexType i = 0; i < N; i++)
+        row_order[next[levels[i]]++] = i;
+}
+
+template <typename IndexType, typename ValueType>
+template <typename MatrixType>
+void level_scheduled_factor<IndexType,ValueType>
+::initialize(const MatrixType& T, bool lower, bool unit_diagonal)
+{
+    const IndexType N = T.num_rows;
+
+    compute_levels(T, lower, level_offsets, row_order);
+
+    // count the off-diagonal entries of every row in level order
+    row_offsets.resize(N + 1);
+    row_offsets[0] = 0;
+
+    for (IndexType r = 0; r < N; r++)
+    {
+        IndexType i = row_order[r];
+        IndexType count = 0;
+
+        for (IndexType jj = T.row_offsets[i]; jj < T.row_offsets[i + 1]; jj++)
+        {
+            IndexType j = T.column_indices[jj];
+
+            if ((lower && j < i) || (!lower && j > i))
+                count++;
+        }
+
+        row_offsets[r + 1] = row_offsets[r] + count;
+    }
+
+    column_indices.resize(row_offsets[N]);
+    values.resize(row_offsets[N]);
+    diagonal_reciprocals.resize(N);
+
+    #pragma omp parallel for
+    for (int r = 0; r < int(N); r++)
+    {
+        IndexType i = row_order[r];
+        IndexType offset = row_offsets[r];
+        ValueType diagonal = ValueType(1);
+
+        for (IndexType jj = T.row_offsets[i]; jj < T.row_offsets[i + 1]; jj++)
+        {
+            IndexType j = T.column_indices[jj];
+
+            if ((lower && j < i) || (!lower && j > i))
+            {
+                column_indices[offset] = j;
+                values[offset] = T.values[jj];
+                offset++;
+            }
+            else if (j == i && !unit_diagonal)
+            {
+                diagonal = T.values[jj];
+            }
+        }
+
+        diagonal_reciprocals[r] = ValueType(1) / diagonal;
+    }
+}
+
+template <typename IndexType, typename ValueType>
+template <typename VectorType1, typename VectorType2>
+void level_scheduled_factor<IndexType,ValueType>
+::solve(const VectorType1& x, VectorType2& y) const
+{
+    const int L = num_levels();
+
+    #pragma omp parallel
+    {
+        for (int l = 0; l < L; l++)
+        {
+            // rows within a level only depend on rows of previous levels
+            #pragma omp for
+            for (int r = level_offsets[l]; r < int(level_offsets[l + 1]); r++)
+            {
+                IndexType i = row_order[r];
+                ValueType sum = x[i];
+
+                for (IndexType jj = row_offsets[r]; jj < row_offsets[r + 1]; jj++)
+                    sum -= values[jj] * y[column_indices[jj]];
+
+                y[i] = sum * diagonal_reciprocals[r];
+            }
+        }
+    }
+}
+
+// In-place ILU(0) of a host CSR matrix with sorted rows, one level of the
+// lower triangular dependency graph at a time.
+template <typename MatrixType>
+void ilu0_factor(MatrixType& A)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+
+    const IndexType N = A.num_rows;
+
+    cusp::array1d<IndexType, cusp::host_memory> diagonal_positions;
+    cusp::array1d<IndexType, cusp::host_memory> level_offsets;
+    cusp::array1d<IndexType, cusp::host_memory> row_order;
+
+    find_diagonal_positions(A, diagonal_positions);
+    compute_levels(A, true, level_offsets, row_order);
+
+    const int num_levels = level_offsets.size() - 1;
+    int num_zero = 0;
+
+    #pragma omp parallel reduction(+ : num_zero)
+    {
+        cusp::array1d<IndexType, cusp::host_memory> position(N, -1);
+
+        for (int l = 0; l < num_levels; l++)
+        {
+            #pragma omp for
+            for (int r = level_offsets[l]; r < int(level_offsets[l + 1]); r++)
+            {
+                IndexType i = row_order[r];
+                IndexType row_start = A.row_offsets[i];
+                IndexType row_end   = A.row_offsets[i + 1];
+
+                for (IndexType jj = row_start; jj < row_end; jj++)
+                    position[A.column_indices[jj]] = jj;
+
+                // eliminate the entries left of the diagonal using the
+                // already factored rows k < i
+                for (IndexType kk = row_start; kk < diagonal_positions[i]; kk++)
+                {
+                    IndexType k = A.column_indices[kk];
+
+                    ValueType multiplier = A.values[kk] / A.values[diagonal_positions[k]];
+                    A.values[kk] = multiplier;
+
+                    for (IndexType jj = diagonal_positions[k] + 1; jj < A.row_offsets[k + 1]; jj++)
+                    {
+                        IndexType p = position[A.column_indices[jj]];
+
+                        if (p >= 0)
+                            A.values[p] -= multiplier * A.values[jj];
+                    }
+                }
+
+                for (IndexType jj = row_start; jj < row_end; jj++)
+                    position[A.column_indices[jj]] = -1;
+
+                if (A.values[diagonal_positions[i]] == ValueType(0))
+                    num_zero++;
+            }
+        }
+    }
+
+    if (num_zero > 0)
+        throw cusp::runtime_exception("zero pivot encountered in ILU(0) factorization");
+}
+
+// In-place IC(0) of the lower triangle of a symmetric matrix stored as a
+// host CSR matrix with sorted rows.  The diagonal is the last entry of
+// every row.
+template <typename MatrixType>
+void ic0_factor(MatrixType& L)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+
+    const IndexType N = L.num_rows;
+
+    cusp::array1d<IndexType, cusp::host_memory> level_offsets;
+    cusp::array1d<IndexType, cusp::host_memory> row_order;
+
+    compute_levels(L, true, level_offsets, row_order);
+
+    const int num_levels = level_offsets.size() - 1;
+    int num_nonpositive = 0;
+
+    #pragma omp parallel reduction(+ : num_nonpositive)
+    {
+        cusp::array1d<IndexType, cusp::host_memory> position(N, -1);
+
+        for (int l = 0; l < num_levels; l++)
+        {
+            #pragma omp for
+            for (int r = level_offsets[l]; r < int(level_offsets[l + 1]); r++)
+            {
+                IndexType i = row_order[r];
+                IndexType row_start = L.row_offsets[i];
+                IndexType row_end   = L.row_offsets[i + 1];
+
+                for (IndexType jj = row_start; jj < row_end; jj++)
+                    position[L.column_indices[jj]] = jj;
+
+                // L(i,k) = (A(i,k) - sum_{j<k} L(i,j) L(k,j)) / L(k,k)
+                for (IndexType kk = row_start; kk < row_end - 1; kk++)
+                {
+                    IndexType k = L.column_indices[kk];
+                    ValueType sum = L.values[kk];
+
+                    for (IndexType jj = L.row_offsets[k]; jj < L.row_offsets[k + 1] - 1; jj++)
+                    {
+                        IndexType p = position[L.column_indices[jj]];
+
+                        if (p >= 0 && p < kk)
+                            sum -= L.values[p] * L.values[jj];
+                    }
+
+                    L.values[kk] = sum / L.values[L.row_offsets[k + 1] - 1];
+                }
+
+                // L(i,i) = sqrt(A(i,i) - sum_{j<i} L(i,j)^2)
+                ValueType diagonal = L.values[row_end - 1];
+
+                for (IndexType jj = row_start; jj < row_end - 1; jj++)
+                    diagonal -= L.values[jj] * L.values[jj];
+
+                if (diagonal <= ValueType(0))
+                {
+                    num_nonpositive++;
+                    diagonal = ValueType(1);
+                }
+
+                L.values[row_end - 1] = std::sqrt(diagonal);
+
+                for (IndexType jj = row_start; jj < row_end; jj++)
+                    position[L.column_indices[jj]] = -1;
+            }
+        }
+    }
+
+    if (num_nonpositive > 0)
+        throw cusp::runtime_exception("nonpositive pivot encountered in IC(0) factorization");
+}
+
+} // end namespace detail
+
+
+// constructor
+template <typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+ilu0<ValueType,MemorySpace>
+::ilu0(const MatrixType& A)
+    : linear_operator<ValueType,MemorySpace>(A.num_rows, A.num_cols, A.num_entries)
+{
+    cusp::csr_matrix<int, ValueType, cusp::host_memory> LU;
+    detail::sorted_host_csr(A, LU);
+
+    detail::ilu0_factor(LU);
+
+    L.initialize(LU, true,  true);
+    U.initialize(LU, false, false);
+}
+
+// linear operator
+template <typename ValueType, typename MemorySpace>
+template <typename VectorType1, typename VectorType2>
+void ilu0<ValueType,MemorySpace>
+::operator()(const VectorType1& x, VectorType2& y)
+{
+    apply(x, y, typename VectorType2::memory_space());
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename VectorType1, typename VectorType2>
+void ilu0<ValueType,MemorySpace>
+::apply(const VectorType1& x, VectorType2& y, cusp::host_memory)
+{
+    // y <- L^-1 x, y <- U^-1 y
+    L.solve(x, y);
+    U.solve(y, y);
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename VectorType1, typename VectorType2, typename System>
+void ilu0<ValueType,MemorySpace>
+::apply(const VectorType1& x, VectorType2& y, System)
+{
+    cusp::copy(x, temp);
+    L.solve(temp, temp);
+    U.solve(temp, temp);
+    cusp::copy(temp, y);
+}
+
+// constructor
+template <typename ValueType, typename MemorySpace>
+template <typename MatrixType>
+ic0<ValueType,MemorySpace>
+::ic0(const MatrixType& A)
+    : linear_operator<ValueType,MemorySpace>(A.num_rows, A.num_cols, A.num_entries)
+{
+    typedef cusp::csr_matrix<int, ValueType, cusp::host_memory> HostMatrix;
+
+    HostMatrix host_A;
+    detail::sorted_host_csr(A, host_A);
+
+    // extract the lower triangle including the main diagonal
+    cusp::array1d<int, cusp::host_memory> diagonal_positions;
+    detail::find_diagonal_positions(host_A, diagonal_positions);
+
+    HostMatrix host_L(A.num_rows, A.num_cols, host_A.num_entries);
+
+    int nnz = 0;
+    host_L.row_offsets[0] = 0;
+
+    for (int i = 0; i < int(A.num_rows); i++)
+    {
+        for (int jj = host_A.row_offsets[i]; jj <= diagonal_positions[i]; jj++)
+        {
+            host_L.column_indices[nnz] = host_A.column_indices[jj];
+            host_L.values[nnz] = host_A.values[jj];
+            nnz++;
+        }
+
+        host_L.row_offsets[i + 1] = nnz;
+    }
+
+    host_L.resize(A.num_rows, A.num_cols, nnz);
+
+    detail::ic0_factor(host_L);
+
+    HostMatrix host_Lt;
+    cusp::transpose(host_L, host_Lt);
+
+    L.initialize(host_L,  true,  false);
+    Lt.initialize(host_Lt, false, false);
+}
+
+// linear operator
+template <typename ValueType, typename MemorySpace>
+template <typename VectorType1, typename VectorType2>
+void ic0<ValueType,MemorySpace>
+::operator()(const VectorType1& x, VectorType2& y)
+{
+    apply(x, y, typename VectorType2::memory_space());
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename VectorType1, typename VectorType2>
+void ic0<ValueType,MemorySpace>
+::apply(const VectorType1& x, VectorType2& y, cusp::host_memory)
+{
+    // y <- L^-1 x, y <- L^-T y
+    L.solve(x, y);
+    Lt.solve(y, y);
+}
+
+template <typename ValueType, typename MemorySpace>
+template <typename VectorType1, typename VectorType2, typename System>
+void ic0<ValueType,MemorySpace>
+::apply(const VectorType1& x, VectorType2& y, System)
+{
+    cusp::copy(x, temp);
+    L.solve(temp, temp);
+    Lt.solve(temp, temp);
+    cusp::copy(temp, y);
+}
+
+} // end namespace precond
+} // end namespace cusp
@@ -0,0 +1,183 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file fsai.h
+ *  \brief Factorized sparse approximate inverse preconditioners.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/linear_operator.h>
+
+namespace cusp
+{
+namespace precond
+{
+
+/*! \addtogroup iterative_solvers Iterative Solvers
+ *  \addtogroup preconditioners Preconditioners
+ *  \brief Several preconditioners for iterative solvers
+ *  \ingroup iterative_solvers
+ *  \{
+ */
+
+/** \brief Factorized sparse approximate inverse preconditioner for SPD
+ *  matrices
+ *
+ *  \tparam ValueType Type used for matrix values (e.g. \c float or \c double).
+ *  \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ *  \par Overview
+ *  Computes a sparse lower triangular factor \c G with
+ *  <tt>G^T G ~ A^-1</tt> and applies <tt>y = G^T G x</tt> with two sparse
+ *  matrix-vector products. Row \c i of \c G solves a small dense system
+ *  with the submatrix of \c A on the pattern of the row, so the rows are
+ *  computed independently, in parallel on the host.
+ *
+ *  The initial pattern of row \c i holds the columns <tt>j <= i</tt>
+ *  within \p pattern_power edges of \c i in the graph of \c A, that is the
+ *  lower triangle of the pattern of <tt>A^pattern_power</tt>; 0 gives a
+ *  diagonal pattern. With \p adaptive_steps > 0 every step adds to each
+ *  row the \p entries_per_step columns that most reduce the Kaporin
+ *  condition number of <tt>G A G^T</tt>, which are the largest entries of
+ *  the gradient <tt>A g</tt> of the current row \c g.
+ *
+ *  The setup throws \p cusp::runtime_exception if \c A is found not to be
+ *  positive definite.
+ *
+ *  \par Example
+ *  \code
+ *  #include <cusp/precond/fsai.h>
+ *
+ *  int main(void)
+ *  {
+ *    // allocate storage for solution (x) and right hand side (b)
+ *    cusp::array1d<float, cusp::device_memory> x(A.num_rows, 0);
+ *    cusp::array1d<float, cusp::device_memory> b(A.num_rows, 1);
+ *
+ *    cusp::monitor<float> monitor(b, 100, 1e-6);
+ *
+ *    // pattern of A, grown by 2 steps of 4 entries per row
+ *    cusp::precond::fsai<float, cusp::device_memory> M(A, 1, 2, 4);
+ *
+ *    // solve
+ *    cusp::krylov::cg(A, x, b, monitor, M);
+ *
+ *    return 0;
+ *  }
+ *  \endcode
+ */
+template <typename ValueType, typename MemorySpace>
+class fsai : public linear_operator<ValueType, MemorySpace>
+{
+private:
+    typedef linear_operator<ValueType, MemorySpace> Parent;
+
+public:
+    cusp::csr_matrix<int, ValueType, MemorySpace> G;
+    cusp::csr_matrix<int, ValueType, MemorySpace> G_t;
+
+    /*! construct a \p fsai preconditioner
+     *
+     * \param A symmetric positive definite matrix to precondition
+     * \param pattern_power the initial pattern is the lower triangle of
+     * the pattern of \p A to this power
+     * \param adaptive_steps number of steps enlarging the pattern
+     * \param entries_per_step entries added to each row per step
+     * \tparam MatrixType matrix
+     */
+    template <typename MatrixType>
+    fsai(const MatrixType& A, int pattern_power = 1, size_t adaptive_steps = 0, size_t entries_per_step = 2);
+
+    /*! apply the preconditioner to vector \p x and store the result in \p y
+     *
+     * \param x input vector
+     * \param y ouput vector
+     * \tparam VectorType1 vector
+     * \tparam VectorType2 vector
+     */
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& x, VectorType2& y);
+
+protected:
+    cusp::array1d<ValueType, MemorySpace> temp;
+};
+
+/** \brief Factorized sparse approximate inverse preconditioner for
+ *  nonsymmetric matrices
+ *
+ *  \tparam ValueType Type used for matrix values (e.g. \c float or \c double).
+ *  \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ *  \par Overview
+ *  Computes a sparse lower triangular \c G_l and a sparse upper
+ *  triangular \c G_u with <tt>G_u G_l ~ A^-1</tt>. Row \c i of \c G_l
+ *  makes the entries of <tt>G_l A</tt> on its pattern equal to row \c i of
+ *  the identity, and column \c i of \c G_u, normalized to a unit
+ *  diagonal, does the same for <tt>A G_u</tt>. The patterns are chosen as
+ *  for \p fsai, using the graph of <tt>A^T</tt> for \c G_u. With complete
+ *  patterns <tt>G_u G_l = A^-1</tt>.
+ *
+ *  The setup throws \p cusp::runtime_exception if a submatrix on the
+ *  pattern of a row is singular.
+ */
+template <typename ValueType, typename MemorySpace>
+class nonsym_fsai : public linear_operator<ValueType, MemorySpace>
+{
+private:
+    typedef linear_operator<ValueType, MemorySpace> Parent;
+
+public:
+    cusp::csr_matrix<int, ValueType, MemorySpace> G_l;
+    cusp::csr_matrix<int, ValueType, MemorySpace> G_u;
+
+    /*! construct a \p nonsym_fsai preconditioner
+     *
+     * \param A matrix to precondition
+     * \param pattern_power the initial patterns come from the pattern of
+     * \p A to this power
+     * \param adaptive_steps number of steps enlarging the patterns
+     * \param entries_per_step entries added to each row per step
+     * \tparam MatrixType matrix
+     */
+    template <typename MatrixType>
+    nonsym_fsai(const MatrixType& A, int pattern_power = 1, size_t adaptive_steps = 0, size_t entries_per_step = 2);
+
+    /*! apply the preconditioner to vector \p x and store the result in \p y
+     *
+     * \param x input vector
+     * \param y ouput vector
+     * \tparam VectorType1 vector
+     * \tparam VectorType2 vector
+     */
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& x, VectorType2& y);
+
+protected:
+    cusp::array1d<ValueType, MemorySpace> temp;
+};
+/*! \}
+ */
+
+} // end namespace precond
+} // end namespace cusp
+
+#include <cusp/precond/detail/fsai.inl>
@@ -0,0 +1,221 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file ilu.h
+ *  \brief Incomplete factorization (ILU(0) and IC(0)) preconditioners.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/linear_operator.h>
+
+namespace cusp
+{
+namespace precond
+{
+namespace detail
+{
+
+/* \cond */
+template <typename IndexType, typename ValueType>
+class level_scheduled_factor
+{
+public:
+
+    // rows of the factor grouped by level, levels stored contiguously
+    cusp::array1d<IndexType, cusp::host_memory> level_offsets;
+    cusp::array1d<IndexType, cusp::host_memory> row_order;
+
+    // off-diagonal entries of the factor in level order
+    cusp::array1d<IndexType, cusp::host_memory> row_offsets;
+    cusp::array1d<IndexType, cusp::host_memory> column_indices;
+    cusp::array1d<ValueType, cusp::host_memory> values;
+    cusp::array1d<ValueType, cusp::host_memory> diagonal_reciprocals;
+
+    template <typename MatrixType>
+    void initialize(const MatrixType& T, bool lower, bool unit_diagonal);
+
+    template <typename VectorType1, typename VectorType2>
+    void solve(const VectorType1& x, VectorType2& y) const;
+
+    size_t num_levels(void) const
+    {
+        return level_offsets.size() - 1;
+    }
+};
+/* \endcond */
+
+} // end namespace detail
+
+/**
+ *  \ingroup preconditioners
+ *  \{
+ */
+
+/**
+ * \brief Incomplete LU factorization with zero fill-in (ILU(0))
+ *
+ * \tparam ValueType Type used for matrix values (e.g. \c float or \c double).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ * Computes factors \c L (unit lower triangular) and \c U (upper triangular)
+ * with the sparsity pattern of \c A such that <tt>LU = A</tt> on that
+ * pattern, and applies <tt>y = U^-1 L^-1 x</tt>.
+ *
+ * Rows of the factors are grouped into levels of the triangular dependency
+ * graph. All rows within a level are independent, so the factorization
+ * and the forward/backward substitutions process one level at a time
+ * with the rows of a level distributed across OpenMP threads. The factors
+ * are stored permuted into level order so each level is a contiguous
+ * range of rows.
+ *
+ * The factorization and the triangular solves run on the host. When
+ * \p MemorySpace is a device memory space the vectors are staged through
+ * host memory on every application.
+ *
+ * \note \p A must be square and have a nonzero main diagonal.
+ *
+ * \par Example
+ * \code
+ * #include <cusp/csr_matrix.h>
+ * #include <cusp/monitor.h>
+ * #include <cusp/gallery/poisson.h>
+ * #include <cusp/krylov/bicgstab.h>
+ * #include <cusp/precond/ilu.h>
+ *
+ * int main(void)
+ * {
+ *    cusp::csr_matrix<int, double, cusp::host_memory> A;
+ *    cusp::gallery::poisson5pt(A, 100, 100);
+ *
+ *    cusp::array1d<double, cusp::host_memory> x(A.num_rows, 0);
+ *    cusp::array1d<double, cusp::host_memory> b(A.num_rows, 1);
+ *
+ *    cusp::monitor<double> monitor(b, 1000, 1e-8);
+ *
+ *    // setup preconditioner
+ *    cusp::precond::ilu0<double, cusp::host_memory> M(A);
+ *
+ *    cusp::krylov::bicgstab(A, x, b, monitor, M);
+ *
+ *    return 0;
+ * }
+ * \endcode
+ */
+template <typename ValueType, typename MemorySpace>
+class ilu0 : public linear_operator<ValueType, MemorySpace>
+{
+private:
+    typedef linear_operator<ValueType, MemorySpace> Parent;
+
+public:
+    detail::level_scheduled_factor<int, ValueType> L;
+    detail::level_scheduled_factor<int, ValueType> U;
+
+    /*! construct a \p ilu0 preconditioner
+     *
+     * \param A matrix to precondition
+     * \tparam MatrixType matrix
+     */
+    template <typename MatrixType>
+    ilu0(const MatrixType& A);
+
+    /*! apply the preconditioner to vector \p x and store the result in \p y
+     *
+     * \param x input vector
+     * \param y ouput vector
+     * \tparam VectorType1 vector
+     * \tparam VectorType2 vector
+     */
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& x, VectorType2& y);
+
+protected:
+    cusp::array1d<ValueType, cusp::host_memory> temp;
+
+    template <typename VectorType1, typename VectorType2>
+    void apply(const VectorType1& x, VectorType2& y, cusp::host_memory);
+
+    template <typename VectorType1, typename VectorType2, typename System>
+    void apply(const VectorType1& x, VectorType2& y, System);
+};
+
+/**
+ * \brief Incomplete Cholesky factorization with zero fill-in (IC(0))
+ *
+ * \tparam ValueType Type used for matrix values (e.g. \c float or \c double).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ * Computes a lower triangular factor \c L with the sparsity pattern of the
+ * lower triangle of \c A such that <tt>L L^T = A</tt> on that pattern, and
+ * applies <tt>y = L^-T L^-1 x</tt>. Factorization and substitution use the
+ * same level scheduling as \p ilu0.
+ *
+ * \note \p A must be real, symmetric and positive-definite. A
+ * \c cusp::runtime_exception is thrown if a nonpositive pivot is
+ * encountered.
+ *
+ * \see \p ilu0
+ */
+template <typename ValueType, typename MemorySpace>
+class ic0 : public linear_operator<ValueType, MemorySpace>
+{
+private:
+    typedef linear_operator<ValueType, MemorySpace> Parent;
+
+public:
+    detail::level_scheduled_factor<int, ValueType> L;
+    detail::level_scheduled_factor<int, ValueType> Lt;
+
+    /*! construct a \p ic0 preconditioner
+     *
+     * \param A matrix to precondition
+     * \tparam MatrixType matrix
+     */
+    template <typename MatrixType>
+    ic0(const MatrixType& A);
+
+    /*! apply the preconditioner to vector \p x and store the result in \p y
+     *
+     * \param x input vector
+     * \param y ouput vector
+     * \tparam VectorType1 vector
+     * \tparam VectorType2 vector
+     */
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& x, VectorType2& y);
+
+protected:
+    cusp::array1d<ValueType, cusp::host_memory> temp;
+
+    template <typename VectorType1, typename VectorType2>
+    void apply(const VectorType1& x, VectorType2& y, cusp::host_memory);
+
+    template <typename VectorType1, typename VectorType2, typename System>
+    void apply(const VectorType1& x, VectorType2& y, System);
+};
+/*! \}
+ */
+
+} // end namespace precond
+} // end namespace cusp
+
+#include <cusp/precond/detail/ilu.inl>
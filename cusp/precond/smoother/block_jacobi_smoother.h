@@ -0,0 +1,146 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file block_jacobi_smoother.h
+ *  \brief Block Jacobi smoother for multilevel preconditioners.
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/multiply.h>
+#include <cusp/blas/blas.h>
+#include <cusp/precond/block_jacobi.h>
+
+namespace cusp
+{
+namespace precond
+{
+
+/*! \addtogroup preconditioners Preconditioners
+ *  \ingroup preconditioners
+ *  \{
+ */
+
+/*! \p block_jacobi_smoother : damped block Jacobi relaxation
+ *  <tt>x <- x + omega * D^-1 (b - A x)</tt> with diagonal blocks of
+ *  \p BlockSize consecutive rows on every level, for use as the
+ *  \p SmootherType of \p smoothed_aggregation. On the finest level the
+ *  blocks should hold the unknowns of a node. The damping factor is the
+ *  weight divided by an estimate of the spectral radius of <tt>D^-1 A</tt>.
+ */
+template <typename ValueType, typename MemorySpace, int BlockSize>
+class block_jacobi_smoother
+{
+private:
+
+    typedef cusp::precond::block_jacobi<ValueType,MemorySpace> BaseSmoother;
+
+public:
+    size_t num_iters;
+    ValueType omega;
+    BaseSmoother M;
+    cusp::array1d<ValueType,MemorySpace> residual;
+    cusp::array1d<ValueType,MemorySpace> update;
+
+    block_jacobi_smoother(void) {}
+
+    template <typename ValueType2, typename MemorySpace2>
+    block_jacobi_smoother(const block_jacobi_smoother<ValueType2,MemorySpace2,BlockSize>& A)
+        : num_iters(A.num_iters), omega(A.omega), M(A.M), residual(A.residual), update(A.update) {}
+
+    template <typename MatrixType, typename Level>
+    block_jacobi_smoother(const MatrixType& A, const Level& L, double weight=4.0/3.0)
+    {
+        initialize(A, L, weight);
+    }
+
+    template <typename MatrixType, typename Level>
+    void initialize(const MatrixType& A, const Level& L, double weight=4.0/3.0)
+    {
+        num_iters = L.num_iters;
+        M = BaseSmoother(A, BlockSize);
+        residual.resize(A.num_rows);
+        update.resize(A.num_rows);
+        omega = weight / estimate_rho_Dinv_A(A);
+    }
+
+    // ignores initial x
+    template<typename MatrixType, typename VectorType1, typename VectorType2>
+    void presmooth(const MatrixType& A, const VectorType1& b, VectorType2& x)
+    {
+        if (num_iters == 0)
+            return;
+
+        // x <- omega * D^-1 * b
+        M(b, update);
+        cusp::blas::copy(update, x);
+        cusp::blas::scal(x, omega);
+
+        for(size_t i = 1; i < num_iters; i++)
+            relax(A, b, x);
+    }
+
+    // smooths initial x
+    template<typename MatrixType, typename VectorType1, typename VectorType2>
+    void postsmooth(const MatrixType& A, const VectorType1& b, VectorType2& x)
+    {
+        for(size_t i = 0; i < num_iters; i++)
+            relax(A, b, x);
+    }
+
+protected:
+
+    // x <- x + omega * D^-1 * (b - A * x)
+    template<typename MatrixType, typename VectorType1, typename VectorType2>
+    void relax(const MatrixType& A, const VectorType1& b, VectorType2& x)
+    {
+        cusp::multiply(A, x, residual);
+        cusp::blas::axpby(b, residual, residual, ValueType(1), ValueType(-1));
+        M(residual, update);
+        cusp::blas::axpy(update, x, omega);
+    }
+
+    // power iteration for the spectral radius of D^-1 A
+    template<typename MatrixType>
+    ValueType estimate_rho_Dinv_A(const MatrixType& A)
+    {
+        typedef typename cusp::norm_type<ValueType>::type NormType;
+
+        const size_t k = 20;
+
+        cusp::array1d<ValueType,MemorySpace> x(A.num_rows);
+        cusp::copy(cusp::random_array<ValueType>(A.num_rows), x);
+
+        for(size_t i = 0; i < k; i++)
+        {
+            cusp::blas::scal(x, NormType(1.0) / cusp::blas::nrmmax(x));
+            cusp::multiply(A, x, residual);
+            M(residual, update);
+            x.swap(update);
+        }
+
+        return cusp::blas::nrm2(x) / cusp::blas::nrm2(update);
+    }
+};
+/*! \}
+ */
+
+} // end namespace precond
+} // end namespace cusp
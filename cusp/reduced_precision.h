@@ -0,0 +1,211 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+/*! \file reduced_precision.h
+ *  \brief Sparse matrices storing their values in reduced precision
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/linear_operator.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+
+/*! \addtogroup arrays Arrays
+ *  \{
+ */
+
+/**
+ * \brief 16-bit brain floating point number used for value storage
+ *
+ * \par Overview
+ * A \p bfloat16 keeps the sign, the 8 exponent bits and the 7 leading
+ * mantissa bits of a \c float, so it has the range of \c float with about
+ * three significant decimal digits. Conversion from \c float rounds to
+ * nearest even and conversion to \c float is exact. No arithmetic is
+ * defined on \p bfloat16, values are converted to \c float for
+ * computation.
+ */
+struct bfloat16
+{
+    /*! Upper 16 bits of the IEEE single precision representation. */
+    unsigned short bits;
+
+    __host__ __device__
+    bfloat16(void) {}
+
+    __host__ __device__
+    bfloat16(const float value)
+    {
+        union { float f; unsigned int u; } v;
+        v.f = value;
+
+        if ((v.u & 0x7fffffffu) > 0x7f800000u)
+            bits = (v.u >> 16) | 0x40u; // keep NaNs quiet
+        else
+            bits = (v.u + 0x7fffu + ((v.u >> 16) & 1u)) >> 16;
+    }
+
+    __host__ __device__
+    operator float(void) const
+    {
+        union { float f; unsigned int u; } v;
+        v.u = (unsigned int)(bits) << 16;
+        return v.f;
+    }
+};
+
+/*! \}
+ */
+
+/*! \addtogroup sparse_matrices Sparse Matrices
+ */
+
+/*! \addtogroup sparse_matrix_containers Sparse Matrix Containers
+ *  \ingroup sparse_matrices
+ *  \{
+ */
+
+/**
+ * \brief CSR matrix storing its values in a narrower type than it computes with
+ *
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam StorageType Type of the stored values: \c float, \p bfloat16 or \c short.
+ * \tparam ValueType Type used for computation (e.g. \c double).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ * The sparse matrix-vector product with a CSR matrix streams its values
+ * and column indices once per product and is limited by memory
+ * bandwidth. Storing the values in fewer bytes reduces the traffic:
+ * <tt>int</tt> indices with \c float values move 8 instead of 12 bytes
+ * per entry, \p bfloat16 or \c short values 6. The values are converted
+ * to \p ValueType when they are loaded and the products are accumulated
+ * in \p ValueType.
+ *
+ * \c float values are rounded from \p ValueType. \p bfloat16 and \c short
+ * values are scaled per row: row \c i stores <tt>A(i,j) / s_i</tt> where
+ * \c s_i makes the largest magnitude in the row 1 for \p bfloat16 and
+ * 32767 for \c short, and the sum of the row is multiplied by \c s_i.
+ * The relative error of an entry is at most 2^-24 for \c float and 2^-8
+ * for \p bfloat16, and the absolute error at most <tt>s_i / 2</tt> for
+ * \c short.
+ *
+ * The matrix is a \p linear_operator, so it can be passed directly to the
+ * Krylov solvers as the system matrix or wherever an operator is
+ * expected. The product is a \p thrust::for_each over the rows with the
+ * execution policy of the caller, so it is sequential, OpenMP or one
+ * thread per row depending on the backend.
+ *
+ * \par Example
+ *  \code
+ *  #include <cusp/reduced_precision.h>
+ *  #include <cusp/monitor.h>
+ *  #include <cusp/gallery/poisson.h>
+ *  #include <cusp/krylov/cg.h>
+ *
+ *  int main()
+ *  {
+ *    cusp::csr_matrix<int, double, cusp::host_memory> A;
+ *    cusp::gallery::poisson5pt(A, 256, 256);
+ *
+ *    // values stored in single precision, computation in double
+ *    cusp::reduced_precision_csr_matrix<int, float, double, cusp::host_memory> S(A);
+ *
+ *    cusp::array1d<double, cusp::host_memory> x(S.num_rows, 0);
+ *    cusp::array1d<double, cusp::host_memory> b(S.num_rows, 1);
+ *
+ *    cusp::monitor<double> monitor(b, 1000, 1e-8);
+ *    cusp::krylov::cg(S, x, b, monitor);
+ *
+ *    return 0;
+ *  }
+ *  \endcode
+ */
+template <typename IndexType, typename StorageType, typename ValueType, typename MemorySpace>
+class reduced_precision_csr_matrix
+  : public cusp::linear_operator<ValueType, MemorySpace, IndexType>
+{
+private:
+
+    typedef cusp::linear_operator<ValueType, MemorySpace, IndexType> Parent;
+
+public:
+
+    /* \cond */
+    typedef StorageType storage_type;
+    typedef cusp::array1d<IndexType, MemorySpace>   index_array_type;
+    typedef cusp::array1d<StorageType, MemorySpace> storage_array_type;
+    typedef cusp::array1d<ValueType, MemorySpace>   values_array_type;
+    /* \endcond */
+
+    /*! Storage for the row offsets of the CSR data structure. */
+    index_array_type row_offsets;
+
+    /*! Storage for the column indices of the CSR data structure. */
+    index_array_type column_indices;
+
+    /*! Storage for the nonzero entries, scaled by the row scales. */
+    storage_array_type values;
+
+    /*! Scale of every row, 1 for unscaled storage types. */
+    values_array_type row_scales;
+
+    /*! Construct an empty \p reduced_precision_csr_matrix.
+     */
+    reduced_precision_csr_matrix(void) {}
+
+    /*! Construct a \p reduced_precision_csr_matrix from another matrix,
+     *  rounding its values to \p StorageType.
+     *
+     *  \tparam MatrixType Type of the matrix.
+     *
+     *  \param A Matrix to copy.
+     */
+    template <typename MatrixType>
+    reduced_precision_csr_matrix(const MatrixType& A);
+
+    /* \cond */
+    template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+    void operator()(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y) const;
+    /* \endcond */
+
+    /*! Apply the matrix to the vector \p x and produce the vector \p y.
+     *
+     * \tparam VectorType1 Type of the input vector
+     * \tparam VectorType2 Type of the output vector
+     *
+     *  \param x Input vector.
+     *  \param y Output vector.
+     */
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& x, VectorType2& y) const;
+
+};
+
+/*! \} // end Containers
+ */
+
+} // end namespace cusp
+
+#include <cusp/detail/reduced_precision.inl>
@@ -0,0 +1,358 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*! \file split_complex.h
+ *  \brief Split (structure-of-arrays) storage of complex arrays and matrices
+ */
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/complex.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/linear_operator.h>
+
+#include <cstddef>
+
+namespace cusp
+{
+
+/*! \addtogroup arrays Arrays
+ *  \{
+ */
+
+/**
+ * \brief Complex vector with separate arrays of real and imaginary parts
+ *
+ * \tparam RealType Type of the real and imaginary parts (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ * \p cusp::complex stores the real and imaginary part of every entry next
+ * to each other, so loops over complex arrays need shuffles to separate
+ * them and rarely vectorize. A \p split_complex_array1d stores them in two
+ * real arrays. The level-1 BLAS routines of \p cusp::blas (\p copy,
+ * \p fill, \p scal, \p axpy, \p dot, \p dotc and \p nrm2) and
+ * \p cusp::multiply with a \p split_complex_csr_matrix or a real
+ * \p csr_matrix accept split arrays and operate on the two streams with
+ * plain real arithmetic.
+ *
+ * \par Example
+ *  \code
+ *  #include <cusp/split_complex.h>
+ *
+ *  int main()
+ *  {
+ *    typedef cusp::complex<double> Complex;
+ *
+ *    cusp::array1d<Complex, cusp::host_memory> a(4, Complex(1, 2));
+ *
+ *    // separate real and imaginary parts
+ *    cusp::split_complex_array1d<double, cusp::host_memory> x(a);
+ *    cusp::split_complex_array1d<double, cusp::host_memory> y(4, Complex(0, 1));
+ *
+ *    // y += (2 - i) x
+ *    cusp::blas::axpy(x, y, Complex(2, -1));
+ *
+ *    // back to interleaved storage
+ *    y.copy_to(a);
+ *
+ *    return 0;
+ *  }
+ *  \endcode
+ */
+template <typename RealType, typename MemorySpace>
+class split_complex_array1d
+{
+public:
+
+    /* \cond */
+    typedef RealType                          real_type;
+    typedef cusp::complex<RealType>           value_type;
+    typedef MemorySpace                       memory_space;
+    typedef cusp::array1d<RealType, MemorySpace> real_array_type;
+    /* \endcond */
+
+    /*! Real parts. */
+    real_array_type real;
+
+    /*! Imaginary parts. */
+    real_array_type imag;
+
+    /*! Construct an empty \p split_complex_array1d.
+     */
+    split_complex_array1d(void) {}
+
+    /*! Construct a \p split_complex_array1d of \p n entries.
+     *
+     *  \param n Number of entries.
+     */
+    split_complex_array1d(const size_t n)
+        : real(n), imag(n) {}
+
+    /*! Construct a \p split_complex_array1d of \p n entries equal to \p value.
+     *
+     *  \param n Number of entries.
+     *  \param value Value of all entries.
+     */
+    split_complex_array1d(const size_t n, const value_type& value)
+        : real(n, value.real()), imag(n, value.imag()) {}
+
+    /*! Construct a \p split_complex_array1d from an interleaved complex array.
+     *
+     *  \tparam MemorySpace2 Memory space of the interleaved array.
+     *
+     *  \param x Array of \p cusp::complex values.
+     */
+    template <typename MemorySpace2>
+    split_complex_array1d(const cusp::array1d<value_type, MemorySpace2>& x);
+
+    /*! Copy the entries to an interleaved complex array.
+     *
+     *  \tparam ArrayType Type of the interleaved array.
+     *
+     *  \param x Array of \p cusp::complex values, resized to \p size().
+     */
+    template <typename ArrayType>
+    void copy_to(ArrayType& x) const;
+
+    /*! Number of entries.
+     */
+    size_t size(void) const
+    {
+        return real.size();
+    }
+
+    /*! Resize the array.
+     *
+     *  \param n Number of entries.
+     */
+    void resize(const size_t n)
+    {
+        real.resize(n);
+        imag.resize(n);
+    }
+
+    /*! Swap the contents of two \p split_complex_array1d objects.
+     *
+     *  \param x Another \p split_complex_array1d with the same type.
+     */
+    void swap(split_complex_array1d& x)
+    {
+        real.swap(x.real);
+        imag.swap(x.imag);
+    }
+};
+
+/*! \}
+ */
+
+/*! \addtogroup sparse_matrices Sparse Matrices
+ */
+
+/*! \addtogroup sparse_matrix_containers Sparse Matrix Containers
+ *  \ingroup sparse_matrices
+ *  \{
+ */
+
+/**
+ * \brief Complex CSR matrix with separate arrays of real and imaginary parts
+ *
+ * \tparam IndexType Type used for matrix indices (e.g. \c int).
+ * \tparam RealType Type of the real and imaginary parts (e.g. \c float).
+ * \tparam MemorySpace A memory space (e.g. \c cusp::host_memory or \c cusp::device_memory)
+ *
+ * \par Overview
+ * Stores a complex sparse matrix in CSR format with the real and
+ * imaginary parts of the values in separate arrays. The product with a
+ * vector accumulates the real and imaginary parts of every row in separate
+ * real sums, which vectorizes on the host. The matrix is a
+ * \p linear_operator on interleaved complex vectors, so it can be passed
+ * directly to the Krylov solvers, and \p cusp::multiply also accepts
+ * \p split_complex_array1d vectors.
+ *
+ * \par Example
+ *  \code
+ *  #include <cusp/split_complex.h>
+ *  #include <cusp/monitor.h>
+ *  #include <cusp/krylov/gmres.h>
+ *
+ *  int main()
+ *  {
+ *    typedef cusp::complex<double> Complex;
+ *
+ *    cusp::csr_matrix<int, Complex, cusp::host_memory> A;
+ *    // ... assemble A
+ *
+ *    cusp::split_complex_csr_matrix<int, double, cusp::host_memory> S(A);
+ *
+ *    cusp::array1d<Complex, cusp::host_memory> x(S.num_rows, 0);
+ *    cusp::array1d<Complex, cusp::host_memory> b(S.num_rows, 1);
+ *
+ *    cusp::monitor<double> monitor(b, 1000, 1e-8);
+ *    cusp::krylov::gmres(S, x, b, 50, monitor);
+ *
+ *    return 0;
+ *  }
+ *  \endcode
+ */
+template <typename IndexType, typename RealType, typename MemorySpace>
+class split_complex_csr_matrix
+  : public cusp::linear_operator<cusp::complex<RealType>, MemorySpace, IndexType>
+{
+private:
+
+    typedef cusp::linear_operator<cusp::complex<RealType>, MemorySpace, IndexType> Parent;
+
+public:
+
+    /* \cond */
+    typedef RealType real_type;
+    typedef cusp::array1d<IndexType, MemorySpace> index_array_type;
+    typedef cusp::array1d<RealType, MemorySpace>  real_array_type;
+    /* \endcond */
+
+    /*! Storage for the row offsets of the CSR data structure. */
+    index_array_type row_offsets;
+
+    /*! Storage for the column indices of the CSR data structure. */
+    index_array_type column_indices;
+
+    /*! Real parts of the nonzero entries. */
+    real_array_type real_values;
+
+    /*! Imaginary parts of the nonzero entries. */
+    real_array_type imag_values;
+
+    /*! Construct an empty \p split_complex_csr_matrix.
+     */
+    split_complex_csr_matrix(void) {}
+
+    /*! Construct a \p split_complex_csr_matrix with a specific shape and
+     *  number of nonzero entries.
+     *
+     *  \param num_rows Number of rows.
+     *  \param num_cols Number of columns.
+     *  \param num_entries Number of nonzero matrix entries.
+     */
+    split_complex_csr_matrix(const size_t num_rows, const size_t num_cols, const size_t num_entries)
+        : Parent(num_rows, num_cols, num_entries),
+          row_offsets(num_rows + 1), column_indices(num_entries),
+          real_values(num_entries), imag_values(num_entries) {}
+
+    /*! Construct a \p split_complex_csr_matrix from another matrix.
+     *
+     *  \tparam MatrixType Type of the matrix, with real or complex values.
+     *
+     *  \param A Matrix to copy.
+     */
+    template <typename MatrixType>
+    split_complex_csr_matrix(const MatrixType& A);
+
+    /* \cond */
+    template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+    void operator()(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y);
+    /* \endcond */
+
+    /*! Apply the matrix to the interleaved complex vector \p x and produce
+     *  the interleaved complex vector \p y.
+     *
+     * \tparam VectorType1 Type of the input vector
+     * \tparam VectorType2 Type of the output vector
+     *
+     *  \param x Input vector.
+     *  \param y Output vector.
+     */
+    template <typename VectorType1, typename VectorType2>
+    void operator()(const VectorType1& x, VectorType2& y);
+
+protected:
+
+    /* \cond */
+    template <typename DerivedPolicy, typename VectorType1, typename VectorType2>
+    void apply(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y,
+               cusp::host_memory);
+
+    template <typename DerivedPolicy, typename VectorType1, typename VectorType2, typename System>
+    void apply(thrust::execution_policy<DerivedPolicy>& exec, const VectorType1& x, VectorType2& y,
+               System);
+    /* \endcond */
+};
+
+/*! \} // end Containers
+ */
+
+/*! \addtogroup algorithms Algorithms
+ *  \{
+ */
+
+/* \cond */
+template <typename IndexType, typename RealType, typename MemorySpace>
+void multiply(const split_complex_csr_matrix<IndexType, RealType, MemorySpace>& A,
+              const split_complex_array1d<RealType, MemorySpace>& x,
+                    split_complex_array1d<RealType, MemorySpace>& y);
+
+template <typename IndexType, typename RealType, typename MemorySpace>
+void multiply(const csr_matrix<IndexType, RealType, MemorySpace>& A,
+              const split_complex_array1d<RealType, MemorySpace>& x,
+                    split_complex_array1d<RealType, MemorySpace>& y);
+/* \endcond */
+
+/*! \}
+ */
+
+namespace blas
+{
+
+/* \cond */
+template <typename RealType, typename MemorySpace>
+void copy(const cusp::split_complex_array1d<RealType, MemorySpace>& x,
+                cusp::split_complex_array1d<RealType, MemorySpace>& y);
+
+template <typename RealType, typename MemorySpace>
+void fill(cusp::split_complex_array1d<RealType, MemorySpace>& x,
+          const cusp::complex<RealType> alpha);
+
+template <typename RealType, typename MemorySpace>
+void scal(cusp::split_complex_array1d<RealType, MemorySpace>& x,
+          const cusp::complex<RealType> alpha);
+
+template <typename RealType, typename MemorySpace>
+void axpy(const cusp::split_complex_array1d<RealType, MemorySpace>& x,
+                cusp::split_complex_array1d<RealType, MemorySpace>& y,
+          const cusp::complex<RealType> alpha);
+
+template <typename RealType, typename MemorySpace>
+cusp::complex<RealType>
+dot(const cusp::split_complex_array1d<RealType, MemorySpace>& x,
+    const cusp::split_complex_array1d<RealType, MemorySpace>& y);
+
+template <typename RealType, typename MemorySpace>
+cusp::complex<RealType>
+dotc(const cusp::split_complex_array1d<RealType, MemorySpace>& x,
+     const cusp::split_complex_array1d<RealType, MemorySpace>& y);
+
+template <typename RealType, typename MemorySpace>
+RealType
+nrm2(const cusp::split_complex_array1d<RealType, MemorySpace>& x);
+/* \endcond */
+
+} // end namespace blas
+} // end namespace cusp
+
+#include <cusp/detail/split_complex.inl>
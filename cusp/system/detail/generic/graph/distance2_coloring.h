@@ -0,0 +1,349 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/exception.h>
+#include <cusp/transpose.h>
+#include <cusp/graph/distance2_coloring.h>
+
+#include <cusp/detail/execution_policy.h>
+#include <cusp/detail/type_traits.h>
+
+#include <thrust/copy.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+namespace detail
+{
+
+// Apply visitor to the vertices u != v reached from v through X and then
+// Y, and through X alone if first_hop is set. Stops when visitor returns
+// false.
+template <typename MatrixType1, typename MatrixType2, typename IndexType, typename Visitor>
+bool visit_distance2_neighbors(const MatrixType1& X,
+                               const MatrixType2& Y,
+                               const bool first_hop,
+                               const IndexType v,
+                                     Visitor& visitor)
+{
+    for (IndexType jj = X.row_offsets[v]; jj < X.row_offsets[v + 1]; jj++)
+    {
+        const IndexType w = X.column_indices[jj];
+
+        if (first_hop && w != v && !visitor(w))
+            return false;
+
+        for (IndexType kk = Y.row_offsets[w]; kk < Y.row_offsets[w + 1]; kk++)
+        {
+            const IndexType u = Y.column_indices[kk];
+
+            if (u != v && !visitor(u))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+// Marks the colors of the neighbors of v as forbidden. Neighbors in the
+// block of v are read from colors, all others from the snapshot taken
+// before the round, which no thread writes.
+template <typename ArrayType>
+struct forbid_colors
+{
+    typedef typename ArrayType::value_type IndexType;
+
+    const ArrayType& colors;
+    const ArrayType& snapshot;
+    const ArrayType& block_of;
+    std::vector<IndexType>& mark;
+    IndexType v;
+    IndexType block;
+
+    forbid_colors(const ArrayType& colors, const ArrayType& snapshot,
+                  const ArrayType& block_of, std::vector<IndexType>& mark)
+        : colors(colors), snapshot(snapshot), block_of(block_of), mark(mark), v(0), block(0) {}
+
+    bool operator()(const IndexType u)
+    {
+        const IndexType color = block_of[u] == block ? colors[u] : snapshot[u];
+
+        if (color >= 0)
+        {
+            if (size_t(color) >= mark.size())
+                mark.resize(color + 1, IndexType(-1));
+
+            mark[color] = v;
+        }
+
+        return true;
+    }
+};
+
+// Finds a neighbor of v with a smaller index that was colored in another
+// block of the same round and received the color of v
+template <typename ArrayType>
+struct find_conflict
+{
+    typedef typename ArrayType::value_type IndexType;
+
+    const ArrayType& colors;
+    const ArrayType& block_of;
+    IndexType v;
+
+    find_conflict(const ArrayType& colors, const ArrayType& block_of)
+        : colors(colors), block_of(block_of), v(0) {}
+
+    bool operator()(const IndexType u)
+    {
+        return !(u < v && block_of[u] >= 0 && block_of[u] != block_of[v] && colors[u] == colors[v]);
+    }
+};
+
+// Speculative greedy coloring of the distance-2 graph defined by X and Y.
+// Every round colors blocks of the remaining vertices in parallel, each
+// block sequentially, and keeps the vertices that conflict with a vertex
+// of smaller index in another block for the next round.
+template <typename MatrixType1, typename MatrixType2, typename ArrayType>
+size_t speculative_distance2_coloring(const MatrixType1& X,
+                                      const MatrixType2& Y,
+                                      const bool first_hop,
+                                            ArrayType& colors)
+{
+    typedef typename ArrayType::value_type IndexType;
+
+    const IndexType N = X.num_rows;
+    const IndexType block_size = 256;
+
+    colors.resize(N);
+    thrust::fill(colors.begin(), colors.end(), IndexType(-1));
+
+    ArrayType snapshot(N);
+    ArrayType block_of(N, IndexType(-1));
+
+    std::vector<IndexType> worklist(N);
+    for (IndexType i = 0; i < N; i++)
+        worklist[i] = i;
+
+    std::vector<char> conflict;
+
+    while (!worklist.empty())
+    {
+        const IndexType num_vertices = worklist.size();
+        const IndexType num_blocks = (num_vertices + block_size - 1) / block_size;
+
+        thrust::copy(colors.begin(), colors.end(), snapshot.begin());
+
+        for (IndexType n = 0; n < num_vertices; n++)
+            block_of[worklist[n]] = n / block_size;
+
+        #pragma omp parallel
+        {
+            std::vector<IndexType> mark;
+            forbid_colors<ArrayType> forbid(colors, snapshot, block_of, mark);
+
+            #pragma omp for schedule(dynamic)
+            for (IndexType block = 0; block < num_blocks; block++)
+            {
+                const IndexType n_end = std::min(num_vertices, (block + 1) * block_size);
+
+                forbid.block = block;
+
+                for (IndexType n = block * block_size; n < n_end; n++)
+                {
+                    const IndexType v = worklist[n];
+
+                    forbid.v = v;
+                    visit_distance2_neighbors(X, Y, first_hop, v, forbid);
+
+                    // smallest color not used by a neighbor
+                    IndexType color = 0;
+                    while (size_t(color) < mark.size() && mark[color] == v)
+                        color++;
+
+                    colors[v] = color;
+                }
+            }
+        }
+
+        conflict.assign(num_vertices, 0);
+
+        #pragma omp parallel
+        {
+            find_conflict<ArrayType> find(colors, block_of);
+
+            #pragma omp for schedule(dynamic, 256)
+            for (IndexType n = 0; n < num_vertices; n++)
+            {
+                find.v = worklist[n];
+
+                if (!visit_distance2_neighbors(X, Y, first_hop, find.v, find))
+                    conflict[n] = 1;
+            }
+        }
+
+        IndexType num_conflicts = 0;
+
+        for (IndexType n = 0; n < num_vertices; n++)
+        {
+            block_of[worklist[n]] = -1;
+
+            if (conflict[n])
+                worklist[num_conflicts++] = worklist[n];
+        }
+
+        worklist.resize(num_conflicts);
+    }
+
+    IndexType max_color = -1;
+
+    for (IndexType i = 0; i < N; i++)
+        max_color = std::max(max_color, colors[i]);
+
+    return size_t(max_color + 1);
+}
+
+} // end namespace detail
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+size_t distance2_coloring(thrust::execution_policy<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                                ArrayType& colors,
+                          cusp::csr_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    // the coloring runs on the host
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> G_host(G);
+    cusp::array1d<IndexType,cusp::host_memory> colors_host;
+
+    size_t num_colors = detail::speculative_distance2_coloring(G_host, G_host, true, colors_host);
+
+    colors.resize(G.num_rows);
+    thrust::copy(colors_host.begin(), colors_host.end(), colors.begin());
+
+    return num_colors;
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+size_t distance2_coloring(thrust::execution_policy<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                                ArrayType& colors,
+                          cusp::known_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix G_csr(G);
+
+    return cusp::graph::distance2_coloring(exec, G_csr, colors);
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+size_t distance2_coloring(thrust::execution_policy<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                                ArrayType& colors)
+{
+    typedef typename MatrixType::format Format;
+
+    Format format;
+
+    return distance2_coloring(thrust::detail::derived_cast(exec), G, colors, format);
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+size_t partial_distance2_coloring(thrust::execution_policy<DerivedPolicy>& exec,
+                                  const MatrixType& A,
+                                        ArrayType& colors,
+                                  cusp::csr_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+
+    // the coloring runs on the host, columns reach rows through A^T
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> A_host(A);
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> At_host;
+    cusp::transpose(A_host, At_host);
+
+    cusp::array1d<IndexType,cusp::host_memory> colors_host;
+
+    size_t num_colors = detail::speculative_distance2_coloring(At_host, A_host, false, colors_host);
+
+    colors.resize(A.num_cols);
+    thrust::copy(colors_host.begin(), colors_host.end(), colors.begin());
+
+    return num_colors;
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+size_t partial_distance2_coloring(thrust::execution_policy<DerivedPolicy>& exec,
+                                  const MatrixType& A,
+                                        ArrayType& colors,
+                                  cusp::known_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix A_csr(A);
+
+    return cusp::graph::partial_distance2_coloring(exec, A_csr, colors);
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+size_t partial_distance2_coloring(thrust::execution_policy<DerivedPolicy>& exec,
+                                  const MatrixType& A,
+                                        ArrayType& colors)
+{
+    typedef typename MatrixType::format Format;
+
+    Format format;
+
+    return partial_distance2_coloring(thrust::detail::derived_cast(exec), A, colors, format);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
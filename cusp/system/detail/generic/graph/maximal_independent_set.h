@@ -25,6 +25,12 @@
 
 #include <cusp/detail/execution_policy.h>
 
+#include <thrust/count.h>
+#include <thrust/for_each.h>
+#include <thrust/iterator/counting_iterator.h>
+
+#include <algorithm>
+
 namespace cusp
 {
 namespace system
@@ -69,7 +75,7 @@ template <typename DerivedPolicy,
           typename Array2,
           typename Array3,
           typename Array4>
-void compute_mis_states(thrust::execution_policy<DerivedPolicy>& exec,
+size_t compute_mis_states(thrust::execution_policy<DerivedPolicy>& exec,
                         const size_t k,
                         const Array1& row_indices,
                         const Array2& column_indices,
@@ -125,9 +131,12 @@ void compute_mis_states(thrust::execution_policy<DerivedPolicy>& exec,
     ArrayType2 z(z_iter, z_iter + N);
 
     size_t active_nodes = N;
+    size_t num_rounds = 0;
 
     do
     {
+        num_rounds++;
+
         // find the largest (state,value,index) 1-ring neighbor for each node
         cusp::generalized_spmv(exec, A, x, x, z, thrust::project2nd<Tuple1,Tuple2>(), thrust::maximum<Tuple2>());
 
@@ -162,6 +171,202 @@ void compute_mis_states(thrust::execution_policy<DerivedPolicy>& exec,
         active_nodes = thrust::count(exec, states.begin(), states.end(), 1);
 
     } while (active_nodes > 0);
+
+    return num_rounds;
+}
+
+// (state, priority, index) of a node, ordered lexicographically
+template <typename IndexType>
+struct mis_key
+{
+    unsigned char state;
+    unsigned int  priority;
+    IndexType     index;
+
+    __host__ __device__
+    bool operator<(const mis_key& other) const
+    {
+        if (state != other.state)
+            return state < other.state;
+        if (priority != other.priority)
+            return priority < other.priority;
+        return index < other.index;
+    }
+};
+
+// z[i] = max(x[j]) over i and its neighbors j
+template <typename IndexType>
+struct mis_first_ring
+{
+    const IndexType*     row_offsets;
+    const IndexType*     column_indices;
+    const unsigned char* states;
+    const unsigned int*  priorities;
+    mis_key<IndexType>*  z;
+
+    mis_first_ring(const IndexType* row_offsets, const IndexType* column_indices,
+                   const unsigned char* states, const unsigned int* priorities, mis_key<IndexType>* z)
+        : row_offsets(row_offsets), column_indices(column_indices), states(states), priorities(priorities), z(z) {}
+
+    __host__ __device__
+    mis_key<IndexType> key(const IndexType i) const
+    {
+        mis_key<IndexType> x;
+        x.state    = states[i];
+        x.priority = priorities[i];
+        x.index    = i;
+        return x;
+    }
+
+    __host__ __device__
+    void operator()(const IndexType i) const
+    {
+        mis_key<IndexType> maximum = key(i);
+
+        for (IndexType jj = row_offsets[i]; jj < row_offsets[i + 1]; jj++)
+        {
+            mis_key<IndexType> x = key(column_indices[jj]);
+
+            if (maximum < x)
+                maximum = x;
+        }
+
+        z[i] = maximum;
+    }
+};
+
+// z[i] = max(y[j]) over i and its neighbors j
+template <typename IndexType>
+struct mis_next_ring
+{
+    const IndexType*          row_offsets;
+    const IndexType*          column_indices;
+    const mis_key<IndexType>* y;
+    mis_key<IndexType>*       z;
+
+    mis_next_ring(const IndexType* row_offsets, const IndexType* column_indices,
+                  const mis_key<IndexType>* y, mis_key<IndexType>* z)
+        : row_offsets(row_offsets), column_indices(column_indices), y(y), z(z) {}
+
+    __host__ __device__
+    void operator()(const IndexType i) const
+    {
+        mis_key<IndexType> maximum = y[i];
+
+        for (IndexType jj = row_offsets[i]; jj < row_offsets[i + 1]; jj++)
+        {
+            const mis_key<IndexType>& x = y[column_indices[jj]];
+
+            if (maximum < x)
+                maximum = x;
+        }
+
+        z[i] = maximum;
+    }
+};
+
+// undecided nodes that dominate their k-ring join the MIS
+template <typename IndexType>
+struct mis_select_nodes
+{
+    unsigned char*            states;
+    const mis_key<IndexType>* z;
+
+    mis_select_nodes(unsigned char* states, const mis_key<IndexType>* z)
+        : states(states), z(z) {}
+
+    __host__ __device__
+    void operator()(const IndexType i) const
+    {
+        if (states[i] == 1 && z[i].index == i)
+            states[i] = 2;
+    }
+};
+
+// undecided nodes whose k-ring contains an MIS node leave the set
+template <typename IndexType>
+struct mis_remove_nodes
+{
+    unsigned char*            states;
+    const mis_key<IndexType>* z;
+
+    mis_remove_nodes(unsigned char* states, const mis_key<IndexType>* z)
+        : states(states), z(z) {}
+
+    __host__ __device__
+    void operator()(const IndexType i) const
+    {
+        if (states[i] == 1 && z[i].state == 2)
+            states[i] = 0;
+    }
+};
+
+// Luby-style MIS(k) of a CSR graph in the formulation of Bell, Dalton and
+// Olson: every round each undecided node finds the largest (state,
+// priority, index) key within distance k, nodes that hold their own key
+// join the set and undecided nodes that see a set node leave it. The
+// priorities are a hash of the node index, so the result does not depend
+// on the number of threads.
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t luby_maximal_independent_set(thrust::execution_policy<DerivedPolicy>& exec,
+                                    const MatrixType& G,
+                                          ArrayType& stencil,
+                                    const size_t k,
+                                          size_t& num_rounds)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef mis_key<IndexType>              KeyType;
+
+    const IndexType N = G.num_rows;
+
+    cusp::detail::temporary_array<unsigned int, DerivedPolicy> priorities(exec, N);
+    cusp::copy(exec, cusp::random_array<unsigned int>(N), priorities);
+
+    cusp::detail::temporary_array<unsigned char, DerivedPolicy> states(exec, N, (unsigned char)(1));
+    cusp::detail::temporary_array<KeyType, DerivedPolicy> y(exec, N);
+    cusp::detail::temporary_array<KeyType, DerivedPolicy> z(exec, N);
+
+    const IndexType* row_offsets    = thrust::raw_pointer_cast(&G.row_offsets[0]);
+    const IndexType* column_indices = G.num_entries == 0 ? NULL : thrust::raw_pointer_cast(&G.column_indices[0]);
+
+    unsigned char* states_ptr     = N == 0 ? NULL : thrust::raw_pointer_cast(&states[0]);
+    unsigned int*  priorities_ptr = N == 0 ? NULL : thrust::raw_pointer_cast(&priorities[0]);
+    KeyType*       y_ptr          = N == 0 ? NULL : thrust::raw_pointer_cast(&y[0]);
+    KeyType*       z_ptr          = N == 0 ? NULL : thrust::raw_pointer_cast(&z[0]);
+
+    thrust::counting_iterator<IndexType> first(0);
+    thrust::counting_iterator<IndexType> last(N);
+
+    num_rounds = 0;
+
+    while (thrust::count(exec, states.begin(), states.end(), (unsigned char)(1)) > 0)
+    {
+        num_rounds++;
+
+        // largest key within distance k of each node
+        thrust::for_each(exec, first, last,
+                         mis_first_ring<IndexType>(row_offsets, column_indices, states_ptr, priorities_ptr, z_ptr));
+
+        for (size_t ring = 1; ring < k; ring++)
+        {
+            std::swap(y_ptr, z_ptr);
+            thrust::for_each(exec, first, last, mis_next_ring<IndexType>(row_offsets, column_indices, y_ptr, z_ptr));
+        }
+
+        thrust::for_each(exec, first, last, mis_select_nodes<IndexType>(states_ptr, z_ptr));
+        thrust::for_each(exec, first, last, mis_remove_nodes<IndexType>(states_ptr, z_ptr));
+    }
+
+    // mark all mis nodes
+    stencil.resize(N);
+
+    thrust::transform(exec, states.begin(), states.end(),
+                      thrust::constant_iterator<unsigned char>(2),
+                      stencil.begin(), thrust::equal_to<unsigned char>());
+
+    return thrust::count(exec, stencil.begin(), stencil.end(), typename ArrayType::value_type(true));
 }
 
 } // end namespace detail
@@ -173,6 +378,7 @@ size_t maximal_independent_set(thrust::execution_policy<DerivedPolicy>& exec,
                                const MatrixType& G,
                                      ArrayType& stencil,
                                const size_t k,
+                                     size_t& num_rounds,
                                cusp::coo_format)
 {
     typedef typename MatrixType::index_type   IndexType;
@@ -185,7 +391,7 @@ size_t maximal_independent_set(thrust::execution_policy<DerivedPolicy>& exec,
     cusp::copy(exec, cusp::random_array<RandomType>(N), random_values);
 
     cusp::detail::temporary_array<NodeStateType, DerivedPolicy> states(exec, N, NodeStateType(1));
-    detail::compute_mis_states(exec, k, G.row_indices, G.column_indices, random_values, states);
+    num_rounds = detail::compute_mis_states(exec, k, G.row_indices, G.column_indices, random_values, states);
 
     // resize output
     stencil.resize(N);
@@ -206,6 +412,7 @@ size_t maximal_independent_set(thrust::execution_policy<DerivedPolicy>& exec,
                                const MatrixType& G,
                                      ArrayType& stencil,
                                const size_t k,
+                                     size_t& num_rounds,
                                cusp::csr_format)
 {
     typedef typename MatrixType::index_type                             IndexType;
@@ -223,7 +430,7 @@ size_t maximal_independent_set(thrust::execution_policy<DerivedPolicy>& exec,
                                                          cusp::make_array1d_view(G.column_indices),
                                                          cusp::make_array1d_view(G.values));
 
-    return cusp::graph::maximal_independent_set(exec, G_coo, stencil, k);
+    return cusp::graph::maximal_independent_set(exec, G_coo, stencil, k, num_rounds);
 }
 
 template <typename DerivedPolicy,
@@ -233,13 +440,14 @@ size_t maximal_independent_set(thrust::execution_policy<DerivedPolicy>& exec,
                                const MatrixType& G,
                                      ArrayType& stencil,
                                const size_t k,
+                                     size_t& num_rounds,
                                cusp::known_format)
 {
     typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
 
     CsrMatrix G_csr(G);
 
-    return cusp::graph::maximal_independent_set(exec, G_csr, stencil, k);
+    return cusp::graph::maximal_independent_set(exec, G_csr, stencil, k, num_rounds);
 }
 
 template <typename DerivedPolicy,
@@ -248,13 +456,15 @@ template <typename DerivedPolicy,
 size_t maximal_independent_set(thrust::execution_policy<DerivedPolicy>& exec,
                                const MatrixType& G,
                                      ArrayType& stencil,
-                               const size_t k)
+                               const size_t k,
+                                     size_t& num_rounds)
 {
     if(G.num_rows != G.num_cols)
         throw cusp::invalid_input_exception("matrix must be square");
 
     if (k == 0)
     {
+        num_rounds = 0;
         stencil.resize(G.num_rows);
         thrust::fill(exec, stencil.begin(), stencil.end(), typename ArrayType::value_type(1));
         return stencil.size();
@@ -262,10 +472,23 @@ size_t maximal_independent_set(thrust::execution_policy<DerivedPolicy>& exec,
     else
     {
         typename MatrixType::format format;
-        return maximal_independent_set(thrust::detail::derived_cast(exec), G, stencil, k, format);
+        return maximal_independent_set(thrust::detail::derived_cast(exec), G, stencil, k, num_rounds, format);
     }
 }
 
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename ArrayType>
+size_t maximal_independent_set(thrust::execution_policy<DerivedPolicy>& exec,
+                               const MatrixType& G,
+                                     ArrayType& stencil,
+                               const size_t k)
+{
+    size_t num_rounds;
+
+    return maximal_independent_set(exec, G, stencil, k, num_rounds);
+}
+
 } // end namespace generic
 } // end namespace detail
 } // end namespace system
@@ -0,0 +1,272 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/exception.h>
+#include <cusp/format_utils.h>
+#include <cusp/graph/multi_source_bfs.h>
+
+#include <cusp/detail/execution_policy.h>
+#include <cusp/detail/temporary_array.h>
+#include <cusp/detail/type_traits.h>
+
+#include <thrust/copy.h>
+#include <thrust/extrema.h>
+#include <thrust/fill.h>
+#include <thrust/functional.h>
+#include <thrust/reduce.h>
+#include <thrust/scatter.h>
+#include <thrust/transform.h>
+
+#include <thrust/iterator/counting_iterator.h>
+#include <thrust/iterator/permutation_iterator.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+
+// mask of newly reached sources, x & ~y
+template <typename MaskType>
+struct msbfs_and_not
+{
+    __host__ __device__
+    MaskType operator()(const MaskType x, const MaskType y) const
+    {
+        return x & ~y;
+    }
+};
+
+// sources that advanced this level replace their last level
+template <typename MaskType>
+struct msbfs_update_last
+{
+    const MaskType advanced;
+
+    msbfs_update_last(const MaskType advanced) : advanced(advanced) {}
+
+    __host__ __device__
+    MaskType operator()(const MaskType last, const MaskType next) const
+    {
+        return (last & ~advanced) | next;
+    }
+};
+
+// degree of the vertices in the last level of a source, the largest
+// IndexType otherwise, which no real degree reaches
+template <typename IndexType, typename MaskType>
+struct msbfs_last_level_degree
+{
+    const int bit;
+    const IndexType none;
+
+    msbfs_last_level_degree(const int bit)
+        : bit(bit), none(std::numeric_limits<IndexType>::max()) {}
+
+    __host__ __device__
+    IndexType operator()(const MaskType last, const IndexType degree) const
+    {
+        return ((last >> bit) & MaskType(1)) ? degree : none;
+    }
+};
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType1,
+         typename ArrayType2,
+         typename ArrayType3>
+void multi_source_bfs(thrust::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType1& sources,
+                            ArrayType2& eccentricities,
+                            ArrayType3& farthest,
+                      cusp::csr_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef unsigned long long              MaskType;
+
+    const IndexType N = G.num_rows;
+    const size_t num_sources = sources.size();
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    if(eccentricities.size() < num_sources || farthest.size() < num_sources)
+        throw cusp::invalid_input_exception("output arrays must have one entry per source");
+
+    if(num_sources == 0)
+        return;
+
+    cusp::array1d<IndexType, cusp::host_memory> sources_h(sources);
+    cusp::array1d<IndexType, cusp::host_memory> eccentricities_h(num_sources, 0);
+    cusp::array1d<IndexType, cusp::host_memory> farthest_h(num_sources);
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_indices(exec, G.num_entries);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> degrees(exec, N);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> costs(exec, N);
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> keys(exec, N);
+    cusp::detail::temporary_array<MaskType, DerivedPolicy> masks(exec, N);
+
+    // per-vertex masks of the sources that reached the vertex, reached it
+    // in the last level, reach it in the next level and reached it last
+    cusp::detail::temporary_array<MaskType, DerivedPolicy> seen(exec, N);
+    cusp::detail::temporary_array<MaskType, DerivedPolicy> visit(exec, N);
+    cusp::detail::temporary_array<MaskType, DerivedPolicy> next(exec, N);
+    cusp::detail::temporary_array<MaskType, DerivedPolicy> last(exec, N);
+
+    cusp::offsets_to_indices(exec, G.row_offsets, row_indices);
+
+    thrust::transform(exec,
+                      G.row_offsets.begin() + 1, G.row_offsets.end(),
+                      G.row_offsets.begin(), degrees.begin(),
+                      thrust::minus<IndexType>());
+
+    for(size_t batch = 0; batch < num_sources; batch += 64)
+    {
+        const int batch_size = std::min(num_sources - batch, size_t(64));
+
+        thrust::fill(exec, visit.begin(), visit.end(), MaskType(0));
+
+        for(int b = 0; b < batch_size; b++)
+        {
+            const IndexType v = sources_h[batch + b];
+
+            if(v < 0 || v >= N)
+                throw cusp::invalid_input_exception("source vertex out of range");
+
+            visit[v] = MaskType(visit[v]) | (MaskType(1) << b);
+        }
+
+        thrust::copy(exec, visit.begin(), visit.end(), seen.begin());
+        thrust::copy(exec, visit.begin(), visit.end(), last.begin());
+
+        for(IndexType level = 1; ; level++)
+        {
+            // next[i] = OR of visit[j] over the neighbors j of i, pulled by
+            // every vertex so that no atomics are needed
+            thrust::fill(exec, next.begin(), next.end(), MaskType(0));
+
+            const size_t num_keys =
+                thrust::reduce_by_key(exec,
+                                      row_indices.begin(), row_indices.end(),
+                                      thrust::make_permutation_iterator(visit.begin(), G.column_indices.begin()),
+                                      keys.begin(),
+                                      masks.begin(),
+                                      thrust::equal_to<IndexType>(),
+                                      thrust::bit_or<MaskType>()).first - keys.begin();
+
+            thrust::scatter(exec, masks.begin(), masks.begin() + num_keys, keys.begin(), next.begin());
+
+            thrust::transform(exec, next.begin(), next.end(), seen.begin(), next.begin(), msbfs_and_not<MaskType>());
+
+            const MaskType advanced = thrust::reduce(exec, next.begin(), next.end(), MaskType(0), thrust::bit_or<MaskType>());
+
+            if(advanced == 0)
+                break;
+
+            for(int b = 0; b < batch_size; b++)
+                if((advanced >> b) & MaskType(1))
+                    eccentricities_h[batch + b] = level;
+
+            thrust::transform(exec, seen.begin(), seen.end(), next.begin(), seen.begin(), thrust::bit_or<MaskType>());
+            thrust::transform(exec, last.begin(), last.end(), next.begin(), last.begin(), msbfs_update_last<MaskType>(advanced));
+
+            visit.swap(next);
+        }
+
+        // the vertex of smallest degree, then smallest index, in the last level
+        for(int b = 0; b < batch_size; b++)
+        {
+            thrust::transform(exec, last.begin(), last.end(), degrees.begin(), costs.begin(),
+                              msbfs_last_level_degree<IndexType,MaskType>(b));
+
+            farthest_h[batch + b] = thrust::min_element(exec, costs.begin(), costs.end()) - costs.begin();
+        }
+    }
+
+    thrust::copy(eccentricities_h.begin(), eccentricities_h.end(), eccentricities.begin());
+    thrust::copy(farthest_h.begin(), farthest_h.end(), farthest.begin());
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType1,
+         typename ArrayType2,
+         typename ArrayType3>
+void multi_source_bfs(thrust::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType1& sources,
+                            ArrayType2& eccentricities,
+                            ArrayType3& farthest,
+                      cusp::known_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix G_csr(G);
+
+    cusp::graph::multi_source_bfs(exec, G_csr, sources, eccentricities, farthest);
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType1,
+         typename ArrayType2,
+         typename ArrayType3>
+void multi_source_bfs(thrust::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType1& sources,
+                            ArrayType2& eccentricities,
+                            ArrayType3& farthest)
+{
+    typedef typename MatrixType::format Format;
+
+    Format format;
+
+    multi_source_bfs(thrust::detail::derived_cast(exec), G, sources, eccentricities, farthest, format);
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType1,
+         typename ArrayType2>
+void multi_source_bfs(thrust::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType1& sources,
+                            ArrayType2& eccentricities)
+{
+    typedef typename MatrixType::index_type IndexType;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> farthest(exec, sources.size());
+
+    cusp::graph::multi_source_bfs(exec, G, sources, eccentricities, farthest);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/exception.h>
+#include <cusp/graph/multilevel_partition.h>
+
+#include <cusp/detail/execution_policy.h>
+#include <cusp/detail/type_traits.h>
+#include <cusp/graph/detail/multilevel.h>
+
+#include <thrust/copy.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+void multilevel_partition(thrust::execution_policy<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                          const size_t num_parts,
+                                ArrayType& parts,
+                          cusp::csr_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    if(num_parts == 0)
+        throw cusp::invalid_input_exception("number of parts must be positive");
+
+    // the multilevel scheme runs on the host
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> G_host(G);
+
+    cusp::graph::detail::weighted_graph<IndexType> W;
+    cusp::graph::detail::build_weighted_graph(G_host, W);
+
+    cusp::array1d<IndexType,cusp::host_memory> parts_host;
+    cusp::graph::detail::multilevel_kway(W, IndexType(num_parts), parts_host);
+
+    thrust::copy(parts_host.begin(), parts_host.end(), parts.begin());
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+void multilevel_partition(thrust::execution_policy<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                          const size_t num_parts,
+                                ArrayType& parts,
+                          cusp::known_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix G_csr(G);
+
+    cusp::graph::multilevel_partition(exec, G_csr, num_parts, parts);
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+void multilevel_partition(thrust::execution_policy<DerivedPolicy>& exec,
+                          const MatrixType& G,
+                          const size_t num_parts,
+                                ArrayType& parts)
+{
+    typedef typename MatrixType::format Format;
+
+    Format format;
+
+    multilevel_partition(thrust::detail::derived_cast(exec), G, num_parts, parts, format);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
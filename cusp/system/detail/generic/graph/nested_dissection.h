@@ -0,0 +1,118 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/exception.h>
+#include <cusp/graph/nested_dissection.h>
+
+#include <cusp/detail/execution_policy.h>
+#include <cusp/detail/type_traits.h>
+#include <cusp/graph/detail/multilevel.h>
+
+#include <thrust/copy.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace generic
+{
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename PermutationType>
+void nested_dissection(thrust::execution_policy<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                             PermutationType& P,
+                       cusp::csr_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef typename MatrixType::value_type ValueType;
+
+    // subgraphs of at most this many vertices keep their order
+    const IndexType leaf_size = 64;
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    assert(P.num_rows == G.num_rows);
+
+    const IndexType N = G.num_rows;
+
+    // the multilevel scheme runs on the host
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> G_host(G);
+
+    cusp::graph::detail::weighted_graph<IndexType> W;
+    cusp::graph::detail::build_weighted_graph(G_host, W);
+
+    cusp::array1d<IndexType,cusp::host_memory> vertices(N);
+    cusp::array1d<IndexType,cusp::host_memory> order;
+
+    for(IndexType i = 0; i < N; i++)
+        vertices[i] = i;
+
+    cusp::graph::detail::nested_dissection_order(W, vertices, leaf_size, order);
+
+    // vertex order[i] becomes vertex i
+    cusp::array1d<IndexType,cusp::host_memory> permutation(N);
+
+    for(IndexType i = 0; i < N; i++)
+        permutation[order[i]] = i;
+
+    thrust::copy(permutation.begin(), permutation.end(), P.permutation.begin());
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename PermutationType>
+void nested_dissection(thrust::execution_policy<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                             PermutationType& P,
+                       cusp::known_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix G_csr(G);
+
+    cusp::graph::nested_dissection(exec, G_csr, P);
+}
+
+template <typename DerivedPolicy,
+          typename MatrixType,
+          typename PermutationType>
+void nested_dissection(thrust::execution_policy<DerivedPolicy>& exec,
+                       const MatrixType& G,
+                             PermutationType& P)
+{
+    typedef typename MatrixType::format Format;
+
+    Format format;
+
+    nested_dissection(thrust::detail::derived_cast(exec), G, P, format);
+}
+
+} // end namespace generic
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
@@ -20,11 +20,18 @@
 #include <cusp/detail/config.h>
 #include <cusp/detail/execution_policy.h>
 #include <cusp/detail/temporary_array.h>
+#include <cusp/detail/type_traits.h>
 
+#include <cusp/array1d.h>
+#include <cusp/exception.h>
 #include <cusp/graph/breadth_first_search.h>
+#include <cusp/graph/multi_source_bfs.h>
 
-#include <thrust/count.h>
 #include <thrust/extrema.h>
+#include <thrust/find.h>
+#include <thrust/functional.h>
+#include <thrust/random.h>
+#include <thrust/transform.h>
 
 namespace cusp
 {
@@ -42,6 +49,7 @@ typename MatrixType::index_type
 pseudo_peripheral_vertex(thrust::execution_policy<DerivedPolicy>& exec,
                          const MatrixType& G,
                                ArrayType& levels,
+                         const unsigned int seed,
                          cusp::csr_format)
 {
     typedef typename MatrixType::index_type IndexType;
@@ -49,58 +57,69 @@ pseudo_peripheral_vertex(thrust::execution_policy<DerivedPolicy>& exec,
     if(G.num_rows != G.num_cols)
         throw cusp::invalid_input_exception("matrix must be square");
 
-    IndexType delta = 0;
-    IndexType x = rand() % G.num_rows;
-    IndexType y;
+    const IndexType N = G.num_rows;
 
-    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_lengths(exec, G.num_rows);
+    if(N == 0)
+        return 0;
+
+    cusp::detail::temporary_array<IndexType, DerivedPolicy> row_lengths(exec, N);
     thrust::transform(exec,
                       G.row_offsets.begin() + 1, G.row_offsets.end(),
                       G.row_offsets.begin(), row_lengths.begin(),
                       thrust::minus<IndexType>());
 
+    // start from the vertex of smallest degree and up to 63 vertices drawn
+    // from a generator seeded with seed
+    cusp::array1d<IndexType, cusp::host_memory> sources;
+    sources.push_back(thrust::min_element(exec, row_lengths.begin(), row_lengths.end()) - row_lengths.begin());
+
+    thrust::default_random_engine rng(seed);
+    thrust::uniform_int_distribution<IndexType> dist(0, N - 1);
+
+    for(int i = 0; i < 63 && IndexType(sources.size()) < N; i++)
+    {
+        const IndexType v = dist(rng);
+
+        if(thrust::find(sources.begin(), sources.end(), v) == sources.end())
+            sources.push_back(v);
+    }
+
+    cusp::array1d<IndexType, cusp::host_memory> eccentricities;
+    cusp::array1d<IndexType, cusp::host_memory> farthest;
+
+    IndexType x = sources[0];
+    IndexType delta = -1;
+
+    // every sweep traverses from all candidates at once, the farthest
+    // vertices of the most eccentric candidates become the next candidates
     while(1)
     {
-        cusp::graph::breadth_first_search(exec, G, x, levels);
-
-        typename ArrayType::iterator max_level_iter = thrust::max_element(exec, levels.begin(), levels.end());
-        int max_level = *max_level_iter;
-        int max_count = thrust::count(exec, levels.begin(), levels.end(), max_level);
-
-        if( max_count > 1 )
-        {
-            cusp::detail::temporary_array<IndexType, DerivedPolicy> max_level_vertices(exec, max_count);
-            cusp::detail::temporary_array<IndexType, DerivedPolicy> max_level_valence(exec, max_count);
-
-            thrust::copy_if(exec,
-                            thrust::counting_iterator<IndexType>(0),
-                            thrust::counting_iterator<IndexType>(G.num_rows),
-                            levels.begin(),
-                            max_level_vertices.begin(),
-                            thrust::placeholders::_1 == max_level);
-
-            thrust::gather(exec,
-                           thrust::counting_iterator<IndexType>(0),
-                           thrust::counting_iterator<IndexType>(max_count),
-                           row_lengths.begin(),
-                           max_level_valence.begin());
-
-            int min_valence_pos = thrust::min_element(exec, max_level_valence.begin(), max_level_valence.end()) - max_level_valence.begin();
-
-            y = max_level_vertices[min_valence_pos];
-        }
-        else
-        {
-            y = max_level_iter - levels.begin();
-        }
-
-        if( levels[y] <= delta ) break;
-
-        x = y;
-        delta = levels[y];
+        eccentricities.resize(sources.size());
+        farthest.resize(sources.size());
+
+        cusp::graph::multi_source_bfs(exec, G, sources, eccentricities, farthest);
+
+        const size_t best = thrust::max_element(eccentricities.begin(), eccentricities.end()) - eccentricities.begin();
+
+        if(eccentricities[best] <= delta)
+            break;
+
+        x = sources[best];
+        delta = eccentricities[best];
+
+        cusp::array1d<IndexType, cusp::host_memory> candidates;
+
+        for(size_t i = 0; i < sources.size(); i++)
+            if(eccentricities[i] == delta &&
+               thrust::find(candidates.begin(), candidates.end(), farthest[i]) == candidates.end())
+                candidates.push_back(farthest[i]);
+
+        sources.swap(candidates);
     }
 
-    return y;
+    cusp::graph::breadth_first_search(exec, G, x, levels);
+
+    return x;
 }
 
 template<typename DerivedPolicy,
@@ -109,13 +128,31 @@ template<typename DerivedPolicy,
 typename MatrixType::index_type
 pseudo_peripheral_vertex(thrust::execution_policy<DerivedPolicy>& exec,
                          const MatrixType& G,
-                               ArrayType& levels)
+                               ArrayType& levels,
+                         const unsigned int seed,
+                         cusp::known_format)
+{
+    typedef typename cusp::detail::as_csr_type<MatrixType>::type CsrMatrix;
+
+    CsrMatrix G_csr(G);
+
+    return cusp::graph::pseudo_peripheral_vertex(exec, G_csr, levels, seed);
+}
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType>
+typename MatrixType::index_type
+pseudo_peripheral_vertex(thrust::execution_policy<DerivedPolicy>& exec,
+                         const MatrixType& G,
+                               ArrayType& levels,
+                         const unsigned int seed)
 {
     typedef typename MatrixType::format Format;
 
     Format format;
 
-    return pseudo_peripheral_vertex(thrust::detail::derived_cast(exec), G, levels, format);
+    return pseudo_peripheral_vertex(thrust::detail::derived_cast(exec), G, levels, seed, format);
 }
 
 template<typename DerivedPolicy,
@@ -61,6 +61,7 @@ size_t maximal_independent_set(thrust::cpp::execution_policy<DerivedPolicy>& exe
                                const MatrixType& G,
                                ArrayType& stencil,
                                const size_t k,
+                               size_t& num_rounds,
                                cusp::csr_format)
 {
     typedef typename MatrixType::index_type IndexType;
@@ -85,6 +86,9 @@ size_t maximal_independent_set(thrust::cpp::execution_policy<DerivedPolicy>& exe
         }
     }
 
+    // the greedy selection is a single pass over the nodes
+    num_rounds = N > 0 ? 1 : 0;
+
     // write output
     stencil.resize(N);
 
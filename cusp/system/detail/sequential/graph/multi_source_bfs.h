@@ -0,0 +1,153 @@
+/*
+ *  Copyright 2008-2014 NVIDIA Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+#include <cusp/detail/temporary_array.h>
+
+#include <cusp/array1d.h>
+#include <cusp/exception.h>
+
+#include <cusp/system/detail/sequential/execution_policy.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace cusp
+{
+namespace system
+{
+namespace detail
+{
+namespace sequential
+{
+
+template<typename DerivedPolicy,
+         typename MatrixType,
+         typename ArrayType1,
+         typename ArrayType2,
+         typename ArrayType3>
+void multi_source_bfs(thrust::cpp::execution_policy<DerivedPolicy>& exec,
+                      const MatrixType& G,
+                      const ArrayType1& sources,
+                            ArrayType2& eccentricities,
+                            ArrayType3& farthest,
+                      cusp::csr_format)
+{
+    typedef typename MatrixType::index_type IndexType;
+    typedef unsigned long long              MaskType;
+
+    const IndexType N = G.num_rows;
+    const size_t num_sources = sources.size();
+
+    if(G.num_rows != G.num_cols)
+        throw cusp::invalid_input_exception("matrix must be square");
+
+    if(eccentricities.size() < num_sources || farthest.size() < num_sources)
+        throw cusp::invalid_input_exception("output arrays must have one entry per source");
+
+    // per-vertex masks of the sources that reached the vertex, reached it
+    // in the last level, reach it in the next level and reached it last
+    cusp::detail::temporary_array<MaskType, DerivedPolicy> seen(exec, N);
+    cusp::detail::temporary_array<MaskType, DerivedPolicy> visit(exec, N);
+    cusp::detail::temporary_array<MaskType, DerivedPolicy> next(exec, N);
+    cusp::detail::temporary_array<MaskType, DerivedPolicy> last(exec, N);
+
+    for(size_t batch = 0; batch < num_sources; batch += 64)
+    {
+        const int batch_size = std::min(num_sources - batch, size_t(64));
+
+        for(IndexType i = 0; i < N; i++)
+            visit[i] = 0;
+
+        for(int b = 0; b < batch_size; b++)
+        {
+            const IndexType v = sources[batch + b];
+
+            if(v < 0 || v >= N)
+                throw cusp::invalid_input_exception("source vertex out of range");
+
+            visit[v] |= MaskType(1) << b;
+            eccentricities[batch + b] = 0;
+        }
+
+        for(IndexType i = 0; i < N; i++)
+            seen[i] = last[i] = visit[i];
+
+        for(IndexType level = 1; ; level++)
+        {
+            MaskType advanced = 0;
+
+            // every vertex pulls the masks of its neighbors
+            for(IndexType i = 0; i < N; i++)
+            {
+                MaskType mask = 0;
+
+                for(IndexType jj = G.row_offsets[i]; jj < G.row_offsets[i + 1]; jj++)
+                    mask |= visit[G.column_indices[jj]];
+
+                next[i] = mask & ~seen[i];
+                advanced |= next[i];
+            }
+
+            if(advanced == 0)
+                break;
+
+            for(int b = 0; b < batch_size; b++)
+                if((advanced >> b) & MaskType(1))
+                    eccentricities[batch + b] = level;
+
+            for(IndexType i = 0; i < N; i++)
+            {
+                seen[i] |= next[i];
+                last[i] = (last[i] & ~advanced) | next[i];
+            }
+
+            visit.swap(next);
+        }
+
+        // the vertex of smallest degree, then smallest index, in the last level
+        IndexType best_degree[64];
+
+        for(int b = 0; b < batch_size; b++)
+            best_degree[b] = std::numeric_limits<IndexType>::max();
+
+        for(IndexType i = 0; i < N; i++)
+        {
+            if(last[i] == 0)
+                continue;
+
+            const IndexType degree = G.row_offsets[i + 1] - G.row_offsets[i];
+
+            for(int b = 0; b < batch_size; b++)
+            {
+                if(((last[i] >> b) & MaskType(1)) && degree < best_degree[b])
+                {
+                    best_degree[b] = degree;
+                    farthest[batch + b] = i;
+                }
+            }
+        }
+    }
+}
+
+} // end namespace sequential
+} // end namespace detail
+} // end namespace system
+} // end namespace cusp
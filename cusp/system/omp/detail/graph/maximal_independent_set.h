@@ -17,7 +17,10 @@
 #pragma once
 
 #include <cusp/detail/config.h>
-#include <cusp/system/cpp/detail/graph/maximal_independent_set.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/omp/detail/execution_policy.h>
+#include <cusp/system/detail/generic/graph/maximal_independent_set.h>
 
 namespace cusp
 {
@@ -28,7 +31,19 @@ namespace omp
 namespace detail
 {
 
-using cusp::system::detail::sequential::maximal_independent_set;
+// replaces the sequential greedy MIS(k) with the parallel Luby-style rounds
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t maximal_independent_set(omp::execution_policy<DerivedPolicy>& exec,
+                               const MatrixType& G,
+                               ArrayType& stencil,
+                               const size_t k,
+                               size_t& num_rounds,
+                               cusp::csr_format)
+{
+    using cusp::system::detail::generic::detail::luby_maximal_independent_set;
+
+    return luby_maximal_independent_set(exec, G, stencil, k, num_rounds);
+}
 
 } // end namespace detail
 } // end namespace omp
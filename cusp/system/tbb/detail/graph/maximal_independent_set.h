@@ -17,5 +17,36 @@
 #pragma once
 
 #include <cusp/detail/config.h>
+#include <cusp/detail/format.h>
+
+#include <cusp/system/tbb/detail/execution_policy.h>
+#include <cusp/system/detail/generic/graph/maximal_independent_set.h>
+
+namespace cusp
+{
+namespace system
+{
+namespace tbb
+{
+namespace detail
+{
+
+// replaces the sequential greedy MIS(k) with the parallel Luby-style rounds
+template <typename DerivedPolicy, typename MatrixType, typename ArrayType>
+size_t maximal_independent_set(tbb::execution_policy<DerivedPolicy>& exec,
+                               const MatrixType& G,
+                               ArrayType& stencil,
+                               const size_t k,
+                               size_t& num_rounds,
+                               cusp::csr_format)
+{
+    using cusp::system::detail::generic::detail::luby_maximal_independent_set;
+
+    return luby_maximal_independent_set(exec, G, stencil, k, num_rounds);
+}
+
+} // end namespace detail
+} // end namespace tbb
+} // end namespace system
+} // end namespace cusp
 
-// this system has no special version of this algorithm
@@ -0,0 +1,146 @@
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/cg.h>
+#include <cusp/krylov/gmres.h>
+#include <cusp/mpi/distributed_csr_matrix.h>
+
+#include <cmath>
+#include <iostream>
+
+// which floating point type to use
+typedef double ValueType;
+
+typedef cusp::csr_matrix<int, ValueType, cusp::host_memory>           Matrix;
+typedef cusp::array1d<ValueType, cusp::host_memory>                   Vector;
+typedef cusp::array1d<ValueType, cusp::mpi::distributed_memory>       DistributedVector;
+
+// gather the local parts of a distributed vector on every process
+Vector gather(const cusp::mpi::distributed_csr_matrix<int, ValueType>& A, const DistributedVector& x)
+{
+    int num_procs;
+    MPI_Comm_size(A.comm, &num_procs);
+
+    std::vector<int> counts(num_procs), displs(num_procs);
+
+    for (int p = 0; p < num_procs; p++)
+    {
+        counts[p] = A.row_partition[p + 1] - A.row_partition[p];
+        displs[p] = A.row_partition[p];
+    }
+
+    Vector global(A.global_num_rows);
+
+    MPI_Allgatherv(const_cast<ValueType*>(&x[0]), A.num_rows, MPI_DOUBLE,
+                   &global[0], &counts[0], &displs[0], MPI_DOUBLE, A.comm);
+
+    return global;
+}
+
+// relative residual |b - A x| / |b| of the global system
+ValueType relative_residual(const Matrix& G, const Vector& x, const Vector& b)
+{
+    Vector r(G.num_rows);
+    cusp::multiply(G, x, r);
+    cusp::blas::axpby(b, r, r, ValueType(1), ValueType(-1));
+
+    return cusp::blas::nrm2(r) / cusp::blas::nrm2(b);
+}
+
+int main(int argc, char** argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int rank, num_procs;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+
+    // every process creates the global 2d Poisson problem on a 64x64 mesh
+    // and keeps a contiguous block of its rows
+    Matrix G;
+    cusp::gallery::poisson5pt(G, 64, 64);
+
+    const int first = (G.num_rows * rank) / num_procs;
+    const int last  = (G.num_rows * (rank + 1)) / num_procs;
+
+    Matrix rows(last - first, G.num_cols, G.row_offsets[last] - G.row_offsets[first]);
+
+    for (int i = first; i <= last; i++)
+        rows.row_offsets[i - first] = G.row_offsets[i] - G.row_offsets[first];
+
+    for (int jj = G.row_offsets[first]; jj < G.row_offsets[last]; jj++)
+    {
+        rows.column_indices[jj - G.row_offsets[first]] = G.column_indices[jj];
+        rows.values[jj - G.row_offsets[first]]         = G.values[jj];
+    }
+
+    // distributed matrix with halo exchange between neighbouring blocks
+    cusp::mpi::distributed_csr_matrix<int, ValueType> A(MPI_COMM_WORLD, rows);
+
+    bool passed = true;
+
+    // check the distributed multiply against the global one
+    {
+        DistributedVector x(A.num_rows);
+        DistributedVector y(A.num_rows);
+
+        for (size_t i = 0; i < A.num_rows; i++)
+            x[i] = std::sin(ValueType(first + i));
+
+        cusp::multiply(A, x, y);
+
+        Vector y_global(G.num_rows);
+        cusp::multiply(G, gather(A, x), y_global);
+
+        Vector y_dist = gather(A, y);
+
+        for (size_t i = 0; i < G.num_rows; i++)
+            passed = passed && std::abs(y_dist[i] - y_global[i]) < 1e-12;
+    }
+
+    DistributedVector b(A.num_rows, ValueType(1));
+    Vector b_global(G.num_rows, ValueType(1));
+
+    // solve the linear system A * x = b with CG, the monitor and the solver
+    // use global inner products and norms
+    {
+        DistributedVector x(A.num_rows, ValueType(0));
+        cusp::monitor<ValueType> monitor(b, 1000, 1e-8);
+
+        cusp::krylov::cg(A, x, b, monitor);
+
+        const ValueType residual = relative_residual(G, gather(A, x), b_global);
+        passed = passed && monitor.converged() && residual < 1e-7;
+
+        if (rank == 0)
+            std::cout << "CG converged in " << monitor.iteration_count()
+                      << " iterations with relative residual " << residual << std::endl;
+    }
+
+    // and with restarted GMRES
+    {
+        DistributedVector x(A.num_rows, ValueType(0));
+        cusp::monitor<ValueType> monitor(b, 1000, 1e-8);
+
+        cusp::krylov::gmres(A, x, b, 50, monitor);
+
+        const ValueType residual = relative_residual(G, gather(A, x), b_global);
+        passed = passed && monitor.converged() && residual < 1e-7;
+
+        if (rank == 0)
+            std::cout << "GMRES converged in " << monitor.iteration_count()
+                      << " iterations with relative residual " << residual << std::endl;
+    }
+
+    int all_passed = passed;
+    MPI_Allreduce(MPI_IN_PLACE, &all_passed, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+
+    if (rank == 0)
+        std::cout << (all_passed ? "PASSED" : "FAILED") << " on " << num_procs << " processes" << std::endl;
+
+    MPI_Finalize();
+
+    return all_passed ? 0 : 1;
+}
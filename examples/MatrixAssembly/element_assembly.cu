@@ -0,0 +1,52 @@
+#include <cusp/assembly.h>
+#include <cusp/print.h>
+
+// Assemble a matrix repeatedly from element contributions into a
+// sparsity pattern that is computed once from the element connectivity.
+
+// stiffness matrix of a linear 1D element with length h
+struct element_stiffness
+{
+    float h;
+
+    element_stiffness(float h) : h(h) {}
+
+    void operator()(size_t element, float* block) const
+    {
+        block[0] =  1.0f / h; block[1] = -1.0f / h;
+        block[2] = -1.0f / h; block[3] =  1.0f / h;
+    }
+};
+
+int main(void)
+{
+    // number of elements of the 1D mesh
+    int num_elements = 5;
+    int num_nodes    = num_elements + 1;
+
+    // element e connects nodes e and e + 1
+    cusp::array1d<int, cusp::host_memory> element_offsets(num_elements + 1);
+    cusp::array1d<int, cusp::host_memory> element_indices(2 * num_elements);
+
+    for (int e = 0; e < num_elements; e++)
+    {
+        element_offsets[e] = 2 * e;
+        element_indices[2 * e + 0] = e;
+        element_indices[2 * e + 1] = e + 1;
+    }
+    element_offsets[num_elements] = 2 * num_elements;
+
+    // compute the CSR pattern, element coloring and position caches once
+    cusp::csr_assembler<int, float> assembler(num_nodes, element_offsets, element_indices);
+
+    // every time step only streams over the elements
+    for (int step = 1; step <= 3; step++)
+    {
+        assembler.assemble(element_stiffness(float(step)));
+    }
+
+    // print matrix
+    cusp::print(assembler.matrix);
+
+    return 0;
+}
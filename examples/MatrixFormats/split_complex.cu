@@ -0,0 +1,47 @@
+#include <cusp/complex.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/split_complex.h>
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/gmres.h>
+
+#include <iostream>
+
+// where to perform the computation
+typedef cusp::host_memory MemorySpace;
+
+// which floating point type to use
+typedef cusp::complex<double> ValueType;
+
+int main(void)
+{
+    // create a 2d Poisson problem on a 32x32 mesh
+    cusp::csr_matrix<int, ValueType, MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 32, 32);
+
+    // shift it to a damped Helmholtz operator -L - (k^2 + i) I
+    for (size_t i = 0; i < A.num_rows; i++)
+        for (int jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            if (A.column_indices[jj] == int(i))
+                A.values[jj] -= ValueType(0.1, 1.0);
+
+    // store the real and imaginary parts of the values in separate arrays
+    cusp::split_complex_csr_matrix<int, double, MemorySpace> S(A);
+
+    // the split matrix is a linear operator on interleaved complex vectors
+    cusp::array1d<ValueType, MemorySpace> x(A.num_rows, ValueType(0));
+    cusp::array1d<ValueType, MemorySpace> b(A.num_rows, ValueType(1));
+
+    cusp::monitor<double> monitor(b, 1000, 1e-8, 0, true);
+    cusp::krylov::gmres(S, x, b, 50, monitor);
+
+    // split vectors work with the level-1 BLAS and multiply
+    cusp::split_complex_array1d<double, MemorySpace> xs(x);
+    cusp::split_complex_array1d<double, MemorySpace> ys(A.num_rows);
+
+    cusp::multiply(S, xs, ys);
+
+    std::cout << "|A x| = " << cusp::blas::nrm2(ys) << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include <cusp/array2d.h>
+#include <cusp/batched_csr_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/batched.h>
+
+#include <iostream>
+
+// which floating point type to use
+typedef double ValueType;
+
+int main(void)
+{
+    // create a 2d Poisson problem on a 16x16 mesh
+    cusp::csr_matrix<int, ValueType, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 16, 16);
+
+    // store 1000 systems with the sparsity pattern of A
+    const size_t num_systems = 1000;
+    cusp::batched_csr_matrix<int, ValueType, cusp::host_memory> batch(A, num_systems);
+
+    // shift the diagonal of every system by a different amount
+    for (size_t s = 0; s < num_systems; s++)
+    {
+        cusp::array1d<ValueType, cusp::host_memory> values(A.values);
+
+        for (size_t i = 0; i < A.num_rows; i++)
+            for (int jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+                if (A.column_indices[jj] == int(i))
+                    values[jj] += ValueType(s) / ValueType(num_systems);
+
+        batch.set_values(s, values);
+    }
+
+    // one column of solutions and right-hand sides per system
+    cusp::array2d<ValueType, cusp::host_memory> X(A.num_rows, num_systems, ValueType(0));
+    cusp::array2d<ValueType, cusp::host_memory> B(A.num_rows, num_systems, ValueType(1));
+
+    // set stopping criteria of every system:
+    //  iteration_limit    = 100
+    //  relative_tolerance = 1e-6
+    cusp::krylov::batched_monitor<ValueType> monitor(100, 1e-6);
+
+    // solve all systems with Jacobi preconditioned CG
+    cusp::krylov::batched_cg(batch, X, B, monitor, cusp::krylov::batched_jacobi());
+
+    monitor.print();
+
+    std::cout << "system 0 converged in " << monitor.iteration_count(0) << " iterations" << std::endl;
+
+    return 0;
+}
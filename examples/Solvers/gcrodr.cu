@@ -0,0 +1,50 @@
+#include <cusp/copy.h>
+#include <cusp/hyb_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/gcrodr.h>
+
+#include <iostream>
+
+// where to perform the computation
+typedef cusp::device_memory MemorySpace;
+
+// which floating point type to use
+typedef float ValueType;
+
+int main(void)
+{
+    // create an empty sparse matrix structure (HYB format)
+    cusp::hyb_matrix<int, ValueType, MemorySpace> A;
+
+    // create a 2d Poisson problem on a 10x10 mesh
+    cusp::gallery::poisson5pt(A, 10, 10);
+
+    // allocate storage for solution (x) and right hand side (b)
+    cusp::array1d<ValueType, MemorySpace> x(A.num_rows);
+    cusp::array1d<ValueType, MemorySpace> b(A.num_rows);
+
+    // keep up to 10 vectors between the solves
+    cusp::krylov::recycle_space<ValueType, MemorySpace> space(10);
+
+    // solve a sequence of systems with different right hand sides
+    for (int i = 0; i < 4; i++)
+    {
+        cusp::copy(cusp::random_array<ValueType>(A.num_rows, i), b);
+
+        // set initial guess
+        thrust::fill( x.begin(), x.end(), ValueType(0) );
+
+        // set stopping criteria:
+        //  iteration_limit    = 100
+        //  relative_tolerance = 1e-6
+        cusp::monitor<ValueType> monitor(b, 100, 1e-6);
+
+        // solve the linear system A * x = b with search spaces of dimension 30
+        cusp::krylov::gcrodr(A, x, b, 30, space, monitor);
+
+        std::cout << "system " << i << " solved in " << monitor.iteration_count() << " iterations" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/sstep_gmres.h>
+
+// where to perform the computation
+typedef cusp::host_memory MemorySpace;
+
+// which floating point type to use
+typedef double ValueType;
+
+int main(void)
+{
+    // create an empty sparse matrix structure (CSR format)
+    cusp::csr_matrix<int, ValueType, MemorySpace> A;
+
+    // create a 2d Poisson problem on a 200x200 mesh
+    cusp::gallery::poisson5pt(A, 200, 200);
+
+    // allocate storage for solution (x) and right hand side (b)
+    cusp::array1d<ValueType, MemorySpace> x(A.num_rows, ValueType(1));
+    cusp::array1d<ValueType, MemorySpace> b(A.num_rows);
+
+    cusp::multiply(A,x,b);
+
+    // set initial guess
+    thrust::fill( x.begin(), x.end(), ValueType(0) );
+
+    // set stopping criteria:
+    //  iteration_limit    = 2000
+    //  relative_tolerance = 1e-6
+    cusp::monitor<ValueType> monitor(b, 2000, 1e-6, 0, true);
+    int restart = 40;
+    int s = 8;
+    // solve the linear system A * x = b with s-step GMRES,
+    // generating 8 Krylov vectors per pass over the matrix
+    cusp::krylov::sstep_gmres(A, x, b, restart, s, monitor);
+
+    return 0;
+}
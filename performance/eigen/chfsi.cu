@@ -0,0 +1,28 @@
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/eigen/chfsi.h>
+#include <cusp/gallery/poisson.h>
+
+#include "../timer.h"
+
+int main(void)
+{
+    // create an empty sparse matrix structure (CSR format)
+    cusp::csr_matrix<int, double, cusp::device_memory> A;
+    // initialize matrix
+    cusp::gallery::poisson5pt(A, 512, 512);
+    // allocate storage and initialize eigenpairs
+    cusp::array1d<double, cusp::device_memory> S(200,0);
+    cusp::array2d<double, cusp::device_memory, cusp::column_major> X;
+
+    // at most 200 filtered iterations, residuals below 1e-8 * ||A||
+    cusp::array1d<double, cusp::device_memory> b(A.num_rows, 1);
+    cusp::monitor<double> monitor(b, 200, 1e-8, 0, true);
+
+    // Compute the smallest eigenpairs of A with a filter of degree 12
+    timer t;
+    cusp::eigen::chfsi(A, S, X, monitor, false, 12);
+    std::cout << "ChFSI time : " << t.milliseconds_elapsed() << " (ms)" << std::endl;
+    std::cout << "Smallest eigenvalue : " << S[0] << std::endl;
+    return 0;
+}
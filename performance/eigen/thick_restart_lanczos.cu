@@ -0,0 +1,32 @@
+#include <cusp/csr_matrix.h>
+#include <cusp/eigen/lanczos.h>
+#include <cusp/gallery/poisson.h>
+
+#include "../timer.h"
+
+int main(void)
+{
+    // create an empty sparse matrix structure (CSR format)
+    cusp::csr_matrix<int, double, cusp::device_memory> A;
+    // initialize matrix
+    cusp::gallery::poisson5pt(A, 1024, 1024);
+    // allocate storage and initialize eigenpairs
+    cusp::array1d<double, cusp::device_memory> S(200,0);
+    cusp::array2d<double, cusp::device_memory, cusp::column_major> V;
+
+    // Compute the smallest eigenpairs of A with at most 320 basis vectors
+    cusp::eigen::lanczos_options<double> options;
+
+    options.tol = 1e-8;
+    options.maxIter = 20000;
+    options.maxBasisSize = 320;
+    options.verbose = true;
+    options.computeEigVecs = true;
+    options.eigPart = cusp::eigen::SA;
+
+    timer t;
+    cusp::eigen::lanczos(A, S, V, options);
+    std::cout << "Thick-restart Lanczos time : " << t.milliseconds_elapsed() << " (ms)" << std::endl;
+    std::cout << "Smallest eigenvalue : " << S[0] << std::endl;
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
+#include <cusp/reduced_precision.h>
+#include <cusp/blas/blas.h>
+#include <cusp/gallery/poisson.h>
+#include <cusp/io/matrix_market.h>
+#include <cusp/krylov/cg.h>
+
+#include <iostream>
+#include <string>
+
+#include "../timer.h"
+
+template <typename SystemMatrix, typename Matrix>
+void benchmark_matrix(const std::string& name, const SystemMatrix& S, const Matrix& A)
+{
+    typedef typename Matrix::memory_space MemorySpace;
+    typedef typename Matrix::value_type   ValueType;
+
+    const size_t N = A.num_rows;
+    const size_t num_trials = 100;
+
+    cusp::array1d<ValueType, MemorySpace> x(N, 1);
+    cusp::array1d<ValueType, MemorySpace> y(N, 0);
+
+    // time SpMV
+    cusp::multiply(S, x, y);
+
+    timer t;
+
+    for (size_t i = 0; i < num_trials; i++)
+        cusp::multiply(S, x, y);
+
+    cudaThreadSynchronize();
+
+    float spmv_time = t.milliseconds_elapsed() / num_trials;
+
+    // time solver
+    cusp::array1d<ValueType, MemorySpace> b(N, 1);
+    cusp::blas::fill(x, 0);
+
+    cusp::monitor<ValueType> monitor(b, 2000, 1e-10);
+
+    timer s;
+
+    cusp::krylov::cg(S, x, b, monitor);
+
+    cudaThreadSynchronize();
+
+    float solver_time = s.seconds_elapsed();
+
+    // residual of the solution with the full precision matrix
+    cusp::multiply(A, x, y);
+    cusp::blas::axpby(b, y, y, ValueType(1), ValueType(-1));
+
+    std::cout << "  " << name << ": SpMV " << spmv_time << " ms, ";
+    std::cout << monitor.iteration_count() << " CG iterations in " << solver_time << " s, ";
+    std::cout << "relative residual " << cusp::blas::nrm2(y) / cusp::blas::nrm2(b) << std::endl;
+}
+
+template <typename MemorySpace, typename HostMatrix>
+void benchmark_storage(const HostMatrix& H)
+{
+    typedef int    IndexType;
+    typedef double ValueType;
+
+    cusp::csr_matrix<IndexType, ValueType, MemorySpace> A(H);
+
+    benchmark_matrix("double  ", A, A);
+    benchmark_matrix("float   ", cusp::reduced_precision_csr_matrix<IndexType, float, ValueType, MemorySpace>(A), A);
+    benchmark_matrix("bfloat16", cusp::reduced_precision_csr_matrix<IndexType, cusp::bfloat16, ValueType, MemorySpace>(A), A);
+    benchmark_matrix("short   ", cusp::reduced_precision_csr_matrix<IndexType, short, ValueType, MemorySpace>(A), A);
+}
+
+int main(int argc, char** argv)
+{
+    typedef int    IndexType;
+    typedef double ValueType;
+
+    cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> A;
+
+    if (argc == 1)
+    {
+        std::cout << "Using default matrix (5-pt Laplacian stencil)" << std::endl;
+        cusp::gallery::poisson5pt(A, 1000, 1000);
+    }
+    else
+    {
+        std::cout << "Reading matrix from file: " << argv[1] << std::endl;
+        cusp::io::read_matrix_market_file(A, std::string(argv[1]));
+    }
+
+    std::cout << "Running on host..." << std::endl;
+    benchmark_storage<cusp::host_memory>(A);
+
+    std::cout << "Running on device..." << std::endl;
+    benchmark_storage<cusp::device_memory>(A);
+
+    return 0;
+}
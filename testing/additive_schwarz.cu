@@ -0,0 +1,139 @@
+#include <unittest/unittest.h>
+
+#include <cusp/precond/additive_schwarz.h>
+#include <cusp/precond/ilu.h>
+
+#include <cusp/array2d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/gmres.h>
+
+template <class MemorySpace>
+void TestAdditiveSchwarzExact(void)
+{
+    cusp::csr_matrix<int, double, MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 10, 10);
+
+    cusp::array1d<double, MemorySpace> x = unittest::random_samples<double>(A.num_rows);
+    cusp::array1d<double, MemorySpace> b(A.num_rows);
+    cusp::multiply(A, x, b);
+
+    {
+        // a single subdomain factored with dense LU is a direct solver
+        cusp::precond::additive_schwarz<double, MemorySpace> M(A, 1, 0, A.num_rows);
+
+        cusp::array1d<double, MemorySpace> y(A.num_rows, 0.0);
+        cusp::multiply(M, b, y);
+
+        ASSERT_ALMOST_EQUAL(y, x);
+    }
+
+    {
+        // a single subdomain factored with ILU(0) matches ilu0
+        cusp::precond::additive_schwarz<double, MemorySpace> M(A, 1, 0, 0);
+        cusp::precond::ilu0<double, MemorySpace> N(A);
+
+        cusp::array1d<double, MemorySpace> y(A.num_rows, 0.0);
+        cusp::array1d<double, MemorySpace> z(A.num_rows, 0.0);
+        cusp::multiply(M, b, y);
+        cusp::multiply(N, b, z);
+
+        ASSERT_ALMOST_EQUAL(y, z);
+    }
+
+    {
+        // subdomains covering the diagonal blocks of a block diagonal matrix
+        cusp::array2d<double, cusp::host_memory> D(6, 6, 0.0);
+        D(0,0) =  4.0; D(0,1) = -1.0;
+        D(1,0) = -1.0; D(1,1) =  4.0; D(1,2) = -1.0;
+        D(2,1) = -1.0; D(2,2) =  4.0;
+        D(3,3) =  2.0; D(3,4) =  1.0;
+        D(4,3) =  1.0; D(4,4) =  3.0; D(4,5) =  1.0;
+        D(5,4) =  1.0; D(5,5) =  2.0;
+
+        cusp::csr_matrix<int, double, MemorySpace> B(D);
+
+        cusp::array1d<double, MemorySpace> v = unittest::random_samples<double>(6);
+        cusp::array1d<double, MemorySpace> c(6);
+        cusp::multiply(B, v, c);
+
+        cusp::precond::additive_schwarz<double, MemorySpace> M(B, 2, 3);
+
+        ASSERT_EQUAL(M.num_subdomains(), 2);
+
+        cusp::array1d<double, MemorySpace> y(6, 0.0);
+        cusp::multiply(M, c, y);
+
+        ASSERT_ALMOST_EQUAL(y, v);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestAdditiveSchwarzExact);
+
+template <class MemorySpace>
+size_t additive_schwarz_gmres_iterations(const cusp::csr_matrix<int, double, MemorySpace>& A,
+                                         cusp::precond::additive_schwarz<double, MemorySpace>& M)
+{
+    cusp::array1d<double, MemorySpace> x(A.num_rows, 0.0);
+    cusp::array1d<double, MemorySpace> b(A.num_rows, 1.0);
+
+    cusp::monitor<double> monitor(b, 500, 1e-8);
+    cusp::krylov::gmres(A, x, b, 50, monitor, M);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+
+    return monitor.iteration_count();
+}
+
+template <class MemorySpace>
+void TestAdditiveSchwarzGMRES(void)
+{
+    cusp::csr_matrix<int, double, MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 40, 40);
+
+    // contiguous ranges of rows
+    cusp::precond::additive_schwarz<double, MemorySpace> M0(A, 16, 0);
+    cusp::precond::additive_schwarz<double, MemorySpace> M2(A, 16, 2);
+
+    size_t no_overlap = additive_schwarz_gmres_iterations(A, M0);
+    size_t overlap = additive_schwarz_gmres_iterations(A, M2);
+
+    ASSERT_EQUAL(overlap < no_overlap, true);
+
+    // 4x4 squares of the grid
+    cusp::array1d<int, MemorySpace> parts(A.num_rows);
+
+    for (size_t i = 0; i < A.num_rows; i++)
+        parts[i] = ((i % 40) / 10) + 4 * ((i / 40) / 10);
+
+    cusp::precond::additive_schwarz<double, MemorySpace> M(A, parts, 2);
+
+    ASSERT_EQUAL(M.num_subdomains(), 16);
+
+    additive_schwarz_gmres_iterations(A, M);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestAdditiveSchwarzGMRES);
+
+template <class MemorySpace>
+void TestAdditiveSchwarzInvalidInput(void)
+{
+    // the second diagonal block is singular
+    cusp::array2d<double, cusp::host_memory> D(4, 4, 0.0);
+    D(0,0) = 2.0; D(0,1) = 1.0;
+    D(1,0) = 1.0; D(1,1) = 2.0;
+    D(2,2) = 1.0; D(2,3) = 1.0;
+    D(3,2) = 1.0; D(3,3) = 1.0;
+
+    cusp::csr_matrix<int, double, MemorySpace> A(D);
+
+    ASSERT_THROWS((cusp::precond::additive_schwarz<double, MemorySpace>(A, 2, 0)), cusp::runtime_exception);
+    ASSERT_THROWS((cusp::precond::additive_schwarz<double, MemorySpace>(A, 2, 0, 0)), cusp::runtime_exception);
+    ASSERT_THROWS((cusp::precond::additive_schwarz<double, MemorySpace>(A, 0)), cusp::invalid_input_exception);
+
+    cusp::array1d<int, MemorySpace> parts(3, 0);
+
+    ASSERT_THROWS((cusp::precond::additive_schwarz<double, MemorySpace>(A, parts)), cusp::invalid_input_exception);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestAdditiveSchwarzInvalidInput);
@@ -0,0 +1,119 @@
+#include <unittest/unittest.h>
+
+#include <cusp/assembly.h>
+
+#include <cusp/array2d.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+
+struct laplace_1d_element
+{
+    template <typename ValueType>
+    void operator()(size_t element, ValueType* block) const
+    {
+        ValueType scale = ValueType(element + 1);
+
+        block[0] =  scale; block[1] = -scale;
+        block[2] = -scale; block[3] =  scale;
+    }
+};
+
+template <typename ArrayType1, typename ArrayType2>
+void initialize_chain(ArrayType1& offsets, ArrayType2& nodes)
+{
+    // 4 nodes connected by 3 two-node elements
+    offsets.resize(4);
+    nodes.resize(6);
+
+    offsets[0] = 0; offsets[1] = 2; offsets[2] = 4; offsets[3] = 6;
+    nodes[0] = 0; nodes[1] = 1;
+    nodes[2] = 1; nodes[3] = 2;
+    nodes[4] = 2; nodes[5] = 3;
+}
+
+void TestCsrAssemblerPattern(void)
+{
+    cusp::array1d<int, cusp::host_memory> offsets;
+    cusp::array1d<int, cusp::host_memory> nodes;
+    initialize_chain(offsets, nodes);
+
+    cusp::csr_assembler<int, float> assembler(4, offsets, nodes);
+
+    ASSERT_EQUAL(assembler.num_elements(),        size_t(3));
+    ASSERT_EQUAL(assembler.num_colors(),          size_t(2));
+    ASSERT_EQUAL(assembler.matrix.num_rows,       4);
+    ASSERT_EQUAL(assembler.matrix.num_cols,       4);
+    ASSERT_EQUAL(assembler.matrix.num_entries,   10);
+
+    ASSERT_EQUAL(assembler.find(0, 0),  0);
+    ASSERT_EQUAL(assembler.find(0, 1),  1);
+    ASSERT_EQUAL(assembler.find(1, 0),  2);
+    ASSERT_EQUAL(assembler.find(3, 3),  9);
+    ASSERT_EQUAL(assembler.find(0, 2), -1);
+    ASSERT_EQUAL(assembler.find(3, 0), -1);
+}
+DECLARE_UNITTEST(TestCsrAssemblerPattern);
+
+void TestCsrAssemblerAssemble(void)
+{
+    cusp::array1d<int, cusp::host_memory> offsets;
+    cusp::array1d<int, cusp::host_memory> nodes;
+    initialize_chain(offsets, nodes);
+
+    cusp::csr_assembler<int, float> assembler(4, offsets, nodes);
+
+    cusp::array2d<float, cusp::host_memory> expected(4, 4, 0.0f);
+    expected(0,0) =  1; expected(0,1) = -1;
+    expected(1,0) = -1; expected(1,1) =  3; expected(1,2) = -2;
+    expected(2,1) = -2; expected(2,2) =  5; expected(2,3) = -3;
+    expected(3,2) = -3; expected(3,3) =  3;
+
+    // assembling twice must not accumulate
+    for (int step = 0; step < 2; step++)
+    {
+        assembler.assemble(laplace_1d_element());
+
+        cusp::array2d<float, cusp::host_memory> result(assembler.matrix);
+        ASSERT_EQUAL(result.values, expected.values);
+    }
+}
+DECLARE_UNITTEST(TestCsrAssemblerAssemble);
+
+void TestCsrAssemblerAddValues(void)
+{
+    cusp::array1d<int, cusp::host_memory> offsets;
+    cusp::array1d<int, cusp::host_memory> nodes;
+    initialize_chain(offsets, nodes);
+
+    cusp::csr_assembler<int, float> assembler(4, offsets, nodes);
+
+    cusp::array1d<int, cusp::host_memory> rows(2);
+    cusp::array1d<int, cusp::host_memory> cols(2);
+    cusp::array1d<float, cusp::host_memory> block(4);
+
+    #pragma omp parallel for
+    for (int e = 0; e < 3; e++)
+    {
+        cusp::array1d<int, cusp::host_memory> element_nodes(nodes.begin() + 2 * e, nodes.begin() + 2 * e + 2);
+        cusp::array1d<float, cusp::host_memory> element_block(4);
+
+        laplace_1d_element()(size_t(e), thrust::raw_pointer_cast(&element_block[0]));
+
+        assembler.add_values(element_nodes, element_nodes, element_block);
+    }
+
+    cusp::csr_assembler<int, float> reference(4, offsets, nodes);
+    reference.assemble(laplace_1d_element());
+
+    ASSERT_EQUAL(assembler.matrix.values, reference.matrix.values);
+
+    // entries outside of the pattern are dropped
+    rows[0] = 0; rows[1] = 3;
+    cols[0] = 0; cols[1] = 3;
+    block[0] = 1; block[1] = 1; block[2] = 1; block[3] = 1;
+
+    ASSERT_EQUAL(assembler.add_values(rows, cols, block), size_t(2));
+    ASSERT_EQUAL(assembler.matrix.values[assembler.find(0,0)], 2.0f);
+    ASSERT_EQUAL(assembler.matrix.values[assembler.find(3,3)], 4.0f);
+}
+DECLARE_UNITTEST(TestCsrAssemblerAddValues);
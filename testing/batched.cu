@@ -0,0 +1,214 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array2d.h>
+#include <cusp/batched_csr_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/batched.h>
+
+// batch of 5-point operators on an n x n mesh, system s has its diagonal
+// shifted by s / 4 and optionally an upwinded convection term in x
+template <typename BatchedMatrix>
+void batched_test_matrix(BatchedMatrix& batch, const size_t n, const size_t num_systems, const bool convection)
+{
+    typedef typename BatchedMatrix::value_type ValueType;
+
+    cusp::csr_matrix<int, ValueType, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, n, n);
+
+    cusp::batched_csr_matrix<int, ValueType, cusp::host_memory> B(A, num_systems);
+
+    for (size_t s = 0; s < num_systems; s++)
+    {
+        cusp::array1d<ValueType, cusp::host_memory> values(A.values);
+
+        for (size_t i = 0; i < A.num_rows; i++)
+        {
+            for (int jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            {
+                if (A.column_indices[jj] == int(i))
+                    values[jj] += ValueType(s) / ValueType(4) + (convection ? ValueType(0.5) : ValueType(0));
+                else if (convection && A.column_indices[jj] + 1 == int(i))
+                    values[jj] -= ValueType(0.5);
+            }
+        }
+
+        B.set_values(s, values);
+    }
+
+    batch = BatchedMatrix(B);
+}
+
+// check the reported residual of every system against b - A x
+template <typename BatchedMatrix, typename Array2d, typename Monitor>
+void check_batched_residuals(const BatchedMatrix& batch, const Array2d& X, const Array2d& B, const Monitor& monitor)
+{
+    typedef typename BatchedMatrix::value_type ValueType;
+
+    cusp::array2d<ValueType, cusp::host_memory> X_host(X);
+    cusp::array2d<ValueType, cusp::host_memory> B_host(B);
+
+    for (size_t s = 0; s < batch.num_systems; s++)
+    {
+        cusp::csr_matrix<int, ValueType, cusp::host_memory> A;
+        batch.get_system(s, A);
+
+        cusp::array1d<ValueType, cusp::host_memory> x(A.num_rows);
+        cusp::array1d<ValueType, cusp::host_memory> b(A.num_rows);
+        cusp::array1d<ValueType, cusp::host_memory> r(A.num_rows);
+
+        for (size_t i = 0; i < A.num_rows; i++)
+        {
+            x[i] = X_host(i, s);
+            b[i] = B_host(i, s);
+        }
+
+        cusp::multiply(A, x, r);
+        cusp::blas::axpby(b, r, r, ValueType(1), ValueType(-1));
+
+        ASSERT_EQUAL(monitor.converged(s), true);
+        ASSERT_EQUAL(cusp::blas::nrm2(r) <= monitor.relative_tolerance() * cusp::blas::nrm2(b) * 1.01, true);
+        ASSERT_EQUAL(cusp::blas::nrm2(r) <= monitor.residual_norm(s) * 1.01 + 1e-10, true);
+    }
+}
+
+template <class MemorySpace>
+void TestBatchedCsrMatrix(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 4, 4);
+
+    cusp::batched_csr_matrix<int, float, MemorySpace> batch(A, 3);
+
+    ASSERT_EQUAL(batch.num_rows,    A.num_rows);
+    ASSERT_EQUAL(batch.num_cols,    A.num_cols);
+    ASSERT_EQUAL(batch.num_entries, A.num_entries);
+    ASSERT_EQUAL(batch.num_systems, 3);
+    ASSERT_EQUAL(batch.values.size(), 3 * A.num_entries);
+
+    cusp::array1d<float, MemorySpace> values(A.values);
+    cusp::blas::scal(values, 2.0f);
+
+    batch.set_values(1, values);
+
+    cusp::csr_matrix<int, float, MemorySpace> B;
+
+    batch.get_system(0, B);
+    ASSERT_EQUAL(B.row_offsets,    A.row_offsets);
+    ASSERT_EQUAL(B.column_indices, A.column_indices);
+    ASSERT_EQUAL(B.values,         A.values);
+
+    batch.get_system(1, B);
+    ASSERT_EQUAL(B.values, values);
+
+    batch.get_system(2, B);
+    ASSERT_EQUAL(B.values, A.values);
+
+    ASSERT_THROWS(batch.get_system(3, B), cusp::invalid_input_exception);
+    ASSERT_THROWS(batch.set_values(0, B.row_offsets), cusp::invalid_input_exception);
+
+    cusp::batched_csr_matrix<int, float, cusp::host_memory> copy(batch);
+    ASSERT_EQUAL(copy.num_systems, 3);
+    ASSERT_EQUAL(copy.values[A.num_entries * 3 - 2], values[A.num_entries - 1]);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBatchedCsrMatrix);
+
+template <class MemorySpace>
+void TestBatchedCG(void)
+{
+    // not a multiple of the number of systems iterated together
+    const size_t num_systems = 11;
+
+    cusp::batched_csr_matrix<int, double, MemorySpace> batch;
+    batched_test_matrix(batch, 8, num_systems, false);
+
+    cusp::array2d<double, MemorySpace> B(batch.num_rows, num_systems, 1.0);
+
+    {
+        cusp::array2d<double, MemorySpace> X(batch.num_rows, num_systems, 0.0);
+        cusp::krylov::batched_monitor<double> monitor(100, 1e-8);
+
+        cusp::krylov::batched_cg(batch, X, B, monitor);
+
+        ASSERT_EQUAL(monitor.num_converged(), num_systems);
+        check_batched_residuals(batch, X, B, monitor);
+
+        // larger shifts converge faster
+        ASSERT_EQUAL(monitor.iteration_count(num_systems - 1) < monitor.iteration_count(0), true);
+    }
+
+    {
+        cusp::array2d<double, MemorySpace> X(batch.num_rows, num_systems, 0.0);
+        cusp::krylov::batched_monitor<double> monitor(100, 1e-8);
+
+        cusp::krylov::batched_cg(batch, X, B, monitor, cusp::krylov::batched_jacobi());
+
+        ASSERT_EQUAL(monitor.num_converged(), num_systems);
+        check_batched_residuals(batch, X, B, monitor);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBatchedCG);
+
+template <class MemorySpace>
+void TestBatchedBiCGStab(void)
+{
+    const size_t num_systems = 13;
+
+    cusp::batched_csr_matrix<int, double, MemorySpace> batch;
+    batched_test_matrix(batch, 8, num_systems, true);
+
+    cusp::array2d<double, MemorySpace> B(batch.num_rows, num_systems, 1.0);
+
+    {
+        cusp::array2d<double, MemorySpace> X(batch.num_rows, num_systems, 0.0);
+        cusp::krylov::batched_monitor<double> monitor(200, 1e-8);
+
+        cusp::krylov::batched_bicgstab(batch, X, B, monitor);
+
+        ASSERT_EQUAL(monitor.num_converged(), num_systems);
+        check_batched_residuals(batch, X, B, monitor);
+    }
+
+    {
+        cusp::array2d<double, MemorySpace> X(batch.num_rows, num_systems, 0.0);
+        cusp::krylov::batched_monitor<double> monitor(200, 1e-8);
+
+        cusp::krylov::batched_bicgstab(batch, X, B, monitor, cusp::krylov::batched_jacobi());
+
+        ASSERT_EQUAL(monitor.num_converged(), num_systems);
+        check_batched_residuals(batch, X, B, monitor);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBatchedBiCGStab);
+
+void TestBatchedIterationLimit(void)
+{
+    const size_t num_systems = 5;
+
+    cusp::batched_csr_matrix<int, double, cusp::host_memory> batch;
+    batched_test_matrix(batch, 8, num_systems, false);
+
+    cusp::array2d<double, cusp::host_memory> X(batch.num_rows, num_systems, 0.0);
+    cusp::array2d<double, cusp::host_memory> B(batch.num_rows, num_systems, 1.0);
+
+    cusp::krylov::batched_monitor<double> monitor(2, 1e-8);
+
+    cusp::krylov::batched_cg(batch, X, B, monitor);
+
+    ASSERT_EQUAL(monitor.num_systems(), num_systems);
+    ASSERT_EQUAL(monitor.num_converged(), 0);
+
+    for (size_t s = 0; s < num_systems; s++)
+    {
+        ASSERT_EQUAL(monitor.converged(s), false);
+        ASSERT_EQUAL(monitor.iteration_count(s), 2);
+    }
+
+    // right-hand sides must have one column per system
+    cusp::array2d<double, cusp::host_memory> C(batch.num_rows, num_systems + 1, 1.0);
+    ASSERT_THROWS(cusp::krylov::batched_cg(batch, X, C, monitor), cusp::invalid_input_exception);
+}
+DECLARE_UNITTEST(TestBatchedIterationLimit);
@@ -4,8 +4,11 @@
 #include <cusp/coo_matrix.h>
 #include <cusp/csr_matrix.h>
 
+#include <cusp/gallery/poisson.h>
 #include <cusp/io/binary.h>
 
+#include <sstream>
+
 #include <stdio.h>
 
 const char random_file_name[] = "test_93298409283221.bin";
@@ -127,3 +130,88 @@ void TestWriteBinaryFileCoordinateRealGeneral(void)
     ASSERT_EQUAL(D == E, true);
 }
 DECLARE_HOST_DEVICE_UNITTEST(TestWriteBinaryFileCoordinateRealGeneral)
+
+template <typename MemorySpace>
+void TestWriteCompressedBinaryFile(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 40, 30);
+
+    for (int compress_values = 0; compress_values < 2; compress_values++)
+    {
+        cusp::io::write_compressed_binary_file(A, random_file_name, compress_values == 1);
+
+        cusp::csr_matrix<int, float, MemorySpace> B;
+        cusp::io::read_binary_file(B, random_file_name);
+
+        cusp::coo_matrix<int, float, MemorySpace> C;
+        cusp::io::read_binary_file(C, random_file_name);
+
+        remove(random_file_name);
+
+        ASSERT_EQUAL(B.num_rows, A.num_rows);
+        ASSERT_EQUAL(B.num_cols, A.num_cols);
+        ASSERT_EQUAL(B.row_offsets == A.row_offsets, true);
+        ASSERT_EQUAL(B.column_indices == A.column_indices, true);
+        ASSERT_EQUAL(B.values == A.values, true);
+
+        cusp::array2d<float, cusp::host_memory> D(A);
+        cusp::array2d<float, cusp::host_memory> E(C);
+        ASSERT_EQUAL(D == E, true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestWriteCompressedBinaryFile);
+
+template <typename MemorySpace>
+void TestWriteRawBinaryFile(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 40, 30);
+
+    // uncompressed format
+    cusp::io::write_binary_file(A, random_file_name);
+
+    cusp::coo_matrix<int, float, MemorySpace> B;
+    cusp::io::read_binary_file(B, random_file_name);
+
+    cusp::csr_matrix<int, float, MemorySpace> C;
+    cusp::io::read_binary_file(C, random_file_name);
+
+    remove(random_file_name);
+
+    ASSERT_EQUAL(C.num_rows, A.num_rows);
+    ASSERT_EQUAL(C.num_cols, A.num_cols);
+    ASSERT_EQUAL(C.row_offsets == A.row_offsets, true);
+    ASSERT_EQUAL(C.column_indices == A.column_indices, true);
+    ASSERT_EQUAL(C.values == A.values, true);
+
+    cusp::array2d<float, cusp::host_memory> D(A);
+    cusp::array2d<float, cusp::host_memory> E(B);
+    ASSERT_EQUAL(D == E, true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestWriteRawBinaryFile);
+
+void TestWriteCompressedBinaryStreamSize(void)
+{
+    cusp::csr_matrix<int, double, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 100, 100);
+
+    // random values do not compress, the column indices do
+    cusp::csr_matrix<int, double, cusp::host_memory> B(A);
+    B.values = unittest::random_samples<double>(B.num_entries);
+
+    std::stringstream raw, compressed, random;
+    cusp::io::write_binary_stream(A, raw);
+    cusp::io::write_compressed_binary_stream(A, compressed);
+    cusp::io::write_compressed_binary_stream(B, random);
+
+    ASSERT_EQUAL(compressed.str().size() * 5 < raw.str().size(), true);
+    ASSERT_EQUAL(random.str().size() < raw.str().size(), true);
+
+    cusp::csr_matrix<int, double, cusp::host_memory> C;
+    cusp::io::read_binary_stream(C, random);
+
+    ASSERT_EQUAL(C.column_indices == B.column_indices, true);
+    ASSERT_EQUAL(C.values == B.values, true);
+}
+DECLARE_UNITTEST(TestWriteCompressedBinaryStreamSize);
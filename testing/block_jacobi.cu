@@ -0,0 +1,154 @@
+#include <unittest/unittest.h>
+
+#include <cusp/precond/block_jacobi.h>
+#include <cusp/precond/smoother/block_jacobi_smoother.h>
+#include <cusp/precond/aggregation/smoothed_aggregation.h>
+
+#include <cusp/array2d.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/cg.h>
+
+// Kronecker product of the 2D Poisson matrix with a 3x3 coupling matrix
+template <typename MatrixType>
+void coupled_poisson(MatrixType& A, size_t n)
+{
+    typedef typename MatrixType::value_type ValueType;
+
+    cusp::csr_matrix<int, ValueType, cusp::host_memory> P;
+    cusp::gallery::poisson5pt(P, n, n);
+
+    const ValueType C[3][3] = {{ 4.0, -1.0,  0.0},
+                               {-1.0,  4.0, -1.0},
+                               { 0.0, -1.0,  4.0}};
+
+    cusp::coo_matrix<int, ValueType, cusp::host_memory> K(3 * P.num_rows, 3 * P.num_cols, 9 * P.num_entries);
+
+    size_t n_entries = 0;
+
+    for (size_t i = 0; i < P.num_rows; i++)
+        for (int r = 0; r < 3; r++)
+            for (int jj = P.row_offsets[i]; jj < P.row_offsets[i + 1]; jj++)
+                for (int c = 0; c < 3; c++, n_entries++)
+                {
+                    K.row_indices[n_entries]    = 3 * i + r;
+                    K.column_indices[n_entries] = 3 * P.column_indices[jj] + c;
+                    K.values[n_entries]         = P.values[jj] * C[r][c];
+                }
+
+    A = K;
+}
+
+template <class MemorySpace>
+void TestBlockJacobiExact(void)
+{
+    // block diagonal matrix, the second block needs pivoting
+    cusp::array2d<float, MemorySpace> D(6, 6, 0.0f);
+    D(0,0) =  4.0; D(0,1) = -1.0; D(0,2) =  0.5;
+    D(1,0) = -1.0; D(1,1) =  5.0; D(1,2) = -1.0;
+    D(2,0) =  0.5; D(2,1) = -1.0; D(2,2) =  6.0;
+    D(3,3) =  0.0; D(3,4) =  2.0; D(3,5) =  1.0;
+    D(4,3) =  3.0; D(4,4) =  0.0; D(4,5) = -1.0;
+    D(5,3) =  1.0; D(5,4) = -1.0; D(5,5) =  0.0;
+
+    cusp::csr_matrix<int, float, MemorySpace> A(D);
+
+    cusp::array1d<float, MemorySpace> x(6);
+    x[0] = 1.0; x[1] = -2.0; x[2] = 3.0; x[3] = 0.5; x[4] = -1.0; x[5] = 2.0;
+
+    cusp::array1d<float, MemorySpace> b(6);
+    cusp::multiply(A, x, b);
+
+    {
+        cusp::precond::block_jacobi<float, MemorySpace> M(A, 3);
+
+        ASSERT_EQUAL(M.block_size, 3);
+        ASSERT_EQUAL(M.num_blocks(), 2);
+
+        cusp::array1d<float, MemorySpace> y(6, 0.0f);
+        cusp::multiply(M, b, y);
+
+        ASSERT_ALMOST_EQUAL(y, x);
+    }
+
+    {
+        // the same blocks given by offsets, split into 3 + 1 + 2 rows
+        cusp::array1d<int, cusp::host_memory> offsets(4);
+        offsets[0] = 0; offsets[1] = 3; offsets[2] = 4; offsets[3] = 6;
+
+        D(3,4) = 0.0; D(4,3) = 0.0; D(5,3) = 0.0; D(3,5) = 0.0;
+        D(3,3) = 2.0;
+
+        cusp::csr_matrix<int, float, MemorySpace> B(D);
+        cusp::multiply(B, x, b);
+
+        cusp::precond::block_jacobi<float, MemorySpace> M(B, offsets);
+
+        ASSERT_EQUAL(M.block_size, 0);
+        ASSERT_EQUAL(M.num_blocks(), 3);
+
+        cusp::array1d<float, MemorySpace> y(6, 0.0f);
+        cusp::multiply(M, b, y);
+
+        ASSERT_ALMOST_EQUAL(y, x);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBlockJacobiExact);
+
+template <class MemorySpace>
+void TestBlockJacobiSingularBlock(void)
+{
+    cusp::array2d<float, MemorySpace> D(4, 4, 0.0f);
+    D(0,0) = 1.0; D(1,1) = 1.0;
+    D(2,2) = 1.0; D(2,3) = 2.0;
+    D(3,2) = 2.0; D(3,3) = 4.0;
+
+    cusp::csr_matrix<int, float, MemorySpace> A(D);
+
+    ASSERT_THROWS((cusp::precond::block_jacobi<float, MemorySpace>(A, 2)), cusp::runtime_exception);
+    ASSERT_THROWS((cusp::precond::block_jacobi<float, MemorySpace>(A, 0)), cusp::invalid_input_exception);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBlockJacobiSingularBlock);
+
+template <class MemorySpace>
+void TestBlockJacobiConjugateGradient(void)
+{
+    cusp::csr_matrix<int, double, MemorySpace> A;
+    coupled_poisson(A, 20);
+
+    cusp::array1d<double, MemorySpace> x(A.num_rows, 0.0);
+    cusp::array1d<double, MemorySpace> b(A.num_rows, 1.0);
+
+    cusp::monitor<double> monitor(b, 400, 1e-8);
+
+    cusp::precond::block_jacobi<double, MemorySpace> M(A, 3);
+    cusp::krylov::cg(A, x, b, monitor, M);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBlockJacobiConjugateGradient);
+
+template <class MemorySpace>
+void TestBlockJacobiSmoother(void)
+{
+    typedef cusp::precond::block_jacobi_smoother<double, MemorySpace, 3> Smoother;
+
+    cusp::csr_matrix<int, double, MemorySpace> A;
+    coupled_poisson(A, 40);
+
+    cusp::precond::aggregation::smoothed_aggregation<int, double, MemorySpace, Smoother> M(A);
+
+    cusp::array1d<double, MemorySpace> x(A.num_rows, 0.0);
+    cusp::array1d<double, MemorySpace> b = unittest::random_samples<double>(A.num_rows);
+
+    // set stopping criteria (iteration_limit = 100, relative_tolerance = 1e-6)
+    cusp::monitor<double> monitor(b, 100, 1e-6);
+    cusp::krylov::cg(A, x, b, monitor, M);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestBlockJacobiSmoother);
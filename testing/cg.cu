@@ -66,6 +66,31 @@ void TestConjugateGradient(void)
 }
 DECLARE_HOST_DEVICE_UNITTEST(TestConjugateGradient)
 
+template <class MemorySpace>
+void TestConjugateGradientResidualReplacement(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A;
+
+    cusp::gallery::poisson5pt(A, 10, 10);
+
+    cusp::array1d<float, MemorySpace> x(A.num_rows, 0.0f);
+    cusp::array1d<float, MemorySpace> b(A.num_rows, 1.0f);
+
+    cusp::monitor<float> monitor(b, 20, 1e-4);
+    monitor.set_replacement_interval(5);
+
+    cusp::krylov::cg(A, x, b, monitor);
+
+    // check residual norm
+    cusp::array1d<float, MemorySpace> residual(A.num_rows, 0.0f);
+    cusp::multiply(A, x, residual);
+    cusp::blas::axpby(residual, b, residual, -1.0f, 1.0f);
+
+    ASSERT_EQUAL(cusp::blas::nrm2(residual) < 1e-4 * cusp::blas::nrm2(b), true);
+    ASSERT_EQUAL(monitor.residuals.size(), monitor.iteration_count() + 1);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestConjugateGradientResidualReplacement)
+
 
 template <class MemorySpace>
 void TestConjugateGradientZeroResidual(void)
@@ -0,0 +1,111 @@
+#include <unittest/unittest.h>
+
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/cg.h>
+#include <cusp/krylov/deflated_cg.h>
+#include <cusp/precond/diagonal.h>
+
+template <class LinearOperator, class VectorType1, class VectorType2, class RecycleSpace, class Monitor, class Preconditioner>
+void deflated_cg(my_system& system, const LinearOperator& A, VectorType1& x, const VectorType2& b, RecycleSpace& space, Monitor& monitor, Preconditioner& M)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestDeflatedConjugateGradientDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::gallery::poisson5pt(A, 10, 10);
+    cusp::array1d<float, cusp::device_memory> x(A.num_rows, 0.0f);
+    cusp::monitor<float> monitor(x, 20, 1e-4);
+    cusp::identity_operator<float,cusp::device_memory> M(A.num_rows, A.num_cols);
+    cusp::krylov::recycle_space<float,cusp::device_memory> space(4);
+
+    {
+        my_system sys(0);
+
+        // call deflated_cg with explicit dispatching
+        cusp::krylov::deflated_cg(sys, A, x, x, space, monitor, M);
+
+        // check if dispatch policy was used
+        ASSERT_EQUAL(true, sys.is_valid());
+    }
+}
+DECLARE_UNITTEST(TestDeflatedConjugateGradientDispatch);
+
+template <class MemorySpace>
+void TestDeflatedConjugateGradient(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 16, 16);
+
+    cusp::array1d<float, MemorySpace> residual(A.num_rows, 0.0f);
+
+    cusp::krylov::recycle_space<float, MemorySpace> space(8);
+
+    // solve a sequence of right-hand sides
+    for (int i = 0; i < 3; i++)
+    {
+        cusp::array1d<float, MemorySpace> x(A.num_rows, 0.0f);
+        cusp::array1d<float, MemorySpace> b(cusp::random_array<float>(A.num_rows, i));
+
+        cusp::monitor<float> monitor(b, 200, 1e-5);
+
+        cusp::krylov::deflated_cg(A, x, b, space, monitor);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+        ASSERT_EQUAL(space.size(), size_t(8));
+
+        // check residual norm
+        cusp::multiply(A, x, residual);
+        cusp::blas::axpby(residual, b, residual, -1.0f, 1.0f);
+
+        ASSERT_EQUAL(cusp::blas::nrm2(residual) < 1e-4 * cusp::blas::nrm2(b), true);
+
+        // the recycled space deflates the smallest eigenvalues
+        if (i > 0)
+        {
+            cusp::array1d<float, MemorySpace> y(A.num_rows, 0.0f);
+            cusp::monitor<float> cg_monitor(b, 200, 1e-5);
+
+            cusp::krylov::cg(A, y, b, cg_monitor);
+
+            ASSERT_EQUAL(monitor.iteration_count() < cg_monitor.iteration_count(), true);
+        }
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestDeflatedConjugateGradient);
+
+template <class MemorySpace>
+void TestDeflatedConjugateGradientPreconditioned(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 16, 16);
+
+    cusp::array1d<float, MemorySpace> b(A.num_rows, 1.0f);
+    cusp::array1d<float, MemorySpace> residual(A.num_rows, 0.0f);
+
+    cusp::precond::diagonal<float, MemorySpace> M(A);
+    cusp::krylov::recycle_space<float, MemorySpace> space(4);
+
+    for (int i = 0; i < 2; i++)
+    {
+        cusp::array1d<float, MemorySpace> x(A.num_rows, 0.0f);
+        cusp::monitor<float> monitor(b, 200, 1e-5);
+
+        cusp::krylov::deflated_cg(A, x, b, space, monitor, M);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+
+        cusp::multiply(A, x, residual);
+        cusp::blas::axpby(residual, b, residual, -1.0f, 1.0f);
+
+        ASSERT_EQUAL(cusp::blas::nrm2(residual) < 1e-4 * cusp::blas::nrm2(b), true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestDeflatedConjugateGradientPreconditioned);
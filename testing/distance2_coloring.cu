@@ -0,0 +1,170 @@
+#include <unittest/unittest.h>
+
+#include <cusp/graph/distance2_coloring.h>
+
+#include <cusp/array2d.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+
+#include <algorithm>
+
+template <typename TestMatrix>
+void TestDistance2Coloring(void)
+{
+    typedef typename TestMatrix::index_type   IndexType;
+    typedef typename TestMatrix::value_type   ValueType;
+    typedef typename TestMatrix::memory_space MemorySpace;
+
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 30, 30);
+
+    TestMatrix G(A);
+
+    cusp::array1d<IndexType,MemorySpace> colors;
+    size_t num_colors = cusp::graph::distance2_coloring(G, colors);
+
+    cusp::array1d<IndexType,cusp::host_memory> h_colors(colors);
+
+    ASSERT_EQUAL(h_colors.size(), A.num_rows);
+
+    // the closed neighborhood of a vertex needs 5 distinct colors
+    ASSERT_EQUAL(num_colors >= 5, true);
+    ASSERT_EQUAL(num_colors <= 13, true);
+
+    // vertices at distance one or two have different colors
+    bool valid = true;
+
+    for (IndexType v = 0; v < IndexType(A.num_rows); v++)
+    {
+        if (h_colors[v] < 0 || h_colors[v] >= IndexType(num_colors))
+            valid = false;
+
+        for (IndexType jj = A.row_offsets[v]; jj < A.row_offsets[v + 1]; jj++)
+        {
+            IndexType w = A.column_indices[jj];
+
+            if (w != v && h_colors[w] == h_colors[v])
+                valid = false;
+
+            for (IndexType kk = A.row_offsets[w]; kk < A.row_offsets[w + 1]; kk++)
+            {
+                IndexType u = A.column_indices[kk];
+
+                if (u != v && h_colors[u] == h_colors[v])
+                    valid = false;
+            }
+        }
+    }
+
+    ASSERT_EQUAL(valid, true);
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestDistance2Coloring)
+
+template <typename MemorySpace>
+void TestPartialDistance2Coloring(void)
+{
+    typedef int   IndexType;
+    typedef float ValueType;
+
+    // random rectangular Jacobian pattern
+    cusp::coo_matrix<IndexType,ValueType,cusp::host_memory> C(200, 150, 800);
+
+    for (size_t n = 0; n < C.num_entries; n++)
+    {
+        C.row_indices[n]    = n / 4;
+        C.column_indices[n] = (37 * n + (n / 4) * (n / 4)) % 150;
+        C.values[n]         = ValueType(n % 7) + 1;
+    }
+
+    C.sort_by_row_and_column();
+
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> A_h(C);
+    cusp::csr_matrix<IndexType,ValueType,MemorySpace> A(A_h);
+
+    cusp::array1d<IndexType,MemorySpace> colors;
+    size_t num_colors = cusp::graph::partial_distance2_coloring(A, colors);
+
+    cusp::array1d<IndexType,cusp::host_memory> h_colors(colors);
+
+    ASSERT_EQUAL(h_colors.size(), A.num_cols);
+
+    // columns sharing a row have different colors
+    bool valid = true;
+    IndexType max_degree = 0;
+
+    for (IndexType i = 0; i < IndexType(A_h.num_rows); i++)
+    {
+        max_degree = std::max(max_degree, A_h.row_offsets[i + 1] - A_h.row_offsets[i]);
+
+        for (IndexType jj = A_h.row_offsets[i]; jj < A_h.row_offsets[i + 1]; jj++)
+            for (IndexType kk = jj + 1; kk < A_h.row_offsets[i + 1]; kk++)
+                if (h_colors[A_h.column_indices[jj]] == h_colors[A_h.column_indices[kk]])
+                    valid = false;
+    }
+
+    ASSERT_EQUAL(valid, true);
+    ASSERT_EQUAL(num_colors >= size_t(max_degree), true);
+    ASSERT_EQUAL(num_colors < A.num_cols, true);
+
+    // compress with the seed matrix and recover the entries of A
+    cusp::array2d<ValueType,MemorySpace,cusp::column_major> S;
+    cusp::graph::coloring_seed_matrix(colors, num_colors, S);
+
+    ASSERT_EQUAL(S.num_rows, A.num_cols);
+    ASSERT_EQUAL(S.num_cols, num_colors);
+
+    cusp::array2d<ValueType,MemorySpace,cusp::column_major> B(A.num_rows, num_colors);
+
+    for (size_t c = 0; c < num_colors; c++)
+    {
+        typename cusp::array2d<ValueType,MemorySpace,cusp::column_major>::column_view B_c = B.column(c);
+        cusp::multiply(A, S.column(c), B_c);
+    }
+
+    cusp::csr_matrix<IndexType,ValueType,MemorySpace> J;
+    cusp::graph::recover_colored_matrix(A, colors, B, J);
+
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> J_h(J);
+
+    ASSERT_EQUAL(J_h.row_offsets, A_h.row_offsets);
+    ASSERT_EQUAL(J_h.column_indices, A_h.column_indices);
+    ASSERT_EQUAL(J_h.values, A_h.values);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestPartialDistance2Coloring);
+
+void TestColoringSeedMatrixInvalidColor(void)
+{
+    cusp::array1d<int,cusp::host_memory> colors(3, 0);
+    colors[2] = 2;
+
+    cusp::array2d<float,cusp::host_memory> S;
+
+    ASSERT_THROWS(cusp::graph::coloring_seed_matrix(colors, 2, S), cusp::invalid_input_exception);
+}
+DECLARE_UNITTEST(TestColoringSeedMatrixInvalidColor);
+
+template <typename MatrixType, typename ArrayType>
+size_t distance2_coloring(my_system& system, const MatrixType& G, ArrayType& colors)
+{
+    system.validate_dispatch();
+    return 0;
+}
+
+void TestDistance2ColoringDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::array1d<int, cusp::device_memory> colors;
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::graph::distance2_coloring(sys, A, colors);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestDistance2ColoringDispatch);
@@ -0,0 +1,116 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+#include <cusp/eigen/chfsi.h>
+#include <cusp/gallery/poisson.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// eigenvalues of the Poisson matrix on an nx-by-ny-by-nz grid in ascending
+// order, sum of 2 - 2 cos(k pi / (n + 1)) over the dimensions
+std::vector<double> chfsi_poisson_eigenvalues(size_t nx, size_t ny, size_t nz)
+{
+    const double pi = 3.14159265358979323846;
+
+    std::vector<double> values;
+
+    for (size_t i = 1; i <= nx; i++)
+        for (size_t j = 1; j <= ny; j++)
+            for (size_t k = 1; k <= nz; k++)
+            {
+                double value = 4.0 - 2.0 * std::cos(i * pi / (nx + 1)) - 2.0 * std::cos(j * pi / (ny + 1));
+
+                if (nz > 1)
+                    value += 2.0 - 2.0 * std::cos(k * pi / (nz + 1));
+
+                values.push_back(value);
+            }
+
+    std::sort(values.begin(), values.end());
+
+    return values;
+}
+
+// Frobenius norm of A X - X diag(S) over the first S.size() columns of X
+template <typename MatrixType, typename Array1d, typename Array2d>
+double chfsi_residual_norm(const MatrixType& A, const Array1d& S, Array2d& X)
+{
+    typedef typename MatrixType::value_type   ValueType;
+    typedef typename MatrixType::memory_space MemorySpace;
+
+    cusp::array1d<ValueType, cusp::host_memory> S_h(S);
+    cusp::array1d<ValueType, MemorySpace> r(A.num_rows);
+
+    double norm = 0.0;
+
+    for (size_t i = 0; i < S_h.size(); i++)
+    {
+        cusp::multiply(A, X.column(i), r);
+        cusp::blas::axpy(X.column(i), r, -S_h[i]);
+
+        const double ri = cusp::blas::nrm2(r);
+        norm += ri * ri;
+    }
+
+    return std::sqrt(norm);
+}
+
+template <class MemorySpace>
+void TestChebyshevFilteredSubspaceIterationSmallest(void)
+{
+    cusp::csr_matrix<int, double, MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 12, 12);
+
+    const std::vector<double> exact = chfsi_poisson_eigenvalues(12, 12, 1);
+
+    cusp::array1d<double, MemorySpace> S(4, 0);
+    cusp::array2d<double, MemorySpace, cusp::column_major> X;
+
+    cusp::array1d<double, MemorySpace> b(A.num_rows, 1);
+    cusp::monitor<double> monitor(b, 500, 1e-8);
+
+    cusp::eigen::chfsi(A, S, X, monitor, false, 12);
+
+    cusp::array1d<double, cusp::host_memory> S_h(S);
+
+    // ascending from the smallest
+    for (size_t i = 0; i < S_h.size(); i++)
+        ASSERT_EQUAL(std::abs(S_h[i] - exact[i]) < 1e-6, true);
+
+    ASSERT_EQUAL(chfsi_residual_norm(A, S, X) < 1e-5, true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestChebyshevFilteredSubspaceIterationSmallest);
+
+template <class MemorySpace>
+void TestChebyshevFilteredSubspaceIterationLargest(void)
+{
+    cusp::csr_matrix<int, double, MemorySpace> A;
+    cusp::gallery::poisson7pt(A, 6, 6, 6);
+
+    const std::vector<double> exact = chfsi_poisson_eigenvalues(6, 6, 6);
+
+    cusp::array1d<double, MemorySpace> S(4, 0);
+    cusp::array2d<double, MemorySpace, cusp::column_major> X;
+
+    cusp::array1d<double, MemorySpace> b(A.num_rows, 1);
+    cusp::monitor<double> monitor(b, 500, 1e-8);
+
+    cusp::eigen::chfsi(A, S, X, monitor, true, 12);
+
+    cusp::array1d<double, cusp::host_memory> S_h(S);
+
+    // descending from the largest
+    for (size_t i = 0; i < S_h.size(); i++)
+        ASSERT_EQUAL(std::abs(S_h[i] - exact[exact.size() - 1 - i]) < 1e-6, true);
+
+    ASSERT_EQUAL(chfsi_residual_norm(A, S, X) < 1e-5, true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestChebyshevFilteredSubspaceIterationLargest);
@@ -0,0 +1,159 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+#include <cusp/eigen/lanczos.h>
+#include <cusp/gallery/poisson.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// eigenvalues of the 5-point Poisson matrix on an nx-by-ny grid in
+// ascending order, 4 - 2 cos(i pi / (nx + 1)) - 2 cos(j pi / (ny + 1))
+std::vector<double> lanczos_poisson_eigenvalues(size_t nx, size_t ny)
+{
+    const double pi = 3.14159265358979323846;
+
+    std::vector<double> values;
+
+    for (size_t i = 1; i <= nx; i++)
+        for (size_t j = 1; j <= ny; j++)
+            values.push_back(4.0 - 2.0 * std::cos(i * pi / (nx + 1)) - 2.0 * std::cos(j * pi / (ny + 1)));
+
+    std::sort(values.begin(), values.end());
+
+    return values;
+}
+
+// largest residual norm ||A v - s v|| of the returned eigenpairs
+template <typename MatrixType, typename Array1d, typename Array2d>
+double lanczos_max_residual(const MatrixType& A, const Array1d& S, Array2d& V)
+{
+    typedef typename MatrixType::value_type   ValueType;
+    typedef typename MatrixType::memory_space MemorySpace;
+
+    cusp::array1d<ValueType, cusp::host_memory> S_h(S);
+    cusp::array1d<ValueType, MemorySpace> r(A.num_rows);
+
+    double max_residual = 0.0;
+
+    for (size_t i = 0; i < S_h.size(); i++)
+    {
+        cusp::multiply(A, V.column(i), r);
+        cusp::blas::axpy(V.column(i), r, -S_h[i]);
+
+        max_residual = std::max(max_residual, double(cusp::blas::nrm2(r)));
+    }
+
+    return max_residual;
+}
+
+template <class MemorySpace>
+void TestThickRestartLanczos(void)
+{
+    // a rectangular grid, single-vector Lanczos finds one copy of a
+    // multiple eigenvalue only
+    cusp::csr_matrix<int, double, MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 24, 17);
+
+    const std::vector<double> exact = lanczos_poisson_eigenvalues(24, 17);
+
+    // 4 clustered eigenvalues of 408 unknowns cannot converge in a basis
+    // of 16 vectors, so the basis is restarted many times
+    cusp::eigen::lanczos_options<double> options;
+    options.tol            = 1e-8;
+    options.maxIter        = 20000;
+    options.maxBasisSize   = 16;
+    options.computeEigVecs = true;
+
+    {
+        options.eigPart = cusp::eigen::SA;
+
+        cusp::array1d<double, MemorySpace> S(4, 0);
+        cusp::array2d<double, MemorySpace, cusp::column_major> V;
+        cusp::eigen::lanczos(A, S, V, options);
+
+        cusp::array1d<double, cusp::host_memory> S_h(S);
+
+        ASSERT_EQUAL(S_h.size(), size_t(4));
+
+        for (size_t i = 0; i < S_h.size(); i++)
+            ASSERT_EQUAL(std::abs(S_h[i] - exact[i]) < 1e-6, true);
+
+        ASSERT_EQUAL(lanczos_max_residual(A, S, V) < 1e-6, true);
+
+        // the smallest eigenvalue from Lanczos with the full basis
+        cusp::eigen::lanczos_options<double> full_options;
+        full_options.tol     = 1e-8;
+        full_options.reorth  = cusp::eigen::Full;
+        full_options.eigPart = cusp::eigen::SA;
+
+        cusp::array1d<double, MemorySpace> S_full(1, 0);
+        cusp::array2d<double, MemorySpace, cusp::column_major> V_full;
+        cusp::eigen::lanczos(A, S_full, V_full, full_options);
+
+        ASSERT_EQUAL(std::abs(S_h[0] - double(S_full[0])) < 1e-6, true);
+    }
+
+    {
+        options.eigPart = cusp::eigen::LA;
+
+        cusp::array1d<double, MemorySpace> S(3, 0);
+        cusp::array2d<double, MemorySpace, cusp::column_major> V;
+        cusp::eigen::lanczos(A, S, V, options);
+
+        cusp::array1d<double, cusp::host_memory> S_h(S);
+
+        // returned in ascending order
+        for (size_t i = 0; i < S_h.size(); i++)
+            ASSERT_EQUAL(std::abs(S_h[i] - exact[exact.size() - S_h.size() + i]) < 1e-6, true);
+
+        ASSERT_EQUAL(lanczos_max_residual(A, S, V) < 1e-6, true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestThickRestartLanczos);
+
+template <class MemorySpace>
+void TestThickRestartLanczosInvariantSubspace(void)
+{
+    // two distinct eigenvalues, so the Krylov space of any starting
+    // vector is invariant after two steps
+    const size_t N = 40;
+
+    cusp::csr_matrix<int, double, cusp::host_memory> D(N, N, N);
+
+    for (size_t i = 0; i < N; i++)
+    {
+        D.row_offsets[i]    = i;
+        D.column_indices[i] = i;
+        D.values[i]         = 1.0 + (i % 2);
+    }
+    D.row_offsets[N] = N;
+
+    cusp::csr_matrix<int, double, MemorySpace> A(D);
+
+    cusp::eigen::lanczos_options<double> options;
+    options.tol            = 1e-8;
+    options.maxIter        = 1000;
+    options.maxBasisSize   = 8;
+    options.computeEigVecs = true;
+    options.eigPart        = cusp::eigen::SA;
+
+    cusp::array1d<double, MemorySpace> S(3, 0);
+    cusp::array2d<double, MemorySpace, cusp::column_major> V;
+    cusp::eigen::lanczos(A, S, V, options);
+
+    cusp::array1d<double, cusp::host_memory> S_h(S);
+
+    for (size_t i = 0; i < S_h.size(); i++)
+        ASSERT_EQUAL(std::abs(S_h[i] - 1.0) < 1e-6, true);
+
+    // NaN fails the comparison
+    ASSERT_EQUAL(lanczos_max_residual(A, S, V) < 1e-6, true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestThickRestartLanczosInvariantSubspace);
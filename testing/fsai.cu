@@ -0,0 +1,136 @@
+#include <unittest/unittest.h>
+
+#include <cusp/precond/fsai.h>
+
+#include <cusp/array2d.h>
+#include <cusp/blas/blas.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/cg.h>
+#include <cusp/krylov/gmres.h>
+
+#include <thrust/sequence.h>
+
+template <class MemorySpace>
+size_t fsai_cg_iterations(const cusp::csr_matrix<int, double, MemorySpace>& A,
+                          int pattern_power, size_t adaptive_steps)
+{
+    cusp::array1d<double, MemorySpace> x(A.num_rows, 0.0);
+    cusp::array1d<double, MemorySpace> b(A.num_rows, 1.0);
+
+    cusp::monitor<double> monitor(b, 1000, 1e-8);
+
+    cusp::precond::fsai<double, MemorySpace> M(A, pattern_power, adaptive_steps, 2);
+    cusp::krylov::cg(A, x, b, monitor, M);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+
+    return monitor.iteration_count();
+}
+
+template <class MemorySpace>
+void TestFSAIConjugateGradient(void)
+{
+    cusp::csr_matrix<int, double, MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 30, 30);
+
+    cusp::precond::fsai<double, MemorySpace> M(A);
+
+    // G has the lower triangle of the pattern of A
+    ASSERT_EQUAL(M.G.num_entries, (A.num_entries + A.num_rows) / 2);
+
+    size_t diagonal = fsai_cg_iterations(A, 0, 0);
+    size_t static_pattern = fsai_cg_iterations(A, 1, 0);
+    size_t adaptive_pattern = fsai_cg_iterations(A, 1, 4);
+    size_t squared_pattern = fsai_cg_iterations(A, 2, 0);
+
+    ASSERT_EQUAL(static_pattern < diagonal, true);
+    ASSERT_EQUAL(adaptive_pattern < static_pattern, true);
+    ASSERT_EQUAL(squared_pattern < static_pattern, true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestFSAIConjugateGradient);
+
+template <class MemorySpace>
+void TestFSAIExact(void)
+{
+    // with complete patterns the factors are exact
+    cusp::array2d<double, cusp::host_memory> D(5, 5, 0.0);
+    D(0,0) =  6.0; D(0,1) = -1.0; D(0,3) =  2.0;
+    D(1,0) =  1.0; D(1,1) =  5.0; D(1,2) = -2.0;
+    D(2,1) =  3.0; D(2,2) =  7.0; D(2,4) = -1.0;
+    D(3,0) = -2.0; D(3,3) =  4.0; D(3,4) =  1.0;
+    D(4,2) =  1.0; D(4,3) = -1.0; D(4,4) =  5.0;
+
+    cusp::csr_matrix<int, double, MemorySpace> A(D);
+
+    cusp::array1d<double, MemorySpace> x(5);
+    x[0] = 1.0; x[1] = -2.0; x[2] = 3.0; x[3] = 0.5; x[4] = -1.0;
+
+    cusp::array1d<double, MemorySpace> b(5);
+    cusp::multiply(A, x, b);
+
+    cusp::precond::nonsym_fsai<double, MemorySpace> M(A, 5);
+
+    cusp::array1d<double, MemorySpace> y(5, 0.0);
+    cusp::multiply(M, b, y);
+
+    ASSERT_ALMOST_EQUAL(y, x);
+
+    cusp::csr_matrix<int, double, MemorySpace> B;
+    cusp::gallery::poisson5pt(B, 3, 3);
+
+    x.resize(9);
+    b.resize(9);
+    y.resize(9);
+    thrust::sequence(x.begin(), x.end());
+    cusp::multiply(B, x, b);
+
+    cusp::precond::fsai<double, MemorySpace> N(B, 8);
+    cusp::multiply(N, b, y);
+
+    ASSERT_ALMOST_EQUAL(y, x);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestFSAIExact);
+
+template <class MemorySpace>
+void TestNonsymFSAIGMRES(void)
+{
+    // upwinded convection-diffusion
+    cusp::csr_matrix<int, double, cusp::host_memory> P;
+    cusp::gallery::poisson5pt(P, 30, 30);
+
+    for (size_t i = 0; i < P.num_rows; i++)
+        for (int jj = P.row_offsets[i]; jj < P.row_offsets[i + 1]; jj++)
+            if (size_t(P.column_indices[jj]) + 1 == i)
+                P.values[jj] -= 1.0;
+            else if (size_t(P.column_indices[jj]) == i)
+                P.values[jj] += 1.0;
+
+    cusp::csr_matrix<int, double, MemorySpace> A(P);
+
+    cusp::array1d<double, MemorySpace> x(A.num_rows, 0.0);
+    cusp::array1d<double, MemorySpace> b(A.num_rows, 1.0);
+
+    cusp::monitor<double> monitor(b, 200, 1e-8);
+
+    cusp::precond::nonsym_fsai<double, MemorySpace> M(A, 1, 2);
+    cusp::krylov::gmres(A, x, b, 50, monitor, M);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestNonsymFSAIGMRES);
+
+template <class MemorySpace>
+void TestFSAINotPositiveDefinite(void)
+{
+    cusp::csr_matrix<int, double, MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 5, 5);
+    cusp::blas::scal(A.values, -1.0);
+
+    ASSERT_THROWS((cusp::precond::fsai<double, MemorySpace>(A)), cusp::runtime_exception);
+    ASSERT_THROWS((cusp::precond::fsai<double, MemorySpace>(A, -1)), cusp::invalid_input_exception);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestFSAINotPositiveDefinite);
@@ -0,0 +1,144 @@
+#include <unittest/unittest.h>
+
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/gcrodr.h>
+#include <cusp/krylov/gmres.h>
+#include <cusp/precond/diagonal.h>
+
+template <class LinearOperator, class VectorType1, class VectorType2, class RecycleSpace, class Monitor, class Preconditioner>
+void gcrodr(my_system& system, const LinearOperator& A, VectorType1& x, const VectorType2& b, const size_t m, RecycleSpace& space, Monitor& monitor, Preconditioner& M)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestGCRODRDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::gallery::poisson5pt(A, 10, 10);
+    cusp::array1d<float, cusp::device_memory> x(A.num_rows, 0.0f);
+    cusp::monitor<float> monitor(x, 20, 1e-4);
+    cusp::identity_operator<float,cusp::device_memory> M(A.num_rows, A.num_cols);
+    cusp::krylov::recycle_space<float,cusp::device_memory> space(4);
+
+    {
+        my_system sys(0);
+
+        // call gcrodr with explicit dispatching
+        cusp::krylov::gcrodr(sys, A, x, x, 10, space, monitor, M);
+
+        // check if dispatch policy was used
+        ASSERT_EQUAL(true, sys.is_valid());
+    }
+}
+DECLARE_UNITTEST(TestGCRODRDispatch);
+
+// shifted 5-point Poisson operator with a weak upwinded convection in x
+template <typename MatrixType>
+void gcrodr_test_matrix(MatrixType& A, const size_t n, const float shift)
+{
+    typedef typename MatrixType::value_type ValueType;
+
+    cusp::csr_matrix<int, ValueType, cusp::host_memory> B;
+    cusp::gallery::poisson5pt(B, n, n);
+
+    for (size_t i = 0; i < B.num_rows; i++)
+    {
+        for (int jj = B.row_offsets[i]; jj < B.row_offsets[i + 1]; jj++)
+        {
+            if (B.column_indices[jj] == int(i))
+                B.values[jj] += ValueType(0.1 + shift);
+            else if (B.column_indices[jj] + 1 == int(i))
+                B.values[jj] -= ValueType(0.1);
+        }
+    }
+
+    A = B;
+}
+
+template <class MemorySpace>
+void TestGCRODR(void)
+{
+    cusp::array1d<float, MemorySpace> b(256, 1.0f);
+    cusp::array1d<float, MemorySpace> residual(256, 0.0f);
+
+    cusp::krylov::recycle_space<float, MemorySpace> space(8);
+
+    for (int i = 0; i < 3; i++)
+    {
+        cusp::csr_matrix<int, float, MemorySpace> A;
+        gcrodr_test_matrix(A, 16, 0.01f * i);
+
+        cusp::array1d<float, MemorySpace> x(A.num_rows, 0.0f);
+        cusp::monitor<float> monitor(b, 500, 1e-5);
+
+        cusp::krylov::gcrodr(A, x, b, 20, space, monitor);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+        ASSERT_EQUAL(space.size(), size_t(8));
+
+        // check residual norm
+        cusp::multiply(A, x, residual);
+        cusp::blas::axpby(residual, b, residual, -1.0f, 1.0f);
+
+        ASSERT_EQUAL(cusp::blas::nrm2(residual) < 1e-4 * cusp::blas::nrm2(b), true);
+
+        // recycling must not be slower than GMRES with the same memory
+        if (i > 0)
+        {
+            cusp::array1d<float, MemorySpace> y(A.num_rows, 0.0f);
+            cusp::monitor<float> gmres_monitor(b, 500, 1e-5);
+
+            cusp::krylov::gmres(A, y, b, 20, gmres_monitor);
+
+            ASSERT_EQUAL(monitor.iteration_count() <= gmres_monitor.iteration_count(), true);
+        }
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestGCRODR);
+
+template <class MemorySpace>
+void TestGCRODRPreconditioned(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A;
+    gcrodr_test_matrix(A, 16, 0.0f);
+
+    cusp::array1d<float, MemorySpace> x(A.num_rows, 0.0f);
+    cusp::array1d<float, MemorySpace> b(A.num_rows, 1.0f);
+    cusp::array1d<float, MemorySpace> residual(A.num_rows, 0.0f);
+
+    cusp::monitor<float> monitor(b, 500, 1e-5);
+    cusp::precond::diagonal<float, MemorySpace> M(A);
+    cusp::krylov::recycle_space<float, MemorySpace> space(4);
+
+    cusp::krylov::gcrodr(A, x, b, 12, space, monitor, M);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+
+    cusp::multiply(A, x, residual);
+    cusp::blas::axpby(residual, b, residual, -1.0f, 1.0f);
+
+    ASSERT_EQUAL(cusp::blas::nrm2(residual) < 1e-4 * cusp::blas::nrm2(b), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestGCRODRPreconditioned);
+
+void TestGCRODRInvalidDimension(void)
+{
+    typedef cusp::krylov::recycle_space<float, cusp::host_memory> RecycleSpace;
+
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 4, 4);
+
+    cusp::array1d<float, cusp::host_memory> x(A.num_rows, 0.0f);
+    cusp::array1d<float, cusp::host_memory> b(A.num_rows, 1.0f);
+
+    RecycleSpace space(8);
+
+    ASSERT_THROWS(cusp::krylov::gcrodr(A, x, b, 8, space), cusp::invalid_input_exception);
+}
+DECLARE_UNITTEST(TestGCRODRInvalidDimension);
@@ -0,0 +1,112 @@
+#include <unittest/unittest.h>
+
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/idrs.h>
+#include <cusp/precond/diagonal.h>
+
+template <class LinearOperator, class VectorType1, class VectorType2, class Monitor, class Preconditioner>
+void idrs(my_system& system, const LinearOperator& A, VectorType1& x, const VectorType2& b, const size_t s, Monitor& monitor, Preconditioner& M)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestIDRsDispatch()
+{
+    // initialize testing variables
+    size_t s = 4;
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::gallery::poisson5pt(A, 10, 10);
+    cusp::array1d<float, cusp::device_memory> x(A.num_rows, 0.0f);
+    cusp::monitor<float> monitor(x, 20, 1e-4);
+    cusp::identity_operator<float,cusp::device_memory> M(A.num_rows, A.num_cols);
+
+    {
+        my_system sys(0);
+
+        // call idrs with explicit dispatching
+        cusp::krylov::idrs(sys, A, x, x, s, monitor, M);
+
+        // check if dispatch policy was used
+        ASSERT_EQUAL(true, sys.is_valid());
+    }
+}
+DECLARE_UNITTEST(TestIDRsDispatch);
+
+// 5-point convection-diffusion operator with upwinded convection in x
+template <typename MatrixType>
+void convection_diffusion(MatrixType& A, const size_t n)
+{
+    typedef typename MatrixType::value_type ValueType;
+
+    cusp::csr_matrix<int, ValueType, cusp::host_memory> B;
+    cusp::gallery::poisson5pt(B, n, n);
+
+    for (size_t i = 0; i < B.num_rows; i++)
+    {
+        for (int jj = B.row_offsets[i]; jj < B.row_offsets[i + 1]; jj++)
+        {
+            if (B.column_indices[jj] == int(i))
+                B.values[jj] += ValueType(0.5);
+            else if (B.column_indices[jj] + 1 == int(i))
+                B.values[jj] -= ValueType(0.5);
+        }
+    }
+
+    A = B;
+}
+
+template <class MemorySpace>
+void TestIDRs(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A;
+    convection_diffusion(A, 20);
+
+    cusp::array1d<float, MemorySpace> b(A.num_rows, 1.0f);
+    cusp::array1d<float, MemorySpace> residual(A.num_rows, 0.0f);
+
+    for (size_t s = 1; s <= 8; s *= 2)
+    {
+        cusp::array1d<float, MemorySpace> x(A.num_rows, 0.0f);
+        cusp::monitor<float> monitor(b, 400, 1e-5);
+
+        cusp::krylov::idrs(A, x, b, s, monitor);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+
+        // check residual norm
+        cusp::multiply(A, x, residual);
+        cusp::blas::axpby(residual, b, residual, -1.0f, 1.0f);
+
+        ASSERT_EQUAL(cusp::blas::nrm2(residual) < 1e-4 * cusp::blas::nrm2(b), true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestIDRs);
+
+template <class MemorySpace>
+void TestIDRsPreconditioned(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A;
+    convection_diffusion(A, 20);
+
+    cusp::array1d<float, MemorySpace> x(A.num_rows, 0.0f);
+    cusp::array1d<float, MemorySpace> b(A.num_rows, 1.0f);
+    cusp::array1d<float, MemorySpace> residual(A.num_rows, 0.0f);
+
+    cusp::monitor<float> monitor(b, 400, 1e-5);
+    cusp::precond::diagonal<float, MemorySpace> M(A);
+
+    cusp::krylov::idrs(A, x, b, 4, monitor, M);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+
+    cusp::multiply(A, x, residual);
+    cusp::blas::axpby(residual, b, residual, -1.0f, 1.0f);
+
+    ASSERT_EQUAL(cusp::blas::nrm2(residual) < 1e-4 * cusp::blas::nrm2(b), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestIDRsPreconditioned);
@@ -0,0 +1,147 @@
+#include <unittest/unittest.h>
+
+#include <cusp/precond/ilu.h>
+
+#include <cusp/array2d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/bicgstab.h>
+#include <cusp/krylov/cg.h>
+
+template <typename ValueType, typename MemorySpace>
+void initialize_dense_spd(cusp::array2d<ValueType, MemorySpace>& A)
+{
+    A.resize(4,4);
+    A(0,0) =  4.0; A(0,1) = -1.0; A(0,2) =  0.5; A(0,3) =  0.0;
+    A(1,0) = -1.0; A(1,1) =  5.0; A(1,2) = -1.0; A(1,3) =  1.0;
+    A(2,0) =  0.5; A(2,1) = -1.0; A(2,2) =  6.0; A(2,3) = -2.0;
+    A(3,0) =  0.0; A(3,1) =  1.0; A(3,2) = -2.0; A(3,3) =  7.0;
+}
+
+template <class MemorySpace>
+void TestILU0Exact(void)
+{
+    // ILU(0) of a matrix without zeros is the complete LU factorization
+    cusp::array2d<float, MemorySpace> D;
+    initialize_dense_spd(D);
+    D(0,3) = 2.0;
+    D(3,0) = 1.0;
+
+    cusp::csr_matrix<int, float, MemorySpace> A(D);
+
+    cusp::array1d<float, MemorySpace> x(4);
+    x[0] = 1.0; x[1] = -2.0; x[2] = 3.0; x[3] = 0.5;
+
+    cusp::array1d<float, MemorySpace> b(4);
+    cusp::array1d<float, MemorySpace> y(4, 0.0f);
+    cusp::multiply(A, x, b);
+
+    cusp::precond::ilu0<float, MemorySpace> M(A);
+
+    ASSERT_EQUAL(M.num_rows, 4);
+    ASSERT_EQUAL(M.num_cols, 4);
+
+    cusp::multiply(M, b, y);
+
+    ASSERT_ALMOST_EQUAL(y, x);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestILU0Exact);
+
+template <class MemorySpace>
+void TestIC0Exact(void)
+{
+    cusp::array2d<float, MemorySpace> D;
+    initialize_dense_spd(D);
+
+    cusp::csr_matrix<int, float, MemorySpace> A(D);
+
+    cusp::array1d<float, MemorySpace> x(4);
+    x[0] = 1.0; x[1] = -2.0; x[2] = 3.0; x[3] = 0.5;
+
+    cusp::array1d<float, MemorySpace> b(4);
+    cusp::array1d<float, MemorySpace> y(4, 0.0f);
+    cusp::multiply(A, x, b);
+
+    cusp::precond::ic0<float, MemorySpace> M(A);
+
+    cusp::multiply(M, b, y);
+
+    ASSERT_ALMOST_EQUAL(y, x);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestIC0Exact);
+
+void TestILU0LevelSchedule(void)
+{
+    // the lower triangle of a 5-point stencil on a 4x6 grid has one
+    // level per anti-diagonal of the grid
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 4, 6);
+
+    cusp::precond::ilu0<float, cusp::host_memory> M(A);
+
+    ASSERT_EQUAL(M.L.num_levels(), size_t(9));
+    ASSERT_EQUAL(M.U.num_levels(), size_t(9));
+    ASSERT_EQUAL(M.L.level_offsets[0], 0);
+    ASSERT_EQUAL(M.L.level_offsets[1], 1);
+    ASSERT_EQUAL(M.L.level_offsets[9], 24);
+    ASSERT_EQUAL(M.L.row_order[0], 0);
+    ASSERT_EQUAL(M.U.row_order[0], 23);
+}
+DECLARE_UNITTEST(TestILU0LevelSchedule);
+
+void TestILU0MissingDiagonal(void)
+{
+    cusp::array2d<float, cusp::host_memory> D(2,2);
+    D(0,0) = 0.0; D(0,1) = 1.0;
+    D(1,0) = 1.0; D(1,1) = 1.0;
+
+    cusp::csr_matrix<int, float, cusp::host_memory> A(D);
+
+    typedef cusp::precond::ilu0<float, cusp::host_memory> Preconditioner;
+
+    ASSERT_THROWS(Preconditioner M(A), cusp::invalid_input_exception);
+}
+DECLARE_UNITTEST(TestILU0MissingDiagonal);
+
+template <class MemorySpace>
+void TestILU0Convergence(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 50, 50);
+
+    cusp::array1d<float, MemorySpace> b(A.num_rows, 1.0f);
+
+    size_t unpreconditioned_iterations;
+
+    {
+        cusp::array1d<float, MemorySpace> x(A.num_rows, 0.0f);
+        cusp::monitor<float> monitor(b, 1000, 1e-5);
+        cusp::krylov::cg(A, x, b, monitor);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+        unpreconditioned_iterations = monitor.iteration_count();
+    }
+
+    {
+        cusp::array1d<float, MemorySpace> x(A.num_rows, 0.0f);
+        cusp::monitor<float> monitor(b, 1000, 1e-5);
+        cusp::precond::ic0<float, MemorySpace> M(A);
+        cusp::krylov::cg(A, x, b, monitor, M);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+        ASSERT_EQUAL(monitor.iteration_count() < unpreconditioned_iterations, true);
+    }
+
+    {
+        cusp::array1d<float, MemorySpace> x(A.num_rows, 0.0f);
+        cusp::monitor<float> monitor(b, 1000, 1e-5);
+        cusp::precond::ilu0<float, MemorySpace> M(A);
+        cusp::krylov::bicgstab(A, x, b, monitor, M);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestILU0Convergence);
@@ -5,6 +5,12 @@
 #include <cusp/coo_matrix.h>
 #include <cusp/csr_matrix.h>
 #include <cusp/array2d.h>
+#include <cusp/gallery/poisson.h>
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
 
 #include <stdio.h>
 
@@ -324,3 +330,89 @@ void TestWriteMatrixMarketFileCoordinateComplexGeneral(void)
 }
 DECLARE_HOST_DEVICE_UNITTEST(TestWriteMatrixMarketFileCoordinateComplexGeneral);
 
+
+void TestWriteMatrixMarketStreamCoordinateExact(void)
+{
+    cusp::coo_matrix<int, double, cusp::host_memory> A(3, 3, 5);
+    A.row_indices[0] = 0; A.column_indices[0] = 0; A.values[0] =  1.5;
+    A.row_indices[1] = 0; A.column_indices[1] = 2; A.values[1] =  0.1;
+    A.row_indices[2] = 1; A.column_indices[2] = 1; A.values[2] = -2.0;
+    A.row_indices[3] = 2; A.column_indices[3] = 0; A.values[3] =  1e6;
+    A.row_indices[4] = 2; A.column_indices[4] = 2; A.values[4] =  1.0 / 3.0;
+
+    std::ostringstream output;
+    cusp::io::write_matrix_market_stream(A, output);
+
+    ASSERT_EQUAL(output.str(),
+                 std::string("%%MatrixMarket matrix coordinate real general\n"
+                             "\t3\t3\t5\n"
+                             "1 1 1.5\n"
+                             "1 3 0.1\n"
+                             "2 2 -2\n"
+                             "3 1 1e+06\n"
+                             "3 3 0.3333333333333333\n"));
+
+    cusp::coo_matrix<int, cusp::complex<float>, cusp::host_memory> B(2, 2, 1);
+    B.row_indices[0] = 1; B.column_indices[0] = 0; B.values[0] = cusp::complex<float>(0.1f, -3.0f);
+
+    std::ostringstream complex_output;
+    cusp::io::write_matrix_market_stream(B, complex_output);
+
+    ASSERT_EQUAL(complex_output.str(),
+                 std::string("%%MatrixMarket matrix coordinate complex general\n"
+                             "\t2\t2\t1\n"
+                             "2 1 0.1 -3\n"));
+}
+DECLARE_UNITTEST(TestWriteMatrixMarketStreamCoordinateExact);
+
+void TestWriteMatrixMarketFileRoundTrip(void)
+{
+    // values that need all significant digits to read back exactly
+    cusp::array1d<double, cusp::host_memory> a(1000);
+
+    for (size_t i = 0; i < a.size(); i++)
+        a[i] = std::sin(double(i + 1)) * std::pow(10.0, int(i % 41) - 20);
+
+    cusp::io::write_matrix_market_file(a, random_file_name);
+
+    cusp::array1d<double, cusp::host_memory> b;
+    cusp::io::read_matrix_market_file(b, random_file_name);
+
+    remove(random_file_name);
+
+    ASSERT_EQUAL(a == b, true);
+}
+DECLARE_UNITTEST(TestWriteMatrixMarketFileRoundTrip);
+
+template <typename MemorySpace>
+void TestWriteMatrixMarketFileCoordinateSymmetric(void)
+{
+    cusp::coo_matrix<int, float, MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 4, 5);
+
+    // write the lower triangle only
+    cusp::io::write_matrix_market_file(A, random_file_name, true);
+
+    std::ifstream file(random_file_name);
+    std::string banner;
+    std::getline(file, banner);
+    file.close();
+
+    cusp::coo_matrix<int, float, MemorySpace> B;
+    cusp::io::read_matrix_market_file(B, random_file_name);
+
+    remove(random_file_name);
+
+    ASSERT_EQUAL(banner, std::string("%%MatrixMarket matrix coordinate real symmetric"));
+    ASSERT_EQUAL(B.num_entries, A.num_entries);
+    ASSERT_EQUAL(B.row_indices == A.row_indices, true);
+    ASSERT_EQUAL(B.column_indices == A.column_indices, true);
+    ASSERT_EQUAL(B.values == A.values, true);
+
+    // non-square matrices cannot be written as symmetric
+    cusp::coo_matrix<int, float, MemorySpace> C(2, 3, 0);
+    ASSERT_THROWS(cusp::io::write_matrix_market_file(C, random_file_name, true), cusp::invalid_input_exception);
+
+    remove(random_file_name);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestWriteMatrixMarketFileCoordinateSymmetric);
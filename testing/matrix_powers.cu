@@ -0,0 +1,97 @@
+#include <unittest/unittest.h>
+
+#include <cusp/array1d.h>
+#include <cusp/array2d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/matrix_powers.h>
+
+#include <thrust/copy.h>
+
+// V(:,j+1) = (A V(:,j) - alpha[j] V(:,j) - beta[j] V(:,j-1)) / gamma[j]
+// with one multiplication per step
+template <typename MatrixType, typename Array2d, typename Basis>
+void reference_matrix_powers(const MatrixType& A, Array2d& V, const Basis& basis)
+{
+    typedef typename Array2d::value_type ValueType;
+    typedef typename Array2d::memory_space MemorySpace;
+
+    for (size_t j = 0; j < basis.size(); j++)
+    {
+        cusp::array1d<ValueType, MemorySpace> vj(V.column(j));
+        cusp::array1d<ValueType, MemorySpace> vj1(V.num_rows);
+
+        cusp::multiply(A, vj, vj1);
+        cusp::blas::axpy(vj, vj1, -ValueType(basis.alpha[j]));
+
+        if (j > 0)
+            cusp::blas::axpy(V.column(j - 1), vj1, -ValueType(basis.beta[j]));
+
+        cusp::blas::scal(vj1, ValueType(1) / ValueType(basis.gamma[j]));
+        cusp::blas::copy(vj1, V.column(j + 1));
+    }
+}
+
+template <typename SparseMatrix, typename Basis>
+void check_matrix_powers(const Basis& basis)
+{
+    typedef typename SparseMatrix::value_type   ValueType;
+    typedef typename SparseMatrix::memory_space MemorySpace;
+    typedef cusp::array2d<ValueType, MemorySpace, cusp::column_major> Block;
+
+    // more rows than one block of the host kernel
+    SparseMatrix A;
+    cusp::gallery::poisson5pt(A, 70, 70);
+
+    const size_t s = basis.size();
+
+    cusp::array1d<ValueType, cusp::host_memory> v0(A.num_rows);
+    for (size_t i = 0; i < A.num_rows; i++)
+        v0[i] = ValueType(i % 7) / ValueType(7);
+
+    Block V(A.num_rows, s + 1, ValueType(0));
+    Block W(A.num_rows, s + 1, ValueType(0));
+    thrust::copy(v0.begin(), v0.end(), V.values.begin());
+    thrust::copy(v0.begin(), v0.end(), W.values.begin());
+
+    cusp::krylov::matrix_powers(A, V, basis);
+    reference_matrix_powers(A, W, basis);
+
+    cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> V_host(V);
+    cusp::array2d<ValueType, cusp::host_memory, cusp::column_major> W_host(W);
+
+    ASSERT_ALMOST_EQUAL(V_host.values, W_host.values);
+}
+
+template <typename SparseMatrix>
+void TestMatrixPowers(void)
+{
+    typedef typename SparseMatrix::value_type ValueType;
+
+    check_matrix_powers<SparseMatrix>(cusp::krylov::monomial_basis<ValueType>(1));
+    check_matrix_powers<SparseMatrix>(cusp::krylov::monomial_basis<ValueType>(3));
+    check_matrix_powers<SparseMatrix>(cusp::krylov::chebyshev_basis<ValueType>(5, 0, 8));
+
+    cusp::array1d<ValueType, cusp::host_memory> shifts(4);
+    shifts[0] = 7.5; shifts[1] = 0.5; shifts[2] = 4.0; shifts[3] = 6.0;
+
+    check_matrix_powers<SparseMatrix>(cusp::krylov::newton_basis(shifts));
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestMatrixPowers);
+
+void TestMatrixPowersInvalidInput(void)
+{
+    typedef cusp::array2d<float, cusp::host_memory, cusp::column_major> Block;
+
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 4, 4);
+
+    Block V(A.num_rows, 3, 1.0f);
+
+    ASSERT_THROWS(cusp::krylov::matrix_powers(A, V, cusp::krylov::monomial_basis<float>(3)), cusp::invalid_input_exception);
+    ASSERT_THROWS(cusp::krylov::chebyshev_basis<float>(3, 1.0f, 1.0f), cusp::invalid_input_exception);
+}
+DECLARE_UNITTEST(TestMatrixPowersInvalidInput);
@@ -181,3 +181,41 @@ void TestMaximalIndependentSet(void)
 }
 DECLARE_SPARSE_MATRIX_UNITTEST(TestMaximalIndependentSet);
 
+template <typename MemorySpace>
+void TestMaximalIndependentSetRounds(void)
+{
+    typedef cusp::csr_matrix<int,float,MemorySpace> TestMatrix;
+
+    cusp::coo_matrix<int,float,cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 40, 40);
+    thrust::fill(A.values.begin(), A.values.end(), 1.0f);
+
+    TestMatrix G(A);
+
+    cusp::array1d<int, MemorySpace> stencil;
+    size_t num_rounds = 0;
+
+    for (size_t k = 1; k <= 2; k++)
+    {
+        size_t num_nodes = cusp::graph::maximal_independent_set(G, stencil, k, num_rounds);
+
+        ASSERT_EQUAL(thrust::count(stencil.begin(), stencil.end(), 1), num_nodes);
+        ASSERT_EQUAL(num_rounds >= 1, true);
+        ASSERT_EQUAL(num_rounds <= G.num_rows, true);
+
+        if (k == 1)
+            ASSERT_EQUAL(is_valid_mis(G, stencil), true);
+
+        // the set is reproducible
+        cusp::array1d<int, MemorySpace> stencil2;
+        size_t num_rounds2 = 0;
+        cusp::graph::maximal_independent_set(G, stencil2, k, num_rounds2);
+
+        ASSERT_EQUAL(stencil2, stencil);
+        ASSERT_EQUAL(num_rounds2, num_rounds);
+    }
+
+    cusp::graph::maximal_independent_set(G, stencil, 0, num_rounds);
+    ASSERT_EQUAL(num_rounds, size_t(0));
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestMaximalIndependentSetRounds);
@@ -67,3 +67,60 @@ void TestMonitorSimple(void)
 }
 DECLARE_HOST_DEVICE_UNITTEST(TestMonitorSimple);
 
+
+template <typename MemorySpace>
+void TestMonitorFinishedNorm(void)
+{
+    cusp::array1d<float,MemorySpace> b(2);
+    b[0] = 10;
+    b[1] =  0;
+
+    cusp::monitor<float> monitor(b, 3, 0.5, 1.0);
+
+    ASSERT_EQUAL(monitor.residual_norm() > 6.0, true);
+
+    ASSERT_EQUAL(monitor.finished_norm(10.0f), false);
+    ASSERT_EQUAL(monitor.residual_norm(), 10.0);
+
+    ++monitor;
+
+    ASSERT_EQUAL(monitor.finished_norm(5.0f), true);
+    ASSERT_EQUAL(monitor.converged(), true);
+    ASSERT_EQUAL(monitor.residual_norm(), 5.0);
+
+    // the history holds every tested norm
+    ASSERT_EQUAL(monitor.residuals.size(), 2);
+    ASSERT_EQUAL(monitor.residuals[0], 10.0);
+    ASSERT_EQUAL(monitor.residuals[1],  5.0);
+    ASSERT_EQUAL(monitor.residuals.capacity() >= 4, true);
+
+    ++monitor;
+    ++monitor;
+
+    ASSERT_EQUAL(monitor.finished_norm(7.0f), true);
+    ASSERT_EQUAL(monitor.converged(), false);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestMonitorFinishedNorm);
+
+template <typename MemorySpace>
+void TestMonitorReplaceResidual(void)
+{
+    cusp::array1d<float,MemorySpace> b(2, 1);
+
+    cusp::monitor<float> monitor(b, 10);
+
+    ASSERT_EQUAL(monitor.replacement_interval(), 0);
+
+    for (int i = 0; i < 10; i++, ++monitor)
+        ASSERT_EQUAL(monitor.replace_residual(), false);
+
+    monitor.reset(b);
+    monitor.set_replacement_interval(3);
+
+    ASSERT_EQUAL(monitor.replacement_interval(), 3);
+
+    // iterations 3, 6 and 9 recompute the residual
+    for (int i = 0; i < 10; i++, ++monitor)
+        ASSERT_EQUAL(monitor.replace_residual(), (i + 1) % 3 == 0);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestMonitorReplaceResidual);
@@ -0,0 +1,161 @@
+#include <unittest/unittest.h>
+
+#include <cusp/graph/breadth_first_search.h>
+#include <cusp/graph/multi_source_bfs.h>
+#include <cusp/graph/pseudo_peripheral.h>
+
+#include <cusp/array2d.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+
+#include <cusp/gallery/grid.h>
+#include <cusp/gallery/poisson.h>
+
+#include <thrust/extrema.h>
+
+template <typename TestMatrix, typename ExampleMatrix>
+void _TestMultiSourceBFS(const ExampleMatrix& example_matrix)
+{
+    typedef typename TestMatrix::index_type   IndexType;
+    typedef typename TestMatrix::value_type   ValueType;
+    typedef typename TestMatrix::memory_space MemorySpace;
+
+    TestMatrix test_matrix(example_matrix);
+
+    const IndexType N = test_matrix.num_rows;
+
+    // every third vertex, so that large graphs need several batches
+    cusp::array1d<IndexType, cusp::host_memory> h_sources;
+    for (IndexType i = 0; i < N; i += 3)
+        h_sources.push_back(i);
+
+    cusp::array1d<IndexType, MemorySpace> sources(h_sources);
+    cusp::array1d<IndexType, MemorySpace> eccentricities(sources.size(), -1);
+    cusp::array1d<IndexType, MemorySpace> farthest(sources.size(), -1);
+
+    cusp::graph::multi_source_bfs(test_matrix, sources, eccentricities, farthest);
+
+    cusp::array1d<IndexType, cusp::host_memory> h_eccentricities(eccentricities);
+    cusp::array1d<IndexType, cusp::host_memory> h_farthest(farthest);
+
+    // compare with single-source traversals on the host
+    cusp::csr_matrix<IndexType, ValueType, cusp::host_memory> h_test_matrix(test_matrix);
+    cusp::array1d<IndexType, cusp::host_memory> levels(N);
+
+    for (size_t i = 0; i < h_sources.size(); i++)
+    {
+        cusp::graph::breadth_first_search(h_test_matrix, h_sources[i], levels, true);
+
+        IndexType eccentricity = *thrust::max_element(levels.begin(), levels.end());
+
+        ASSERT_EQUAL(h_eccentricities[i], eccentricity);
+        ASSERT_EQUAL(levels[h_farthest[i]], eccentricity);
+    }
+}
+
+template <typename TestMatrix>
+void TestMultiSourceBFS(void)
+{
+    typedef typename TestMatrix::value_type ValueType;
+
+    // complete graph
+    cusp::array2d<ValueType,cusp::host_memory> C(6,6,1);
+
+    // empty graph
+    cusp::array2d<ValueType,cusp::host_memory> D(6,6,0);
+
+    cusp::coo_matrix<int,ValueType,cusp::host_memory> E;
+    cusp::gallery::poisson5pt(E, 3, 3);
+
+    cusp::coo_matrix<int,ValueType,cusp::host_memory> F;
+    cusp::gallery::poisson5pt(F, 13, 17);
+
+    cusp::coo_matrix<int,ValueType,cusp::host_memory> G;
+    cusp::gallery::poisson5pt(G, 23, 24);
+
+    _TestMultiSourceBFS<TestMatrix>(C);
+    _TestMultiSourceBFS<TestMatrix>(D);
+    _TestMultiSourceBFS<TestMatrix>(E);
+    _TestMultiSourceBFS<TestMatrix>(F);
+    _TestMultiSourceBFS<TestMatrix>(G);
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestMultiSourceBFS)
+
+template <typename MemorySpace>
+void TestMultiSourceBFSGrid(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> G;
+    cusp::gallery::grid2d(G, 4, 4);
+
+    cusp::array1d<int, MemorySpace> sources(4);
+    sources[0] = 0;
+    sources[1] = 3;
+    sources[2] = 5;
+    sources[3] = 15;
+
+    cusp::array1d<int, MemorySpace> eccentricities(4);
+    cusp::array1d<int, MemorySpace> farthest(4);
+
+    cusp::graph::multi_source_bfs(G, sources, eccentricities, farthest);
+
+    ASSERT_EQUAL(eccentricities[0], 6);
+    ASSERT_EQUAL(eccentricities[1], 6);
+    ASSERT_EQUAL(eccentricities[2], 4);
+    ASSERT_EQUAL(eccentricities[3], 6);
+
+    ASSERT_EQUAL(farthest[0], 15);
+    ASSERT_EQUAL(farthest[1], 12);
+    ASSERT_EQUAL(farthest[2], 15);
+    ASSERT_EQUAL(farthest[3], 0);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestMultiSourceBFSGrid)
+
+template <typename MemorySpace>
+void TestPseudoPeripheralVertexSeed(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> G;
+    cusp::gallery::grid2d(G, 7, 5);
+
+    cusp::array1d<int, MemorySpace> levels(G.num_rows);
+
+    for (unsigned int seed = 0; seed < 4; seed++)
+    {
+        int x = cusp::graph::pseudo_peripheral_vertex(G, levels, seed);
+        int y = cusp::graph::pseudo_peripheral_vertex(G, levels, seed);
+
+        // a corner of the grid, found the same way every time
+        ASSERT_EQUAL(x, y);
+        ASSERT_EQUAL(x == 0 || x == 6 || x == 28 || x == 34, true);
+        ASSERT_EQUAL(*thrust::max_element(levels.begin(), levels.end()), 10);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestPseudoPeripheralVertexSeed)
+
+template <typename MatrixType, typename ArrayType1, typename ArrayType2, typename ArrayType3>
+void multi_source_bfs(my_system& system,
+                      const MatrixType& G,
+                      const ArrayType1& sources,
+                      ArrayType2& eccentricities,
+                      ArrayType3& farthest)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestMultiSourceBFSDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::array1d<int, cusp::device_memory> sources;
+    cusp::array1d<int, cusp::device_memory> eccentricities;
+    cusp::array1d<int, cusp::device_memory> farthest;
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::graph::multi_source_bfs(sys, A, sources, eccentricities, farthest);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestMultiSourceBFSDispatch);
@@ -0,0 +1,77 @@
+#include <unittest/unittest.h>
+
+#include <cusp/graph/multilevel_partition.h>
+
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+
+#include <cusp/gallery/poisson.h>
+
+template <typename TestMatrix>
+void TestMultilevelPartition(void)
+{
+    typedef typename TestMatrix::index_type   IndexType;
+    typedef typename TestMatrix::value_type   ValueType;
+    typedef typename TestMatrix::memory_space MemorySpace;
+
+    cusp::coo_matrix<IndexType,ValueType,cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 20, 20);
+
+    TestMatrix G(A);
+
+    for (size_t num_parts = 1; num_parts <= 8; num_parts *= 2)
+    {
+        cusp::array1d<IndexType,MemorySpace> parts(G.num_rows, -1);
+
+        cusp::graph::multilevel_partition(G, num_parts, parts);
+
+        cusp::array1d<IndexType,cusp::host_memory> h_parts(parts);
+        cusp::array1d<IndexType,cusp::host_memory> sizes(num_parts, 0);
+
+        for (size_t i = 0; i < h_parts.size(); i++)
+        {
+            ASSERT_EQUAL(h_parts[i] >= 0 && h_parts[i] < IndexType(num_parts), true);
+            sizes[h_parts[i]]++;
+        }
+
+        // parts of nearly equal size
+        for (size_t p = 0; p < num_parts; p++)
+        {
+            ASSERT_EQUAL(sizes[p] >= IndexType(0.9 * G.num_rows / num_parts), true);
+            ASSERT_EQUAL(sizes[p] <= IndexType(1.1 * G.num_rows / num_parts), true);
+        }
+
+        // the cut of the straight partitions is 20 edges per bisection
+        IndexType cut = 0;
+
+        for (size_t n = 0; n < A.num_entries; n++)
+            if (h_parts[A.row_indices[n]] != h_parts[A.column_indices[n]])
+                cut++;
+
+        ASSERT_EQUAL(cut / 2 <= IndexType(2 * 20 * (num_parts - 1)), true);
+    }
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestMultilevelPartition)
+
+template <typename MatrixType, typename ArrayType>
+void multilevel_partition(my_system& system, const MatrixType& G, const size_t num_parts, ArrayType& parts)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestMultilevelPartitionDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::array1d<int, cusp::device_memory> parts;
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::graph::multilevel_partition(sys, A, 2, parts);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestMultilevelPartitionDispatch);
@@ -0,0 +1,76 @@
+#include <unittest/unittest.h>
+
+#include <cusp/graph/nested_dissection.h>
+
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/permutation_matrix.h>
+
+#include <cusp/gallery/poisson.h>
+
+template <typename TestMatrix>
+void TestNestedDissection(void)
+{
+    typedef typename TestMatrix::index_type   IndexType;
+    typedef typename TestMatrix::value_type   ValueType;
+    typedef typename TestMatrix::memory_space MemorySpace;
+
+    cusp::coo_matrix<IndexType,ValueType,cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 30, 30);
+
+    TestMatrix G(A);
+
+    cusp::permutation_matrix<IndexType,MemorySpace> P(G.num_rows);
+
+    cusp::graph::nested_dissection(G, P);
+
+    cusp::array1d<IndexType,cusp::host_memory> permutation(P.permutation);
+    cusp::array1d<IndexType,cusp::host_memory> count(G.num_rows, 0);
+
+    // the ordering is a permutation
+    for (size_t i = 0; i < permutation.size(); i++)
+    {
+        ASSERT_EQUAL(permutation[i] >= 0 && permutation[i] < IndexType(G.num_rows), true);
+        count[permutation[i]]++;
+    }
+
+    for (size_t i = 0; i < count.size(); i++)
+        ASSERT_EQUAL(count[i], 1);
+
+    // the top-level separator is numbered last and splits the grid, so the
+    // first half is not connected to the second half
+    const IndexType N = G.num_rows;
+    const IndexType separator = 30 + 30;
+
+    for (size_t n = 0; n < A.num_entries; n++)
+    {
+        IndexType i = permutation[A.row_indices[n]];
+        IndexType j = permutation[A.column_indices[n]];
+
+        ASSERT_EQUAL(i < N / 2 - separator && j >= N / 2 + separator && j < N - separator, false);
+    }
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestNestedDissection)
+
+template <typename MatrixType, typename PermutationType>
+void nested_dissection(my_system& system, const MatrixType& G, PermutationType& P)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestNestedDissectionDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::permutation_matrix<int,cusp::device_memory> P;
+
+    my_system sys(0);
+
+    // call with explicit dispatching
+    cusp::graph::nested_dissection(sys, A, P);
+
+    // check if dispatch policy was used
+    ASSERT_EQUAL(true, sys.is_valid());
+}
+DECLARE_UNITTEST(TestNestedDissectionDispatch);
@@ -0,0 +1,179 @@
+#include <unittest/unittest.h>
+
+#include <cusp/operator_expressions.h>
+
+#include <cusp/array2d.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/cg.h>
+
+template <typename ValueType, typename MemorySpace>
+void initialize_operator_test(cusp::array2d<ValueType, MemorySpace>& A,
+                              cusp::array1d<ValueType, MemorySpace>& x,
+                              cusp::array1d<ValueType, MemorySpace>& d)
+{
+    A.resize(3,3);
+    A(0,0) = 1.0; A(0,1) = 2.0; A(0,2) = 0.0;
+    A(1,0) = 0.0; A(1,1) = 3.0; A(1,2) = 4.0;
+    A(2,0) = 5.0; A(2,1) = 0.0; A(2,2) = 6.0;
+
+    x.resize(3);
+    x[0] = 1.0; x[1] = 2.0; x[2] = 3.0;
+
+    d.resize(3);
+    d[0] = 2.0; d[1] = -1.0; d[2] = 0.5;
+}
+
+template <typename SparseMatrix>
+void TestShiftScaleDiagScale(void)
+{
+    typedef typename SparseMatrix::value_type   ValueType;
+    typedef typename SparseMatrix::memory_space MemorySpace;
+
+    cusp::array2d<ValueType, MemorySpace> D;
+    cusp::array1d<ValueType, MemorySpace> x;
+    cusp::array1d<ValueType, MemorySpace> d;
+    initialize_operator_test(D, x, d);
+
+    SparseMatrix A(D);
+
+    // A * x = [5, 18, 23]
+    cusp::array1d<ValueType, MemorySpace> y(3, ValueType(0));
+
+    cusp::multiply(cusp::shift(A, ValueType(2)), x, y);
+    ASSERT_EQUAL(y[0], ValueType( 7));
+    ASSERT_EQUAL(y[1], ValueType(22));
+    ASSERT_EQUAL(y[2], ValueType(29));
+
+    cusp::multiply(cusp::scale(A, ValueType(-2)), x, y);
+    ASSERT_EQUAL(y[0], ValueType(-10));
+    ASSERT_EQUAL(y[1], ValueType(-36));
+    ASSERT_EQUAL(y[2], ValueType(-46));
+
+    cusp::multiply(cusp::diag_scale(d, A), x, y);
+    ASSERT_EQUAL(y[0], ValueType( 10));
+    ASSERT_EQUAL(y[1], ValueType(-18));
+    ASSERT_EQUAL(y[2], ValueType(11.5));
+
+    // 2 * (D * A + I) collapses into a single affine operator
+    cusp::multiply(cusp::scale(cusp::shift(cusp::diag_scale(d, A), ValueType(1)), ValueType(2)), x, y);
+    ASSERT_EQUAL(y[0], ValueType( 22));
+    ASSERT_EQUAL(y[1], ValueType(-32));
+    ASSERT_EQUAL(y[2], ValueType( 29));
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestShiftScaleDiagScale);
+
+template <typename SparseMatrix>
+void TestSumProductTranspose(void)
+{
+    typedef typename SparseMatrix::value_type   ValueType;
+    typedef typename SparseMatrix::memory_space MemorySpace;
+
+    cusp::array2d<ValueType, MemorySpace> D;
+    cusp::array1d<ValueType, MemorySpace> x;
+    cusp::array1d<ValueType, MemorySpace> d;
+    initialize_operator_test(D, x, d);
+
+    SparseMatrix A(D);
+
+    cusp::array1d<ValueType, MemorySpace> y(3, ValueType(0));
+
+    // A^T * x = [16, 8, 26]
+    cusp::multiply(cusp::transpose_view(A), x, y);
+    ASSERT_EQUAL(y[0], ValueType(16));
+    ASSERT_EQUAL(y[1], ValueType( 8));
+    ASSERT_EQUAL(y[2], ValueType(26));
+
+    // (A + A^T) * x
+    cusp::multiply(cusp::sum(A, cusp::transpose_view(A)), x, y);
+    ASSERT_EQUAL(y[0], ValueType(21));
+    ASSERT_EQUAL(y[1], ValueType(26));
+    ASSERT_EQUAL(y[2], ValueType(49));
+
+    // A^T * A * x = A^T * [5, 18, 23]
+    cusp::multiply(cusp::product(cusp::transpose_view(A), A), x, y);
+    ASSERT_EQUAL(y[0], ValueType(120));
+    ASSERT_EQUAL(y[1], ValueType( 64));
+    ASSERT_EQUAL(y[2], ValueType(210));
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestSumProductTranspose);
+
+template <typename SparseMatrix>
+void TestTransposeOperatorRefresh(void)
+{
+    typedef typename SparseMatrix::value_type   ValueType;
+    typedef typename SparseMatrix::memory_space MemorySpace;
+
+    cusp::array2d<ValueType, MemorySpace> D;
+    cusp::array1d<ValueType, MemorySpace> x;
+    cusp::array1d<ValueType, MemorySpace> d;
+    initialize_operator_test(D, x, d);
+
+    SparseMatrix A(D);
+
+    cusp::transpose_operator<SparseMatrix> At = cusp::transpose_view(A);
+
+    cusp::array1d<ValueType, MemorySpace> y(3, ValueType(0));
+
+    cusp::multiply(At, x, y);
+    ASSERT_EQUAL(y[0], ValueType(16));
+    ASSERT_EQUAL(y[1], ValueType( 8));
+    ASSERT_EQUAL(y[2], ValueType(26));
+
+    // new values with the same sparsity pattern
+    cusp::array2d<ValueType, cusp::host_memory> D2(D);
+    for (size_t i = 0; i < D2.num_rows; i++)
+        for (size_t j = 0; j < D2.num_cols; j++)
+            D2(i,j) *= ValueType(2);
+
+    A = SparseMatrix(D2);
+    At.refresh();
+
+    cusp::multiply(At, x, y);
+    ASSERT_EQUAL(y[0], ValueType(32));
+    ASSERT_EQUAL(y[1], ValueType(16));
+    ASSERT_EQUAL(y[2], ValueType(52));
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestTransposeOperatorRefresh);
+
+void TestOperatorExpressionDimensions(void)
+{
+    cusp::coo_matrix<int, float, cusp::host_memory> A(3, 4, 0);
+    cusp::coo_matrix<int, float, cusp::host_memory> B(3, 3, 0);
+    cusp::array1d<float, cusp::host_memory> d(4);
+
+    ASSERT_THROWS(cusp::shift(A, 1.0f), cusp::invalid_input_exception);
+    ASSERT_THROWS(cusp::sum(A, B), cusp::invalid_input_exception);
+    ASSERT_THROWS(cusp::product(A, B), cusp::invalid_input_exception);
+    ASSERT_THROWS(cusp::diag_scale(d, A), cusp::invalid_input_exception);
+}
+DECLARE_UNITTEST(TestOperatorExpressionDimensions);
+
+template <class MemorySpace>
+void TestShiftedConjugateGradient(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 10, 10);
+
+    cusp::array1d<float, MemorySpace> x(A.num_rows, 0.0f);
+    cusp::array1d<float, MemorySpace> b(A.num_rows, 1.0f);
+    cusp::array1d<float, MemorySpace> r(A.num_rows);
+
+    cusp::monitor<float> monitor(b, 100, 1e-5);
+
+    cusp::krylov::cg(cusp::shift(A, 0.5f), x, b, monitor);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+
+    // verify the residual of the explicitly shifted system
+    cusp::multiply(A, x, r);
+    cusp::blas::axpy(x, r, 0.5f);
+    cusp::blas::axpy(b, r, -1.0f);
+
+    ASSERT_EQUAL(cusp::blas::nrm2(r) < 1e-4 * cusp::blas::nrm2(b), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestShiftedConjugateGradient);
@@ -0,0 +1,115 @@
+#include <unittest/unittest.h>
+
+#include <cusp/reduced_precision.h>
+
+#include <cusp/array1d.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/cg.h>
+
+#include <thrust/system/cpp/execution_policy.h>
+
+void TestBfloat16Conversion(void)
+{
+    // exactly representable values
+    ASSERT_EQUAL(float(cusp::bfloat16(1.0f)), 1.0f);
+    ASSERT_EQUAL(float(cusp::bfloat16(-2.5f)), -2.5f);
+    ASSERT_EQUAL(float(cusp::bfloat16(0.15625f)), 0.15625f);
+
+    // ties round to the even mantissa
+    ASSERT_EQUAL(float(cusp::bfloat16(1.0f + 1.0f / 256)), 1.0f);
+    ASSERT_EQUAL(float(cusp::bfloat16(1.0f + 3.0f / 256)), 1.0f + 1.0f / 64);
+
+    // the range of float is kept
+    ASSERT_ALMOST_EQUAL(float(cusp::bfloat16(1e30f)), 1e30f);
+    ASSERT_ALMOST_EQUAL(float(cusp::bfloat16(-3e-30f)), -3e-30f);
+}
+DECLARE_UNITTEST(TestBfloat16Conversion);
+
+template <typename StorageType, typename MemorySpace>
+void _TestReducedPrecisionMultiply(const double tolerance)
+{
+    cusp::csr_matrix<int, double, cusp::host_memory> H;
+    cusp::gallery::poisson5pt(H, 20, 30);
+
+    // rows with different magnitudes
+    cusp::array1d<double, cusp::host_memory> samples = unittest::random_samples<double>(H.num_entries);
+
+    for (size_t i = 0; i < H.num_rows; i++)
+        for (int jj = H.row_offsets[i]; jj < H.row_offsets[i + 1]; jj++)
+            H.values[jj] *= (1.0 + samples[jj]) * (i % 7 + 1) * 1e-3;
+
+    cusp::csr_matrix<int, double, MemorySpace> A(H);
+    cusp::reduced_precision_csr_matrix<int, StorageType, double, MemorySpace> S(A);
+
+    ASSERT_EQUAL(S.num_rows, A.num_rows);
+    ASSERT_EQUAL(S.num_entries, A.num_entries);
+
+    cusp::array1d<double, MemorySpace> x = unittest::random_samples<double>(A.num_cols);
+    cusp::array1d<double, MemorySpace> y(A.num_rows);
+    cusp::array1d<double, MemorySpace> z(A.num_rows);
+
+    cusp::multiply(A, x, y);
+    cusp::multiply(S, x, z);
+
+    cusp::blas::axpy(y, z, -1.0);
+
+    ASSERT_EQUAL(cusp::blas::nrmmax(z) <= tolerance * cusp::blas::nrmmax(y), true);
+}
+
+template <typename MemorySpace>
+void TestReducedPrecisionMultiply(void)
+{
+    _TestReducedPrecisionMultiply<float, MemorySpace>(1e-6);
+    _TestReducedPrecisionMultiply<cusp::bfloat16, MemorySpace>(5e-2);
+    _TestReducedPrecisionMultiply<short, MemorySpace>(1e-3);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestReducedPrecisionMultiply);
+
+void TestReducedPrecisionMultiplySequential(void)
+{
+    cusp::csr_matrix<int, double, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 20, 30);
+
+    cusp::reduced_precision_csr_matrix<int, float, double, cusp::host_memory> S(A);
+
+    cusp::array1d<double, cusp::host_memory> x = unittest::random_samples<double>(A.num_cols);
+    cusp::array1d<double, cusp::host_memory> y(A.num_rows);
+    cusp::array1d<double, cusp::host_memory> z(A.num_rows);
+
+    // the product follows the execution policy of the caller
+    cusp::multiply(S, x, y);
+    cusp::multiply(thrust::cpp::par, S, x, z);
+
+    ASSERT_EQUAL(z, y);
+}
+DECLARE_UNITTEST(TestReducedPrecisionMultiplySequential);
+
+template <typename MemorySpace>
+void TestReducedPrecisionConjugateGradient(void)
+{
+    cusp::csr_matrix<int, double, MemorySpace> A;
+    cusp::gallery::poisson5pt(A, 40, 40);
+
+    // the entries of the Poisson matrix are exact in single precision
+    cusp::reduced_precision_csr_matrix<int, float, double, MemorySpace> S(A);
+
+    cusp::array1d<double, MemorySpace> x(A.num_rows, 0.0);
+    cusp::array1d<double, MemorySpace> b(A.num_rows, 1.0);
+
+    cusp::monitor<double> monitor(b, 500, 1e-10);
+    cusp::krylov::cg(S, x, b, monitor);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+
+    cusp::array1d<double, MemorySpace> r(A.num_rows);
+    cusp::multiply(A, x, r);
+    cusp::blas::axpy(b, r, -1.0);
+
+    ASSERT_EQUAL(cusp::blas::nrm2(r) <= 1e-9 * cusp::blas::nrm2(b), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestReducedPrecisionConjugateGradient);
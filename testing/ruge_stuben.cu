@@ -0,0 +1,261 @@
+#include <unittest/unittest.h>
+
+#include <cusp/precond/classical/ruge_stuben.h>
+
+#include <cusp/array2d.h>
+#include <cusp/coo_matrix.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/dia_matrix.h>
+#include <cusp/ell_matrix.h>
+#include <cusp/hyb_matrix.h>
+#include <cusp/monitor.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/cg.h>
+
+#include <thrust/count.h>
+
+#include <cstdlib>
+
+void TestClassicalStrengthOfConnection(void)
+{
+    typedef cusp::array2d<float,cusp::host_memory> Matrix;
+
+    Matrix M(3,3);
+    M(0,0) =  4.0;
+    M(0,1) = -1.0;
+    M(0,2) = -0.2;
+    M(1,0) = -1.0;
+    M(1,1) =  4.0;
+    M(1,2) =  1.0;
+    M(2,0) = -2.0;
+    M(2,1) = -2.0;
+    M(2,2) = -4.0;
+
+    cusp::csr_matrix<int,float,cusp::host_memory> A(M);
+    cusp::csr_matrix<int,float,cusp::host_memory> S;
+    cusp::precond::classical::classical_strength_of_connection(A, S, 0.25);
+
+    Matrix result = S;
+
+    // only couplings opposite to the diagonal are strong
+    Matrix N(3,3, 0.0f);
+    N(0,1) = 1.0;
+    N(1,0) = 1.0;
+
+    ASSERT_EQUAL(result == N, true);
+}
+DECLARE_UNITTEST(TestClassicalStrengthOfConnection);
+
+template <typename MemorySpace>
+void TestClassicalSplitting(void)
+{
+    cusp::csr_matrix<int,float,cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 40, 40);
+
+    cusp::csr_matrix<int,float,cusp::host_memory> S;
+    cusp::precond::classical::classical_strength_of_connection(A, S);
+
+    for (int method = 0; method < 2; method++)
+    {
+        cusp::array1d<int,MemorySpace> splitting;
+
+        if (method == 0)
+            cusp::precond::classical::pmis_splitting(S, splitting);
+        else
+            cusp::precond::classical::hmis_splitting(S, splitting);
+
+        cusp::array1d<int,cusp::host_memory> cf(splitting);
+
+        ASSERT_EQUAL(cf.size(), A.num_rows);
+
+        bool coarse_connected = false;
+        bool fine_isolated = false;
+
+        for (size_t i = 0; i < A.num_rows; i++)
+        {
+            bool has_coarse_neighbor = false;
+
+            for (int jj = S.row_offsets[i]; jj < S.row_offsets[i + 1]; jj++)
+                if (cf[S.column_indices[jj]] == 1)
+                    has_coarse_neighbor = true;
+
+            if (cf[i] == 1 && has_coarse_neighbor && method == 0)
+                coarse_connected = true;
+
+            if (cf[i] == 0 && !has_coarse_neighbor)
+                fine_isolated = true;
+        }
+
+        ASSERT_EQUAL(coarse_connected, false);
+        ASSERT_EQUAL(fine_isolated, false);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestClassicalSplitting);
+
+void TestClassicalInterpolation(void)
+{
+    typedef cusp::csr_matrix<int,double,cusp::host_memory> Matrix;
+
+    // graph Laplacian, whose row sums vanish
+    Matrix A;
+    cusp::gallery::poisson5pt(A, 30, 30);
+
+    for (size_t i = 0; i < A.num_rows; i++)
+    {
+        double sum = 0;
+
+        for (int jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            if (A.column_indices[jj] != int(i))
+                sum += A.values[jj];
+
+        for (int jj = A.row_offsets[i]; jj < A.row_offsets[i + 1]; jj++)
+            if (A.column_indices[jj] == int(i))
+                A.values[jj] = -sum;
+    }
+
+    Matrix S;
+    cusp::precond::classical::classical_strength_of_connection(A, S);
+
+    cusp::array1d<int,cusp::host_memory> splitting;
+    cusp::precond::classical::pmis_splitting(S, splitting);
+
+    for (int method = 0; method < 2; method++)
+    {
+        Matrix P;
+
+        if (method == 0)
+            cusp::precond::classical::direct_interpolation(A, S, splitting, P, 0.2, 4);
+        else
+            cusp::precond::classical::extended_i_interpolation(A, S, splitting, P, 0.2, 4);
+
+        ASSERT_EQUAL(P.num_rows, A.num_rows);
+        ASSERT_EQUAL(P.num_cols, size_t(thrust::count(splitting.begin(), splitting.end(), 1)));
+
+        // constants are interpolated exactly and rows are truncated
+        for (size_t i = 0; i < P.num_rows; i++)
+        {
+            double sum = 0;
+
+            for (int jj = P.row_offsets[i]; jj < P.row_offsets[i + 1]; jj++)
+                sum += P.values[jj];
+
+            ASSERT_ALMOST_EQUAL(sum, 1.0);
+            ASSERT_LEQUAL(P.row_offsets[i + 1] - P.row_offsets[i], 4);
+        }
+    }
+}
+DECLARE_UNITTEST(TestClassicalInterpolation);
+
+template <typename SparseMatrix>
+void TestRugeStuben(void)
+{
+    typedef typename SparseMatrix::index_type   IndexType;
+    typedef typename SparseMatrix::value_type   ValueType;
+    typedef typename SparseMatrix::memory_space MemorySpace;
+
+    // Create 2D Poisson problem
+    SparseMatrix A;
+    cusp::gallery::poisson5pt(A, 100, 100);
+
+    // create classical AMG solver
+    cusp::precond::classical::ruge_stuben<IndexType,ValueType,MemorySpace> M(A);
+
+    ASSERT_EQUAL(M.levels.size() > 2, true);
+
+    // test as standalone solver
+    {
+        cusp::array1d<ValueType,MemorySpace> b = unittest::random_samples<ValueType>(A.num_rows);
+        cusp::array1d<ValueType,MemorySpace> x = unittest::random_samples<ValueType>(A.num_rows);
+
+        // set stopping criteria (iteration_limit = 40, relative_tolerance = 1e-4)
+        cusp::monitor<ValueType> monitor(b, 40, 1e-4);
+        M.solve(b,x,monitor);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+        ASSERT_EQUAL(monitor.geometric_rate() < 0.8, true);
+    }
+
+    // test as preconditioner
+    {
+        cusp::array1d<ValueType,MemorySpace> b = unittest::random_samples<ValueType>(A.num_rows);
+        cusp::array1d<ValueType,MemorySpace> x = unittest::random_samples<ValueType>(A.num_rows);
+
+        // set stopping criteria (iteration_limit = 20, relative_tolerance = 1e-4)
+        cusp::monitor<ValueType> monitor(b, 20, 1e-4);
+        cusp::krylov::cg(A, x, b, monitor, M);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+        ASSERT_EQUAL(monitor.geometric_rate() < 0.5, true);
+    }
+}
+DECLARE_SPARSE_MATRIX_UNITTEST(TestRugeStuben);
+
+template <typename MemorySpace>
+void TestRugeStubenOptions(void)
+{
+    typedef int    IndexType;
+    typedef double ValueType;
+
+    // anisotropic 2D problem
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> A_h;
+    cusp::gallery::poisson5pt(A_h, 100, 100);
+
+    for (size_t i = 0; i < A_h.num_rows; i++)
+        for (IndexType jj = A_h.row_offsets[i]; jj < A_h.row_offsets[i + 1]; jj++)
+            if (std::abs(A_h.column_indices[jj] - IndexType(i)) == 1)
+                A_h.values[jj] *= 0.001;
+            else if (A_h.column_indices[jj] == IndexType(i))
+                A_h.values[jj] = 2.002;
+
+    cusp::csr_matrix<IndexType,ValueType,MemorySpace> A(A_h);
+
+    for (int method = 0; method < 3; method++)
+    {
+        cusp::precond::classical::CoarseningType coarsening =
+            method == 2 ? cusp::precond::classical::PMIS : cusp::precond::classical::HMIS;
+        cusp::precond::classical::InterpolationType interpolation =
+            method == 1 ? cusp::precond::classical::Direct : cusp::precond::classical::ExtendedI;
+
+        cusp::precond::classical::ruge_stuben<IndexType,ValueType,MemorySpace> M(A, 0.25, coarsening, interpolation);
+
+        cusp::array1d<ValueType,MemorySpace> b = unittest::random_samples<ValueType>(A.num_rows);
+        cusp::array1d<ValueType,MemorySpace> x(A.num_rows, 0);
+
+        // set stopping criteria (iteration_limit = 40, relative_tolerance = 1e-6)
+        cusp::monitor<ValueType> monitor(b, 40, 1e-6);
+        cusp::krylov::cg(A, x, b, monitor, M);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestRugeStubenOptions);
+
+void TestRugeStubenHostToDevice(void)
+{
+    typedef int                 IndexType;
+    typedef float               ValueType;
+
+    // Create 2D Poisson problem
+    cusp::coo_matrix<IndexType,ValueType,cusp::host_memory> A_h;
+    cusp::gallery::poisson5pt(A_h, 100, 100);
+
+    // create classical AMG solver
+    cusp::precond::classical::ruge_stuben<IndexType,ValueType,cusp::host_memory> M_h(A_h);
+    cusp::precond::classical::ruge_stuben<IndexType,ValueType,cusp::device_memory> M_d(M_h);
+
+    // test as preconditioner
+    {
+        cusp::coo_matrix<IndexType,ValueType,cusp::device_memory> A_d(A_h);
+        cusp::array1d<ValueType,cusp::device_memory> b = unittest::random_samples<ValueType>(A_d.num_rows);
+        cusp::array1d<ValueType,cusp::device_memory> x = unittest::random_samples<ValueType>(A_d.num_rows);
+
+        // set stopping criteria (iteration_limit = 20, relative_tolerance = 1e-4)
+        cusp::monitor<ValueType> monitor(b, 20, 1e-4);
+        cusp::krylov::cg(A_d, x, b, monitor, M_d);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+        ASSERT_EQUAL(monitor.geometric_rate() < 0.5, true);
+    }
+}
+DECLARE_UNITTEST(TestRugeStubenHostToDevice);
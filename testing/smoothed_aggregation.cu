@@ -9,6 +9,7 @@
 #include <cusp/ell_matrix.h>
 #include <cusp/hyb_matrix.h>
 #include <cusp/monitor.h>
+#include <cusp/multiply.h>
 
 #include <cusp/gallery/poisson.h>
 #include <cusp/krylov/cg.h>
@@ -97,3 +98,133 @@ void TestSmoothedAggregationHostToDevice(void)
 }
 DECLARE_UNITTEST(TestSmoothedAggregationHostToDevice);
 
+
+void TestSmoothedAggregationLevelThreads(void)
+{
+    typedef int                 IndexType;
+    typedef double              ValueType;
+
+    cusp::csr_matrix<IndexType,ValueType,cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 200, 200);
+
+    cusp::precond::aggregation::smoothed_aggregation<IndexType,ValueType,cusp::host_memory> M(A);
+
+    const size_t num_levels = M.levels.size();
+
+    ASSERT_EQUAL(num_levels > 2, true);
+
+    // smaller levels never use more threads, the coarse solve uses one
+    ASSERT_EQUAL(M.levels[num_levels - 1].num_threads, 1);
+
+    for (size_t lvl = 0; lvl + 1 < num_levels; lvl++)
+    {
+        ASSERT_EQUAL(M.levels[lvl].num_threads >= 1, true);
+        ASSERT_EQUAL(M.levels[lvl + 1].num_threads <= M.levels[lvl].num_threads, true);
+    }
+
+    // all threads on every level, including the coarse solve
+    M.set_min_entries_per_thread(0);
+
+    const int max_threads = M.levels[0].num_threads;
+
+    for (size_t lvl = 0; lvl < num_levels; lvl++)
+        ASSERT_EQUAL(M.levels[lvl].num_threads, max_threads);
+
+    // a single thread on every level
+    M.set_min_entries_per_thread(A.num_entries + 1);
+
+    for (size_t lvl = 0; lvl < num_levels; lvl++)
+        ASSERT_EQUAL(M.levels[lvl].num_threads, 1);
+
+    M.calibrate_level_threads(2);
+
+    for (size_t lvl = 0; lvl < num_levels; lvl++)
+    {
+        ASSERT_EQUAL(M.levels[lvl].num_threads >= 1, true);
+        ASSERT_EQUAL(M.levels[lvl].num_threads <= max_threads, true);
+    }
+
+    cusp::array1d<ValueType,cusp::host_memory> b = unittest::random_samples<ValueType>(A.num_rows);
+    cusp::array1d<ValueType,cusp::host_memory> x(A.num_rows, 0);
+
+    cusp::monitor<ValueType> monitor(b, 50, 1e-6);
+    cusp::krylov::cg(A, x, b, monitor, M);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+
+    // device levels, including the coarse one, keep the team of the caller
+    cusp::precond::aggregation::smoothed_aggregation<IndexType,ValueType,cusp::device_memory> M_d(A);
+
+    for (size_t lvl = 0; lvl < M_d.levels.size(); lvl++)
+        ASSERT_EQUAL(M_d.levels[lvl].num_threads, 0);
+
+    // a host copy of a device hierarchy selects its own teams
+    cusp::precond::aggregation::smoothed_aggregation<IndexType,ValueType,cusp::host_memory> M_h(M_d);
+
+    ASSERT_EQUAL(M_h.levels.back().num_threads, 1);
+
+    for (size_t lvl = 0; lvl < M_h.levels.size(); lvl++)
+        ASSERT_EQUAL(M_h.levels[lvl].num_threads >= 1, true);
+}
+DECLARE_UNITTEST(TestSmoothedAggregationLevelThreads);
+
+template <class MemorySpace>
+void TestSmoothedAggregationCoarsening(void)
+{
+    typedef int    IndexType;
+    typedef double ValueType;
+    typedef cusp::precond::aggregation::smoothed_aggregation<IndexType,ValueType,MemorySpace> Preconditioner;
+
+    cusp::csr_matrix<IndexType,ValueType,MemorySpace> A;
+    cusp::gallery::poisson7pt(A, 20, 20, 20);
+
+    cusp::array1d<ValueType,MemorySpace> b = unittest::random_samples<ValueType>(A.num_rows);
+
+    Preconditioner M0(A);
+
+    // aggregate the aggregates on the finest level
+    Preconditioner M1;
+    M1.set_aggressive_levels(1);
+    M1.initialize(A);
+
+    ASSERT_EQUAL(M1.levels[1].A.num_rows < M0.levels[1].A.num_rows, true);
+    ASSERT_EQUAL(M1.operator_complexity() < M0.operator_complexity(), true);
+
+    {
+        cusp::array1d<ValueType,MemorySpace> x(A.num_rows, 0);
+        cusp::monitor<ValueType> monitor(b, 100, 1e-6);
+        cusp::krylov::cg(A, x, b, monitor, M1);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+    }
+
+    // drop weak entries of the coarse operators
+    Preconditioner M2;
+    M2.set_sparsification_threshold(0.1);
+    M2.initialize(A);
+
+    ASSERT_EQUAL(M2.levels[1].A.num_rows, M0.levels[1].A.num_rows);
+    ASSERT_EQUAL(M2.levels[1].A.num_entries < M0.levels[1].A.num_entries, true);
+    ASSERT_EQUAL(M2.operator_complexity() < M0.operator_complexity(), true);
+
+    // the dropped entries are moved to the diagonal, so row sums are preserved
+    {
+        cusp::array1d<ValueType,MemorySpace> ones(M0.levels[1].A.num_rows, 1);
+        cusp::array1d<ValueType,MemorySpace> y0(M0.levels[1].A.num_rows);
+        cusp::array1d<ValueType,MemorySpace> y2(M0.levels[1].A.num_rows);
+
+        cusp::multiply(M0.levels[1].A, ones, y0);
+        cusp::multiply(M2.levels[1].A, ones, y2);
+
+        ASSERT_ALMOST_EQUAL(y2, y0);
+    }
+
+    {
+        cusp::array1d<ValueType,MemorySpace> x(A.num_rows, 0);
+        cusp::monitor<ValueType> monitor(b, 100, 1e-6);
+        cusp::krylov::cg(A, x, b, monitor, M2);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSmoothedAggregationCoarsening);
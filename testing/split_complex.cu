@@ -0,0 +1,194 @@
+#include <unittest/unittest.h>
+
+#include <cusp/split_complex.h>
+
+#include <cusp/array1d.h>
+#include <cusp/complex.h>
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/blas/blas.h>
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/gmres.h>
+
+// complex shifted Laplacian -L - (k^2 + i eps) I of a 2d mesh
+template <typename MatrixType>
+void split_complex_test_matrix(MatrixType& A, const size_t n)
+{
+    typedef typename MatrixType::value_type ValueType;
+
+    cusp::csr_matrix<int, ValueType, cusp::host_memory> B;
+    cusp::gallery::poisson5pt(B, n, n);
+
+    for (size_t i = 0; i < B.num_rows; i++)
+        for (int jj = B.row_offsets[i]; jj < B.row_offsets[i + 1]; jj++)
+            if (B.column_indices[jj] == int(i))
+                B.values[jj] -= ValueType(0.5, 0.5);
+            else
+                B.values[jj] *= ValueType(1, 0.1 * (i % 3));
+
+    A = B;
+}
+
+template <typename ArrayType>
+void split_complex_test_vector(ArrayType& x, const size_t n, const int seed)
+{
+    typedef typename ArrayType::value_type ValueType;
+
+    cusp::array1d<ValueType, cusp::host_memory> y(n);
+
+    for (size_t i = 0; i < n; i++)
+        y[i] = ValueType(((i * 7 + seed) % 11) - 5.0, ((i * 3 + seed) % 5) - 2.0);
+
+    x = y;
+}
+
+template <class MemorySpace>
+void TestSplitComplexArray1d(void)
+{
+    typedef cusp::complex<double> ValueType;
+
+    cusp::array1d<ValueType, MemorySpace> a;
+    split_complex_test_vector(a, 10, 1);
+
+    cusp::split_complex_array1d<double, MemorySpace> x(a);
+
+    ASSERT_EQUAL(x.size(), 10);
+    ASSERT_EQUAL(x.real[3], ValueType(a[3]).real());
+    ASSERT_EQUAL(x.imag[3], ValueType(a[3]).imag());
+
+    cusp::array1d<ValueType, MemorySpace> b;
+    x.copy_to(b);
+    ASSERT_EQUAL(b, a);
+
+    cusp::split_complex_array1d<double, MemorySpace> y(4, ValueType(1, -2));
+    ASSERT_EQUAL(y.real[3],  1.0);
+    ASSERT_EQUAL(y.imag[3], -2.0);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSplitComplexArray1d);
+
+template <class MemorySpace>
+void TestSplitComplexBlas(void)
+{
+    typedef cusp::complex<double> ValueType;
+    typedef cusp::split_complex_array1d<double, MemorySpace> SplitArray;
+
+    const size_t n = 37;
+    const ValueType alpha(0.5, -1.5);
+
+    cusp::array1d<ValueType, MemorySpace> a, b, c;
+    split_complex_test_vector(a, n, 1);
+    split_complex_test_vector(b, n, 4);
+
+    SplitArray x(a);
+    SplitArray y(b);
+
+    ASSERT_ALMOST_EQUAL(cusp::blas::dotc(x, y), cusp::blas::dotc(a, b));
+    ASSERT_ALMOST_EQUAL(cusp::blas::dot(x, y),  cusp::blas::dot(a, b));
+    ASSERT_ALMOST_EQUAL(cusp::blas::nrm2(x),    cusp::blas::nrm2(a));
+
+    cusp::blas::axpy(x, y, alpha);
+    cusp::blas::axpy(a, b, alpha);
+    y.copy_to(c);
+    ASSERT_ALMOST_EQUAL(c, b);
+
+    cusp::blas::scal(x, alpha);
+    cusp::blas::scal(a, alpha);
+    x.copy_to(c);
+    ASSERT_ALMOST_EQUAL(c, a);
+
+    cusp::blas::copy(x, y);
+    y.copy_to(c);
+    ASSERT_EQUAL(c, a);
+
+    cusp::blas::fill(y, alpha);
+    ASSERT_EQUAL(y.real[n - 1], alpha.real());
+    ASSERT_EQUAL(y.imag[n - 1], alpha.imag());
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSplitComplexBlas);
+
+template <class MemorySpace>
+void TestSplitComplexMultiply(void)
+{
+    typedef cusp::complex<double> ValueType;
+    typedef cusp::split_complex_array1d<double, MemorySpace> SplitArray;
+
+    cusp::csr_matrix<int, ValueType, MemorySpace> A;
+    split_complex_test_matrix(A, 6);
+
+    cusp::split_complex_csr_matrix<int, double, MemorySpace> S(A);
+
+    ASSERT_EQUAL(S.num_rows,    A.num_rows);
+    ASSERT_EQUAL(S.num_entries, A.num_entries);
+
+    cusp::array1d<ValueType, MemorySpace> a;
+    split_complex_test_vector(a, A.num_rows, 2);
+
+    cusp::array1d<ValueType, MemorySpace> reference(A.num_rows);
+    cusp::multiply(A, a, reference);
+
+    // split matrix with interleaved vectors
+    {
+        cusp::array1d<ValueType, MemorySpace> b(A.num_rows);
+        cusp::multiply(S, a, b);
+        ASSERT_ALMOST_EQUAL(b, reference);
+    }
+
+    // split matrix with split vectors
+    {
+        SplitArray x(a);
+        SplitArray y(A.num_rows);
+        cusp::multiply(S, x, y);
+
+        cusp::array1d<ValueType, MemorySpace> b;
+        y.copy_to(b);
+        ASSERT_ALMOST_EQUAL(b, reference);
+    }
+
+    // real matrix with split vectors
+    {
+        cusp::csr_matrix<int, double, MemorySpace> R;
+        cusp::gallery::poisson5pt(R, 6, 6);
+
+        cusp::csr_matrix<int, ValueType, MemorySpace> C(R);
+        cusp::multiply(C, a, reference);
+
+        SplitArray x(a);
+        SplitArray y(A.num_rows);
+        cusp::multiply(R, x, y);
+
+        cusp::array1d<ValueType, MemorySpace> b;
+        y.copy_to(b);
+        ASSERT_ALMOST_EQUAL(b, reference);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSplitComplexMultiply);
+
+template <class MemorySpace>
+void TestSplitComplexGmres(void)
+{
+    typedef cusp::complex<double> ValueType;
+
+    cusp::csr_matrix<int, ValueType, MemorySpace> A;
+    split_complex_test_matrix(A, 10);
+
+    cusp::split_complex_csr_matrix<int, double, MemorySpace> S(A);
+
+    cusp::array1d<ValueType, MemorySpace> b(A.num_rows, ValueType(1, 0));
+    cusp::array1d<ValueType, MemorySpace> x(A.num_rows, ValueType(0, 0));
+    cusp::array1d<ValueType, MemorySpace> r(A.num_rows);
+
+    cusp::monitor<double> monitor(b, 500, 1e-8);
+
+    cusp::krylov::gmres(S, x, b, 30, monitor);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+
+    // residual of the interleaved matrix
+    cusp::multiply(A, x, r);
+    cusp::blas::axpy(b, r, ValueType(-1));
+
+    ASSERT_EQUAL(cusp::blas::nrm2(r) < 1e-7 * cusp::blas::nrm2(b), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSplitComplexGmres);
@@ -0,0 +1,133 @@
+#include <unittest/unittest.h>
+
+#include <cusp/csr_matrix.h>
+#include <cusp/monitor.h>
+#include <cusp/multiply.h>
+
+#include <cusp/gallery/poisson.h>
+#include <cusp/krylov/gmres.h>
+#include <cusp/krylov/sstep_gmres.h>
+#include <cusp/precond/diagonal.h>
+
+template <class LinearOperator, class VectorType1, class VectorType2, class Monitor, class Preconditioner>
+void sstep_gmres(my_system& system, const LinearOperator& A, VectorType1& x, const VectorType2& b, const size_t restart, const size_t s, Monitor& monitor, Preconditioner& M)
+{
+    system.validate_dispatch();
+    return;
+}
+
+void TestSStepGMRESDispatch()
+{
+    // initialize testing variables
+    cusp::csr_matrix<int, float, cusp::device_memory> A;
+    cusp::gallery::poisson5pt(A, 10, 10);
+    cusp::array1d<float, cusp::device_memory> x(A.num_rows, 0.0f);
+    cusp::monitor<float> monitor(x, 20, 1e-4);
+    cusp::identity_operator<float,cusp::device_memory> M(A.num_rows, A.num_cols);
+
+    {
+        my_system sys(0);
+
+        // call sstep_gmres with explicit dispatching
+        cusp::krylov::sstep_gmres(sys, A, x, x, 20, 4, monitor, M);
+
+        // check if dispatch policy was used
+        ASSERT_EQUAL(true, sys.is_valid());
+    }
+}
+DECLARE_UNITTEST(TestSStepGMRESDispatch);
+
+// 5-point Poisson operator with a weak upwinded convection in x
+template <typename MatrixType>
+void sstep_gmres_test_matrix(MatrixType& A, const size_t n)
+{
+    typedef typename MatrixType::value_type ValueType;
+
+    cusp::csr_matrix<int, ValueType, cusp::host_memory> B;
+    cusp::gallery::poisson5pt(B, n, n);
+
+    for (size_t i = 0; i < B.num_rows; i++)
+    {
+        for (int jj = B.row_offsets[i]; jj < B.row_offsets[i + 1]; jj++)
+        {
+            if (B.column_indices[jj] == int(i))
+                B.values[jj] += ValueType(0.2);
+            else if (B.column_indices[jj] + 1 == int(i))
+                B.values[jj] -= ValueType(0.2);
+        }
+    }
+
+    A = B;
+}
+
+template <class MemorySpace>
+void TestSStepGMRES(void)
+{
+    cusp::csr_matrix<int, double, MemorySpace> A;
+    sstep_gmres_test_matrix(A, 16);
+
+    cusp::array1d<double, MemorySpace> b(A.num_rows, 1.0);
+    cusp::array1d<double, MemorySpace> residual(A.num_rows, 0.0);
+
+    // reference GMRES iteration count
+    cusp::array1d<double, MemorySpace> y(A.num_rows, 0.0);
+    cusp::monitor<double> gmres_monitor(b, 1000, 1e-8);
+    cusp::krylov::gmres(A, y, b, 24, gmres_monitor);
+
+    for (size_t s = 1; s <= 8; s *= 2)
+    {
+        cusp::array1d<double, MemorySpace> x(A.num_rows, 0.0);
+        cusp::monitor<double> monitor(b, 1000, 1e-8);
+
+        cusp::krylov::sstep_gmres(A, x, b, 24, s, monitor);
+
+        ASSERT_EQUAL(monitor.converged(), true);
+
+        // check residual norm
+        cusp::multiply(A, x, residual);
+        cusp::blas::axpby(residual, b, residual, -1.0, 1.0);
+
+        ASSERT_EQUAL(cusp::blas::nrm2(residual) < 1e-7 * cusp::blas::nrm2(b), true);
+
+        // same iterates as GMRES in exact arithmetic
+        ASSERT_EQUAL(monitor.iteration_count() <= gmres_monitor.iteration_count() + 2, true);
+    }
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSStepGMRES);
+
+template <class MemorySpace>
+void TestSStepGMRESPreconditioned(void)
+{
+    cusp::csr_matrix<int, float, MemorySpace> A;
+    sstep_gmres_test_matrix(A, 16);
+
+    cusp::array1d<float, MemorySpace> x(A.num_rows, 0.0f);
+    cusp::array1d<float, MemorySpace> b(A.num_rows, 1.0f);
+    cusp::array1d<float, MemorySpace> residual(A.num_rows, 0.0f);
+
+    cusp::monitor<float> monitor(b, 500, 1e-5);
+    cusp::precond::diagonal<float, MemorySpace> M(A);
+
+    cusp::krylov::sstep_gmres(A, x, b, 20, 4, monitor, M);
+
+    ASSERT_EQUAL(monitor.converged(), true);
+
+    cusp::multiply(A, x, residual);
+    cusp::blas::axpby(residual, b, residual, -1.0f, 1.0f);
+
+    ASSERT_EQUAL(cusp::blas::nrm2(residual) < 1e-4 * cusp::blas::nrm2(b), true);
+}
+DECLARE_HOST_DEVICE_UNITTEST(TestSStepGMRESPreconditioned);
+
+void TestSStepGMRESInvalidStep(void)
+{
+    cusp::csr_matrix<int, float, cusp::host_memory> A;
+    cusp::gallery::poisson5pt(A, 4, 4);
+
+    cusp::array1d<float, cusp::host_memory> x(A.num_rows, 0.0f);
+    cusp::array1d<float, cusp::host_memory> b(A.num_rows, 1.0f);
+
+    ASSERT_THROWS(cusp::krylov::sstep_gmres(A, x, b, 10, 0), cusp::invalid_input_exception);
+    ASSERT_THROWS(cusp::krylov::sstep_gmres(A, x, b, 10, 11), cusp::invalid_input_exception);
+}
+DECLARE_UNITTEST(TestSStepGMRESInvalidStep);